@@ -501,6 +501,10 @@ LightApp_Application::~LightApp_Application()
 /*!Start application.*/
 void LightApp_Application::start()
 {
+  // decode icons of all modules in the background while GUI is being built
+  if ( resourceMgr()->booleanValue( "desktop", "preload_pixmaps", false ) )
+    resourceMgr()->preloadPixmaps();
+
   CAM_Application::start();
 
   updateWindows();
@@ -2564,6 +2568,7 @@ QWidget* LightApp_Application::createWindow( const int flag )
     ob->setObjectName( "objectBrowser" );
     ob->setSortMenuEnabled( true );
     ob->setAutoUpdate( true );
+    ob->setLazyLoading( resMgr->booleanValue( "ObjectBrowser", "lazy_loading", false ) );
     if ( resMgr->hasValue( "ObjectBrowser", "auto_hide_search_tool" ) )
       ob->searchTool()->enableAutoHide( resMgr->booleanValue( "ObjectBrowser", "auto_hide_search_tool" ) );
 
@@ -2856,6 +2861,12 @@ void LightApp_Application::createPreferences( LightApp_Preferences* pref )
   pref->setItemProperty( "min",        0, autoSaveInterval );
   pref->setItemProperty( "max",     1440, autoSaveInterval );
   pref->setItemProperty( "special", tr( "PREF_AUTO_SAVE_DISABLED" ), autoSaveInterval );
+  // .... -> compression of module data
+  int compressionLevel = pref->addPreference( tr( "PREF_COMPRESSION_LEVEL" ), studyGroup,
+                                              LightApp_Preferences::IntSpin, "Study", "compression_level" );
+  pref->setItemProperty( "min",       0, compressionLevel );
+  pref->setItemProperty( "max",       9, compressionLevel );
+  pref->setItemProperty( "special", tr( "PREF_COMPRESSION_DISABLED" ), compressionLevel );
   // ... "Study properties" group <<end>>
 
   // ... "Help browser" group <<start>>
@@ -3407,6 +3418,15 @@ void LightApp_Application::createPreferences( LightApp_Preferences* pref )
   anIndicesList << 0                           << 1;
   pref->setItemProperty( "strings", aValuesList,   modePref );
   pref->setItemProperty( "indexes", anIndicesList, modePref );
+  // .... -> output format
+  int formatPref = pref->addPreference( tr( "PREF_RECORDING_FORMAT" ), vtkRec,
+                                        LightApp_Preferences::Selector, "VTKViewer", "recorder_format" );
+  aValuesList.clear();
+  anIndicesList.clear();
+  aValuesList   << tr( "PREF_FORMAT_AVI_MAKER" ) << tr( "PREF_FORMAT_RAW_AVI" ) << tr( "PREF_FORMAT_Y4M" );
+  anIndicesList << 0                             << 1                           << 2;
+  pref->setItemProperty( "strings", aValuesList,   formatPref );
+  pref->setItemProperty( "indexes", anIndicesList, formatPref );
   // .... -> fps
   int fpsPref = pref->addPreference( tr( "PREF_FPS" ), vtkRec,
                                      LightApp_Preferences::DblSpin, "VTKViewer", "recorder_fps" );
@@ -3621,6 +3641,9 @@ void LightApp_Application::createPreferences( LightApp_Preferences* pref )
   // .... -> resize columns on expand item
   pref->addPreference( tr( "PREF_RESIZE_ON_EXPAND_ITEM" ), objSetGroup, LightApp_Preferences::Bool,
                        "ObjectBrowser", "resize_on_expand_item" );
+  // .... -> create items on expand only
+  pref->addPreference( tr( "PREF_LAZY_LOADING" ), objSetGroup, LightApp_Preferences::Bool,
+                       "ObjectBrowser", "lazy_loading" );
   // .... -> browse to published object
   int browsePublished = pref->addPreference( tr( "PREF_BROWSE_TO_THE_PUBLISHED_OBJECT" ), objSetGroup, LightApp_Preferences::Selector,
                                              "ObjectBrowser", "browse_published_object" );
@@ -4397,6 +4420,9 @@ void LightApp_Application::preferencesChanged( const QString& sec, const QString
       bool resizeOnExpandItem = resMgr->booleanValue( "ObjectBrowser", "resize_on_expand_item", false );
       ob->setResizeOnExpandItem(resizeOnExpandItem);
     }
+    else if ( param=="lazy_loading" ) {
+      ob->setLazyLoading( resMgr->booleanValue( "ObjectBrowser", "lazy_loading", false ) );
+    }
     else if ( param == "auto_hide_search_tool" ) {
       ob->searchTool()->enableAutoHide( resMgr->booleanValue( "ObjectBrowser", "auto_hide_search_tool" ) );
     }
@@ -5544,6 +5570,7 @@ QString LightApp_Application::browseObjects( const QStringList& theEntryList,
       anObject = aStudy->findObjectByEntry( anEntry );
       if( anObject )
       {
+        aModel->fetchObject( anObject );
         QModelIndex anIndex = aModel->index( anObject );
         anOB->treeView()->scrollTo( anIndex );
       }
@@ -5868,6 +5895,7 @@ void LightApp_Application::updateVisibilityState( DataObjectList& theList,
 
   SALOME_View* aView = dynamic_cast<SALOME_View*>( theViewModel );
 
+  QMap<QString, Qtx::VisibilityState> aStates;
   for ( DataObjectList::iterator itr = theList.begin(); itr != theList.end(); ++itr ) {
     LightApp_DataObject* obj = dynamic_cast<LightApp_DataObject*>(*itr);
 
@@ -5884,9 +5912,11 @@ void LightApp_Application::updateVisibilityState( DataObjectList& theList,
         else
           anObjState = Qtx::HiddenState;
       }
-      aStudy->setVisibilityState( obj->entry(), anObjState );
+      aStates.insert( obj->entry(), anObjState );
     }
   }
+  // the Object Browser is refreshed once for all the objects
+  aStudy->setVisibilityStates( aStates );
 }
 
 /*!
@@ -5914,26 +5944,35 @@ void LightApp_Application::updatePresentations( const QString& theComponent,
         for ( ; itVMTypes != theViewManagerTypes.end(); ++itVMTypes )
           viewManagers( *itVMTypes, aViewMgrs );
 
+        QStringList anEntries;
         DataObjectList::const_iterator itObjs = anObjs.begin();
         for ( ; itObjs != anObjs.end(); itObjs++ ) {
           LightApp_DataObject* anObj = dynamic_cast<LightApp_DataObject*>( *itObjs );
-          QString anEntry = anObj->entry();
-
-          QListIterator<SUIT_ViewManager*> itViewMgrs( aViewMgrs );
-          while ( itViewMgrs.hasNext()) {
-            SUIT_ViewModel* aVM = itViewMgrs.next()->getViewModel();
-            if ( aVM ) {
-              SALOME_View* aView = dynamic_cast<SALOME_View*>(aVM);
-              if ( aView ) {
-                bool isDisp = aDisplayer->IsDisplayed( anEntry, aView );
-                aDisplayer->Erase( anEntry, true, false, aView );
-                if ( isDisp ) {
-                  aDisplayer->Display( anEntry, false, aView );
-                }
+          if ( anObj )
+            anEntries.append( anObj->entry() );
+        }
+
+        // all the objects of a view are erased then displayed at once,
+        // the Object Browser is updated at the end
+        aDisplayer->StartBatch();
+        QListIterator<SUIT_ViewManager*> itViewMgrs( aViewMgrs );
+        while ( itViewMgrs.hasNext()) {
+          SUIT_ViewModel* aVM = itViewMgrs.next()->getViewModel();
+          if ( aVM ) {
+            SALOME_View* aView = dynamic_cast<SALOME_View*>(aVM);
+            if ( aView ) {
+              QStringList aDisplayed;
+              QStringList::const_iterator itEntries = anEntries.constBegin();
+              for ( ; itEntries != anEntries.constEnd(); ++itEntries ) {
+                if ( aDisplayer->IsDisplayed( *itEntries, aView ) )
+                  aDisplayed.append( *itEntries );
               }
+              aDisplayer->Erase( anEntries, true, false, aView );
+              aDisplayer->Display( aDisplayed, false, aView );
             }
           }
         }
+        aDisplayer->FinishBatch( false );
       }
     }
   }
@@ -127,16 +127,21 @@ void LightApp_DataModel::update( LightApp_DataObject*, LightApp_Study* )
   LightApp_DataObject* modelRoot = dynamic_cast<LightApp_DataObject*>( root() );
   DataObjectList ch;
   QMap<SUIT_DataObject*,int> aMap;
-  if( modelRoot )
   {
-    ch = modelRoot->children();
-    QListIterator<SUIT_DataObject*> it( ch );
-    while ( it.hasNext() )
-      it.next()->setParent( 0 );
+    // the Object Browser is notified once, when the tree is rebuilt
+    SUIT_DataObject::Transaction aTransaction;
+
+    if( modelRoot )
+    {
+      ch = modelRoot->children();
+      QListIterator<SUIT_DataObject*> it( ch );
+      while ( it.hasNext() )
+        it.next()->setParent( 0 );
+    }
+
+    build();
   }
 
-  build();
-
   modelRoot = dynamic_cast<LightApp_DataObject*>( root() );
   if( modelRoot )
   {
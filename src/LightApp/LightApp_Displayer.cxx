@@ -43,6 +43,7 @@
   Default constructor
 */
 LightApp_Displayer::LightApp_Displayer()
+: myBatchLevel( 0 )
 {
 }
 
@@ -77,6 +78,7 @@ void LightApp_Displayer::Display( const QStringList& list, const bool updateView
                                   SALOME_View* theViewFrame )
 {
   SALOME_View* vf = theViewFrame ? theViewFrame : GetActiveView();
+  QMap<QString, Qtx::VisibilityState> aStates;
   QStringList::const_iterator it = list.constBegin();
   for ( ; it != list.constEnd(); ++it)
   {
@@ -90,14 +92,16 @@ void LightApp_Displayer::Display( const QStringList& list, const bool updateView
         vf->BeforeDisplay( this, prs );
         vf->Display( this, prs );
         vf->AfterDisplay( this, prs );
-
-        if ( updateViewer )
-          vf->Repaint();
       }
       delete prs;  // delete presentation because displayer is its owner
-      setVisibilityState(*it, Qtx::ShownState);
+      aStates.insert( *it, Qtx::ShownState );
     }
   }
+
+  // the view is repainted and the Object Browser is updated once for all the objects
+  if ( vf && updateViewer && !aStates.isEmpty() )
+    repaintView( vf );
+  updateVisibilityStates( aStates );
 }
 
 /*!
@@ -127,8 +131,10 @@ void LightApp_Displayer::Redisplay( const QString& entry, const bool updateViewe
       SALOME_View* view = dynamic_cast<SALOME_View*>(vmodel);
       if( view && ( IsDisplayed( entry, view ) || view == GetActiveView() ) )
       {
+        StartBatch();
         Erase( entry, true, false, view );
         Display( entry, updateViewer, view );
+        FinishBatch( updateViewer );
       }
     }
   }
@@ -166,6 +172,7 @@ void LightApp_Displayer::Erase( const QStringList& list, const bool forced,
   if ( !vf )
     return;
 
+  QMap<QString, Qtx::VisibilityState> aStates;
   QStringList::const_iterator it = list.constBegin();
   for ( ; it != list.constEnd(); ++it)
   {
@@ -175,12 +182,15 @@ void LightApp_Displayer::Erase( const QStringList& list, const bool forced,
       vf->BeforeErase( this, prs );
       vf->Erase( this, prs, forced );
       vf->AfterErase( this, prs );
-      if ( updateViewer )
-        vf->Repaint();
       delete prs;  // delete presentation because displayer is its owner
-      setVisibilityState(*it,Qtx::HiddenState);
+      aStates.insert( *it, Qtx::HiddenState );
     }
   }
+
+  // the view is repainted and the Object Browser is updated once for all the objects
+  if ( updateViewer && !aStates.isEmpty() )
+    repaintView( vf );
+  updateVisibilityStates( aStates );
 }
 
 /*!
@@ -196,9 +206,12 @@ void LightApp_Displayer::EraseAll( const bool forced, const bool updateViewer, S
   if ( vf ) {
     vf->EraseAll( this, forced );
     if ( updateViewer )
-      vf->Repaint();
+      repaintView( vf );
   }
 
+  // states which are still pending refer to erased objects
+  myBatchStates.clear();
+
   LightApp_Application* app = dynamic_cast<LightApp_Application*>( SUIT_Session::session()->activeApplication() );
   LightApp_Study* study = app ? dynamic_cast<LightApp_Study*>( app->activeStudy() ) : 0;  
   if(study)
@@ -235,6 +248,84 @@ void LightApp_Displayer::UpdateViewer() const
     vf->Repaint();
 }
 
+/*!
+  \brief Start a batch of display/erase operations.
+
+  Until the matching FinishBatch(), the views are not repainted and the
+  visibility states of the objects are not sent to the Object Browser:
+  this is done once, at the end of the batch. Batches can be nested.
+  \sa FinishBatch()
+*/
+void LightApp_Displayer::StartBatch()
+{
+  myBatchLevel++;
+}
+
+/*!
+  \brief Finish a batch of display/erase operations.
+
+  When the outermost batch is finished, the views which had to be updated
+  are repainted once and the visibility states are set at once.
+  \param updateViewer - if false, the views are not repainted
+  \sa StartBatch()
+*/
+void LightApp_Displayer::FinishBatch( const bool updateViewer )
+{
+  if ( myBatchLevel == 0 || --myBatchLevel > 0 )
+    return;
+
+  QSet<SALOME_View*> aViews = myBatchViews;
+  QMap<QString, Qtx::VisibilityState> aStates = myBatchStates;
+  myBatchViews.clear();
+  myBatchStates.clear();
+
+  if ( updateViewer ) {
+    QSet<SALOME_View*>::const_iterator it = aViews.constBegin();
+    for ( ; it != aViews.constEnd(); ++it )
+      (*it)->Repaint();
+  }
+  setVisibilityStates( aStates );
+}
+
+/*!
+  \return true if a batch of display/erase operations is in progress
+  \sa StartBatch()
+*/
+bool LightApp_Displayer::IsBatch() const
+{
+  return myBatchLevel > 0;
+}
+
+/*!
+  Repaints the view, or postpones it until the end of the current batch
+  \param theViewFrame - view
+*/
+void LightApp_Displayer::repaintView( SALOME_View* theViewFrame )
+{
+  if ( IsBatch() )
+    myBatchViews.insert( theViewFrame );
+  else
+    theViewFrame->Repaint();
+}
+
+/*!
+  Sets the visibility states, or postpones it until the end of the current batch
+  \param theStates - visibility states, by entry
+*/
+void LightApp_Displayer::updateVisibilityStates( const QMap<QString, Qtx::VisibilityState>& theStates )
+{
+  if ( theStates.isEmpty() )
+    return;
+
+  if ( IsBatch() ) {
+    QMap<QString, Qtx::VisibilityState>::const_iterator it = theStates.constBegin();
+    for ( ; it != theStates.constEnd(); ++it )
+      myBatchStates.insert( it.key(), it.value() );
+  }
+  else
+    setVisibilityStates( theStates );
+}
+
 /*!
   \return presentation of object, built with help of CreatePrs method
   \param entry - object entry
@@ -344,3 +435,19 @@ void LightApp_Displayer::setVisibilityState( const QString& theEntry, Qtx::Visib
   if(study)
     study->setVisibilityState( theEntry, theState);
 }
+
+/*!
+  Find the active study and set the 'visibility state' property of several objects at once
+  \param theStates - visibility states, by entry
+*/
+void LightApp_Displayer::setVisibilityStates( const QMap<QString, Qtx::VisibilityState>& theStates ) const
+{
+  if ( theStates.isEmpty() )
+    return;
+
+  LightApp_Application* app = dynamic_cast<LightApp_Application*>( SUIT_Session::session()->activeApplication() );
+  LightApp_Study* study = app ? dynamic_cast<LightApp_Study*>( app->activeStudy() ) : 0;
+
+  if ( study )
+    study->setVisibilityStates( theStates );
+}
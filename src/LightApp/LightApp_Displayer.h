@@ -29,6 +29,9 @@
 
 #include <Qtx.h>
 
+#include <QMap>
+#include <QSet>
+
 class QString;
 
 /*!
@@ -56,6 +59,10 @@ public:
   virtual bool IsDisplayed( const QString&, SALOME_View* = 0 ) const;
   void UpdateViewer() const;
 
+  void StartBatch();
+  void FinishBatch( const bool updateViewer = true );
+  bool IsBatch() const;
+
   static SALOME_View*        GetActiveView();
   static LightApp_Displayer* FindDisplayer( const QString&, const bool );
 
@@ -63,11 +70,22 @@ public:
           bool canBeDisplayed( const QString& /*entry*/ ) const;
 	  
 	  void setVisibilityState (const QString& entry, Qtx::VisibilityState) const;
+	  void setVisibilityStates(const QMap<QString, Qtx::VisibilityState>&) const;
 
 protected:
   virtual SALOME_Prs* buildPresentation( const QString&, SALOME_View* = 0 );
+
+private:
+  void repaintView( SALOME_View* );
+  void updateVisibilityStates( const QMap<QString, Qtx::VisibilityState>& );
+
 protected:
   QString myLastEntry; 
+
+private:
+  int                                 myBatchLevel;    //!< depth of nested batches
+  QSet<SALOME_View*>                  myBatchViews;    //!< views to be repainted at the end of the batch
+  QMap<QString, Qtx::VisibilityState> myBatchStates;   //!< visibility states to be set at the end of the batch
 };
 
 #endif
@@ -228,6 +228,25 @@ void LightApp_Driver::SetListOfFiles( const char* theModuleName, const ListOfFil
   myMap[aName] = theListOfFiles;
 }
 
+/*!
+  Sets compression level (0 - no compression, 1..9 - from the fastest to the best)
+  for files of module with name 'theModuleName'. The level is used by the drivers
+  which support compression of the stored data (see LightApp_HDFDriver).
+*/
+void LightApp_Driver::SetCompressionLevel( const char* theModuleName, const int theLevel )
+{
+  myCompression[std::string(theModuleName)] = theLevel < 0 ? 0 : ( theLevel > 9 ? 9 : theLevel );
+}
+
+/*!
+  \return compression level for files of module with name 'theModuleName'
+*/
+int LightApp_Driver::CompressionLevel( const char* theModuleName ) const
+{
+  std::map<std::string, int>::const_iterator it = myCompression.find(std::string(theModuleName));
+  return it != myCompression.end() ? it->second : 0;
+}
+
 /*!
   Converts files which was created from module <theModuleName> into a byte sequence unsigned char
 */
@@ -55,6 +55,9 @@ public:
 
   virtual void        ClearDriverContents();
 
+  void                SetCompressionLevel(const char* theModuleName, const int theLevel);
+  int                 CompressionLevel(const char* theModuleName) const;
+
 protected:
   void                PutFilesToStream(const std::string& theModuleName, unsigned char*& theBuffer,
                                        long& theBufferSize, bool theNamesOnly = false);
@@ -71,6 +74,7 @@ protected:
   typedef std::map<std::string, ListOfFiles> MapOfListOfFiles;
   MapOfListOfFiles                           myMap;
   std::string                                myTmpDir;
+  std::map<std::string, int>                 myCompression;
 
 private:
   bool                                       myIsTemp;
@@ -27,6 +27,257 @@
 // OCCT Includes
 #include <TCollection_AsciiString.hxx>
 
+#include <QElapsedTimer>
+#include <QFile>
+#include <QRunnable>
+#include <QThreadPool>
+#include <QVector>
+
+#include <hdf5.h>
+
+#include <utilities.h>
+
+// Compressed chunks are packed and unpacked by the driver itself (in parallel)
+// and passed to HDF by direct chunk I/O when the library supports it
+#if H5_VERSION_GE(1,10,3)
+#define LIGHTAPP_HDF_DIRECT_CHUNKS
+#endif
+
+namespace
+{
+  const hsize_t ChunkSize  = 1 << 20;  // size of HDF chunk of a file dataset
+  const hsize_t WindowSize = 64 << 20; // size of a file part mapped to memory at once (multiple of ChunkSize)
+
+  /*!
+    Chunk of a file dataset: raw data of the file and its stored (deflated
+    or, if it does not compress, raw) representation.
+  */
+  struct FileChunk
+  {
+    char*      myData;     // raw data of the chunk in a file window
+    int        mySize;     // size of raw data, less than the chunk size for the edge chunk
+    QByteArray myStored;   // stored representation, of the full chunk size when unpacked
+    unsigned   myMask;     // HDF filter mask: 1 if the deflate filter is skipped
+    bool       myIsOk;
+  };
+
+  /*!
+    Packs (\a theLevel > 0) or unpacks (\a theLevel == 0) a chunk in a worker thread.
+    The packed data is a zlib stream, as expected by the HDF deflate filter.
+  */
+  class FileChunkJob : public QRunnable
+  {
+  public:
+    FileChunkJob( FileChunk& theChunk, int theChunkSize, int theLevel )
+      : myChunk( theChunk ), myChunkSize( theChunkSize ), myLevel( theLevel ) {}
+
+    virtual void run()
+    {
+      if ( myLevel > 0 ) {
+        // the edge chunk is stored full size
+        QByteArray aRaw( myChunk.myData, myChunk.mySize );
+        if ( myChunk.mySize < myChunkSize )
+          aRaw.append( QByteArray( myChunkSize - myChunk.mySize, '\0' ) );
+        // qCompress() prepends 4 bytes of the data size to the zlib stream
+        QByteArray aPacked = qCompress( aRaw, myLevel );
+        myChunk.myMask = aPacked.size() - 4 < aRaw.size() ? 0 : 1;
+        myChunk.myStored = myChunk.myMask ? aRaw : aPacked.mid( 4 );
+        myChunk.myIsOk = true;
+      }
+      else {
+        QByteArray aRaw;
+        if ( myChunk.myMask & 1 )
+          aRaw = myChunk.myStored;
+        else {
+          QByteArray aPacked( 4, '\0' );
+          aPacked[0] = (char)( ( myChunkSize >> 24 ) & 0xff );
+          aPacked[1] = (char)( ( myChunkSize >> 16 ) & 0xff );
+          aPacked[2] = (char)( ( myChunkSize >> 8 ) & 0xff );
+          aPacked[3] = (char)( myChunkSize & 0xff );
+          aRaw = qUncompress( aPacked + myChunk.myStored );
+        }
+        myChunk.myIsOk = aRaw.size() >= myChunk.mySize;
+        if ( myChunk.myIsOk )
+          memcpy( myChunk.myData, aRaw.constData(), myChunk.mySize );
+      }
+    }
+
+  private:
+    FileChunk& myChunk;
+    int        myChunkSize;
+    int        myLevel;
+  };
+
+  /*!
+    Splits the window \a theData of \a theSize bytes to chunks of \a theChunkSize bytes.
+  */
+  QVector<FileChunk> splitWindow( char* theData, hsize_t theSize, hsize_t theChunkSize )
+  {
+    QVector<FileChunk> aChunks;
+    for ( hsize_t anOffset = 0; anOffset < theSize; anOffset += theChunkSize ) {
+      FileChunk aChunk;
+      aChunk.myData = theData + anOffset;
+      aChunk.mySize = (int)( theSize - anOffset < theChunkSize ? theSize - anOffset : theChunkSize );
+      aChunk.myMask = 0;
+      aChunk.myIsOk = false;
+      aChunks.append( aChunk );
+    }
+    return aChunks;
+  }
+
+  /*!
+    Packs (\a theLevel > 0) or unpacks (\a theLevel == 0) chunks by the pool \a thePool.
+  */
+  bool processChunks( QVector<FileChunk>& theChunks, hsize_t theChunkSize, int theLevel, QThreadPool& thePool )
+  {
+    for ( int i = 0; i < theChunks.count(); i++ )
+      thePool.start( new FileChunkJob( theChunks[i], (int)theChunkSize, theLevel ) );
+    thePool.waitForDone();
+
+    bool isOk = true;
+    for ( int i = 0; i < theChunks.count() && isOk; i++ )
+      isOk = theChunks[i].myIsOk;
+    return isOk;
+  }
+
+  /*!
+    Writes contents of the opened file \a theFile to a new chunked dataset
+    \a theName of the HDF group \a theGroupId. The file is mapped to memory by
+    windows of WindowSize bytes and each window is passed to HDF as is;
+    a buffer of the same size is used if the file can not be mapped.
+    If \a theLevel is positive, the dataset is deflated with this level;
+    chunks of a window are packed in parallel by \a thePool.
+    Size of the written dataset is returned in \a theStoredSize.
+  */
+  bool writeFileData( hid_t theGroupId, const char* theName, QFile& theFile,
+                      int theLevel, QThreadPool& thePool, hsize_t& theStoredSize )
+  {
+    hsize_t aSize = (hsize_t)theFile.size();
+    bool isPacked = theLevel > 0 && aSize > 0;
+    hid_t aFileSpace = H5Screate_simple( 1, &aSize, 0 );
+    hid_t aProps = H5Pcreate( H5P_DATASET_CREATE );
+    hsize_t aChunk = aSize < ChunkSize ? aSize : ChunkSize;
+    if ( aSize > 0 )
+      H5Pset_chunk( aProps, 1, &aChunk );
+    if ( isPacked )
+      H5Pset_deflate( aProps, theLevel );
+    hid_t aDataset = H5Dcreate2( theGroupId, theName, H5T_NATIVE_UCHAR, aFileSpace,
+                                 H5P_DEFAULT, aProps, H5P_DEFAULT );
+    bool isOk = aDataset >= 0;
+
+    QByteArray aBuffer;
+    for ( hsize_t anOffset = 0; isOk && anOffset < aSize; ) {
+      hsize_t aCount = aSize - anOffset < WindowSize ? aSize - anOffset : WindowSize;
+      uchar* aData = theFile.map( (qint64)anOffset, (qint64)aCount );
+      if ( !aData ) {
+        aBuffer.resize( (int)aCount );
+        isOk = theFile.seek( (qint64)anOffset ) && theFile.read( aBuffer.data(), (qint64)aCount ) == (qint64)aCount;
+      }
+      char* aWindow = aData ? (char*)aData : aBuffer.data();
+#ifdef LIGHTAPP_HDF_DIRECT_CHUNKS
+      if ( isOk && isPacked ) {
+        QVector<FileChunk> aChunks = splitWindow( aWindow, aCount, aChunk );
+        isOk = processChunks( aChunks, aChunk, theLevel, thePool );
+        for ( int i = 0; i < aChunks.count() && isOk; i++ ) {
+          hsize_t aChunkOffset = anOffset + (hsize_t)i * aChunk;
+          isOk = H5Dwrite_chunk( aDataset, H5P_DEFAULT, aChunks[i].myMask, &aChunkOffset,
+                                 (size_t)aChunks[i].myStored.size(), aChunks[i].myStored.constData() ) >= 0;
+        }
+      }
+      else
+#endif
+      if ( isOk ) {
+        hid_t aMemSpace = H5Screate_simple( 1, &aCount, 0 );
+        H5Sselect_hyperslab( aFileSpace, H5S_SELECT_SET, &anOffset, 0, &aCount, 0 );
+        isOk = H5Dwrite( aDataset, H5T_NATIVE_UCHAR, aMemSpace, aFileSpace, H5P_DEFAULT, aWindow ) >= 0;
+        H5Sclose( aMemSpace );
+      }
+      if ( aData )
+        theFile.unmap( aData );
+      anOffset += aCount;
+    }
+
+    theStoredSize = 0;
+    if ( aDataset >= 0 ) {
+      theStoredSize = H5Dget_storage_size( aDataset );
+      H5Dclose( aDataset );
+    }
+    H5Pclose( aProps );
+    H5Sclose( aFileSpace );
+    return isOk;
+  }
+
+  /*!
+    Restores contents of the file \a theFile (opened for reading and writing)
+    from the dataset \a theName of the HDF group \a theGroupId. The file is resized
+    in advance and HDF reads the data directly into its memory mapped windows.
+    Deflated chunks of a window are read as is and unpacked in parallel by \a thePool.
+  */
+  bool readFileData( hid_t theGroupId, const char* theName, QFile& theFile, QThreadPool& thePool )
+  {
+    hid_t aDataset = H5Dopen2( theGroupId, theName, H5P_DEFAULT );
+    if ( aDataset < 0 )
+      return false;
+
+    hid_t aFileSpace = H5Dget_space( aDataset );
+    hsize_t aSize = (hsize_t)H5Sget_simple_extent_npoints( aFileSpace );
+    bool isOk = theFile.resize( (qint64)aSize );
+
+    // only datasets written by writeFileData() are unpacked by the driver
+    bool isPacked = false;
+    hsize_t aChunk = 0;
+#ifdef LIGHTAPP_HDF_DIRECT_CHUNKS
+    hid_t aProps = H5Dget_create_plist( aDataset );
+    isPacked = H5Pget_layout( aProps ) == H5D_CHUNKED && H5Pget_chunk( aProps, 1, &aChunk ) == 1 &&
+               ( aChunk == ChunkSize || aChunk == aSize ) && H5Pget_nfilters( aProps ) == 1 &&
+               H5Pget_filter2( aProps, 0, 0, 0, 0, 0, 0, 0 ) == H5Z_FILTER_DEFLATE;
+    H5Pclose( aProps );
+#endif
+
+    QByteArray aBuffer;
+    for ( hsize_t anOffset = 0; isOk && anOffset < aSize; ) {
+      hsize_t aCount = aSize - anOffset < WindowSize ? aSize - anOffset : WindowSize;
+      uchar* aData = theFile.map( (qint64)anOffset, (qint64)aCount );
+      if ( !aData )
+        aBuffer.resize( (int)aCount );
+      char* aWindow = aData ? (char*)aData : aBuffer.data();
+#ifdef LIGHTAPP_HDF_DIRECT_CHUNKS
+      if ( isPacked ) {
+        QVector<FileChunk> aChunks = splitWindow( aWindow, aCount, aChunk );
+        for ( int i = 0; i < aChunks.count() && isOk; i++ ) {
+          hsize_t aChunkOffset = anOffset + (hsize_t)i * aChunk;
+          hsize_t aStoredSize = 0;
+          uint32_t aMask = 0;
+          isOk = H5Dget_chunk_storage_size( aDataset, &aChunkOffset, &aStoredSize ) >= 0 && aStoredSize > 0;
+          if ( isOk ) {
+            aChunks[i].myStored.resize( (int)aStoredSize );
+            isOk = H5Dread_chunk( aDataset, H5P_DEFAULT, &aChunkOffset, &aMask, aChunks[i].myStored.data() ) >= 0;
+            aChunks[i].myMask = aMask;
+          }
+        }
+        isOk = isOk && processChunks( aChunks, aChunk, 0, thePool );
+      }
+      else
+#endif
+      {
+        hid_t aMemSpace = H5Screate_simple( 1, &aCount, 0 );
+        H5Sselect_hyperslab( aFileSpace, H5S_SELECT_SET, &anOffset, 0, &aCount, 0 );
+        isOk = H5Dread( aDataset, H5T_NATIVE_UCHAR, aMemSpace, aFileSpace, H5P_DEFAULT, aWindow ) >= 0;
+        H5Sclose( aMemSpace );
+      }
+      if ( aData )
+        isOk = theFile.unmap( aData ) && isOk;
+      else if ( isOk )
+        isOk = theFile.seek( (qint64)anOffset ) && theFile.write( aBuffer.constData(), (qint64)aCount ) == (qint64)aCount;
+      anOffset += aCount;
+    }
+
+    H5Sclose( aFileSpace );
+    H5Dclose( aDataset );
+    return isOk;
+  }
+}
+
 /*! Constructor.*/
 LightApp_HDFDriver::LightApp_HDFDriver()
 {
@@ -50,6 +301,7 @@ bool LightApp_HDFDriver::SaveDatasInFile( const char* theFileName, bool isMultiF
   HDFgroup *hdf_group_study_structure = 0;
   HDFgroup *hdf_sco_group  = 0;
   HDFgroup *hdf_sco_group2 = 0;
+  HDFgroup *hdf_group_files = 0;
   HDFdataset *hdf_dataset = 0;
   hdf_size aHDFSize[1];
 
@@ -70,9 +322,6 @@ bool LightApp_HDFDriver::SaveDatasInFile( const char* theFileName, bool isMultiF
     for (it = myMap.begin(); it != myMap.end(); ++it, ++tag) {
       std::string aName (it->first);
       char* aModuleName = const_cast<char*>(aName.c_str());
-      unsigned char* aBuffer;
-      long           aBufferSize;
-      PutFilesToStream(aName, aBuffer, aBufferSize, isMultiFile);
 
       //Handle(SALOMEDSImpl_SComponent) sco = itcomponent.Value();
       //TCollection_AsciiString scoid = sco->GetID();
@@ -86,13 +335,12 @@ bool LightApp_HDFDriver::SaveDatasInFile( const char* theFileName, bool isMultiF
       hdf_sco_group = new HDFgroup (entry.ToCString(), hdf_group_datacomponent);
       hdf_sco_group->CreateOnDisk();
 
-      aHDFSize[0] = aBufferSize;
-
-      hdf_dataset = new HDFdataset ("FILE_STREAM", hdf_sco_group, HDF_STRING, aHDFSize, 1);
-      hdf_dataset->CreateOnDisk();
-      hdf_dataset->WriteOnDisk(aBuffer); //Save the stream in the HDF file
-      hdf_dataset->CloseOnDisk();
-      hdf_dataset = 0; //will be deleted by hdf_sco_group destructor
+      // files are streamed to separate datasets (FILE_STREAM of older studies is still readable)
+      hdf_group_files = new HDFgroup ("FILES", hdf_sco_group);
+      hdf_group_files->CreateOnDisk();
+      PutFilesToGroup(aName, hdf_group_files, isMultiFile);
+      hdf_group_files->CloseOnDisk();
+      hdf_group_files = 0; // will be deleted by hdf_sco_group destructor
 
       // store multifile state
       aHDFSize[0] = 2;
@@ -112,8 +360,6 @@ bool LightApp_HDFDriver::SaveDatasInFile( const char* theFileName, bool isMultiF
 
       hdf_sco_group->CloseOnDisk();
       hdf_sco_group = 0; // will be deleted by hdf_group_datacomponent destructor
-
-      delete [] aBuffer;
     }
 
     hdf_group_datacomponent->CloseOnDisk();
@@ -312,6 +558,14 @@ bool LightApp_HDFDriver::ReadDatasFromFile( const char* theFileName, bool isMult
 
             delete [] aStreamFile;
           }
+          else if (hdf_sco_group->ExistInternalObject("FILES")) {
+            HDFgroup *hdf_group_files = new HDFgroup ("FILES", hdf_sco_group);
+            hdf_group_files->OpenOnDisk();
+            ListOfFiles aListOfFiles = PutGroupToFiles(hdf_group_files, isMultiFile);
+            char* aCompDataType = (char*)(mapEntryName[name].c_str());
+            SetListOfFiles(aCompDataType, aListOfFiles);
+            hdf_group_files->CloseOnDisk();
+          }
 
           hdf_sco_group->CloseOnDisk();
         }
@@ -344,3 +598,97 @@ bool LightApp_HDFDriver::ReadDatasFromFile( const char* theFileName, bool isMult
 
   return !isError;
 }
+
+/*!
+  Stores files which was created from module <theModuleName> into group <theGroup>:
+  the name of each file goes to FILE_NAME_<i> dataset and its contents goes
+  to FILE_DATA_<i> chunked dataset. The contents is passed to HDF by parts
+  straight from the memory mapped file, so no buffer of the file size is needed.
+  The datasets are deflated if a compression level is set for the module
+  (see SetCompressionLevel()).
+*/
+void LightApp_HDFDriver::PutFilesToGroup( const std::string& theModuleName, HDFgroup* theGroup,
+                                          bool theNamesOnly )
+{
+  ListOfFiles aFiles = myMap[theModuleName];
+  // aFiles must contain temporary directory name in its first item
+  // and names of files (relatively the temporary directory) in the others
+  hdf_size aHDFSize[1];
+  int aNbFiles = 0;
+  int aLevel = CompressionLevel(theModuleName.c_str());
+  hsize_t aRawSize = 0, aStoredSize = 0;
+  QThreadPool aPool;
+  QElapsedTimer aTimer;
+  aTimer.start();
+  for (size_t i = 1; i < aFiles.size(); i++) {
+    QFile aFile(QFile::decodeName((aFiles[0] + aFiles[i]).c_str()));
+    // if only file names must be stored, then files are not opened
+    if (!theNamesOnly && !aFile.open(QIODevice::ReadOnly))
+      continue;
+
+    aNbFiles++;
+    TCollection_AsciiString aNameId = TCollection_AsciiString("FILE_NAME_") + TCollection_AsciiString(aNbFiles);
+    aHDFSize[0] = aFiles[i].length() + 1;
+    HDFdataset *hdf_dataset = new HDFdataset (aNameId.ToCString(), theGroup, HDF_STRING, aHDFSize, 1);
+    hdf_dataset->CreateOnDisk();
+    hdf_dataset->WriteOnDisk((void*)aFiles[i].c_str());
+    hdf_dataset->CloseOnDisk();
+    hdf_dataset = 0; //will be deleted by theGroup destructor
+
+    if (!theNamesOnly) {
+      TCollection_AsciiString aDataId = TCollection_AsciiString("FILE_DATA_") + TCollection_AsciiString(aNbFiles);
+      hsize_t aFileStoredSize = 0;
+      if (!writeFileData(theGroup->GetId(), aDataId.ToCString(), aFile, aLevel, aPool, aFileStoredSize))
+        throw HDFexception("Can't write a file to the study");
+      aRawSize += (hsize_t)aFile.size();
+      aStoredSize += aFileStoredSize;
+    }
+  }
+
+  if (aRawSize > 0) {
+    double aSeconds = aTimer.elapsed() / 1000.;
+    INFOS("Module " << theModuleName << ": " << aNbFiles << " file(s), " << aRawSize << " bytes stored in "
+          << aStoredSize << " bytes (ratio " << (aStoredSize > 0 ? (double)aRawSize / aStoredSize : 0.)
+          << ", compression level " << aLevel << ", "
+          << (aSeconds > 0 ? aRawSize / aSeconds / (1 << 20) : 0.) << " MB/s)");
+  }
+}
+
+/*!
+  Restores files stored by PutFilesToGroup() from group <theGroup> and return list of them
+*/
+LightApp_Driver::ListOfFiles LightApp_HDFDriver::PutGroupToFiles( HDFgroup* theGroup, bool theNamesOnly )
+{
+  ListOfFiles aFiles;
+  QThreadPool aPool;
+  for (int i = 1; ; i++) {
+    TCollection_AsciiString aNameId = TCollection_AsciiString("FILE_NAME_") + TCollection_AsciiString(i);
+    if (!theGroup->ExistInternalObject(aNameId.ToCString()))
+      break;
+
+    if (aFiles.empty()) {
+      // Create a temporary directory for the component's data files
+      aFiles.push_back(GetTmpDir());
+      // Remember that the files are in a temporary location that should be deleted
+      // when a study is closed
+      SetIsTemporary(true);
+    }
+
+    HDFdataset *hdf_dataset = new HDFdataset(aNameId.ToCString(), theGroup);
+    hdf_dataset->OpenOnDisk();
+    std::vector<char> aFileName(hdf_dataset->GetSize() + 1, 0);
+    hdf_dataset->ReadFromDisk(&aFileName[0]);
+    hdf_dataset->CloseOnDisk();
+    hdf_dataset = 0;
+    aFiles.push_back(&aFileName[0]);
+
+    if (!theNamesOnly) {
+      TCollection_AsciiString aDataId = TCollection_AsciiString("FILE_DATA_") + TCollection_AsciiString(i);
+      QFile aFile(QFile::decodeName((aFiles[0] + aFiles.back()).c_str()));
+      if (!aFile.open(QIODevice::ReadWrite | QIODevice::Truncate) ||
+          !readFileData(theGroup->GetId(), aDataId.ToCString(), aFile, aPool))
+        throw HDFexception("Can't restore a file from the study");
+    }
+  }
+  return aFiles;
+}
@@ -30,6 +30,8 @@
 #pragma warning( disable:4251 )
 #endif
 
+class HDFgroup;
+
 /*!Description : Driver can save to file and read from file list of files for light modules*/
 
 class LIGHTAPP_EXPORT LightApp_HDFDriver : public LightApp_Driver
@@ -40,6 +42,11 @@ public:
 
   virtual bool        SaveDatasInFile   (const char* theFileName, bool isMultiFile);
   virtual bool        ReadDatasFromFile (const char* theFileName, bool isMultiFile);
+
+protected:
+  void                PutFilesToGroup(const std::string& theModuleName, HDFgroup* theGroup,
+                                      bool theNamesOnly = false);
+  ListOfFiles         PutGroupToFiles(HDFgroup* theGroup, bool theNamesOnly = false);
 };
 
 #endif
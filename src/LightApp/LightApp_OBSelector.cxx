@@ -28,6 +28,7 @@
 #include "LightApp_DataOwner.h"
 #include "LightApp_DataObject.h"
 #include "LightApp_Application.h"
+#include "LightApp_Study.h"
 #include <SUIT_DataBrowser.h>
 #include <SUIT_Session.h>
 #include <SUIT_DataObjectIterator.h>
@@ -160,12 +161,27 @@ void LightApp_OBSelector::setSelection( const SUIT_DataOwnerPtrList& theList )
   if( myEntries.count() == 0 || myModifiedTime < myBrowser->getModifiedTime() )
     fillEntries( myEntries );
 
+  // in the lazy mode, the data objects may be not created yet:
+  // the study creates them on demand
+  LightApp_Study* study = 0;
+  if ( myBrowser->lazyLoading() ) {
+    SUIT_Application* app = SUIT_Session::session()->activeApplication();
+    study = app ? dynamic_cast<LightApp_Study*>( app->activeStudy() ) : 0;
+  }
+
   DataObjectList objList;
   for ( SUIT_DataOwnerPtrList::const_iterator it = theList.begin(); 
         it != theList.end(); ++it ) {
     const LightApp_DataOwner* owner = dynamic_cast<const LightApp_DataOwner*>( (*it).operator->() );
-    if ( owner && myEntries.contains( owner->entry() ) )
+    if ( !owner )
+      continue;
+    if ( myEntries.contains( owner->entry() ) )
       objList.append( myEntries[owner->entry()] );
+    else if ( study ) {
+      LightApp_DataObject* obj = study->findObjectByEntry( owner->entry() );
+      if ( obj )
+        objList.append( obj );
+    }
   }
 
   myBrowser->setSelected( objList );
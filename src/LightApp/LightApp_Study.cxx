@@ -42,11 +42,20 @@
   Constructor.
 */
 LightApp_Study::LightApp_Study( SUIT_Application* app )
-: CAM_Study( app )
+: CAM_Study( app ),
+  myIndexedRoot( 0 )
 {
   // HDF persistence
   myDriver = new LightApp_HDFDriver();
   //myDriver = new LightApp_Driver();
+
+  // maintain the index of entries used by findObjectByEntry()
+  SUIT_DataObject::connect( SIGNAL( inserted( SUIT_DataObject*, SUIT_DataObject* ) ),
+                            this, SLOT( onObjectInserted( SUIT_DataObject*, SUIT_DataObject* ) ) );
+  SUIT_DataObject::connect( SIGNAL( destroyed( SUIT_DataObject* ) ),
+                            this, SLOT( onObjectDestroyed( SUIT_DataObject* ) ) );
+  SUIT_DataObject::connect( SIGNAL( childrenChanged( SUIT_DataObject* ) ),
+                            this, SLOT( onChildrenChanged( SUIT_DataObject* ) ) );
 }
 
 /*!
@@ -378,6 +387,18 @@ bool LightApp_Study::saveStudyData( const QString& theFileName, int /*type*/ )
     return false;
   bool isMultiFile = resMgr->booleanValue( "Study", "multi_file", false );
 
+  // compression level can be redefined for a module in its own resources section
+  int aLevel = resMgr->integerValue( "Study", "compression_level", 0 );
+  QListIterator<CAM_DataModel*> itList( list );
+  while ( itList.hasNext() )
+  {
+    CAM_DataModel* aModel = itList.next();
+    if ( !aModel || !aModel->module() ) continue;
+    QString aName = aModel->module()->name();
+    myDriver->SetCompressionLevel( aName.toLatin1().constData(),
+                                   resMgr->integerValue( aName, "compression_level", aLevel ) );
+  }
+
   bool aRes = myDriver->SaveDatasInFile(theFileName.toUtf8(), isMultiFile);
   return aRes;
 }
@@ -708,6 +729,25 @@ void LightApp_Study::setVisibilityState( const QString& theEntry, Qtx::Visibilit
   }
 }
 
+/*!
+  Set 'visibility state' property of several objects at once.
+  \param theStates - visibility status of the objects, by entry
+*/
+void LightApp_Study::setVisibilityStates( const QMap<QString, Qtx::VisibilityState>& theStates )
+{
+  LightApp_Application* app = (LightApp_Application*)application();
+  if ( !app ) return;
+  SUIT_DataBrowser* db = app->objectBrowser();
+  if ( !db ) return;
+  SUIT_AbstractModel* treeModel = dynamic_cast<SUIT_AbstractModel*>( db->model() );
+  if ( treeModel ) {
+    treeModel->setVisibilityStates( theStates );
+    QMap<QString, Qtx::VisibilityState>::const_iterator it;
+    for ( it = theStates.begin(); it != theStates.end(); ++it )
+      emit objVisibilityChanged( it.key(), it.value() );
+  }
+}
+
 /*!
   Set 'visibility state' property for all object.
   \param theEntry - Entry of the object.
@@ -750,11 +790,129 @@ Qtx::VisibilityState LightApp_Study::visibilityState( const QString& theEntry )
 */
 LightApp_DataObject* LightApp_Study::findObjectByEntry( const QString& theEntry )
 {
-  LightApp_DataObject* aCurObj;
+  updateEntryIndex();
+
+  SUIT_DataObject* anObj = myEntryIndex.value( theEntry );
+  LightApp_DataObject* aCurObj = dynamic_cast<LightApp_DataObject*>( anObj );
+  if ( aCurObj && anObj->root() == root() && aCurObj->entry() == theEntry )
+    return aCurObj;
+
+  // the object has been moved out of the study tree or its entry has changed
+  if ( anObj )
+    unindexObject( anObj );
+
+  // objects can be attached to the tree without the inserted() signal
+  // (e.g. by SUIT_DataObject::insertChildAtPos()): look through the tree
+  // and index the objects met on the way
   for ( SUIT_DataObjectIterator it( root(), SUIT_DataObjectIterator::DepthLeft ); it.current(); ++it ) {
+    if ( myIndexedRoot )
+      indexObject( it.current() );
     aCurObj = dynamic_cast<LightApp_DataObject*>( it.current() );
     if ( aCurObj && aCurObj->entry() == theEntry )
       return aCurObj;
   }
   return NULL;
 }
+
+/*!
+  Brings the index of entries up to date.
+
+  The whole tree is indexed on the first call (or after the root has been changed),
+  then only the objects inserted since the previous call are indexed.
+  Objects are indexed lazily because the inserted() signal is emitted
+  from the SUIT_DataObject constructor, before entry() can be called.
+*/
+void LightApp_Study::updateEntryIndex()
+{
+  if ( myIndexedRoot != root() ) {
+    myEntryIndex.clear();
+    myObjectEntries.clear();
+    myInsertedObjects.clear();
+    myIndexedRoot = root();
+    indexObjects( myIndexedRoot );
+    return;
+  }
+
+  QSet<SUIT_DataObject*> anObjects;
+  anObjects.swap( myInsertedObjects );
+  foreach ( SUIT_DataObject* anObj, anObjects ) {
+    if ( anObj->root() == myIndexedRoot )
+      indexObjects( anObj );
+  }
+}
+
+/*!
+  Adds the object and all its children to the index of entries.
+*/
+void LightApp_Study::indexObjects( SUIT_DataObject* theObj )
+{
+  if ( !theObj )
+    return;
+
+  for ( SUIT_DataObjectIterator it( theObj, SUIT_DataObjectIterator::DepthLeft ); it.current(); ++it )
+    indexObject( it.current() );
+}
+
+/*!
+  Adds the object to the index of entries (or updates its entry in the index).
+*/
+void LightApp_Study::indexObject( SUIT_DataObject* theObj )
+{
+  LightApp_DataObject* aCurObj = dynamic_cast<LightApp_DataObject*>( theObj );
+  if ( !aCurObj )
+    return;
+
+  QString anEntry = aCurObj->entry();
+  if ( anEntry.isEmpty() )
+    return;
+
+  QString anOldEntry = myObjectEntries.value( theObj );
+  if ( anOldEntry != anEntry )
+    unindexObject( theObj );
+
+  // keep the object found first by a depth-first walk, if it is still in the tree
+  SUIT_DataObject*& anIndexed = myEntryIndex[ anEntry ];
+  if ( !anIndexed || anIndexed->root() != myIndexedRoot )
+    anIndexed = theObj;
+  myObjectEntries.insert( theObj, anEntry );
+}
+
+/*!
+  Removes the object from the index of entries.
+*/
+void LightApp_Study::unindexObject( SUIT_DataObject* theObj )
+{
+  QString anEntry = myObjectEntries.take( theObj );
+  if ( !anEntry.isEmpty() && myEntryIndex.value( anEntry ) == theObj )
+    myEntryIndex.remove( anEntry );
+}
+
+/*!
+  Called when a data object is inserted into a tree: it is indexed on the next lookup.
+*/
+void LightApp_Study::onObjectInserted( SUIT_DataObject* theObj, SUIT_DataObject* /*theParent*/ )
+{
+  if ( myIndexedRoot && theObj )
+    myInsertedObjects.insert( theObj );
+}
+
+/*!
+  Marks the subtree changed by a transaction to be indexed
+  \param theObj - top-most changed data object
+*/
+void LightApp_Study::onChildrenChanged( SUIT_DataObject* theObj )
+{
+  if ( myIndexedRoot && theObj )
+    myInsertedObjects.insert( theObj );
+}
+
+/*!
+  Called when a data object is destroyed: removes it from the index.
+*/
+void LightApp_Study::onObjectDestroyed( SUIT_DataObject* theObj )
+{
+  myInsertedObjects.remove( theObj );
+  if ( theObj == myIndexedRoot )
+    myIndexedRoot = 0;
+  unindexObject( theObj );
+}
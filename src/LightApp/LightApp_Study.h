@@ -32,7 +32,9 @@
 #include "vector"
 #include <Qtx.h>
 
+#include <QHash>
 #include <QMap>
+#include <QSet>
 #include <QVariant>
 
 class SUIT_Study;
@@ -41,6 +43,7 @@ class CAM_DataModel;
 class CAM_ModuleObject;
 class LightApp_DataObject;
 class LightApp_DataModel;
+class SUIT_DataObject;
 
 //Map to store visual property of the object.
 //Key:   Name of the visual property of the object.
@@ -110,6 +113,7 @@ public:
   virtual void              removeObjectProperties( const QString& );
 
   virtual void                  setVisibilityState(const QString& theEntry, Qtx::VisibilityState theState);
+  virtual void                  setVisibilityStates(const QMap<QString, Qtx::VisibilityState>& theStates);
   virtual Qtx::VisibilityState  visibilityState(const QString& theEntry) const;
   virtual void                  setVisibilityStateForAll(Qtx::VisibilityState theState);
 
@@ -140,11 +144,30 @@ signals:
 
   void                objVisibilityChanged( QString, Qtx::VisibilityState );
 
+private slots:
+  void                onObjectInserted( SUIT_DataObject*, SUIT_DataObject* );
+  void                onChildrenChanged( SUIT_DataObject* );
+  void                onObjectDestroyed( SUIT_DataObject* );
+
+
+private:
+  void                indexObjects( SUIT_DataObject* );
+  void                indexObject( SUIT_DataObject* );
+  void                unindexObject( SUIT_DataObject* );
+  void                updateEntryIndex();
 
 private:
+  typedef QHash<QString, SUIT_DataObject*>     EntryIndex;
+  typedef QHash<SUIT_DataObject*, QString>     ObjectEntries;
+
   LightApp_Driver*    myDriver;
   ViewMgrMap          myViewMgrMap;
 
+  EntryIndex              myEntryIndex;       // entry -> data object
+  ObjectEntries           myObjectEntries;    // data object -> entry it is indexed with
+  QSet<SUIT_DataObject*>  myInsertedObjects;  // inserted since the last lookup
+  SUIT_DataObject*        myIndexedRoot;      // root of the indexed tree, 0 if the index is outdated
+
   friend class LightApp_Application;
   friend class LightApp_DataModel;
 };
@@ -252,6 +252,14 @@ The changes will be applied on the next application session.</translation>
         <source>PREF_AUTO_SAVE_DISABLED</source>
         <translation>Disabled</translation>
     </message>
+    <message>
+        <source>PREF_COMPRESSION_LEVEL</source>
+        <translation>Compression level of module data</translation>
+    </message>
+    <message>
+        <source>PREF_COMPRESSION_DISABLED</source>
+        <translation>Disabled</translation>
+    </message>
     <message>
         <source>PREF_PROJECTION_MODE</source>
         <translation>Projection mode:</translation>
@@ -388,6 +396,22 @@ The changes will be applied on the next application session.</translation>
         <source>PREF_ALL_DISLPAYED_FRAMES</source>
         <translation>Recording all displayed frames</translation>
     </message>
+    <message>
+        <source>PREF_RECORDING_FORMAT</source>
+        <translation>Output format</translation>
+    </message>
+    <message>
+        <source>PREF_FORMAT_AVI_MAKER</source>
+        <translation>AVI (jpeg2yuv)</translation>
+    </message>
+    <message>
+        <source>PREF_FORMAT_RAW_AVI</source>
+        <translation>AVI (uncompressed)</translation>
+    </message>
+    <message>
+        <source>PREF_FORMAT_Y4M</source>
+        <translation>YUV4MPEG2 (Y4M)</translation>
+    </message>
     <message>
         <source>PREF_FPS</source>
         <translation>FPS</translation>
@@ -540,6 +564,10 @@ The changes will be applied on the next application session.</translation>
         <source>PREF_RESIZE_ON_EXPAND_ITEM</source>
         <translation>Resize columns on expand item</translation>
     </message>
+    <message>
+        <source>PREF_LAZY_LOADING</source>
+        <translation>Show children on expand item only</translation>
+    </message>
     <message>
         <source>PREF_BROWSE_TO_THE_PUBLISHED_OBJECT</source>
         <translation>Browse to the published object</translation>
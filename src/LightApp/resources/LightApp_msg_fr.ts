@@ -252,6 +252,14 @@ Les modifications seront appliquées à la prochaine session.</translation>
         <source>PREF_AUTO_SAVE_DISABLED</source>
         <translation>Désactivé</translation>
     </message>
+    <message>
+        <source>PREF_COMPRESSION_LEVEL</source>
+        <translation>Niveau de compression des données des modules</translation>
+    </message>
+    <message>
+        <source>PREF_COMPRESSION_DISABLED</source>
+        <translation>Désactivé</translation>
+    </message>
     <message>
         <source>PREF_PROJECTION_MODE</source>
         <translation>Mode de projection:</translation>
@@ -388,6 +396,22 @@ Les modifications seront appliquées à la prochaine session.</translation>
         <source>PREF_ALL_DISLPAYED_FRAMES</source>
         <translation>Enregistrer toutes les images affichées</translation>
     </message>
+    <message>
+        <source>PREF_RECORDING_FORMAT</source>
+        <translation>Format de sortie</translation>
+    </message>
+    <message>
+        <source>PREF_FORMAT_AVI_MAKER</source>
+        <translation>AVI (jpeg2yuv)</translation>
+    </message>
+    <message>
+        <source>PREF_FORMAT_RAW_AVI</source>
+        <translation>AVI (non compressé)</translation>
+    </message>
+    <message>
+        <source>PREF_FORMAT_Y4M</source>
+        <translation>YUV4MPEG2 (Y4M)</translation>
+    </message>
     <message>
         <source>PREF_FPS</source>
         <translation>FPS</translation>
@@ -540,6 +564,10 @@ Les modifications seront appliquées à la prochaine session.</translation>
         <source>PREF_RESIZE_ON_EXPAND_ITEM</source>
         <translation>Redimensionner les colonnes quand l&apos;objet est déplié</translation>
     </message>
+    <message>
+        <source>PREF_LAZY_LOADING</source>
+        <translation>Afficher les enfants seulement quand l&apos;objet est déplié</translation>
+    </message>
     <message>
         <source>PREF_BROWSE_TO_THE_PUBLISHED_OBJECT</source>
         <translation>Se déplacer sur l&apos;objet publié</translation>
@@ -251,6 +251,14 @@ Pythonファイルは、文字、数字、アンダースコアが含まれて
       <source>PREF_AUTO_SAVE_DISABLED</source>
       <translation>無効</translation>
     </message>
+    <message>
+      <source>PREF_COMPRESSION_LEVEL</source>
+      <translation>モジュールデータの圧縮レベル</translation>
+    </message>
+    <message>
+      <source>PREF_COMPRESSION_DISABLED</source>
+      <translation>無効</translation>
+    </message>
     <message>
       <source>PREF_PROJECTION_MODE</source>
       <translation>投影モード:</translation>
@@ -387,6 +395,22 @@ Pythonファイルは、文字、数字、アンダースコアが含まれて
       <source>PREF_ALL_DISLPAYED_FRAMES</source>
       <translation>表示されるすべてのフレームを保存</translation>
     </message>
+    <message>
+      <source>PREF_RECORDING_FORMAT</source>
+      <translation>出力形式</translation>
+    </message>
+    <message>
+      <source>PREF_FORMAT_AVI_MAKER</source>
+      <translation>AVI (jpeg2yuv)</translation>
+    </message>
+    <message>
+      <source>PREF_FORMAT_RAW_AVI</source>
+      <translation>AVI (非圧縮)</translation>
+    </message>
+    <message>
+      <source>PREF_FORMAT_Y4M</source>
+      <translation>YUV4MPEG2 (Y4M)</translation>
+    </message>
     <message>
       <source>PREF_FPS</source>
       <translation>FPS</translation>
@@ -539,6 +563,10 @@ Pythonファイルは、文字、数字、アンダースコアが含まれて
       <source>PREF_RESIZE_ON_EXPAND_ITEM</source>
       <translation>オブジェクトを開いたときの列のサイズを変更</translation>
     </message>
+    <message>
+      <source>PREF_LAZY_LOADING</source>
+      <translation>オブジェクトを開いたときにのみ子を表示</translation>
+    </message>
     <message>
       <source>PREF_BROWSE_TO_THE_PUBLISHED_OBJECT</source>
       <translation>公開オブジェクトをブラウズ</translation>
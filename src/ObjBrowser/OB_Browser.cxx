@@ -151,7 +151,10 @@ OB_Browser::OB_Browser( QWidget* parent, QAbstractItemModel* model )
   mySearchTool = new QtxSearchTool( this, myView );                  // create search tool
   mySearchTool->setFrameStyle( QFrame::NoFrame | QFrame::Plain );    // do not show frame
   mySearchTool->setActivators( QtxSearchTool::StandardKey | QtxSearchTool::SlashKey ); // set activation mode
-  mySearchTool->setSearcher( new QtxTreeViewSearcher( myView ) );    // assign searcher (for tree view)
+  QtxTreeViewSearcher* searcher = new QtxTreeViewSearcher( myView );
+  searcher->setIndexed( true );                                      // index the texts of the big trees
+  mySearchTool->setSearcher( searcher );                             // assign searcher (for tree view)
+  mySearchTool->setSearchDelay( 150 );                               // do not search at each key stroke
   
   // layout widgets
   QVBoxLayout* main = new QVBoxLayout( this );
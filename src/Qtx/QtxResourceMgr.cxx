@@ -30,6 +30,16 @@
 #include <QDir>
 #include <QFile>
 #include <QFileInfo>
+#include <QSaveFile>
+#include <QDataStream>
+#include <QDateTime>
+#include <QStandardPaths>
+#include <QCryptographicHash>
+#include <QImageReader>
+#include <QMutex>
+#include <QRunnable>
+#include <QThreadPool>
+#include <QWaitCondition>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QRegExp>
@@ -45,6 +55,12 @@
 
 #include <stdlib.h>
 
+// typed values kept in the values cache
+Q_DECLARE_METATYPE(QLinearGradient)
+Q_DECLARE_METATYPE(QRadialGradient)
+Q_DECLARE_METATYPE(QConicalGradient)
+Q_DECLARE_METATYPE(Qtx::BackgroundData)
+
 /* XPM for the default pixmap */
 static const char* pixmap_not_found_xpm[] = {
 "16 16 3 1",
@@ -489,6 +505,323 @@ QString QtxResourceMgr::Resources::makeSubstitution( const QString& str, const Q
   return res;
 }
 
+/*!
+  \class QtxResourceMgr::Snapshot
+  \internal
+  \brief Binary snapshot of the sections loaded from a resources file.
+
+  The snapshot keeps the sections map read from a resources file (with all its imports)
+  together with the size and modification time of each file that contributed to it and
+  the list of import directives. Import directives can refer to environment variables,
+  so they are resolved again when the snapshot is validated. The snapshot is memory
+  mapped when it is read; it is used only if none of its sources has changed.
+*/
+
+class QtxResourceMgr::Snapshot
+{
+  typedef QMap<QString, Section> SectionMap;
+
+public:
+  Snapshot( const QString&, const QString& );
+
+  bool                   load( SectionMap& ) const;
+  bool                   save( const SectionMap& ) const;
+
+  void                   addDependency( const QString& );
+  void                   addImport( const QString&, const QString&, const QString& );
+
+private:
+  static QString         resolveImport( const QString&, const QString& );
+  static void            fileStamp( const QString&, qint64&, qint64& );
+
+private:
+  QString                myFileName;        //!< snapshot file name
+  QString                mySource;          //!< resources file name
+  QStringList            myDependencies;    //!< files read while loading resources
+  QList<QStringList>     myImports;         //!< import directives: name, base directory, file
+};
+
+namespace
+{
+  const quint32 SnapshotMagic   = 0x51525353; // "QRSS"
+  const quint32 SnapshotVersion = 1;
+}
+
+/*!
+  \brief Constructor.
+  \param fileName snapshot file name
+  \param source resources file name
+*/
+QtxResourceMgr::Snapshot::Snapshot( const QString& fileName, const QString& source )
+: myFileName( fileName ),
+  mySource( source )
+{
+}
+
+/*!
+  \brief Read sections map from the snapshot.
+  \param secMap resources map to be filled in
+  \return \c false if the snapshot does not exist, is invalid or outdated
+*/
+bool QtxResourceMgr::Snapshot::load( SectionMap& secMap ) const
+{
+  QFile file( myFileName );
+  if ( !file.open( QFile::ReadOnly ) || file.size() == 0 )
+    return false;
+
+  uchar* data = file.map( 0, file.size() );
+  QByteArray buffer = data ? QByteArray::fromRawData( (const char*)data, (int)file.size() ) : file.readAll();
+
+  QDataStream ds( buffer );
+  ds.setVersion( QDataStream::Qt_5_0 );
+
+  quint32 magic = 0, version = 0;
+  QString source;
+  ds >> magic >> version >> source;
+  bool res = ds.status() == QDataStream::Ok && magic == SnapshotMagic &&
+             version == SnapshotVersion && source == mySource;
+
+  // all contributing files must be unchanged
+  qint32 count = 0;
+  if ( res )
+    ds >> count;
+  for ( int i = 0; res && i < count; i++ )
+  {
+    QString fname;
+    qint64 size, time, curSize, curTime;
+    ds >> fname >> size >> time;
+    fileStamp( fname, curSize, curTime );
+    res = ds.status() == QDataStream::Ok && size == curSize && time == curTime;
+  }
+
+  // imports must lead to the same files
+  if ( res )
+    ds >> count;
+  for ( int i = 0; res && i < count; i++ )
+  {
+    QString name, dir, fname;
+    ds >> name >> dir >> fname;
+    res = ds.status() == QDataStream::Ok && resolveImport( name, dir ) == fname;
+  }
+
+  if ( res )
+    ds >> count;
+  for ( int i = 0; res && i < count; i++ )
+  {
+    QString sectName;
+    qint32 nbParams = 0;
+    ds >> sectName >> nbParams;
+    Section& sect = secMap[sectName];
+    for ( int j = 0; j < nbParams && ds.status() == QDataStream::Ok; j++ )
+    {
+      QString name, val;
+      ds >> name >> val;
+      sect.insert( name, val );
+    }
+    res = ds.status() == QDataStream::Ok;
+  }
+
+  if ( data )
+    file.unmap( data );
+
+  if ( !res )
+    secMap.clear();
+  return res;
+}
+
+/*!
+  \brief Write sections map to the snapshot.
+
+  Snapshot is not written if the format has not reported files read while loading.
+
+  \param secMap resources map
+  \return \c true on success and \c false on error
+*/
+bool QtxResourceMgr::Snapshot::save( const SectionMap& secMap ) const
+{
+  if ( myDependencies.isEmpty() || !Qtx::mkDir( QFileInfo( myFileName ).absolutePath() ) )
+    return false;
+
+  QSaveFile file( myFileName );
+  if ( !file.open( QFile::WriteOnly ) )
+    return false;
+
+  QDataStream ds( &file );
+  ds.setVersion( QDataStream::Qt_5_0 );
+
+  ds << SnapshotMagic << SnapshotVersion << mySource;
+
+  // imported files which were not loaded are also stamped
+  QStringList files = myDependencies;
+  for ( QList<QStringList>::ConstIterator it = myImports.begin(); it != myImports.end(); ++it )
+  {
+    if ( !files.contains( (*it)[2] ) )
+      files.append( (*it)[2] );
+  }
+
+  ds << (qint32)files.count();
+  for ( QStringList::ConstIterator it = files.begin(); it != files.end(); ++it )
+  {
+    qint64 size, time;
+    fileStamp( *it, size, time );
+    ds << *it << size << time;
+  }
+
+  ds << (qint32)myImports.count();
+  for ( QList<QStringList>::ConstIterator it = myImports.begin(); it != myImports.end(); ++it )
+    ds << (*it)[0] << (*it)[1] << (*it)[2];
+
+  ds << (qint32)secMap.count();
+  for ( SectionMap::ConstIterator it = secMap.begin(); it != secMap.end(); ++it )
+  {
+    ds << it.key() << (qint32)it.value().count();
+    for ( Section::ConstIterator itr = it.value().begin(); itr != it.value().end(); ++itr )
+      ds << itr.key() << itr.value();
+  }
+
+  return ds.status() == QDataStream::Ok && file.commit();
+}
+
+/*!
+  \brief Register file read while loading resources.
+  \param fname file name
+*/
+void QtxResourceMgr::Snapshot::addDependency( const QString& fname )
+{
+  if ( !myDependencies.contains( fname ) )
+    myDependencies.append( fname );
+}
+
+/*!
+  \brief Register import directive met while loading resources.
+  \param name imported file name as it is specified in the resources file
+  \param dir directory of the importing resources file
+  \param fname resolved imported file name
+*/
+void QtxResourceMgr::Snapshot::addImport( const QString& name, const QString& dir, const QString& fname )
+{
+  myImports.append( QStringList() << name << dir << fname );
+}
+
+/*!
+  \brief Get the file name referred by the import directive.
+
+  Import is resolved the same way as the resources formats do it.
+
+  \param name imported file name as it is specified in the resources file
+  \param dir directory of the importing resources file
+  \return absolute file name
+*/
+QString QtxResourceMgr::Snapshot::resolveImport( const QString& name, const QString& dir )
+{
+  QString impFile = QDir::toNativeSeparators( Qtx::makeEnvVarSubst( name, Qtx::Always ) );
+  QFileInfo impFInfo( impFile );
+  if ( impFInfo.isRelative() )
+    impFInfo.setFile( QDir( dir ), impFile );
+  return impFInfo.absoluteFilePath();
+}
+
+/*!
+  \brief Get size and modification time of the file.
+  \param fname file name
+  \param size returns file size (-1 if file does not exist)
+  \param time returns modification time in milliseconds
+*/
+void QtxResourceMgr::Snapshot::fileStamp( const QString& fname, qint64& size, qint64& time )
+{
+  QFileInfo fi( fname );
+  size = fi.exists() ? fi.size() : -1;
+  time = fi.exists() ? fi.lastModified().toMSecsSinceEpoch() : 0;
+}
+
+/*!
+  \class QtxResourceMgr::PixmapData
+  \internal
+  \brief Image of the pixmaps index which is decoded in the background.
+
+  The image is decoded either by the worker thread or, if the worker has not
+  started yet when the pixmap is requested, by the requesting thread itself.
+*/
+
+class QtxResourceMgr::PixmapData
+{
+public:
+  PixmapData( const QString& );
+
+  void                   decode();
+  QImage                 image();
+
+private:
+  typedef enum { Queued, Decoding, Done } State;
+
+  QString                myFileName;        //!< image file name
+  QImage                 myImage;           //!< decoded image
+  State                  myState;           //!< decoding state
+  QMutex                 myMutex;           //!< guards image and state
+  QWaitCondition         myDone;            //!< signalled when image is decoded
+};
+
+/*!
+  \brief Constructor.
+  \param fileName image file name
+*/
+QtxResourceMgr::PixmapData::PixmapData( const QString& fileName )
+: myFileName( fileName ),
+  myState( Queued )
+{
+}
+
+/*!
+  \brief Decode image if it is not decoded (or being decoded) yet.
+*/
+void QtxResourceMgr::PixmapData::decode()
+{
+  {
+    QMutexLocker lock( &myMutex );
+    if ( myState != Queued )
+      return;
+    myState = Decoding;
+  }
+
+  QImage img( myFileName );
+
+  QMutexLocker lock( &myMutex );
+  myImage = img;
+  myState = Done;
+  myDone.wakeAll();
+}
+
+/*!
+  \brief Get decoded image, wait for decoding if necessary.
+  \return image (null image if file can not be decoded)
+*/
+QImage QtxResourceMgr::PixmapData::image()
+{
+  decode();
+
+  QMutexLocker lock( &myMutex );
+  while ( myState != Done )
+    myDone.wait( &myMutex );
+  return myImage;
+}
+
+namespace
+{
+  /*!
+    \internal
+    \brief Background job decoding an image of the pixmaps index.
+  */
+  template <class T> class PixmapJob : public QRunnable
+  {
+  public:
+    PixmapJob( const QSharedPointer<T>& data ) : myData( data ) {}
+    virtual void run() { myData->decode(); }
+
+  private:
+    QSharedPointer<T> myData;
+  };
+}
+
 /*!
   \class QtxResourceMgr::IniFormat
   \internal
@@ -564,6 +897,8 @@ bool QtxResourceMgr::IniFormat::load( const QString& fname, QMap<QString, Sectio
   else
     return true;   // already imported (prevent import loops)
 
+  addDependency( aFName );
+
   QFile file( aFName );
   if ( !file.open( QFile::ReadOnly ) )
     return false;  // file is not accessible
@@ -621,6 +956,7 @@ bool QtxResourceMgr::IniFormat::load( const QString& fname, QMap<QString, Sectio
       QFileInfo impFInfo( impFile );
       if ( impFInfo.isRelative() )
         impFInfo.setFile( aFinfo.absoluteDir(), impFile );
+      addImport( data, aFinfo.absolutePath(), impFInfo.absoluteFilePath() );
 
       QMap<QString, Section> impMap;
       if ( !load( impFInfo.absoluteFilePath(), impMap, importHistory ) )
@@ -784,6 +1120,8 @@ bool QtxResourceMgr::XmlFormat::load( const QString& fname, QMap<QString, Sectio
   else
     return true;   // already imported (prevent import loops)
 
+  addDependency( aFName );
+
   bool res = false;
 
 #ifndef QT_NO_DOM
@@ -859,6 +1197,7 @@ bool QtxResourceMgr::XmlFormat::load( const QString& fname, QMap<QString, Sectio
 	      QFileInfo impFInfo( impFile );
 	      if ( impFInfo.isRelative() )
 	         impFInfo.setFile( aFinfo.absoluteDir(), impFile );
+        addImport( sectElem.attribute( nameAttribute() ), aFinfo.absolutePath(), impFInfo.absoluteFilePath() );
 
         QMap<QString, Section> impMap;
         if ( !load( impFInfo.absoluteFilePath(), impMap, importHistory ) )
@@ -1117,6 +1456,8 @@ bool QtxResourceMgr::JsonFormat::load( const QString& fname, QMap<QString, Secti
   else
     return true;   // already imported (prevent import loops)
 
+  addDependency( aFName );
+
   QFile file( aFName );
   if ( !file.open( QFile::ReadOnly ) )
     return false;  // file is not accessible
@@ -1137,6 +1478,7 @@ bool QtxResourceMgr::JsonFormat::load( const QString& fname, QMap<QString, Secti
       QFileInfo impFInfo( impPath );
       if ( impFInfo.isRelative() )
         impFInfo.setFile( aFinfo.absoluteDir(), impPath );
+      addImport( impFile, aFinfo.absolutePath(), impFInfo.absoluteFilePath() );
       QMap<QString, Section> impMap;
       if ( !load( impFInfo.absoluteFilePath(), impMap, importHistory ) )
       {
@@ -1260,7 +1602,8 @@ public:
   \param fmt format name (for example, "xml" or "ini")
 */
 QtxResourceMgr::Format::Format( const QString& fmt )
-: myFmt( fmt )
+: myFmt( fmt ),
+  mySnapshot( 0 )
 {
 }
 
@@ -1325,16 +1668,69 @@ bool QtxResourceMgr::Format::load( Resources* res )
   if ( !res )
     return false;
 
+  // snapshot of the file is used instead of parsing if sources are not changed
+  QString snapshotFile = res->resMgr() ? res->resMgr()->snapshotFileName( res->myFileName, format() ) : QString();
+  if ( !snapshotFile.isEmpty() )
+  {
+    QMap<QString, Section> sections;
+    if ( Snapshot( snapshotFile, res->myFileName ).load( sections ) )
+    {
+      res->mySections = sections;
+      return true;
+    }
+  }
+
+  Snapshot snapshot( snapshotFile, res->myFileName );
+  mySnapshot = !snapshotFile.isEmpty() ? &snapshot : 0;
+
   QMap<QString, Section> sections;
   bool status = load( res->myFileName, sections );
+  mySnapshot = 0;
+
   if ( status )
+  {
     res->mySections = sections;
+    if ( !snapshotFile.isEmpty() )
+      snapshot.save( sections );
+  }
   else
     qDebug() << "QtxResourceMgr: Can't load resource file:" << res->myFileName;
 
   return status;
 }
 
+/*!
+  \brief Register file read by load().
+
+  Resources formats should call this method for the loaded file and each
+  imported file: the files are checked to validate resources snapshot
+  (see QtxResourceMgr::setSnapshotDir()). Snapshot is not created for the
+  formats which do not register files.
+
+  \param fname file name
+*/
+void QtxResourceMgr::Format::addDependency( const QString& fname )
+{
+  if ( mySnapshot )
+    mySnapshot->addDependency( fname );
+}
+
+/*!
+  \brief Register import directive processed by load().
+
+  Import directives are resolved again (with current environment) when
+  resources snapshot is validated.
+
+  \param name imported file name as it is specified in the resources file
+  \param dir directory of the importing resources file
+  \param fname absolute name of the imported file
+*/
+void QtxResourceMgr::Format::addImport( const QString& name, const QString& dir, const QString& fname )
+{
+  if ( mySnapshot )
+    mySnapshot->addImport( name, dir, fname );
+}
+
 /*!
   \brief Save resources to the resource file.
   \param res resources object
@@ -1466,6 +1862,8 @@ QtxResourceMgr::QtxResourceMgr( const QString& appName, const QString& resVarTem
   myCheckExist( true ),
   myDefaultPix( 0 ),
   myIsPixmapCached( true ),
+  myPixmapPool( 0 ),
+  myIsValueCached( true ),
   myHasUserValues( true ),
   myWorkingMode( AllowUserValues )
 {
@@ -1490,6 +1888,10 @@ QtxResourceMgr::QtxResourceMgr( const QString& appName, const QString& resVarTem
   installFormat( new SalomexFormat() );
 
   setOption( "translators", QString( "%P_msg_%L.qm|%P_images.qm" ) );
+
+  QString cacheDir = QStandardPaths::writableLocation( QStandardPaths::GenericCacheLocation );
+  if ( !cacheDir.isEmpty() && !appName.isEmpty() )
+    setSnapshotDir( Qtx::addSlash( cacheDir ) + appName + "/resources" );
 }
 
 /*!
@@ -1499,6 +1901,8 @@ QtxResourceMgr::QtxResourceMgr()
 : myCheckExist( true ),
   myDefaultPix( 0 ),
   myIsPixmapCached( true ),
+  myPixmapPool( 0 ),
+  myIsValueCached( true ),
   myHasUserValues( false ),
   myWorkingMode( IgnoreUserValues )
 {
@@ -1524,6 +1928,13 @@ QtxResourceMgr::~QtxResourceMgr()
   qDeleteAll( myResources );
   qDeleteAll( myFormats );
 
+  if ( myPixmapPool )
+  {
+    myPixmapPool->clear();
+    myPixmapPool->waitForDone();
+    delete myPixmapPool;
+  }
+
   delete myDefaultPix;
 }
 
@@ -1591,6 +2002,7 @@ void QtxResourceMgr::initialize( const bool autoLoad ) const
     that->myResources.append( new Resources( that, userFile ) );
 
   that->myHasUserValues = myResources.count() > 0;
+  invalidateCache();
 
   for ( QStringList::ConstIterator it = myDirList.begin(); it != myDirList.end(); ++it )
   {
@@ -1626,6 +2038,86 @@ bool QtxResourceMgr::isPixmapCached() const
 void QtxResourceMgr::setIsPixmapCached( const bool on )
 {
   myIsPixmapCached = on;
+  if ( !on )
+    myPixmapIndex.clear();
+}
+
+/*!
+  \brief Get "cached values" option value.
+
+  Resources manager keeps a merged view of all resources: each parameter
+  is searched through the user and global resources only once, variables
+  in its value are substituted only once and typed values (colors, fonts,
+  gradients, backgrounds) are parsed only once. The cache is updated when
+  the parameter's section is changed by setValue() or remove(), when the
+  resources are (re)loaded and when the working mode or constants are changed.
+  Environment variables used in the parameters values are read once, so the cache
+  should be switched off if they are changed while the application is running.
+
+  This feature is turned on by default.
+
+  \return \c true if values cache is turned on
+  \sa setIsValueCached()
+*/
+bool QtxResourceMgr::isValueCached() const
+{
+  return myIsValueCached;
+}
+
+/*!
+  \brief Switch "cached values" option on/off.
+  \param on enable values cache if \c true and disable it if \c false
+  \sa isValueCached()
+*/
+void QtxResourceMgr::setIsValueCached( const bool on )
+{
+  myIsValueCached = on;
+  invalidateCache();
+}
+
+/*!
+  \brief Get directory where resources snapshots are stored.
+
+  To speed up loading, sections read from each resources file (with all
+  its imports) are stored to a binary snapshot file in this directory.
+  Next time the snapshot is read instead of parsing the resources file,
+  unless any of the files it was built from has been changed (size or
+  modification time) or an import directive now refers to another file.
+
+  By default, snapshots are stored in the user's cache directory.
+
+  \return snapshots directory (empty string if snapshots are not used)
+  \sa setSnapshotDir()
+*/
+QString QtxResourceMgr::snapshotDir() const
+{
+  return mySnapshotDir;
+}
+
+/*!
+  \brief Set directory where resources snapshots are stored.
+  \param dir snapshots directory; empty string switches snapshots off
+  \sa snapshotDir()
+*/
+void QtxResourceMgr::setSnapshotDir( const QString& dir )
+{
+  mySnapshotDir = dir;
+}
+
+/*!
+  \brief Get snapshot file name for the resources file.
+  \param fname resources file name
+  \param fmt resources format name
+  \return snapshot file name or null string if snapshots are not used
+*/
+QString QtxResourceMgr::snapshotFileName( const QString& fname, const QString& fmt ) const
+{
+  if ( snapshotDir().isEmpty() || fname.isEmpty() )
+    return QString();
+
+  QByteArray key = ( fmt + "\n" + QFileInfo( fname ).absoluteFilePath() ).toUtf8();
+  QString hash = QCryptographicHash::hash( key, QCryptographicHash::Md5 ).toHex();
+  return Qtx::addSlash( snapshotDir() ) + hash + ".res";
 }
 
 /*!
@@ -1635,6 +2127,7 @@ void QtxResourceMgr::clear()
 {
   for ( ResList::Iterator it = myResources.begin(); it != myResources.end(); ++it )
     (*it)->clear();
+  invalidateCache();
 }
 
 /*!
@@ -1665,6 +2158,8 @@ QtxResourceMgr::WorkingMode QtxResourceMgr::setWorkingMode( WorkingMode mode )
 {
   WorkingMode m = myWorkingMode;
   myWorkingMode = mode;
+  if ( m != mode && myHasUserValues )
+    invalidateCache();
   return m;
 }
 
@@ -1753,11 +2248,21 @@ bool QtxResourceMgr::value( const QString& sect, const QString& name, bool& bVal
 */
 bool QtxResourceMgr::value( const QString& sect, const QString& name, QColor& cVal ) const
 {
+  QVariant cached = typedValue( sect, name, qMetaTypeId<QColor>() );
+  if ( cached.isValid() )
+  {
+    cVal = cached.value<QColor>();
+    return true;
+  }
+
   QString val;
   if ( !value( sect, name, val, true ) )
     return false;
 
-  return Qtx::stringToColor( val, cVal );
+  bool ok = Qtx::stringToColor( val, cVal );
+  if ( ok )
+    setTypedValue( sect, name, QVariant::fromValue( cVal ) );
+  return ok;
 }
 
 /*!
@@ -1770,6 +2275,13 @@ bool QtxResourceMgr::value( const QString& sect, const QString& name, QColor& cV
 */
 bool QtxResourceMgr::value( const QString& sect, const QString& name, QFont& fVal ) const
 {
+  QVariant cached = typedValue( sect, name, qMetaTypeId<QFont>() );
+  if ( cached.isValid() )
+  {
+    fVal = cached.value<QFont>();
+    return true;
+  }
+
   QString val;
   if ( !value( sect, name, val, true ) )
     return false;
@@ -1805,6 +2317,7 @@ bool QtxResourceMgr::value( const QString& sect, const QString& name, QFont& fVa
     }
   }
 
+  setTypedValue( sect, name, QVariant::fromValue( fVal ) );
   return true;
 }
 
@@ -1861,11 +2374,21 @@ bool QtxResourceMgr::value( const QString& sect, const QString& name, QByteArray
 */
 bool QtxResourceMgr::value( const QString& sect, const QString& name, QLinearGradient& gVal ) const
 {
+  QVariant cached = typedValue( sect, name, qMetaTypeId<QLinearGradient>() );
+  if ( cached.isValid() )
+  {
+    gVal = cached.value<QLinearGradient>();
+    return true;
+  }
+
   QString val;
   if ( !value( sect, name, val, true ) )
     return false;
 
-  return Qtx::stringToLinearGradient( val, gVal );
+  bool ok = Qtx::stringToLinearGradient( val, gVal );
+  if ( ok )
+    setTypedValue( sect, name, QVariant::fromValue( gVal ) );
+  return ok;
 }
 
 /*!
@@ -1878,11 +2401,21 @@ bool QtxResourceMgr::value( const QString& sect, const QString& name, QLinearGra
 */
 bool QtxResourceMgr::value( const QString& sect, const QString& name, QRadialGradient& gVal ) const
 {
+  QVariant cached = typedValue( sect, name, qMetaTypeId<QRadialGradient>() );
+  if ( cached.isValid() )
+  {
+    gVal = cached.value<QRadialGradient>();
+    return true;
+  }
+
   QString val;
   if ( !value( sect, name, val, true ) )
     return false;
 
-  return Qtx::stringToRadialGradient( val, gVal );
+  bool ok = Qtx::stringToRadialGradient( val, gVal );
+  if ( ok )
+    setTypedValue( sect, name, QVariant::fromValue( gVal ) );
+  return ok;
 }
 
 /*!
@@ -1895,11 +2428,21 @@ bool QtxResourceMgr::value( const QString& sect, const QString& name, QRadialGra
 */
 bool QtxResourceMgr::value( const QString& sect, const QString& name, QConicalGradient& gVal ) const
 {
+  QVariant cached = typedValue( sect, name, qMetaTypeId<QConicalGradient>() );
+  if ( cached.isValid() )
+  {
+    gVal = cached.value<QConicalGradient>();
+    return true;
+  }
+
   QString val;
   if ( !value( sect, name, val, true ) )
     return false;
 
-  return Qtx::stringToConicalGradient( val, gVal );
+  bool ok = Qtx::stringToConicalGradient( val, gVal );
+  if ( ok )
+    setTypedValue( sect, name, QVariant::fromValue( gVal ) );
+  return ok;
 }
 
 /*!
@@ -1912,12 +2455,22 @@ bool QtxResourceMgr::value( const QString& sect, const QString& name, QConicalGr
 */
 bool QtxResourceMgr::value( const QString& sect, const QString& name, Qtx::BackgroundData& bgVal ) const
 {
+  QVariant cached = typedValue( sect, name, qMetaTypeId<Qtx::BackgroundData>() );
+  if ( cached.isValid() )
+  {
+    bgVal = cached.value<Qtx::BackgroundData>();
+    return true;
+  }
+
   QString val;
   if ( !value( sect, name, val, true ) )
     return false;
 
   bgVal = Qtx::stringToBackground( val );
-  return bgVal.isValid();
+  bool ok = bgVal.isValid();
+  if ( ok )
+    setTypedValue( sect, name, QVariant::fromValue( bgVal ) );
+  return ok;
 }
 
 /*!
@@ -1931,22 +2484,31 @@ bool QtxResourceMgr::value( const QString& sect, const QString& name, Qtx::Backg
 */
 bool QtxResourceMgr::value( const QString& sect, const QString& name, QString& val, const bool subst ) const
 {
-  initialize();
+  if ( !isValueCached() )
+  {
+    Resources* res = findResources( sect, name );
+    if ( res )
+      val = res->value( sect, name, subst, myConstants );
+    return res != 0;
+  }
 
-  bool ok = false;
- 
-  ResList::ConstIterator it = myResources.begin();
-  if ( myHasUserValues && workingMode() == IgnoreUserValues )
-    ++it;
+  CachedValue& cv = cachedValue( sect, name );
+  if ( !cv.myRes )
+    return false;
 
-  for ( ; it != myResources.end() && !ok; ++it )
+  if ( !subst )
+    val = cv.myRes->value( sect, name, false, myConstants );
+  else
   {
-    ok = (*it)->hasValue( sect, name );
-    if ( ok )
-      val = (*it)->value( sect, name, subst, myConstants );
+    if ( !cv.myIsSubst )
+    {
+      cv.myValue = cv.myRes->value( sect, name, true, myConstants );
+      cv.myIsSubst = true;
+    }
+    val = cv.myValue;
   }
 
-  return ok;
+  return true;
 }
 
 /*!
@@ -2160,18 +2722,7 @@ Qtx::BackgroundData QtxResourceMgr::backgroundValue( const QString& sect, const
 */
 bool QtxResourceMgr::hasValue( const QString& sect, const QString& name ) const
 {
-  initialize();
-
-  bool ok = false;
-
-  ResList::ConstIterator it = myResources.begin();
-  if ( myHasUserValues && workingMode() == IgnoreUserValues )
-    ++it;
-
-  for ( ; it != myResources.end() && !ok; ++it )
-    ok = (*it)->hasValue( sect, name );
-
-  return ok;
+  return isValueCached() ? cachedValue( sect, name ).myRes != 0 : findResources( sect, name ) != 0;
 }
 
 /*!
@@ -2391,6 +2942,7 @@ void QtxResourceMgr::remove( const QString& sect )
 
   for ( ResList::Iterator it = myResources.begin(); it != myResources.end(); ++it )
     (*it)->removeSection( sect );
+  invalidateCache( sect );
 }
 
 /*!
@@ -2404,6 +2956,7 @@ void QtxResourceMgr::remove( const QString& sect, const QString& name )
 
   for ( ResList::Iterator it = myResources.begin(); it != myResources.end(); ++it )
     (*it)->removeValue( sect, name );
+  invalidateCache( sect );
 }
 
 /*!
@@ -2554,7 +3107,10 @@ QString QtxResourceMgr::constant( const QString& name ) const
 void QtxResourceMgr::setConstant( const QString& name, const QString& value )
 {
   if ( !name.isEmpty() )
+  {
     myConstants.insert( name, value );
+    invalidateCache();
+  }
 }
 
 /*!
@@ -2574,6 +3130,8 @@ bool QtxResourceMgr::load()
   for ( ResList::Iterator it = myResources.begin(); it != myResources.end(); ++it )
     res = fmt->load( *it ) && res;
 
+  invalidateCache();
+
   return res;
 }
 
@@ -2599,6 +3157,7 @@ bool QtxResourceMgr::import( const QString& fname )
   r->setFile( fname );
   bool res = fmt->load( r );
   r->setFile( old );
+  invalidateCache();
   return res;
 }
 
@@ -2657,6 +3216,7 @@ bool QtxResourceMgr::addResource( const QString& fname )
 
   myDirList << dirName;
   myResources << resource;
+  invalidateCache();
   return true;
 }
 
@@ -2946,17 +3506,127 @@ QPixmap QtxResourceMgr::loadPixmap( const QString& prefix, const QString& name,
 
   QPixmap pix;
 
-  ResList::ConstIterator it = myResources.begin();
-  if ( myHasUserValues && workingMode() == IgnoreUserValues )
-    ++it;
+  if ( isPixmapCached() )
+    pix = pixmapEntry( prefix, name ).myPixmap;
+  else
+  {
+    ResList::ConstIterator it = myResources.begin();
+    if ( myHasUserValues && workingMode() == IgnoreUserValues )
+      ++it;
+
+    for ( ; it != myResources.end() && pix.isNull(); ++it )
+      pix = (*it)->loadPixmap( resSection(), prefix, name, myConstants );
+  }
 
-  for ( ; it != myResources.end() && pix.isNull(); ++it )
-    pix = (*it)->loadPixmap( resSection(), prefix, name, myConstants );
   if ( pix.isNull() )
     pix = defPix;
   return pix;
 }
 
+/*!
+  \brief Start decoding of all pixmaps of the resources directory in the background.
+
+  Pixmaps are put to the same index which is used by loadPixmap(), so
+  later requests of these pixmaps do not access the file system. If a pixmap
+  is requested before it is decoded, it is decoded (or the decoding is finished)
+  synchronously. Preloading has no effect if pixmaps cache is switched off.
+
+  \param prefix parameter which refers to the resources directory; if it is empty,
+         pixmaps of all directories listed in the resources section are preloaded
+  \sa loadPixmap(), isPixmapCached()
+*/
+void QtxResourceMgr::preloadPixmaps( const QString& prefix ) const
+{
+  initialize();
+
+  if ( !isPixmapCached() )
+    return;
+
+  if ( !myPixmapPool )
+    ((QtxResourceMgr*)this)->myPixmapPool = new QThreadPool();
+
+  QStringList filters;
+  QList<QByteArray> formats = QImageReader::supportedImageFormats();
+  for ( QList<QByteArray>::ConstIterator it = formats.begin(); it != formats.end(); ++it )
+    filters.append( QString( "*.%1" ).arg( QString( *it ) ) );
+
+  QStringList prefixes = prefix.isEmpty() ? parameters( resSection() ) : QStringList( prefix );
+  for ( QStringList::ConstIterator itp = prefixes.begin(); itp != prefixes.end(); ++itp )
+  {
+    ResList::ConstIterator it = myResources.begin();
+    if ( myHasUserValues && workingMode() == IgnoreUserValues )
+      ++it;
+
+    // resources are processed in priority order, so the first found file is taken
+    QSet<QString> dirs;
+    for ( ; it != myResources.end(); ++it )
+    {
+      QString dir = (*it)->path( resSection(), *itp, QString(), myConstants );
+      if ( dir.isEmpty() || dirs.contains( dir ) )
+        continue;
+      dirs.insert( dir );
+
+      QStringList files = QDir( dir ).entryList( filters, QDir::Files );
+      for ( QStringList::ConstIterator itf = files.begin(); itf != files.end(); ++itf )
+      {
+        PixmapKey key( *itp, *itf );
+        if ( myPixmapIndex.contains( key ) )
+          continue;
+
+        PixmapEntry& entry = myPixmapIndex[key];
+        entry.myFile = QDir( dir ).absoluteFilePath( *itf );
+        entry.myData = QSharedPointer<PixmapData>( new PixmapData( entry.myFile ) );
+        myPixmapPool->start( new PixmapJob<PixmapData>( entry.myData ) );
+      }
+    }
+  }
+}
+
+/*!
+  \brief Get pixmaps index entry.
+
+  If the pixmap is not indexed yet, it is searched through all resources
+  directories referred by the \a prefix parameter. Missing pixmaps are
+  indexed as well, so they are searched only once. If the pixmap has been
+  preloaded in the background, the decoded image is taken.
+
+  \param prefix parameter which refers to the resources directory
+  \param name pixmap file name
+  \return index entry
+*/
+QtxResourceMgr::PixmapEntry& QtxResourceMgr::pixmapEntry( const QString& prefix, const QString& name ) const
+{
+  PixmapKey key( prefix, name );
+  PixmapIndex::iterator itEntry = myPixmapIndex.find( key );
+  if ( itEntry == myPixmapIndex.end() )
+  {
+    PixmapEntry entry;
+
+    ResList::ConstIterator it = myResources.begin();
+    if ( myHasUserValues && workingMode() == IgnoreUserValues )
+      ++it;
+
+    for ( ; it != myResources.end() && entry.myPixmap.isNull(); ++it )
+    {
+      QString fname = (*it)->path( resSection(), prefix, name, myConstants );
+      if ( !fname.isEmpty() && entry.myPixmap.load( fname ) )
+        entry.myFile = fname;
+    }
+
+    itEntry = myPixmapIndex.insert( key, entry );
+  }
+
+  PixmapEntry& entry = itEntry.value();
+  if ( entry.myData )
+  {
+    entry.myPixmap = QPixmap::fromImage( entry.myData->image() );
+    entry.myData.clear();
+    if ( entry.myPixmap.isNull() )
+      entry.myFile = QString();
+  }
+  return entry;
+}
+
 /*!
   \brief Specify default language for the application.
 */
@@ -3229,6 +3899,7 @@ void QtxResourceMgr::setDirList( const QStringList& dl )
     delete *it;
 
   myResources.clear();
+  invalidateCache();
 }
 
 /*!
@@ -3242,7 +3913,11 @@ void QtxResourceMgr::setResource( const QString& sect, const QString& name, cons
   initialize();
 
   if ( !myResources.isEmpty() && myHasUserValues )
+  {
     myResources.first()->setValue( sect, name, val );
+    // other values of the section can refer to this one
+    invalidateCache( sect );
+  }
 }
 
 /*!
@@ -3348,3 +4023,100 @@ QString QtxResourceMgr::substMacro( const QString& src, const QMap<QChar, QStrin
 
   return trg;
 }
+
+/*!
+  \brief Find resources containing the parameter.
+
+  User resources are skipped in IgnoreUserValues working mode.
+
+  \param sect section name
+  \param name parameter name
+  \return resources the parameter value is taken from or 0 if there is no such parameter
+*/
+QtxResourceMgr::Resources* QtxResourceMgr::findResources( const QString& sect, const QString& name ) const
+{
+  initialize();
+
+  ResList::ConstIterator it = myResources.begin();
+  if ( myHasUserValues && workingMode() == IgnoreUserValues )
+    ++it;
+
+  for ( ; it != myResources.end(); ++it )
+  {
+    if ( (*it)->hasValue( sect, name ) )
+      return *it;
+  }
+  return 0;
+}
+
+/*!
+  \brief Get cached parameter, look it up through the resources if it is not cached yet.
+
+  Missing parameters are cached as well.
+
+  \param sect section name
+  \param name parameter name
+  \return cached parameter
+*/
+QtxResourceMgr::CachedValue& QtxResourceMgr::cachedValue( const QString& sect, const QString& name ) const
+{
+  // resources loading drops the cache, so it should be done in advance
+  initialize();
+
+  SectionCache& section = myCache[sect];
+  SectionCache::iterator it = section.find( name );
+  if ( it == section.end() )
+  {
+    CachedValue cv;
+    cv.myRes = findResources( sect, name );
+    it = section.insert( name, cv );
+  }
+  return it.value();
+}
+
+/*!
+  \brief Get typed parameter value parsed before.
+  \param sect section name
+  \param name parameter name
+  \param type meta type id of the value
+  \return cached value or invalid QVariant if there is no cached value of this type
+*/
+QVariant QtxResourceMgr::typedValue( const QString& sect, const QString& name, const int type ) const
+{
+  if ( !isValueCached() )
+    return QVariant();
+
+  const CachedValue& cv = cachedValue( sect, name );
+  return cv.myTyped.userType() == type ? cv.myTyped : QVariant();
+}
+
+/*!
+  \brief Remember parsed typed parameter value.
+  \param sect section name
+  \param name parameter name
+  \param val typed value
+*/
+void QtxResourceMgr::setTypedValue( const QString& sect, const QString& name, const QVariant& val ) const
+{
+  if ( isValueCached() )
+    cachedValue( sect, name ).myTyped = val;
+}
+
+/*!
+  \brief Drop cached values.
+
+  Values of a section can refer to each other, so the cache is dropped for the whole section.
+
+  \param sect section name; if it is null, the whole cache is cleared
+*/
+void QtxResourceMgr::invalidateCache( const QString& sect ) const
+{
+  if ( sect.isNull() )
+    myCache.clear();
+  else
+    myCache.remove( sect );
+
+  // resources directories are taken from the resources section
+  if ( sect.isNull() || sect == resSection() )
+    myPixmapIndex.clear();
+}
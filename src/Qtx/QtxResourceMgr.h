@@ -33,17 +33,22 @@
 #endif
 
 #include <QMap>
+#include <QHash>
+#include <QPair>
 #include <QList>
 #include <QFont>
 #include <QColor>
 #include <QPixmap>
+#include <QSharedPointer>
 #include <QByteArray>
+#include <QVariant>
 #include <QStringList>
 #include <QLinearGradient>
 #include <QRadialGradient>
 #include <QConicalGradient>
 
 class QTranslator;
+class QThreadPool;
 
 #ifdef WIN32
 #pragma warning( disable:4251 )
@@ -56,6 +61,8 @@ class QTX_EXPORT QtxResourceMgr
   class JsonFormat;
   class SalomexFormat;
   class Resources;
+  class Snapshot;
+  class PixmapData;
 
 public:
   class Format;
@@ -86,6 +93,12 @@ public:
   bool             isPixmapCached() const;
   void             setIsPixmapCached( const bool );
 
+  bool             isValueCached() const;
+  void             setIsValueCached( const bool );
+
+  QString          snapshotDir() const;
+  void             setSnapshotDir( const QString& );
+
   void             clear();
 
   WorkingMode      workingMode() const;
@@ -158,6 +171,7 @@ public:
   QPixmap          loadPixmap( const QString&, const QString& ) const;
   QPixmap          loadPixmap( const QString&, const QString&, const bool ) const;
   QPixmap          loadPixmap( const QString&, const QString&, const QPixmap& ) const;
+  void             preloadPixmaps( const QString& = QString() ) const;
   void             loadLanguage( const QString& = QString(), const QString& = QString() );
 
   void             raiseTranslators( const QString& );
@@ -198,6 +212,17 @@ protected:
 private:
   void             initialize( const bool = true ) const;
   QString          substMacro( const QString&, const QMap<QChar, QString>& ) const;
+  QString          snapshotFileName( const QString&, const QString& ) const;
+
+  struct CachedValue;
+  Resources*       findResources( const QString&, const QString& ) const;
+  CachedValue&     cachedValue( const QString&, const QString& ) const;
+  QVariant         typedValue( const QString&, const QString&, const int ) const;
+  void             setTypedValue( const QString&, const QString&, const QVariant& ) const;
+  void             invalidateCache( const QString& = QString() ) const;
+
+  struct PixmapEntry;
+  PixmapEntry&     pixmapEntry( const QString&, const QString& ) const;
 
 private:
   typedef QList<Resources*>        ResList;
@@ -206,6 +231,28 @@ private:
   typedef QMap<QString, QString>   OptionsMap;
   typedef QMap<QString, TransList> TransListMap;
 
+  //! Parameter looked up through all resources
+  struct CachedValue
+  {
+    CachedValue() : myRes( 0 ), myIsSubst( false ) {}
+    Resources*     myRes;      //!< resources the parameter is taken from (0 if it is not found)
+    QString        myValue;    //!< parameter value with variables substituted
+    bool           myIsSubst;  //!< \c true if myValue is already computed
+    QVariant       myTyped;    //!< last requested typed value (color, font, gradient, ...)
+  };
+  typedef QHash<QString, CachedValue>  SectionCache;
+  typedef QHash<QString, SectionCache> ValueCache;
+
+  //! Pixmap found through all resources directories
+  struct PixmapEntry
+  {
+    QString        myFile;     //!< pixmap file (empty if pixmap is not found)
+    QPixmap        myPixmap;   //!< loaded pixmap
+    QSharedPointer<PixmapData> myData; //!< image being decoded in the background
+  };
+  typedef QPair<QString, QString>         PixmapKey;   //!< resources directory parameter and file name
+  typedef QHash<PixmapKey, PixmapEntry>   PixmapIndex;
+
 private:
   QString          myAppName;                 //!< application name
   QStringList      myDirList;                 //!< list of resources directories
@@ -217,6 +264,11 @@ private:
   TransListMap     myTranslator;              //!< map of loaded translators
   QPixmap*         myDefaultPix;              //!< default icon
   bool             myIsPixmapCached;          //!< "cached pixmaps" flag
+  mutable PixmapIndex myPixmapIndex;          //!< pixmaps index: (prefix, name) -> pixmap
+  QThreadPool*     myPixmapPool;              //!< pool decoding preloaded pixmaps
+  bool             myIsValueCached;           //!< "cached values" flag
+  mutable ValueCache myCache;                 //!< values cache: section -> parameter -> value
+  QString          mySnapshotDir;             //!< directory of resources snapshots
 
   bool             myHasUserValues;           //!< \c true if user preferences has been read
   WorkingMode      myWorkingMode;             //!< working mode
@@ -243,9 +295,13 @@ protected:
   virtual bool           load( const QString&, QMap<QString, Section>& ) = 0;
   virtual bool           save( const QString&, const QMap<QString, Section>& ) = 0;
 
+  void                   addDependency( const QString& );
+  void                   addImport( const QString&, const QString&, const QString& );
+
 private:
-  QString                myFmt;    //!< format name
-  QMap<QString, QString> myOpt;    //!< options map
+  QString                myFmt;       //!< format name
+  QMap<QString, QString> myOpt;       //!< options map
+  Snapshot*              mySnapshot;  //!< snapshot being built by load(), 0 if none
 };
 
 #endif // QTXRESOURCEMGR_H
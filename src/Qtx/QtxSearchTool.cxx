@@ -29,6 +29,7 @@
 #include <QKeyEvent>
 #include <QLineEdit>
 #include <QPersistentModelIndex>
+#include <QRegExp>
 #include <QShortcut>
 #include <QTimer>
 #include <QToolButton>
@@ -191,6 +192,7 @@ const char* const close_xpm[] = {
 
 const char* highlightColor = "#FF6666";
 const int DefaultAutoHideDelay = 10000;
+const int IndexChunkSize = 2000;     // number of items indexed at once by QtxTreeViewSearcher
 
 /*!
   \brief Wrap specified widget by another dumb widget.
@@ -277,7 +279,9 @@ QtxSearchTool::QtxSearchTool( QWidget* parent, QWidget* watched, int controls, Q
   myControls( controls ),
   myActivators( None ),
   myAutoHideTimer( 0 ),
-  myAutoHideEnabled( true )
+  myAutoHideEnabled( true ),
+  mySearchTimer( 0 ),
+  mySearchDelay( 0 )
 {
   init( orientation );
 }
@@ -301,7 +305,9 @@ QtxSearchTool::QtxSearchTool( QWidget* parent, int controls, Qt::Orientation ori
   myControls( controls ),
   myActivators( None ),
   myAutoHideTimer( 0 ),
-  myAutoHideEnabled( true )
+  myAutoHideEnabled( true ),
+  mySearchTimer( 0 ),
+  mySearchDelay( 0 )
 {
   init( orientation );
 }
@@ -576,6 +582,31 @@ void QtxSearchTool::enableAutoHide( bool enable )
   }
 }
 
+/*!
+  \brief Get delay between the edition of the searched text and the search.
+  \return delay in milliseconds (0 means that the search is immediate)
+  \sa setSearchDelay()
+*/
+int QtxSearchTool::searchDelay() const
+{
+  return mySearchDelay;
+}
+
+/*!
+  \brief Set delay between the edition of the searched text and the search.
+
+  When the delay is set, the search is not performed at each key stroke:
+  it is started when the user stops typing for the given time.
+  This keeps the typing responsive when the search is long.
+
+  \param delay delay in milliseconds (0 means that the search is immediate)
+  \sa searchDelay()
+*/
+void QtxSearchTool::setSearchDelay( int delay )
+{
+  mySearchDelay = qMax( 0, delay );
+}
+
 /*!
   \brief Get 'case sensitive search' option value.
 
@@ -821,6 +852,9 @@ void QtxSearchTool::findLast()
 */
 void QtxSearchTool::find( const QString& what, int where )
 {
+  // the search is done now: the delayed one is not needed anymore
+  mySearchTimer->stop();
+
   if ( !isVisible() )
     show();
 
@@ -867,6 +901,32 @@ void QtxSearchTool::modifierSwitched()
   find( myData->text() );
 }
 
+/*!
+  \brief Called when the searched text is edited.
+
+  If the search delay is set, the search is postponed: typing
+  a new character cancels the pending search.
+  \internal
+  \param what searched text
+  \sa setSearchDelay()
+*/
+void QtxSearchTool::onTextChanged( const QString& what )
+{
+  if ( mySearchDelay > 0 && !what.isEmpty() )
+    mySearchTimer->start( mySearchDelay );
+  else
+    find( what );
+}
+
+/*!
+  \brief Called when the search delay is elapsed: start the postponed search.
+  \internal
+*/
+void QtxSearchTool::onSearchTimeout()
+{
+  find( myData->text() );
+}
+
 /*!
   \brief Initialize the search tool widget.
   \internal
@@ -894,7 +954,7 @@ void QtxSearchTool::init( Qt::Orientation orientation )
   myData = new QLineEdit( myBtnWidget );
   myData->setMinimumWidth( 50 );
   myBtnWidget_layout->addWidget( wrapWidget( myBtnWidget, myData ), 1 );
-  connect( myData, SIGNAL( textChanged( const QString& ) ), this, SLOT( find( const QString& ) ) );
+  connect( myData, SIGNAL( textChanged( const QString& ) ), this, SLOT( onTextChanged( const QString& ) ) );
   connect( myData, SIGNAL( returnPressed() ), this, SLOT( findNext() ) );
   myData->installEventFilter( this );
 
@@ -1025,6 +1085,10 @@ void QtxSearchTool::initShortcuts( const QList<QKeySequence>& accels )
   myAutoHideTimer->setSingleShot( true );
   connect( myAutoHideTimer, SIGNAL( timeout() ), this, SLOT( hide() ) );
 
+  mySearchTimer = new QTimer( this );
+  mySearchTimer->setSingleShot( true );
+  connect( mySearchTimer, SIGNAL( timeout() ), this, SLOT( onSearchTimeout() ) );
+
   updateShortcuts();
 
   hide();
@@ -1131,6 +1195,24 @@ QtxSearchTool::Searcher::~Searcher()
   \sa find(), findNext(), findPrevious(), findFirst()
 */
 
+/*!
+  \brief Indexed item of the tree view.
+  \internal
+
+  The nodes mirror the model tree, so inserted and removed rows are
+  spliced into the index without reading the other items again.
+*/
+struct QtxTreeViewSearcher::IndexNode
+{
+  IndexNode( IndexNode* parent, int row ) : myParent( parent ), myRow( row ) {}
+  ~IndexNode() { qDeleteAll( myChildren ); }
+
+  IndexNode*          myParent;   //!< parent node (0 for the root)
+  int                 myRow;      //!< row of the item in its parent
+  QString             myText;     //!< text of the item in the search column
+  QVector<IndexNode*> myChildren; //!< child nodes, in the rows order
+};
+
 /*!
   \class QtxTreeViewSearcher
   \brief A QTreeView class based searcher.
@@ -1150,7 +1232,14 @@ QtxSearchTool::Searcher::~Searcher()
   \sa setSearchColumn()
 */
 QtxTreeViewSearcher::QtxTreeViewSearcher( QTreeView* view, int col )
-  : myView( view ), myColumn( col )
+  : myView( view ), myColumn( col ),
+    myIsIndexed( false ),
+    myIndexTimer( 0 ),
+    myIndexRoot( 0 ),
+    myIndexReady( false ),
+    myIndexRevision( 0 ),
+    myLastFlags( 0 ),
+    myLastRevision( -1 )
 {
 }
 
@@ -1159,6 +1248,9 @@ QtxTreeViewSearcher::QtxTreeViewSearcher( QTreeView* view, int col )
 */
 QtxTreeViewSearcher::~QtxTreeViewSearcher()
 {
+  // the connections to the model are destroyed with the timer
+  delete myIndexTimer;
+  delete myIndexRoot;
 }
 
 /*!
@@ -1178,7 +1270,58 @@ int QtxTreeViewSearcher::searchColumn() const
 */
 void QtxTreeViewSearcher::setSearchColumn( int column )
 {
+  if ( myColumn == column )
+    return;
+
   myColumn = column;
+  if ( myIsIndexed )
+    resetIndex();
+}
+
+/*!
+  \brief Check if the searched texts are indexed.
+  \return \c true if the index is used
+  \sa setIndexed()
+*/
+bool QtxTreeViewSearcher::isIndexed() const
+{
+  return myIsIndexed;
+}
+
+/*!
+  \brief Enable or disable the index of the searched texts.
+
+  The texts of the search column are read from the model once, by portions,
+  when the application is idle; then the search does not access the model.
+  Inserted and removed rows and data changes update the index in place;
+  when the rows of the model are moved or its layout is changed, the index
+  is built again and, until it is ready, the model is searched directly.
+
+  When the searched text is typed further, the search is restricted
+  to the items matching the previous text.
+
+  \param on if \c true, the index is used
+  \sa isIndexed()
+*/
+void QtxTreeViewSearcher::setIndexed( bool on )
+{
+  if ( myIsIndexed == on )
+    return;
+
+  myIsIndexed = on;
+  if ( myIsIndexed ) {
+    myIndexTimer = new QTimer();
+    myIndexTimer->setSingleShot( true );
+    QObject::connect( myIndexTimer, &QTimer::timeout, myIndexTimer, [this]() { buildIndex(); } );
+    attachModel();
+  }
+  else {
+    delete myIndexTimer;
+    myIndexTimer = 0;
+    myIndexConnections.clear();
+    myIndexModel = 0;
+    clearIndex();
+  }
 }
 
 /*!
@@ -1406,6 +1549,13 @@ QModelIndexList QtxTreeViewSearcher::findItems( const QString& text, QtxSearchTo
       s.append( ".*" );
   }
 
+  if ( myIsIndexed ) {
+    if ( myIndexModel != myView->model() )
+      attachModel();
+    if ( myIndexReady )
+      return findIndexed( s, fl );
+  }
+
   if ( myView->model() )
     return myView->model()->match( myView->model()->index( 0, myColumn ),
                                    Qt::DisplayRole,
@@ -1413,6 +1563,318 @@ QModelIndexList QtxTreeViewSearcher::findItems( const QString& text, QtxSearchTo
   return QModelIndexList();
 }
 
+/*!
+  \brief Find all appropriate items in the index.
+  \internal
+  \param text text to be found (regular expression is already completed)
+  \param fl match flags
+*/
+QModelIndexList QtxTreeViewSearcher::findIndexed( const QString& text, Qt::MatchFlags fl )
+{
+  Qt::CaseSensitivity cs = fl & Qt::MatchCaseSensitive ? Qt::CaseSensitive : Qt::CaseInsensitive;
+  bool isRegExp = fl & Qt::MatchRegExp;
+
+  // a longer text can only match the items matching the previous one
+  bool narrow = !isRegExp && myLastRevision == myIndexRevision && myLastFlags == (int)fl &&
+    !myLastText.isEmpty() && text.contains( myLastText, cs );
+
+  QVector<IndexNode*> matches;
+  if ( narrow ) {
+    foreach ( IndexNode* node, myLastMatches ) {
+      if ( node->myText.contains( text, cs ) )
+        matches.append( node );
+    }
+  }
+  else {
+    QRegExp rx( text, cs );
+    // walk the index in the tree order, as QAbstractItemModel::match() does
+    QVector<IndexNode*> stack;
+    for ( int i = myIndexRoot->myChildren.count() - 1; i >= 0; i-- )
+      stack.append( myIndexRoot->myChildren[i] );
+    while ( !stack.isEmpty() ) {
+      IndexNode* node = stack.takeLast();
+      if ( isRegExp ? rx.exactMatch( node->myText ) : node->myText.contains( text, cs ) )
+        matches.append( node );
+      for ( int i = node->myChildren.count() - 1; i >= 0; i-- )
+        stack.append( node->myChildren[i] );
+    }
+  }
+
+  myLastText = text;
+  myLastFlags = (int)fl;
+  myLastRevision = myIndexRevision;
+  myLastMatches = matches;
+
+  QModelIndexList found;
+  foreach ( IndexNode* node, matches )
+    found.append( modelIndex( node, myColumn ) );
+  return found;
+}
+
+/*!
+  \brief Follow the model of the tree view: connect to its signals and start indexing.
+  \internal
+*/
+void QtxTreeViewSearcher::attachModel()
+{
+  foreach ( QMetaObject::Connection c, myIndexConnections )
+    QObject::disconnect( c );
+  myIndexConnections.clear();
+
+  myIndexModel = myView ? myView->model() : 0;
+  if ( myIndexModel ) {
+    QAbstractItemModel* m = myIndexModel;
+    myIndexConnections << QObject::connect( m, &QAbstractItemModel::rowsInserted, myIndexTimer,
+                                            [this]( const QModelIndex& p, int first, int last ) { insertIndex( p, first, last ); } );
+    myIndexConnections << QObject::connect( m, &QAbstractItemModel::rowsRemoved, myIndexTimer,
+                                            [this]( const QModelIndex& p, int first, int last ) { removeIndex( p, first, last ); } );
+    myIndexConnections << QObject::connect( m, &QAbstractItemModel::dataChanged, myIndexTimer,
+                                            [this]( const QModelIndex& tl, const QModelIndex& br ) { updateIndex( tl, br ); } );
+    // the other structural changes make the index outdated as a whole
+    myIndexConnections << QObject::connect( m, &QAbstractItemModel::rowsMoved, myIndexTimer, [this]() { resetIndex(); } );
+    myIndexConnections << QObject::connect( m, &QAbstractItemModel::columnsInserted, myIndexTimer, [this]() { resetIndex(); } );
+    myIndexConnections << QObject::connect( m, &QAbstractItemModel::columnsRemoved, myIndexTimer, [this]() { resetIndex(); } );
+    myIndexConnections << QObject::connect( m, &QAbstractItemModel::layoutChanged, myIndexTimer, [this]() { resetIndex(); } );
+    myIndexConnections << QObject::connect( m, &QAbstractItemModel::modelReset, myIndexTimer, [this]() { resetIndex(); } );
+  }
+  resetIndex();
+}
+
+/*!
+  \brief Drop the index.
+  \internal
+*/
+void QtxTreeViewSearcher::clearIndex()
+{
+  delete myIndexRoot;
+  myIndexRoot = 0;
+  myIndexStack.clear();
+  myIndexReady = false;
+  myIndexRevision++;
+  myLastMatches.clear();
+}
+
+/*!
+  \brief Drop the index and schedule its building.
+  \internal
+*/
+void QtxTreeViewSearcher::resetIndex()
+{
+  clearIndex();
+
+  if ( myIndexModel ) {
+    myIndexRoot = new IndexNode( 0, -1 );
+    myIndexStack.append( IndexStep( myIndexRoot, 0 ) );
+    myIndexTimer->start( 0 );
+  }
+}
+
+/*!
+  \brief Index the next portion of the model items.
+
+  The model is walked in the same order as by QAbstractItemModel::match().
+  \internal
+*/
+void QtxTreeViewSearcher::buildIndex()
+{
+  QAbstractItemModel* m = myIndexModel;
+  if ( !m || myIndexModel != myView->model() ) {
+    attachModel();
+    return;
+  }
+
+  // the model indices of the nodes being indexed (rows may have been shifted since the last portion)
+  QList<QModelIndex> parents;
+  foreach ( IndexStep step, myIndexStack )
+    parents.append( modelIndex( step.first, 0 ) );
+
+  for ( int n = 0; n < IndexChunkSize && !myIndexStack.isEmpty(); n++ ) {
+    IndexNode* node = myIndexStack.last().first;
+    QModelIndex parent = parents.last();
+    int row = myIndexStack.last().second++;
+    if ( row >= m->rowCount( parent ) ) {
+      myIndexStack.removeLast();
+      parents.removeLast();
+      continue;
+    }
+
+    IndexNode* item = new IndexNode( node, row );
+    item->myText = m->data( m->index( row, myColumn, parent ), Qt::DisplayRole ).toString();
+    node->myChildren.append( item );
+
+    QModelIndex child = m->index( row, 0, parent );
+    if ( m->hasChildren( child ) ) {
+      myIndexStack.append( IndexStep( item, 0 ) );
+      parents.append( child );
+    }
+  }
+
+  if ( myIndexStack.isEmpty() )
+    myIndexReady = true;
+  else
+    myIndexTimer->start( 0 );
+}
+
+/*!
+  \brief Update the texts of the changed items.
+  \internal
+  \param topLeft top left changed index
+  \param bottomRight bottom right changed index
+*/
+void QtxTreeViewSearcher::updateIndex( const QModelIndex& topLeft, const QModelIndex& bottomRight )
+{
+  if ( !myIndexModel || !topLeft.isValid() ||
+       topLeft.column() > myColumn || bottomRight.column() < myColumn )
+    return;
+
+  // the rows which are not indexed yet will be read by buildIndex()
+  IndexNode* node = indexNode( topLeft.parent() );
+  if ( !node )
+    return;
+
+  for ( int row = topLeft.row(); row <= bottomRight.row() && row < node->myChildren.count(); row++ ) {
+    QModelIndex idx = myIndexModel->index( row, myColumn, topLeft.parent() );
+    node->myChildren[row]->myText = myIndexModel->data( idx, Qt::DisplayRole ).toString();
+    myIndexRevision++;
+  }
+}
+
+/*!
+  \brief Index the inserted rows with all their children.
+  \internal
+  \param parent parent model index
+  \param first first inserted row
+  \param last last inserted row
+*/
+void QtxTreeViewSearcher::insertIndex( const QModelIndex& parent, int first, int last )
+{
+  QAbstractItemModel* m = myIndexModel;
+  IndexNode* node = indexNode( parent );
+  if ( !m || !node )
+    return;
+
+  // rows after the indexed ones will be read by buildIndex()
+  int step = indexStep( node );
+  if ( first > node->myChildren.count() )
+    return;
+
+  int count = last - first + 1;
+  QVector<IndexNode*> items;
+  for ( int row = first; row <= last; row++ ) {
+    IndexNode* item = new IndexNode( node, row );
+    items.append( item );
+
+    // the inserted subtree is indexed at once
+    QList< QPair<IndexNode*, QModelIndex> > stack;
+    stack.append( qMakePair( item, m->index( row, 0, parent ) ) );
+    while ( !stack.isEmpty() ) {
+      QPair<IndexNode*, QModelIndex> cur = stack.takeLast();
+      cur.first->myText = m->data( cur.second.sibling( cur.second.row(), myColumn ), Qt::DisplayRole ).toString();
+      int nbRows = m->rowCount( cur.second );
+      for ( int i = 0; i < nbRows; i++ ) {
+        IndexNode* child = new IndexNode( cur.first, i );
+        cur.first->myChildren.append( child );
+        stack.append( qMakePair( child, m->index( i, 0, cur.second ) ) );
+      }
+    }
+  }
+
+  node->myChildren.insert( first, count, 0 );
+  for ( int i = 0; i < count; i++ )
+    node->myChildren[first + i] = items[i];
+  for ( int row = first + count; row < node->myChildren.count(); row++ )
+    node->myChildren[row]->myRow = row;
+
+  if ( step >= 0 )
+    myIndexStack[step].second += count;
+  myIndexRevision++;
+}
+
+/*!
+  \brief Remove the removed rows from the index.
+  \internal
+  \param parent parent model index
+  \param first first removed row
+  \param last last removed row
+*/
+void QtxTreeViewSearcher::removeIndex( const QModelIndex& parent, int first, int last )
+{
+  IndexNode* node = indexNode( parent );
+  if ( !myIndexModel || !node || first >= node->myChildren.count() )
+    return;
+
+  int step = indexStep( node );
+  if ( step >= 0 ) {
+    // the traversal can not continue inside the removed rows
+    int next = myIndexStack[step].second;
+    if ( next > first && step + 1 < myIndexStack.count() )
+      myIndexStack.erase( myIndexStack.begin() + step + 1, myIndexStack.end() );
+    myIndexStack[step].second = next > last ? next - ( last - first + 1 ) : qMin( next, first );
+  }
+
+  int count = qMin( last, node->myChildren.count() - 1 ) - first + 1;
+  for ( int i = 0; i < count; i++ )
+    delete node->myChildren[first + i];
+  node->myChildren.remove( first, count );
+  for ( int row = first; row < node->myChildren.count(); row++ )
+    node->myChildren[row]->myRow = row;
+
+  myIndexRevision++;
+}
+
+/*!
+  \brief Get the index node of the model item.
+  \internal
+  \param index model index (invalid index for the root)
+  \return index node or 0 if the item is not indexed yet
+*/
+QtxTreeViewSearcher::IndexNode* QtxTreeViewSearcher::indexNode( const QModelIndex& index ) const
+{
+  if ( !myIndexRoot )
+    return 0;
+
+  QList<int> rows;
+  for ( QModelIndex p = index; p.isValid(); p = p.parent() )
+    rows.prepend( p.row() );
+
+  IndexNode* node = myIndexRoot;
+  foreach ( int row, rows ) {
+    if ( row < 0 || row >= node->myChildren.count() )
+      return 0;
+    node = node->myChildren[row];
+  }
+  return node;
+}
+
+/*!
+  \brief Get the model index of the indexed item.
+  \internal
+  \param node index node
+  \param column model column
+  \return model index
+*/
+QModelIndex QtxTreeViewSearcher::modelIndex( IndexNode* node, int column ) const
+{
+  if ( !node || !node->myParent || !myIndexModel )
+    return QModelIndex();
+  return myIndexModel->index( node->myRow, column, modelIndex( node->myParent, 0 ) );
+}
+
+/*!
+  \brief Get the traversal step in which the children of the node are being indexed.
+  \internal
+  \param node index node
+  \return position of the step in the traversal or -1 if the node is not being indexed
+*/
+int QtxTreeViewSearcher::indexStep( IndexNode* node ) const
+{
+  for ( int i = 0; i < myIndexStack.count(); i++ ) {
+    if ( myIndexStack[i].first == node )
+      return i;
+  }
+  return -1;
+}
+
 /*!
   \brief Find model index from the list nearest to the specified index.
   \internal
@@ -27,9 +27,12 @@
 #include <QFrame>
 #include <QList>
 #include <QMap>
+#include <QHash>
 #include <QPersistentModelIndex>
 #include <QPointer>
+#include <QVector>
 
+class QAbstractItemModel;
 class QCheckBox;
 class QLineEdit;
 class QShortcut;
@@ -106,6 +109,9 @@ public:
   bool                isAutoHideEnabled() const;
   void                enableAutoHide( bool );
 
+  int                 searchDelay() const;
+  void                setSearchDelay( int );
+
   bool                isCaseSensitive() const;
   bool                isRegExpSearch() const;
   bool                isSearchWrapped() const;
@@ -127,6 +133,8 @@ public slots:
 private slots:
   void                find( const QString&, int = fAny );
   void                modifierSwitched();
+  void                onTextChanged( const QString& );
+  void                onSearchTimeout();
 
 private:
   void                init( Qt::Orientation );
@@ -159,6 +167,8 @@ private:
   ShortcutList        myShortcuts;
   QTimer*             myAutoHideTimer;
   bool                myAutoHideEnabled;
+  QTimer*             mySearchTimer;
+  int                 mySearchDelay;
   QMap<int, QWidget*> myWidgets;
 };
 
@@ -183,6 +193,9 @@ public:
 
   int                    searchColumn() const;
   void                   setSearchColumn( int );
+
+  bool                   isIndexed() const;
+  void                   setIndexed( bool );
   
   virtual bool           find( const QString&, QtxSearchTool* );
   virtual bool           findNext( const QString&, QtxSearchTool* );
@@ -200,10 +213,39 @@ private:
   QString                getId( const QModelIndex& );
   int                    compareIndices( const QModelIndex&, const QModelIndex& );
 
+  struct IndexNode;
+
+  void                   attachModel();
+  void                   resetIndex();
+  void                   clearIndex();
+  void                   buildIndex();
+  void                   updateIndex( const QModelIndex&, const QModelIndex& );
+  void                   insertIndex( const QModelIndex&, int, int );
+  void                   removeIndex( const QModelIndex&, int, int );
+  IndexNode*             indexNode( const QModelIndex& ) const;
+  QModelIndex            modelIndex( IndexNode*, int ) const;
+  int                    indexStep( IndexNode* ) const;
+  QModelIndexList        findIndexed( const QString&, Qt::MatchFlags );
+
 private:
+  typedef QPair<IndexNode*, int> IndexStep; //!< node being indexed and its next row to be indexed
+
   QTreeView*             myView;
   int                    myColumn;
   QPersistentModelIndex  myIndex;
+
+  bool                             myIsIndexed;
+  QTimer*                          myIndexTimer;     //!< builds the index when the application is idle
+  QPointer<QAbstractItemModel>     myIndexModel;
+  QList<QMetaObject::Connection>   myIndexConnections;
+  IndexNode*                       myIndexRoot;      //!< indexed items, as a tree mirroring the model
+  QList<IndexStep>                 myIndexStack;     //!< traversal of the model in progress
+  bool                             myIndexReady;
+  int                              myIndexRevision;  //!< changed each time the index is changed
+  QString                          myLastText;       //!< last searched text (for the narrowing)
+  int                              myLastFlags;
+  int                              myLastRevision;
+  QVector<IndexNode*>              myLastMatches;
 };
 
 #endif // QTXSEARCHTOOL_H
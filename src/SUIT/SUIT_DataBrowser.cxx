@@ -137,6 +137,32 @@ void SUIT_DataBrowser::setUpdateModified( const bool on )
     m->setUpdateModified( on );
 }
 
+/*!
+  \brief Get 'lazy loading' flag value.
+  \return 'lazy loading' flag value
+  \sa setLazyLoading()
+*/
+bool SUIT_DataBrowser::lazyLoading() const
+{
+  SUIT_ProxyModel* m = qobject_cast<SUIT_ProxyModel*>( model() );
+  return m ? m->lazyLoading() : false;
+}
+
+/*!
+  \brief Set 'lazy loading' flag value.
+
+  If this flag is set to \c true, the children of a data object are shown
+  in the object browser only when its branch is expanded.
+
+  \param on 'lazy loading' flag value
+*/
+void SUIT_DataBrowser::setLazyLoading( const bool on )
+{
+  SUIT_ProxyModel* m = qobject_cast<SUIT_ProxyModel*>( model() );
+  if ( m ) 
+    m->setLazyLoading( on );
+}
+
 /*!
   \brief Update object browser starting from the object \obj;
   open all branches automatically if \a autoOpen is \c true.
@@ -227,6 +253,8 @@ void SUIT_DataBrowser::setSelected( const SUIT_DataObject* obj, const bool appen
   SUIT_ProxyModel* m = qobject_cast<SUIT_ProxyModel*>( model() );
 
   if ( m ) {
+    // in the lazy mode, the object may be not shown yet
+    m->fetchObject( obj );
     QModelIndex index = m->index( obj );
     if ( index.isValid() )
       select( index, true, append );
@@ -260,6 +288,7 @@ void SUIT_DataBrowser::setSelected( const DataObjectList& lst, const bool append
     SUIT_DataObject* obj;
 
     foreach( obj, lst ) {
+      m->fetchObject( obj );
       QModelIndex index = m->index( obj );
       if ( index.isValid() )
         indexes.append( index );
@@ -297,6 +326,7 @@ void SUIT_DataBrowser::ensureVisible( const DataObjectList& lst )
 
   for ( DataObjectList::const_iterator it = lst.begin(); it != lst.end(); ++it )
   {
+    treeModel->fetchObject( *it );
     QModelIndex idx = treeModel->index( *it );
     if ( idx.isValid() )
       tv->scrollTo( idx );
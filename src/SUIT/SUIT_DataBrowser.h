@@ -52,6 +52,9 @@ public:
   bool             updateModified() const;
   void             setUpdateModified( const bool );
 
+  bool             lazyLoading() const;
+  void             setLazyLoading( const bool );
+
   void             updateTree( SUIT_DataObject* = 0, const bool = true );
 
   int              shortcutKey(const int) const;
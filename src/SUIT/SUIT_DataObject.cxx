@@ -30,6 +30,7 @@
 #include <cstdio>
 
 SUIT_DataObject::Signal* SUIT_DataObject::mySignal = 0;
+unsigned long SUIT_DataObject::ourStamp = 0;
 
 /*!
   \class SUIT_DataObject
@@ -52,7 +53,11 @@ SUIT_DataObject::SUIT_DataObject( SUIT_DataObject* p )
   myOpen( false ),
   myCheck( false ),
   myAutoDel( true ),
-  _modified( false )
+  _modified( false ),
+  myLevel( 0 ),
+  myPos( -1 ),
+  myValidPos( 0 ),
+  myStamp( ++ourStamp )
 {
   setParent( p );
   signal()->emitCreated( this );
@@ -82,6 +87,12 @@ SUIT_DataObject::~SUIT_DataObject()
     for ( DataObjectList::iterator itr = myChildren.begin(); itr != myChildren.end(); ++itr )
       delete *itr;
   }
+  else
+  {
+    // orphaned children become top-level objects
+    for ( DataObjectList::iterator itr = myChildren.begin(); itr != myChildren.end(); ++itr )
+      (*itr)->updateLevel();
+  }
 }
 
 /*!
@@ -130,12 +141,27 @@ int SUIT_DataObject::childCount() const
 
 /*!
   \brief Get the index of the specified object in the child list.
+
+  Each child stores its own position; the positions of the children
+  which follow an insertion or a removal are renumbered on the next
+  request only, so that the lookup is constant in amortized time.
+
   \param obj child object
   \return subobject position or -1 if it does not belong to this object
 */
 int SUIT_DataObject::childPos( const SUIT_DataObject* obj ) const
 {
-  return myChildren.indexOf( (SUIT_DataObject*)obj );
+  if ( !obj )
+    return -1;
+
+  if ( obj->myPos >= myValidPos || myChildren.value( obj->myPos ) != obj )
+  {
+    for ( int i = myValidPos; i < (int)myChildren.count(); i++ )
+      myChildren.at( i )->myPos = i;
+    myValidPos = myChildren.count();
+  }
+
+  return myChildren.value( obj->myPos ) == obj ? obj->myPos : -1;
 }
 
 /*!
@@ -152,8 +178,12 @@ void SUIT_DataObject::moveChildPos( SUIT_DataObject* theObj, int theNewPos)
   if (aNewPos < 0) aNewPos = 0;
   if (aNewPos > (myChildren.size() - 1)) aNewPos = myChildren.size() - 1;
 
-  if (myChildren.removeOne(theObj))
-    myChildren.insert(aNewPos, theObj);
+  int aPos = childPos(theObj);
+  if (aPos < 0) return;
+
+  myChildren.removeAt(aPos);
+  invalidatePositions(aPos);
+  placeChild(theObj, aNewPos);
 }
 
 
@@ -181,13 +211,7 @@ SUIT_DataObject* SUIT_DataObject::childObject( const int idx ) const
 */
 int SUIT_DataObject::level() const
 {
-  int lev = 0;
-  SUIT_DataObject* p = parent();
-  while ( p ) {
-    p = p->parent();
-    lev++;
-  }
-  return lev;
+  return myLevel;
 }
 
 /*!
@@ -216,7 +240,7 @@ void SUIT_DataObject::setPosition(int theNewPos)
 */
 SUIT_DataObject* SUIT_DataObject::nextBrother() const
 {
-  return myParent ? myParent->childObject( myParent->childPos( this ) + 1 ) : 0;
+  return myParent ? myParent->childObject( position() + 1 ) : 0;
 }
 
 /*!
@@ -226,7 +250,7 @@ SUIT_DataObject* SUIT_DataObject::nextBrother() const
 */
 SUIT_DataObject* SUIT_DataObject::prevBrother() const
 {
-  return myParent ? myParent->childObject( myParent->childPos( this ) - 1 ) : 0;
+  return myParent ? myParent->childObject( position() - 1 ) : 0;
 }
 
 /*!
@@ -305,11 +329,14 @@ void SUIT_DataObject::appendChild( SUIT_DataObject* obj )
 */
 void SUIT_DataObject::insertChild( SUIT_DataObject* obj, int position )
 {
-  if ( !obj || myChildren.contains( obj ) )
+  if ( !obj || childPos( obj ) >= 0 )
     return;
 
-  int pos = position < 0 ? myChildren.count() : position;
-  myChildren.insert( qMin( pos, (int)myChildren.count() ), obj );
+  // detach the object first, so that it is never referenced by two parents
+  if ( obj->parent() && obj->parent() != this )
+    obj->parent()->removeChild( obj );
+
+  placeChild( obj, position < 0 ? myChildren.count() : position );
   obj->setParent( this );
   signal()->emitInserted( obj, this );
 }
@@ -322,8 +349,7 @@ void SUIT_DataObject::insertChild( SUIT_DataObject* obj, int position )
 void SUIT_DataObject::insertChildAtPos( SUIT_DataObject* obj, int position )
 {
   if ( !obj )return;
-  int pos = position < 0 ? myChildren.count() : position;
-  myChildren.insert( qMin( pos, (int)myChildren.count() ), obj );
+  placeChild( obj, position < 0 ? myChildren.count() : position );
   obj->assignParent( this );
 }
 
@@ -337,7 +363,11 @@ void SUIT_DataObject::removeChild( SUIT_DataObject* obj, const bool del )
   if ( !obj )
     return;
 
-  if ( myChildren.removeAll( obj ) ) {
+  int pos = childPos( obj );
+  if ( pos >= 0 ) {
+    myChildren.removeAt( pos );
+    invalidatePositions( pos );
+    touch();
     signal()->emitRemoved( obj, this );
     obj->setParent( 0 );
 
@@ -415,14 +445,67 @@ void SUIT_DataObject::setParent( SUIT_DataObject* p )
     parent()->removeChild( this );
 
   myParent = p;
+  updateLevel();
 
   if ( parent() )
     parent()->appendChild( this );
 }
 
+/*!
+  \brief Change the parent object without updating the children lists.
+  \param p new parent object
+*/
 void SUIT_DataObject::assignParent( SUIT_DataObject* p )
 {
   myParent = p;
+  updateLevel();
+}
+
+/*!
+  \brief Insert the child object into the children list and keep positions valid.
+  \internal
+  \param obj child object
+  \param pos position (clamped to the children list size)
+*/
+void SUIT_DataObject::placeChild( SUIT_DataObject* obj, const int pos )
+{
+  int idx = qMin( pos, (int)myChildren.count() );
+  myChildren.insert( idx, obj );
+  touch();
+
+  if ( idx == myValidPos && idx == myChildren.count() - 1 )
+  {
+    // appending does not shift anything
+    obj->myPos = idx;
+    myValidPos++;
+  }
+  else
+    invalidatePositions( idx );
+}
+
+/*!
+  \brief Mark positions of the children starting from \a pos as outdated.
+  \internal
+  \param pos first changed position
+*/
+void SUIT_DataObject::invalidatePositions( const int pos ) const
+{
+  myValidPos = qMin( myValidPos, pos );
+}
+
+/*!
+  \brief Recompute the level of the object and of its children after reparenting.
+  \internal
+*/
+void SUIT_DataObject::updateLevel()
+{
+  int lev = myParent ? myParent->myLevel + 1 : 0;
+  if ( lev == myLevel )
+    return;
+
+  myLevel = lev;
+  for ( DataObjectList::iterator it = myChildren.begin(); it != myChildren.end(); ++it )
+    (*it)->updateLevel();
 }
 
 /*!
@@ -439,8 +522,36 @@ void SUIT_DataObject::setModified(bool modified)
     return;
 
   _modified = modified;
-  if ( _modified )
+  if ( _modified ) {
+    touch();
     signal()->emitModified( this );
+  }
+}
+
+/*!
+  \brief Get modification stamp of the subtree.
+
+  The stamp changes each time the object is modified (see setModified()) or
+  its children list is changed, and each time it happens to one of its
+  children, recursively. It allows to skip the unchanged subtrees when
+  the data tree is compared to another tree.
+
+  \return modification stamp
+*/
+unsigned long SUIT_DataObject::stamp() const
+{
+  return myStamp;
+}
+
+/*!
+  \brief Give a new modification stamp to the object and to its ancestors.
+  \internal
+*/
+void SUIT_DataObject::touch()
+{
+  unsigned long aStamp = ++ourStamp;
+  for ( SUIT_DataObject* o = this; o; o = o->myParent )
+    o->myStamp = aStamp;
 }
 
 /*!
@@ -846,6 +957,42 @@ bool SUIT_DataObject::disconnect( const char* sig, QObject* reciever, const char
   return signal()->disconnect( signal(), sig, reciever, slot );
 }
 
+/*!
+  \brief Start a transaction on the data objects tree.
+
+  Until the matching endTransaction(), the inserted() and removed() signals
+  are not emitted: the objects whose children are changed are recorded
+  instead. When the outermost transaction ends, the childrenChanged() signal
+  is emitted once for each top-most changed object, so that a whole
+  data tree can be built without a signal per object.
+  Transactions can be nested.
+
+  \sa endTransaction(), SUIT_DataObject::Transaction
+*/
+void SUIT_DataObject::beginTransaction()
+{
+  signal()->beginTransaction();
+}
+
+/*!
+  \brief Finish a transaction on the data objects tree.
+  \sa beginTransaction()
+*/
+void SUIT_DataObject::endTransaction()
+{
+  signal()->endTransaction();
+}
+
+/*!
+  \brief Check if a transaction on the data objects tree is in progress.
+  \return \c true if the structural signals are postponed
+  \sa beginTransaction()
+*/
+bool SUIT_DataObject::isTransaction()
+{
+  return signal()->myTransLevel > 0;
+}
+
 /*!
   \brief Schedule this object for the late deleting.
 
@@ -905,7 +1052,8 @@ void SUIT_DataObject::dump( const int indent ) const
   \brief Constructor.
 */
 SUIT_DataObject::Signal::Signal()
-: QObject()
+: QObject(),
+  myTransLevel( 0 )
 {
 }
 
@@ -949,6 +1097,7 @@ void SUIT_DataObject::Signal::emitDestroyed( SUIT_DataObject* object )
     else
       // object is being destroyed directly or via deleteLater()
       emit destroyed( object );
+    myTransParents.remove( object );
   }
 }
 
@@ -959,7 +1108,10 @@ void SUIT_DataObject::Signal::emitDestroyed( SUIT_DataObject* object )
 */
 void SUIT_DataObject::Signal::emitInserted( SUIT_DataObject* object, SUIT_DataObject* parent )
 {
-  emit( inserted( object, parent ) );
+  if ( myTransLevel > 0 )
+    myTransParents.insert( parent );
+  else
+    emit( inserted( object, parent ) );
 }
 
 /*!
@@ -969,7 +1121,10 @@ void SUIT_DataObject::Signal::emitInserted( SUIT_DataObject* object, SUIT_DataOb
 */
 void SUIT_DataObject::Signal::emitRemoved( SUIT_DataObject* object, SUIT_DataObject* parent )
 {
-  emit( removed( object, parent ) );
+  if ( myTransLevel > 0 )
+    myTransParents.insert( parent );
+  else
+    emit( removed( object, parent ) );
 }
 
 /*!
@@ -993,6 +1148,71 @@ void SUIT_DataObject::Signal::deleteLater( SUIT_DataObject* object )
   }
 }
 
+/*!
+  \brief Start a transaction: structural signals are postponed.
+*/
+void SUIT_DataObject::Signal::beginTransaction()
+{
+  myTransLevel++;
+}
+
+/*!
+  \brief Finish a transaction.
+
+  When the outermost transaction is finished, childrenChanged() is emitted
+  for the changed objects which have no changed ancestor.
+*/
+void SUIT_DataObject::Signal::endTransaction()
+{
+  if ( myTransLevel == 0 || --myTransLevel > 0 )
+    return;
+
+  QSet<SUIT_DataObject*> parents;
+  parents.swap( myTransParents );
+
+  DataObjectList topParents;
+  foreach ( SUIT_DataObject* parent, parents ) {
+    bool isTop = true;
+    for ( SUIT_DataObject* o = parent ? parent->parent() : 0; o && isTop; o = o->parent() )
+      isTop = !parents.contains( o );
+    if ( parent && isTop )
+      topParents.append( parent );
+  }
+
+  foreach ( SUIT_DataObject* parent, topParents )
+    emit( childrenChanged( parent ) );
+}
+
+/*!
+  \class SUIT_DataObject::Transaction
+  \brief Scoped transaction on the data objects tree.
+
+  Starts a transaction in the constructor and finishes it in the destructor:
+  \code
+  {
+    SUIT_DataObject::Transaction aTransaction;
+    // build the data tree: no inserted()/removed() signals
+  } // childrenChanged() is emitted here
+  \endcode
+  \sa SUIT_DataObject::beginTransaction()
+*/
+
+/*!
+  \brief Constructor. Starts the transaction.
+*/
+SUIT_DataObject::Transaction::Transaction()
+{
+  SUIT_DataObject::beginTransaction();
+}
+
+/*!
+  \brief Destructor. Finishes the transaction.
+*/
+SUIT_DataObject::Transaction::~Transaction()
+{
+  SUIT_DataObject::endTransaction();
+}
+
 /*!
   \brief Updates necessary internal fields of data object
 */
@@ -1000,6 +1220,33 @@ void SUIT_DataObject::update()
 {
 }
 
+/*!
+  \brief Check if the object has children which are not created yet.
+
+  This method can be re-implemented in the subclasses which create their
+  children on demand, for example when the object is expanded in the
+  lazy mode of the tree model. Default implementation returns \c false.
+
+  \return \c true if fetchChildren() can create some children
+  \sa fetchChildren()
+*/
+bool SUIT_DataObject::canFetchChildren() const
+{
+  return false;
+}
+
+/*!
+  \brief Create the children which are not created yet.
+
+  This method can be re-implemented in the subclasses.
+  Default implementation does nothing.
+
+  \sa canFetchChildren()
+*/
+void SUIT_DataObject::fetchChildren()
+{
+}
+
 /*!
   \brief return unique group identificator
 
@@ -1045,3 +1292,11 @@ QVariant SUIT_DataObject::customData(Qtx::CustomDataType /*type*/) {
   \param object data object being removed
   \param parent parent data object
 */
+
+/*!
+  \fn void SUIT_DataObject::Signal::childrenChanged( SUIT_DataObject* object );
+  \brief Emitted at the end of a transaction, instead of the inserted() and
+  removed() signals, for each top-most object whose children were changed.
+  \param object data object whose subtree was changed
+  \sa SUIT_DataObject::beginTransaction()
+*/
@@ -32,6 +32,7 @@
 
 #include <QList>
 #include <QObject>
+#include <QSet>
 #include <QString>
 #include <QPixmap>
 #include <QFont>
@@ -49,6 +50,7 @@ class SUIT_EXPORT SUIT_DataObject
 {
 public:
   class Signal;
+  class Transaction;
 
   //! Color role
   typedef enum {
@@ -103,6 +105,7 @@ public:
   virtual void                assignParent( SUIT_DataObject* );
   void                        insertChildAtPos( SUIT_DataObject* obj, int position );
   bool                        modified(){return _modified;};
+  unsigned long               stamp() const;
   virtual void                setModified(bool modified);
 
   virtual QString             name() const;
@@ -133,6 +136,8 @@ public:
   virtual void                setOpen( const bool );
 
   virtual void                update();
+  virtual bool                canFetchChildren() const;
+  virtual void                fetchChildren();
   virtual bool                customSorting( const int = NameId ) const;
   virtual bool                compare( const QVariant&, const QVariant&, const int = NameId ) const;
 
@@ -144,10 +149,20 @@ public:
   static bool                 connect( const char*, QObject*, const char* );
   static bool                 disconnect( const char*, QObject*, const char* );
 
+  static void                 beginTransaction();
+  static void                 endTransaction();
+  static bool                 isTransaction();
+
   void                        deleteLater();
 
   void                        dump( const int indent = 2 ) const; // dump to cout
 
+private:
+  void                        placeChild( SUIT_DataObject*, const int );
+  void                        invalidatePositions( const int ) const;
+  void                        updateLevel();
+  void                        touch();
+
 private:
   SUIT_DataObject*            myParent;
   bool                        myOpen;
@@ -155,8 +170,13 @@ private:
   bool                        myAutoDel;
   DataObjectList              myChildren;
   bool                        _modified;
+  int                         myLevel;        // depth in the tree, kept up to date by setParent()
+  int                         myPos;          // index in the parent's children list
+  mutable int                 myValidPos;     // number of leading children with valid myPos
+  unsigned long               myStamp;        // last modification of the subtree
 
   static Signal*              mySignal;
+  static unsigned long        ourStamp;       // last given modification stamp
 
   friend class SUIT_DataObject::Signal;
   friend class SUIT_DataObjectIterator;
@@ -179,17 +199,34 @@ private:
 
   void deleteLater( SUIT_DataObject* );
 
+  void beginTransaction();
+  void endTransaction();
+
 signals:
   void created( SUIT_DataObject* );
   void destroyed( SUIT_DataObject* );
   void inserted( SUIT_DataObject*, SUIT_DataObject* );
   void removed( SUIT_DataObject*, SUIT_DataObject* );
   void modified( SUIT_DataObject* );
+  void childrenChanged( SUIT_DataObject* );
 
   friend class SUIT_DataObject;
 
 private:
   DataObjectList myDelLaterObjects;
+  int                    myTransLevel;   // depth of nested transactions
+  QSet<SUIT_DataObject*> myTransParents; // objects whose children were changed by the transaction
+};
+
+class SUIT_EXPORT SUIT_DataObject::Transaction
+{
+public:
+  Transaction();
+  ~Transaction();
+
+private:
+  Transaction( const Transaction& );
+  Transaction& operator=( const Transaction& );
 };
 
 #ifdef WIN32
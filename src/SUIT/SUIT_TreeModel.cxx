@@ -29,6 +29,9 @@
 #include <QApplication>
 #include <QHash>
 #include <QMimeData>
+#include <QSet>
+
+#include <climits>
 
 SUIT_AbstractModel::SUIT_AbstractModel() : mySearcher( 0 )
 {
@@ -77,18 +80,29 @@ public:
   SUIT_DataObject*      dataObject() const;
   TreeItem*             parent() const;
   int                   position() const;
-  void                  setPosition(int position) {_position=position;};
+  int                   level() const;
   int                   childCount() const;
   TreeItem*             child( const int i );
   QList<TreeItem*>      children() const;
   TreeItem*             nextSibling() const;
   TreeItem*             prevSibling() const;
+  int                   fetchLimit() const;
+  void                  setFetchLimit( const int );
+  unsigned long         stamp() const;
+  void                  setStamp( const unsigned long );
   
+private:
+  int                   childPos( const TreeItem* ) const;
+
 private:
   TreeItem*             myParent;
   QList<TreeItem*>      myChildren;
   SUIT_DataObject*      myObj;
-  int _position;
+  int                   myPos;      // index in the parent's children list
+  int                   myLevel;    // depth in the tree, items are never reparented
+  mutable int           myValidPos; // number of leading children with valid myPos
+  int                   myFetchLimit; // lazy mode: number of data object children to be mirrored
+  unsigned long         myStamp;      // stamp of the data object at the last update (0 if never updated)
 };
 
 /*!
@@ -103,7 +117,11 @@ SUIT_TreeModel::TreeItem::TreeItem( SUIT_DataObject*          obj,
                                     SUIT_TreeModel::TreeItem* after )
 : myParent( parent ),
   myObj( obj ),
-  _position(-1)
+  myPos( -1 ),
+  myLevel( parent ? parent->level() + 1 : 0 ),
+  myValidPos( 0 ),
+  myFetchLimit( 0 ),
+  myStamp( 0 )
 {
   // Add <this> to the parent's children list
   if ( myParent )
@@ -118,8 +136,9 @@ SUIT_TreeModel::TreeItem::~TreeItem()
 {
   // Ensure that all children are deleted;
   // each child removes itself from the children list
+  // (starting from the last one, so that other positions stay valid)
   while( myChildren.count() )
-    delete myChildren.at( 0 );
+    delete myChildren.last();
 
   // Remove this item from the parent's children list
   if ( myParent )
@@ -138,8 +157,17 @@ void SUIT_TreeModel::TreeItem::insertChild( SUIT_TreeModel::TreeItem* child,
   if ( !child )
     return;
 
-  int index = after ? after->position() + 1 : 0;
+  int index = after ? childPos( after ) + 1 : 0;
   myChildren.insert( index, child );
+
+  if ( index == myValidPos && index == myChildren.count() - 1 )
+  {
+    // appending does not shift anything
+    child->myPos = index;
+    myValidPos++;
+  }
+  else
+    myValidPos = qMin( myValidPos, index );
 }
 
 /*!
@@ -151,7 +179,38 @@ void SUIT_TreeModel::TreeItem::removeChild( SUIT_TreeModel::TreeItem* child )
 {
   if ( !child )
     return;
-  myChildren.removeAll( child );
+
+  int index = childPos( child );
+  if ( index >= 0 )
+  {
+    myChildren.removeAt( index );
+    myValidPos = qMin( myValidPos, index );
+  }
+}
+
+/*!
+  \brief Get position of the child item.
+
+  Positions of the items which follow an insertion or a removal
+  are renumbered on the next request only.
+
+  \internal
+  \param child child item
+  \return child item position or -1 if it is not a child of this item
+*/
+int SUIT_TreeModel::TreeItem::childPos( const SUIT_TreeModel::TreeItem* child ) const
+{
+  if ( !child )
+    return -1;
+
+  if ( child->myPos >= myValidPos || myChildren.value( child->myPos ) != child )
+  {
+    for ( int i = myValidPos; i < myChildren.count(); i++ )
+      myChildren.at( i )->myPos = i;
+    myValidPos = myChildren.count();
+  }
+
+  return myChildren.value( child->myPos ) == child ? child->myPos : -1;
 }
 
 /*!
@@ -181,7 +240,17 @@ SUIT_TreeModel::TreeItem* SUIT_TreeModel::TreeItem::parent() const
 */
 int SUIT_TreeModel::TreeItem::position() const
 {
-  return _position;
+  return myParent ? myParent->childPos( this ) : -1;
+}
+
+/*!
+  \brief Get depth of this item in the tree.
+  \internal
+  \return item level (root item has level 0)
+*/
+int SUIT_TreeModel::TreeItem::level() const
+{
+  return myLevel;
 }
 
 /*!
@@ -235,6 +304,49 @@ SUIT_TreeModel::TreeItem* SUIT_TreeModel::TreeItem::prevSibling() const
   return parent() ? parent()->child( position()-1 ) : 0;
 }
 
+/*!
+  \brief Get number of children of the data object which can be mirrored
+  by the child items in the lazy mode.
+  \internal
+  \return fetch limit (0 if the children have never been requested)
+*/
+int SUIT_TreeModel::TreeItem::fetchLimit() const
+{
+  return myFetchLimit;
+}
+
+/*!
+  \brief Set number of children of the data object which can be mirrored
+  by the child items in the lazy mode.
+  \internal
+  \param limit fetch limit
+*/
+void SUIT_TreeModel::TreeItem::setFetchLimit( const int limit )
+{
+  myFetchLimit = limit;
+}
+
+/*!
+  \brief Get modification stamp of the data object subtree when the item
+  was synchronized with it for the last time.
+  \internal
+  \return data object stamp (0 if the item has never been synchronized)
+*/
+unsigned long SUIT_TreeModel::TreeItem::stamp() const
+{
+  return myStamp;
+}
+
+/*!
+  \brief Set modification stamp of the data object subtree.
+  \internal
+  \param stamp data object stamp
+*/
+void SUIT_TreeModel::TreeItem::setStamp( const unsigned long stamp )
+{
+  myStamp = stamp;
+}
+
 /*!
   \class SUIT_TreeModel::TreeSync
   \brief Functor class for synchronizing data tree and tree model 
@@ -358,8 +470,17 @@ void SUIT_TreeModel::TreeSync::deleteItemWithChildren( const ItemPtr& item ) con
 QList<SUIT_TreeModel::ObjPtr> SUIT_TreeModel::TreeSync::children( const ObjPtr& obj ) const
 {
   QList<ObjPtr> ch;
-  if ( obj )
-    ch = obj->children();
+  if ( obj ) {
+    // in the lazy mode, only the fetched children are mirrored
+    int nb = qMin( obj->childCount(), myModel->fetchLimit( myModel->treeItem( obj ) ) );
+    if ( nb == obj->childCount() )
+      ch = obj->children();
+    else {
+      ch.reserve( nb );
+      for ( int i = 0; i < nb; i++ )
+        ch.append( obj->childObject( i ) );
+    }
+  }
   return ch;
 }
 
@@ -452,7 +573,9 @@ SUIT_TreeModel::SUIT_TreeModel( QObject* parent )
   myRootItem( 0 ),
   myAutoDeleteTree( false ),
   myAutoUpdate( true ),
-  myUpdateModified( false )
+  myUpdateModified( false ),
+  myLazyLoading( false ),
+  myFetchSize( 1000 )
 {
   initialize();
 }
@@ -468,7 +591,9 @@ SUIT_TreeModel::SUIT_TreeModel( SUIT_DataObject* root, QObject* parent )
   myRootItem( 0 ),
   myAutoDeleteTree( false ),
   myAutoUpdate( true ),
-  myUpdateModified( false )
+  myUpdateModified( false ),
+  myLazyLoading( false ),
+  myFetchSize( 1000 )
 {
   initialize();
 }
@@ -485,6 +610,8 @@ SUIT_TreeModel::~SUIT_TreeModel()
                                  this, SLOT( onRemoved( SUIT_DataObject*, SUIT_DataObject* ) ) );
     SUIT_DataObject::disconnect( SIGNAL( modifed( SUIT_DataObject* ) ),
                                  this, SLOT( onModified( SUIT_DataObject* ) ) );
+    SUIT_DataObject::disconnect( SIGNAL( childrenChanged( SUIT_DataObject* ) ),
+                                 this, SLOT( onChildrenChanged( SUIT_DataObject* ) ) );
     delete myRoot;
   }
 
@@ -678,32 +805,43 @@ Qtx::HeaderViewFlags SUIT_TreeModel::headerFlags( const QString& name ) const
 */
 void SUIT_TreeModel::setVisibilityState( const QString& id, Qtx::VisibilityState state, bool emitChanged )
 {
-  VisibilityMap::const_iterator it = myVisibilityMap.find( id );
-  if ( it != myVisibilityMap.end() && it.value() == state )
-    return;
+  QMap<QString,Qtx::VisibilityState> states;
+  states.insert( id, state );
+  setVisibilityStates( states, emitChanged );
+}
+
+/*!
+  \brief Set visibility state of several objects at once.
+
+  The visibility map is updated in one pass, then the changed cells are
+  refreshed by as few dataChanged() signals as possible (one per range of
+  consecutive rows).
   
-  bool needSignal = false;
-  if ( state != Qtx::UnpresentableState ) {
-    myVisibilityMap.insert( id, state );
-    needSignal = true;
-  }
-  else {
-    needSignal = myVisibilityMap.remove( id ) > 0;
-  }
-  if ( emitChanged && needSignal ) {
-    QModelIndexList lst;
-    if ( searcher() ) {
-      SUIT_DataObject* o = searcher()->findObject( id );
-      if ( o ) lst << index( o );
-    }
-    else {
-      lst = match( index( 0, root()->customData( Qtx::IdType ).toInt() ), DisplayRole, id, 1, Qt::MatchExactly | Qt::MatchRecursive );
+  \param states - visible states of the objects, by object id
+  \param emitChanged - if set to false, blocks dataChanged() signal
+*/
+void SUIT_TreeModel::setVisibilityStates( const QMap<QString,Qtx::VisibilityState>& states, bool emitChanged )
+{
+  QStringList changed;
+  QMap<QString,Qtx::VisibilityState>::const_iterator it;
+  for ( it = states.begin(); it != states.end(); ++it ) {
+    VisibilityMap::iterator vit = myVisibilityMap.find( it.key() );
+    if ( it.value() != Qtx::UnpresentableState ) {
+      if ( vit == myVisibilityMap.end() )
+        myVisibilityMap.insert( it.key(), it.value() );
+      else if ( vit.value() != it.value() )
+        vit.value() = it.value();
+      else
+        continue;
+      changed << it.key();
     }
-    if ( !lst.isEmpty() ) {
-      QModelIndex idx = index( lst.first().row(), SUIT_DataObject::VisibilityId, lst.first().parent() );
-      emit dataChanged( idx, idx );
+    else if ( vit != myVisibilityMap.end() ) {
+      myVisibilityMap.erase( vit );
+      changed << it.key();
     }
   }
+  if ( emitChanged && !changed.isEmpty() )
+    emitVisibilityChanged( changed );
 }
 
 /*!
@@ -713,8 +851,10 @@ void SUIT_TreeModel::setVisibilityState( const QString& id, Qtx::VisibilityState
 */
 void SUIT_TreeModel::setVisibilityStateForAll( Qtx::VisibilityState state )
 {
+  QMap<QString,Qtx::VisibilityState> states;
   foreach( QString id, myVisibilityMap.keys() )
-    setVisibilityState( id, state );
+    states.insert( id, state );
+  setVisibilityStates( states );
 }
 
 /*!
@@ -757,6 +897,8 @@ void SUIT_TreeModel::setRoot( SUIT_DataObject* r )
                                  this, SLOT( onRemoved( SUIT_DataObject*, SUIT_DataObject* ) ) );
     SUIT_DataObject::disconnect( SIGNAL( modified( SUIT_DataObject* ) ),
                                  this, SLOT( onModified( SUIT_DataObject* ) ) );
+    SUIT_DataObject::disconnect( SIGNAL( childrenChanged( SUIT_DataObject* ) ),
+                                 this, SLOT( onChildrenChanged( SUIT_DataObject* ) ) );
     delete myRoot;
     
     if ( myRootItem ) {
@@ -1125,6 +1267,68 @@ int SUIT_TreeModel::rowCount( const QModelIndex& parent ) const
   return parentItem ? parentItem->childCount() : 0;
 }
 
+/*!
+  \brief Check if the specified model index has children.
+
+  In the lazy mode, the children of the data object may be not fetched yet,
+  and the data object may even not have created its own children yet.
+
+  \param parent parent model index
+  \return \c true if there are children
+*/
+bool SUIT_TreeModel::hasChildren( const QModelIndex& parent ) const
+{
+  if ( !lazyLoading() )
+    return QAbstractItemModel::hasChildren( parent );
+
+  SUIT_DataObject* obj = object( treeItem( parent ) );
+  return obj && ( obj->childCount() > 0 || obj->canFetchChildren() ) && columnCount( parent ) > 0;
+}
+
+/*!
+  \brief Check if more children of the specified model index can be fetched.
+
+  Always \c false if the lazy mode is off.
+
+  \param parent parent model index
+  \return \c true if some data object children are not mirrored
+  or not created yet
+  \sa fetchMore(), setLazyLoading()
+*/
+bool SUIT_TreeModel::canFetchMore( const QModelIndex& parent ) const
+{
+  if ( !lazyLoading() )
+    return false;
+
+  TreeItem* item = treeItem( parent );
+  SUIT_DataObject* obj = object( item );
+  return obj && ( item->childCount() < obj->childCount() || obj->canFetchChildren() );
+}
+
+/*!
+  \brief Fetch next fetchSize() children of the specified model index.
+
+  Called by the views when the item is expanded or scrolled to its last child.
+  The data object is first asked to create its children if it did not do it yet
+  (see SUIT_DataObject::fetchChildren()).
+
+  \param parent parent model index
+  \sa canFetchMore(), setFetchSize()
+*/
+void SUIT_TreeModel::fetchMore( const QModelIndex& parent )
+{
+  TreeItem* item = treeItem( parent );
+  SUIT_DataObject* obj = object( item );
+  if ( !lazyLoading() || !obj )
+    return;
+
+  if ( obj->canFetchChildren() )
+    obj->fetchChildren();
+  // the item may be removed by the update of the data tree
+  if ( treeItem( obj ) == item )
+    fetchChildren( item, fetchLimit( item ) + fetchSize() );
+}
+
 /*!
   \brief Get data object by the specified model index.
   \param index model index
@@ -1137,6 +1341,10 @@ SUIT_DataObject* SUIT_TreeModel::object( const QModelIndex& index ) const
 
 /*!
   \brief Get model index by the specified data object.
+
+  In the lazy mode, the index is invalid if the branch containing
+  the object is not fetched yet (see fetchObject()).
+
   \param obj data object
   \param column data object column
   \return model index
@@ -1147,7 +1355,6 @@ QModelIndex SUIT_TreeModel::index( const SUIT_DataObject* obj, int column ) cons
     return QModelIndex();
 
   TreeItem* item = treeItem( obj );
-
   return item ? createIndex( item->position(), column, item ) : QModelIndex();
 }
 
@@ -1205,6 +1412,8 @@ void SUIT_TreeModel::setAutoUpdate( const bool on )
                                this, SLOT( onRemoved( SUIT_DataObject*, SUIT_DataObject* ) ) );
   SUIT_DataObject::disconnect( SIGNAL( modified( SUIT_DataObject* ) ),
                                this, SLOT( onModified( SUIT_DataObject* ) ) );
+  SUIT_DataObject::disconnect( SIGNAL( childrenChanged( SUIT_DataObject* ) ),
+                               this, SLOT( onChildrenChanged( SUIT_DataObject* ) ) );
   myAutoUpdate = on;
 
   if ( myAutoUpdate ) {
@@ -1214,6 +1423,8 @@ void SUIT_TreeModel::setAutoUpdate( const bool on )
                               this, SLOT( onRemoved( SUIT_DataObject*, SUIT_DataObject* ) ) );
     SUIT_DataObject::connect( SIGNAL( modified( SUIT_DataObject* ) ),
                               this, SLOT( onModified( SUIT_DataObject* ) ) );
+    SUIT_DataObject::connect( SIGNAL( childrenChanged( SUIT_DataObject* ) ),
+                              this, SLOT( onChildrenChanged( SUIT_DataObject* ) ) );
 
     updateTree();
   }
@@ -1236,6 +1447,80 @@ void SUIT_TreeModel::setUpdateModified(const bool on)
   myUpdateModified=on;
 }
 
+/*!
+  \brief Get 'lazy loading' flag value.
+  \return 'lazy loading' flag value
+  \sa setLazyLoading()
+*/
+bool SUIT_TreeModel::lazyLoading() const
+{
+  return myLazyLoading;
+}
+
+/*!
+  \brief Set 'lazy loading' flag value.
+
+  If this flag is set to \c true (default=false), the model creates the items
+  for the children of a data object only when they are requested by the view
+  (canFetchMore()/fetchMore(), i.e. when the item is expanded), by pages of
+  fetchSize() items, or when a branch is fetched explicitly by fetchObject().
+  Only the top level objects are mirrored when the tree is built.
+
+  The data objects may also postpone the creation of their own children
+  until they are fetched (see SUIT_DataObject::canFetchChildren()).
+  When the lazy mode is switched off, all such children are created.
+
+  \param on 'lazy loading' flag value
+  \sa fetchSize()
+*/
+void SUIT_TreeModel::setLazyLoading( const bool on )
+{
+  if ( myLazyLoading == on )
+    return;
+
+  myLazyLoading = on;
+
+  if ( !on && root() ) {
+    SUIT_DataObject::Transaction transaction;
+    DataObjectList objs;
+    objs.append( root() );
+    while ( !objs.isEmpty() ) {
+      SUIT_DataObject* obj = objs.takeLast();
+      if ( obj->canFetchChildren() )
+        obj->fetchChildren();
+      objs += obj->children();
+    }
+  }
+
+  // drop the items which are not fetched / create the missing ones
+  resetStamps( rootItem() );
+  if ( root() )
+    updateTree();
+}
+
+/*!
+  \brief Get number of children fetched at once in the lazy mode.
+  \return fetch size
+  \sa setFetchSize()
+*/
+int SUIT_TreeModel::fetchSize() const
+{
+  return myFetchSize;
+}
+
+/*!
+  \brief Set number of children fetched at once in the lazy mode.
+
+  Default value is 1000.
+
+  \param size fetch size
+  \sa setLazyLoading()
+*/
+void SUIT_TreeModel::setFetchSize( const int size )
+{
+  myFetchSize = qMax( 1, size );
+}
+
 /*!
   \brief Check if the specified column supports custom sorting.
   \param column column index on which data is being sorted
@@ -1307,64 +1592,240 @@ void SUIT_TreeModel::updateTree( const QModelIndex& index )
   updateTree( object( index ) );
 }
 
+/*!
+  \brief Synchronize the tree items with the data objects.
+
+  Subtrees which have not been modified since the last update (see
+  SUIT_DataObject::stamp()) are skipped. For each other parent, the
+  items which are kept are the longest sequence of items in the same
+  order as the data objects; the other ones are removed and the new
+  data objects are inserted by ranges of consecutive rows.
 
+  \param obj data object
+  \param item tree item of the data object
+*/
 void SUIT_TreeModel::updateTreeModel(SUIT_DataObject* obj,TreeItem* item)
 {
-  int kobj=0;
-  int kitem=0;
-  int nobjchild=obj->childCount();
-  SUIT_DataObject* sobj=obj->childObject(kobj);
-  TreeItem* sitem = item->child(kitem);
+  if ( !obj || !item )
+    return;
 
-  while(kobj < nobjchild)
-    {
-      if(sitem==0)
-        {
-          //end of item list
-	  sitem=createItemAtPos(sobj,item,kitem);
-          updateTreeModel(sobj,sitem);
-          kobj++;
-          kitem++;
-          sobj=obj->childObject(kobj);
-          sitem = item->child(kitem);
-        }
-      else if(sitem->dataObject() != sobj)
-        {
-          if(treeItem(sobj))
-            {
-              // item : to remove
-              removeItem(sitem);
-              sitem = item->child(kitem);
-            }
-          else
-            {
-              // obj : new object
-              sitem=createItemAtPos(sobj,item,kitem);
-	      updateTreeModel(sobj,sitem);
-              kobj++;
-              kitem++;
-              sobj=obj->childObject(kobj);
-              sitem = item->child(kitem);
-            }
-        }
-      else
-        {
-          //obj and item are synchronised : go to next ones
-          updateTreeModel(sobj,sitem);
-          if(sobj->modified()) updateItem(sitem, true);
-          sobj->update();
-          kobj++;
-          kitem++;
-          sobj=obj->childObject(kobj);
-          sitem = item->child(kitem);
-        }
+  int nobjchild = qMin( obj->childCount(), fetchLimit( item ) );
+
+  // nothing has been changed in the subtree since the last update
+  if ( item->stamp() == obj->stamp() && item->childCount() == nobjchild )
+    return;
+
+  // skip the common head and tail of the children lists
+  int nitemchild = item->childCount();
+  int head = 0;
+  while ( head < nobjchild && head < nitemchild &&
+          item->child( head )->dataObject() == obj->childObject( head ) )
+    head++;
+  int tail = 0;
+  while ( tail < nobjchild - head && tail < nitemchild - head &&
+          item->child( nitemchild-tail-1 )->dataObject() == obj->childObject( nobjchild-tail-1 ) )
+    tail++;
+
+  if ( head + tail < nobjchild || head + tail < nitemchild )
+  {
+    // the items which are kept are the longest subsequence of items
+    // in the same order as the objects
+    QVector<SUIT_DataObject*> objs( nobjchild - head - tail );
+    QHash<SUIT_DataObject*, int> objPos;
+    for ( int i = 0; i < objs.count(); i++ ) {
+      objs[i] = obj->childObject( head + i );
+      objPos.insert( objs[i], i );
     }
-  //remove remaining items
-  for(int i = item->childCount(); i > kitem;i--)
-    {
-      sitem = item->child(i-1);
-      removeItem(sitem);
+    QVector<int> itemPos( nitemchild - head - tail );
+    for ( int i = 0; i < itemPos.count(); i++ )
+      itemPos[i] = objPos.value( item->child( head + i )->dataObject(), -1 );
+
+    QVector<bool> keepItem( itemPos.count(), false );
+    QVector<bool> keepObj( objs.count(), false );
+    QVector<int> seq = longestIncreasingSubsequence( itemPos );
+    foreach ( int i, seq ) {
+      keepItem[i] = true;
+      keepObj[itemPos[i]] = true;
+    }
+
+    // remove the other items by ranges, from the last one
+    for ( int last = keepItem.count() - 1; last >= 0; ) {
+      if ( keepItem[last] ) {
+        last--;
+        continue;
+      }
+      int first = last;
+      while ( first > 0 && !keepItem[first-1] )
+        first--;
+      removeItems( item, head + first, head + last );
+      last = first - 1;
+    }
+
+    // insert the new objects by ranges
+    int row = head;
+    for ( int i = 0; i < objs.count(); ) {
+      if ( keepObj[i] ) {
+        i++;
+        row++;
+        continue;
+      }
+      QList<SUIT_DataObject*> range;
+      for ( ; i < objs.count() && !keepObj[i]; i++ )
+        range.append( objs[i] );
+      insertItems( item, row, range );
+      row += range.count();
+    }
+  }
+
+  // update the children (the new ones are already up to date)
+  for ( int i = 0; i < nobjchild; i++ ) {
+    SUIT_DataObject* sobj = obj->childObject( i );
+    TreeItem* sitem = item->child( i );
+    updateTreeModel( sobj, sitem );
+    if ( sobj->modified() ) updateItem( sitem, false );
+    sobj->update();
+  }
+
+  item->setStamp( obj->stamp() );
+}
+
+/*!
+  \brief Get the longest strictly increasing subsequence of the values.
+
+  The negative values are ignored.
+  \param values values
+  \return indices of the subsequence values, in ascending order
+*/
+QVector<int> SUIT_TreeModel::longestIncreasingSubsequence( const QVector<int>& values )
+{
+  // tails[k]: index of the smallest tail of the increasing subsequences of length k+1
+  QVector<int> tails;
+  QVector<int> prev( values.count(), -1 );
+  for ( int i = 0; i < values.count(); i++ ) {
+    if ( values[i] < 0 )
+      continue;
+    int lo = 0, hi = tails.count();
+    while ( lo < hi ) {
+      int mid = ( lo + hi ) / 2;
+      if ( values[tails[mid]] < values[i] )
+        lo = mid + 1;
+      else
+        hi = mid;
     }
+    if ( lo > 0 )
+      prev[i] = tails[lo-1];
+    if ( lo == tails.count() )
+      tails.append( i );
+    else
+      tails[lo] = i;
+  }
+
+  QVector<int> seq( tails.count() );
+  for ( int k = tails.count() - 1, i = tails.isEmpty() ? -1 : tails.last(); k >= 0; k--, i = prev[i] )
+    seq[k] = i;
+  return seq;
+}
+
+/*!
+  \brief Create the items of a range of data objects.
+
+  The rows are inserted at once; the subtrees of the objects are
+  mirrored as well.
+  \param parent parent tree item
+  \param row position of the first item
+  \param objs data objects
+*/
+void SUIT_TreeModel::insertItems( TreeItem* parent, const int row, const QList<SUIT_DataObject*>& objs )
+{
+  if ( !parent || objs.isEmpty() )
+    return;
+
+  beginInsertRows( parent == rootItem() ? QModelIndex() : createIndex( parent->position(), 0, parent ),
+                   row, row + objs.count() - 1 );
+
+  TreeItem* after = parent->child( row - 1 );
+  foreach ( SUIT_DataObject* obj, objs ) {
+    after = new TreeItem( obj, parent, after );
+    buildItems( obj, after );
+  }
+
+  endInsertRows();
+}
+
+/*!
+  \brief Mirror a data object and its subtree, without any signal.
+  \param obj data object
+  \param item new tree item of the data object
+*/
+void SUIT_TreeModel::buildItems( SUIT_DataObject* obj, TreeItem* item )
+{
+  // the object could be mirrored elsewhere (moved object): the old item
+  // is removed when its parent is updated
+  myItems[ obj ] = item;
+  obj->setModified( false );
+
+  int nobjchild = qMin( obj->childCount(), fetchLimit( item ) );
+  TreeItem* after = 0;
+  for ( int i = 0; i < nobjchild; i++ ) {
+    SUIT_DataObject* child = obj->childObject( i );
+    after = new TreeItem( child, item, after );
+    buildItems( child, after );
+  }
+  obj->update();
+  item->setStamp( obj->stamp() );
+}
+
+/*!
+  \brief Remove a range of items with their children.
+  \param parent parent tree item
+  \param first position of the first item
+  \param last position of the last item
+*/
+void SUIT_TreeModel::removeItems( TreeItem* parent, const int first, const int last )
+{
+  if ( !parent || first > last )
+    return;
+
+  beginRemoveRows( parent == rootItem() ? QModelIndex() : createIndex( parent->position(), 0, parent ),
+                   first, last );
+
+  for ( int i = last; i >= first; i-- ) {
+    TreeItem* item = parent->child( i );
+    forgetItems( item );
+    delete item;
+  }
+
+  endRemoveRows();
+}
+
+/*!
+  \brief Unregister the item and its children.
+
+  The data objects can already be deleted: they are not accessed.
+  \param item tree item
+*/
+void SUIT_TreeModel::forgetItems( TreeItem* item )
+{
+  for ( int i = 0; i < item->childCount(); i++ )
+    forgetItems( item->child( i ) );
+
+  // the data object may be mirrored by another item now (moved object)
+  ItemMap::iterator it = myItems.find( item->dataObject() );
+  if ( it != myItems.end() && it.value() == item )
+    myItems.erase( it );
+}
+
+/*!
+  \brief Force the next update of the items subtree.
+  \param item tree item
+*/
+void SUIT_TreeModel::resetStamps( TreeItem* item )
+{
+  if ( !item )
+    return;
+  item->setStamp( 0 );
+  for ( int i = 0; i < item->childCount(); i++ )
+    resetStamps( item->child( i ) );
 }
 
 /*!
@@ -1385,6 +1846,10 @@ void SUIT_TreeModel::updateTree( SUIT_DataObject* obj )
   else if ( obj->root() != root() )
     return;
 
+  // in the lazy mode, a branch which is not fetched yet has nothing to update
+  if ( lazyLoading() && !treeItem( obj ) )
+    return;
+
   if(updateModified())
     {
       updateTreeModel(obj,treeItem( obj ));
@@ -1409,6 +1874,8 @@ void SUIT_TreeModel::initialize()
                                this, SLOT( onRemoved( SUIT_DataObject*, SUIT_DataObject* ) ) );
   SUIT_DataObject::disconnect( SIGNAL( modified( SUIT_DataObject* ) ),
                                this, SLOT( onModified( SUIT_DataObject* ) ) );
+  SUIT_DataObject::disconnect( SIGNAL( childrenChanged( SUIT_DataObject* ) ),
+                               this, SLOT( onChildrenChanged( SUIT_DataObject* ) ) );
   if ( autoUpdate() ) {
     SUIT_DataObject::connect( SIGNAL( inserted( SUIT_DataObject*, SUIT_DataObject* ) ),
                               this, SLOT( onInserted( SUIT_DataObject*, SUIT_DataObject* ) ) );
@@ -1416,6 +1883,8 @@ void SUIT_TreeModel::initialize()
                               this, SLOT( onRemoved( SUIT_DataObject*, SUIT_DataObject* ) ) );
     SUIT_DataObject::connect( SIGNAL( modified( SUIT_DataObject* ) ),
                               this, SLOT( onModified( SUIT_DataObject* ) ) );
+    SUIT_DataObject::connect( SIGNAL( childrenChanged( SUIT_DataObject* ) ),
+                              this, SLOT( onChildrenChanged( SUIT_DataObject* ) ) );
   }
 
   myItems.clear(); // ????? is it really necessary
@@ -1485,6 +1954,145 @@ SUIT_DataObject* SUIT_TreeModel::object( const SUIT_TreeModel::TreeItem* item )
   return myItems.contains( obj ) ? obj : 0;
 }
 
+/*!
+  \brief Get number of children of the item data object which are mirrored.
+  \param item tree item
+  \return number of children to be mirrored (unlimited if the lazy mode is off)
+*/
+int SUIT_TreeModel::fetchLimit( const SUIT_TreeModel::TreeItem* item ) const
+{
+  if ( !lazyLoading() )
+    return INT_MAX;
+  if ( !item )
+    return 0;
+  // the top level objects are always shown
+  return item == rootItem() ? qMax( item->fetchLimit(), fetchSize() ) : item->fetchLimit();
+}
+
+/*!
+  \brief Create the items for the children of the item data object, up to \a limit.
+  \param item tree item
+  \param limit new fetch limit
+*/
+void SUIT_TreeModel::fetchChildren( SUIT_TreeModel::TreeItem* item, const int limit )
+{
+  SUIT_DataObject* obj = object( item );
+  if ( !obj || limit <= fetchLimit( item ) )
+    return;
+
+  item->setFetchLimit( limit );
+
+  // the already mirrored children are normally in sync: append the new page
+  // as a single range of rows
+  int first = item->childCount();
+  int last = qMin( limit, obj->childCount() ) - 1;
+  bool inSync = first <= obj->childCount() &&
+    ( first == 0 || item->child( first-1 )->dataObject() == obj->childObject( first-1 ) );
+  for ( int i = first; i <= last && inSync; i++ )
+    inSync = !myItems.contains( obj->childObject( i ) );
+
+  if ( !inSync ) {
+    updateTree( obj );
+    return;
+  }
+  if ( last < first )
+    return;
+
+  beginInsertRows( index( obj ), first, last );
+  TreeItem* after = item->child( first-1 );
+  for ( int i = first; i <= last; i++ ) {
+    SUIT_DataObject* child = obj->childObject( i );
+    after = new TreeItem( child, item, after );
+    myItems[ child ] = after;
+    child->setModified( false );
+    child->update();
+  }
+  endInsertRows();
+}
+
+/*!
+  \brief Fetch the branch containing the data object, in the lazy mode.
+
+  Should be called before index() by the code which needs the model index
+  of an object which may be not shown yet, e.g. to select or browse it.
+  Does nothing if the lazy mode is off.
+
+  \param obj data object
+  \return \c true if the object is mirrored by the model
+*/
+bool SUIT_TreeModel::fetchObject( const SUIT_DataObject* obj )
+{
+  if ( !obj || obj->root() != root() )
+    return false;
+  if ( treeItem( obj ) )
+    return true;
+  if ( !lazyLoading() )
+    return false;
+
+  // ancestors which are not mirrored yet, from the top-most one
+  QList<const SUIT_DataObject*> path;
+  for ( const SUIT_DataObject* o = obj; o && !treeItem( o ); o = o->parent() )
+    path.prepend( o );
+
+  foreach ( const SUIT_DataObject* o, path ) {
+    TreeItem* parentItem = treeItem( o->parent() );
+    if ( !parentItem )
+      return false;
+    // fetch all the pages up to the one containing the object
+    int page = o->position() / fetchSize() + 1;
+    fetchChildren( parentItem, page * fetchSize() );
+  }
+  return treeItem( obj ) != 0;
+}
+
+/*!
+  \brief Emit dataChanged() for the visibility column of the objects.
+
+  The objects are found by the searcher if any, otherwise by a single
+  pass over the existing tree items. The rows of the same parent are
+  merged into ranges of consecutive rows. Objects which are not fetched
+  yet (lazy mode) are skipped: they are not shown anyway.
+  \param ids - objects ids
+*/
+void SUIT_TreeModel::emitVisibilityChanged( const QStringList& ids )
+{
+  QList<TreeItem*> items;
+  if ( searcher() ) {
+    foreach( QString id, ids ) {
+      SUIT_DataObject* o = searcher()->findObject( id );
+      TreeItem* item = o && o != root() ? treeItem( o ) : 0;
+      if ( item ) items << item;
+    }
+  }
+  else {
+    QSet<QString> idSet;
+    foreach( QString id, ids )
+      idSet.insert( id );
+    for ( ItemMap::const_iterator it = myItems.begin(); it != myItems.end(); ++it ) {
+      TreeItem* item = it.value();
+      if ( idSet.contains( objectId( createIndex( item->position(), 0, item ) ) ) )
+        items << item;
+    }
+  }
+
+  QMap<TreeItem*, QList<int> > rows;
+  foreach( TreeItem* item, items )
+    rows[ item->parent() ].append( item->position() );
+
+  for ( QMap<TreeItem*, QList<int> >::iterator it = rows.begin(); it != rows.end(); ++it ) {
+    TreeItem* parent = it.key();
+    QList<int>& positions = it.value();
+    qSort( positions );
+    for ( int i = 0; i < positions.count(); ) {
+      int first = positions[i], last = first;
+      for ( ++i; i < positions.count() && positions[i] <= last + 1; ++i )
+        last = positions[i];
+      emit dataChanged( createIndex( first, SUIT_DataObject::VisibilityId, parent->child( first ) ),
+                        createIndex( last,  SUIT_DataObject::VisibilityId, parent->child( last ) ) );
+    }
+  }
+}
+
 /*!
   \brief Get unique object identifier
   
@@ -1531,9 +2139,6 @@ SUIT_TreeModel::TreeItem* SUIT_TreeModel::createItem( SUIT_DataObject* obj,
 
   myItems[ obj ] = new TreeItem( obj, parent, after );
 
-  for(int pos=row;pos < parent->childCount();pos++)
-    parent->child(pos)->setPosition(pos);
-
   endInsertRows();
 
   obj->setModified(false);
@@ -1566,9 +2171,6 @@ SUIT_TreeModel::TreeItem* SUIT_TreeModel::createItemAtPos( SUIT_DataObject* obj,
   SUIT_TreeModel::TreeItem* item = new TreeItem( obj, parent, after );
   myItems[ obj ] = item;
 
-  for(int ppos=row;ppos < parent->childCount();ppos++)
-    parent->child(ppos)->setPosition(ppos);
-
   endInsertRows();
 
   obj->setModified(false);
@@ -1591,28 +2193,14 @@ void SUIT_TreeModel::updateItem( SUIT_TreeModel::TreeItem* item, bool emitLayout
     return;
   
   // update all columns corresponding to the given data object
-  /*To avoid crashes we should update any persistent model indexes before emitting layoutChanged(). In other words, when the structure changes:
-      -  emit layoutAboutToBeChanged
-      - Remember the QModelIndex that will change
-      - call changePersistentIndex()
-      - emit layoutChanged
-  */
-
+  if ( emitLayoutChanged )
     emit layoutAboutToBeChanged();
 
-    // Remember the QModelIndex that will change
-    QModelIndexList fromIndexes;
-    QModelIndexList toIndexes;
-    for (int i = 0; i < columnCount() - 1; ++i) {
-        fromIndexes.append( index( obj, i ));
-        toIndexes.append(QModelIndex());
-    }
-    //changePersistentIndexList(fromIndexes, toIndexes); // Limitation: can lead to loss of selection
+  emit dataChanged( index( obj, 0 ), index( obj, columnCount() - 1 ) );
+  obj->setModified(false);
 
-    emit dataChanged( toIndexes.first(), toIndexes.last() );
-    obj->setModified(false);
-    if ( emitLayoutChanged )
-      emit layoutChanged();
+  if ( emitLayoutChanged )
+    emit layoutChanged();
 }
 
 /*!
@@ -1628,7 +2216,7 @@ void SUIT_TreeModel::removeItem( SUIT_TreeModel::TreeItem* item )
   // Otherwise, "delete item" line below will destroy all item's children,
   // and <myItems> will contain invalid pointers
   while( item->childCount() )
-    removeItem( item->child( 0 ) );
+    removeItem( item->child( item->childCount() - 1 ) );
 
   SUIT_DataObject* obj = object( item );
   
@@ -1645,11 +2233,7 @@ void SUIT_TreeModel::removeItem( SUIT_TreeModel::TreeItem* item )
   if ( obj == root() )
     setRoot( 0 );
   else if ( parent )
-    {
-      parent->removeChild( item );
-      for(int pos=row;pos < parent->childCount();pos++)
-        parent->child(pos)->setPosition(pos);
-    }
+    parent->removeChild( item );
 
   delete item;
 
@@ -1678,6 +2262,17 @@ void SUIT_TreeModel::onRemoved( SUIT_DataObject* /*object*/, SUIT_DataObject* pa
     updateTree( parent );
 }
 
+/*!
+  \brief Called when the children of the data object are changed by a transaction.
+  \param parent top-most data object whose subtree is changed
+  \sa SUIT_DataObject::beginTransaction()
+*/
+void SUIT_TreeModel::onChildrenChanged( SUIT_DataObject* parent )
+{
+  if ( autoUpdate() )
+    updateTree( parent );
+}
+
 /*!
   \brief Called when the data object is modified. TreeSync is not used here for maximum efficiency.
   It is assumed that it is up to the application to decide when its data objects are modified.
@@ -1685,7 +2280,7 @@ void SUIT_TreeModel::onRemoved( SUIT_DataObject* /*object*/, SUIT_DataObject* pa
 */
 void SUIT_TreeModel::onModified( SUIT_DataObject* obj )
 {
-  if ( autoUpdate() )
+  if ( autoUpdate() && treeItem( obj ) )
   {
     QModelIndex firstIdx = index( obj, 0 );
     QModelIndex lastIdx  = index( obj, columnCount() - 1 );
@@ -1884,6 +2479,17 @@ QModelIndex SUIT_ProxyModel::index( const SUIT_DataObject* obj, int column ) con
   return treeModel() ? mapFromSource( treeModel()->index( obj, column ) ) : QModelIndex();
 }
 
+/*!
+  \brief Fetch the branch containing the data object, in the lazy mode.
+  \param obj data object
+  \return \c true if the object is mirrored by the model
+  \sa SUIT_TreeModel::fetchObject()
+*/
+bool SUIT_ProxyModel::fetchObject( const SUIT_DataObject* obj )
+{
+  return treeModel() ? treeModel()->fetchObject( obj ) : false;
+}
+
 /*!
   \brief Get 'auto-delete data tree' flag value.
   \return 'auto-delete data tree' flag value
@@ -1941,6 +2547,49 @@ void SUIT_ProxyModel::setUpdateModified( const bool on )
     treeModel()->setUpdateModified( on );
 }
 
+/*!
+  \brief Get 'lazy loading' flag value.
+  \return 'lazy loading' flag value
+  \sa setLazyLoading()
+*/
+bool SUIT_ProxyModel::lazyLoading() const
+{
+  return treeModel() ? treeModel()->lazyLoading() : false;
+}
+
+/*!
+  \brief Set 'lazy loading' flag value.
+
+  If this flag is set to \c true (default=false), the source model creates
+  the items for the children of a data object only when they are requested.
+
+  \param on 'lazy loading' flag value
+*/
+void SUIT_ProxyModel::setLazyLoading( const bool on )
+{
+  if ( treeModel() )
+    treeModel()->setLazyLoading( on );
+}
+
+/*!
+  \brief Get number of children fetched at once in the lazy mode.
+  \return fetch size
+*/
+int SUIT_ProxyModel::fetchSize() const
+{
+  return treeModel() ? treeModel()->fetchSize() : 0;
+}
+
+/*!
+  \brief Set number of children fetched at once in the lazy mode.
+  \param size fetch size
+*/
+void SUIT_ProxyModel::setFetchSize( const int size )
+{
+  if ( treeModel() )
+    treeModel()->setFetchSize( size );
+}
+
 /*!
   \brief Set 'auto-update tree' flag value.
 
@@ -2212,10 +2861,21 @@ void SUIT_ProxyModel::setVisibilityState(const QString& id, Qtx::VisibilityState
     treeModel()->setVisibilityState(id,state,emitChanged);
 }
 
+/*!
+  \brief Set visibility state of several objects at once.
+  
+  \param states - visible states of the objects, by object id
+  \param emitChanged - if set to false, blocks dataChanged() signal
+*/
+void SUIT_ProxyModel::setVisibilityStates(const QMap<QString,Qtx::VisibilityState>& states, bool emitChanged )
+{
+  if(treeModel())
+    treeModel()->setVisibilityStates(states,emitChanged);
+}
+
 /*!
   \brief Set visibility state for all objects.
   
-  \param id - column name
   \param state - visible state
 */
 void SUIT_ProxyModel::setVisibilityStateForAll(Qtx::VisibilityState state)
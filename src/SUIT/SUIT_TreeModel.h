@@ -33,6 +33,7 @@
 #include <QItemDelegate>
 #include <QVariant>
 #include <QMap>
+#include <QVector>
 
 #ifdef WIN32
 #pragma warning( disable:4251 )
@@ -63,12 +64,17 @@ public:
   virtual void                  setRoot( SUIT_DataObject* ) = 0;
   virtual SUIT_DataObject*      object( const QModelIndex& = QModelIndex() ) const = 0;
   virtual QModelIndex           index( const SUIT_DataObject*, int = 0 ) const = 0;
+  virtual bool                  fetchObject( const SUIT_DataObject* ) = 0;
   virtual bool                  autoDeleteTree() const = 0;
   virtual void                  setAutoDeleteTree( const bool ) = 0;
   virtual bool                  autoUpdate() const = 0;
   virtual void                  setAutoUpdate( const bool ) = 0;
   virtual bool                  updateModified() const = 0;
   virtual void                  setUpdateModified( const bool ) = 0;
+  virtual bool                  lazyLoading() const = 0;
+  virtual void                  setLazyLoading( const bool ) = 0;
+  virtual int                   fetchSize() const = 0;
+  virtual void                  setFetchSize( const int ) = 0;
   virtual QAbstractItemDelegate* delegate() const = 0;
   virtual bool                  customSorting( const int ) const = 0;
   virtual bool                  lessThan( const QModelIndex& left, const QModelIndex& right ) const = 0;
@@ -84,6 +90,7 @@ public:
   virtual void                  setAppropriate( const QString& name, const Qtx::Appropriate appr ) = 0;
   virtual Qtx::Appropriate      appropriate( const QString& name ) const = 0;
   virtual void                  setVisibilityState(const QString& id, Qtx::VisibilityState state, bool emitChanged = true) = 0;
+  virtual void                  setVisibilityStates(const QMap<QString,Qtx::VisibilityState>& states, bool emitChanged = true) = 0;
   virtual void                  setVisibilityStateForAll(Qtx::VisibilityState state) = 0;
   virtual Qtx::VisibilityState  visibilityState(const QString& id) const = 0;
   virtual void                  setHeaderFlags( const QString& name, const Qtx::HeaderViewFlags flags ) = 0;
@@ -146,6 +153,9 @@ public:
 
   virtual int              columnCount( const QModelIndex& = QModelIndex() ) const;
   virtual int              rowCount( const QModelIndex& = QModelIndex() ) const;
+  virtual bool             hasChildren( const QModelIndex& = QModelIndex() ) const;
+  virtual bool             canFetchMore( const QModelIndex& ) const;
+  virtual void             fetchMore( const QModelIndex& );
   virtual void             registerColumn( const int group_id, const QString& name, const int custom_id );
   virtual void             unregisterColumn( const int group_id, const QString& name );
   virtual void             setColumnIcon( const QString& name, const QPixmap& icon );
@@ -153,6 +163,7 @@ public:
   virtual void             setAppropriate( const QString& name, const Qtx::Appropriate appr );
   virtual Qtx::Appropriate appropriate( const QString& name ) const;
   virtual void                  setVisibilityState(const QString& id, Qtx::VisibilityState state, bool emitChanged = true);
+  virtual void                  setVisibilityStates(const QMap<QString,Qtx::VisibilityState>& states, bool emitChanged = true);
   virtual void                  setVisibilityStateForAll(Qtx::VisibilityState state);
   virtual Qtx::VisibilityState  visibilityState(const QString& id) const;
   virtual void                  setHeaderFlags( const QString& name, const Qtx::HeaderViewFlags flags );
@@ -162,6 +173,7 @@ public:
 
   SUIT_DataObject*       object( const QModelIndex& = QModelIndex() ) const;
   QModelIndex            index( const SUIT_DataObject*, int = 0 ) const;
+  bool                   fetchObject( const SUIT_DataObject* );
 
   bool                   autoDeleteTree() const;
   void                   setAutoDeleteTree( const bool );
@@ -172,6 +184,12 @@ public:
   bool                   updateModified() const;
   void                   setUpdateModified( const bool );
 
+  bool                   lazyLoading() const;
+  void                   setLazyLoading( const bool );
+
+  int                    fetchSize() const;
+  void                   setFetchSize( const int );
+
   virtual bool           customSorting( const int ) const;
   virtual bool           lessThan( const QModelIndex& left, const QModelIndex& right ) const;
   virtual void           forgetObject( const SUIT_DataObject* );
@@ -209,11 +227,24 @@ private:
   TreeItem*              createItemAtPos( SUIT_DataObject*, TreeItem* = 0, int pos=0 );
   void                   updateItem( TreeItem*, bool emitLayoutChanged );
   void                   removeItem( TreeItem* );
+  void                   insertItems( TreeItem*, const int, const QList<SUIT_DataObject*>& );
+  void                   removeItems( TreeItem*, const int, const int );
+  void                   buildItems( SUIT_DataObject*, TreeItem* );
+  void                   forgetItems( TreeItem* );
+  void                   resetStamps( TreeItem* );
+
+  static QVector<int>    longestIncreasingSubsequence( const QVector<int>& );
+
+  int                    fetchLimit( const TreeItem* ) const;
+  void                   fetchChildren( TreeItem*, const int );
+
+  void                   emitVisibilityChanged( const QStringList& );
 
 private slots:
   void                   onInserted( SUIT_DataObject*, SUIT_DataObject* );
   void                   onRemoved( SUIT_DataObject*, SUIT_DataObject* );
   void                   onModified( SUIT_DataObject* );
+  void                   onChildrenChanged( SUIT_DataObject* );
 
 private:
   typedef QMap<SUIT_DataObject*, TreeItem*> ItemMap;
@@ -236,6 +267,8 @@ private:
   bool                myAutoDeleteTree;
   bool                myAutoUpdate;
   bool                myUpdateModified;
+  bool                myLazyLoading;
+  int                 myFetchSize;
   QVector<ColumnInfo> myColumns;
 
   friend class SUIT_TreeModel::TreeSync;
@@ -256,6 +289,7 @@ public:
 
   SUIT_DataObject*       object( const QModelIndex& = QModelIndex() ) const;
   QModelIndex            index( const SUIT_DataObject*, int = 0 ) const;
+  bool                   fetchObject( const SUIT_DataObject* );
 
   bool                   autoDeleteTree() const;
   void                   setAutoDeleteTree( const bool );
@@ -266,6 +300,12 @@ public:
   bool                   updateModified() const;
   void                   setUpdateModified( const bool );
 
+  bool                   lazyLoading() const;
+  void                   setLazyLoading( const bool );
+
+  int                    fetchSize() const;
+  void                   setFetchSize( const int );
+
   bool                   isSortingEnabled() const;
   bool                   customSorting( const int ) const;
 
@@ -278,6 +318,7 @@ public:
   virtual void             setAppropriate( const QString& name, const Qtx::Appropriate appr );
   virtual Qtx::Appropriate appropriate( const QString& name ) const;
   virtual void                  setVisibilityState(const QString& id, Qtx::VisibilityState state, bool emitChanged = true);
+  virtual void                  setVisibilityStates(const QMap<QString,Qtx::VisibilityState>& states, bool emitChanged = true);
   virtual void                  setVisibilityStateForAll(Qtx::VisibilityState state);
   virtual Qtx::VisibilityState  visibilityState(const QString& id) const;
   virtual void                  setHeaderFlags( const QString& name, const Qtx::HeaderViewFlags flags );
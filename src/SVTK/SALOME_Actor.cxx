@@ -39,8 +39,10 @@
 #include "VTKViewer_GeometryFilter.h"
 #include "VTKViewer_FramedTextActor.h"
 #include "SVTK_AreaPicker.h"
+#include "SVTK_PointPicker.h"
 
 #include "SVTK_Actor.h"
+#include "SVTK_Event.h"
 
 #include <SUIT_ResourceMgr.h>
 #include <SUIT_Session.h>
@@ -52,6 +54,9 @@
 #include <vtkPicker.h>
 #include <vtkPointPicker.h>
 #include <vtkCellPicker.h>
+#include <vtkStaticPointLocator.h>
+#include <vtkStaticCellLocator.h>
+#include <vtkCamera.h>
 #include <vtkRenderer.h>
 #include <vtkPolyData.h>
 #include <vtkObjectFactory.h>
@@ -69,6 +74,7 @@
 #include <TColStd_IndexedMapOfInteger.hxx>
 
 #include <math.h>
+#include <algorithm>
 #include <QPoint>
 #include <QVector>
 
@@ -85,15 +91,14 @@ namespace
 {
   int
   GetEdgeAndNodesId(SALOME_Actor* theActor,
-                    vtkPicker* thePicker,
+                    const double thePickPosition[3],
                     vtkIdType theObjId,
                     vtkIdType& theFirstNodeId,
                     vtkIdType& theSecondNodeId)
   {
     int anEdgeId = 0;
     if (vtkCell* aPickedCell = theActor->GetElemCell(theObjId)) {
-      double aPickPosition[3];
-      thePicker->GetPickPosition(aPickPosition);
+      double aPickPosition[3] = { thePickPosition[0], thePickPosition[1], thePickPosition[2] };
       double aMinDist = 1000000.0, aDist = 0;
       vtkCell* aSelEdge;
       for (int i = 0, iEnd = aPickedCell->GetNumberOfEdges(); i < iEnd; i++){
@@ -142,6 +147,53 @@ namespace
     };
     return false;
   }
+
+  /*!
+    Make a picker use the locator during a pick (the pickers are shared by the actors)
+  */
+  template<class TPicker, class TLocator>
+  class TPickLocator
+  {
+    TPicker* myPicker;
+    TLocator* myLocator;
+  public:
+    TPickLocator(TPicker* thePicker, TLocator* theLocator):
+      myPicker(thePicker),
+      myLocator(thePicker ? theLocator : NULL)
+    {
+      if(myLocator)
+        myPicker->AddLocator(myLocator);
+    }
+    ~TPickLocator()
+    {
+      if(myLocator)
+        myPicker->RemoveLocator(myLocator);
+    }
+  };
+
+  /*!
+    (Re)build the locator if the input or its modification time changed
+  */
+  template<class TLocator>
+  TLocator*
+  UpdateLocator(vtkSmartPointer<TLocator>& theLocator,
+                vtkMTimeType& theLocatorMTime,
+                vtkDataSet* theInput,
+                vtkIdType theNbItems)
+  {
+    if(!theInput || theNbItems < 1)
+      return NULL;
+
+    if(!theLocator)
+      theLocator = vtkSmartPointer<TLocator>::New();
+
+    if(theLocator->GetDataSet() != theInput || theLocatorMTime != theInput->GetMTime()){
+      theLocator->SetDataSet(theInput);
+      theLocator->BuildLocator();
+      theLocatorMTime = theInput->GetMTime();
+    }
+    return theLocator.GetPointer();
+  }
 }
 
 namespace SVTK
@@ -180,9 +232,13 @@ SALOME_Actor
   myHighlightActor(SVTK_Actor::New()),
   myOutlineActor(VTKViewer_Actor::New()),
   myOutline(vtkOutlineSource::New()),
+  myPointLocatorMTime(0),
+  myCellLocatorMTime(0),
   myIsDisplayNameActor(false),
   myNameActor(VTKViewer_FramedTextActor::New())
 {
+  myPickCache.myMTime = 0;
+
   myPreHighlightActor->Delete();
   myPreHighlightActor->Initialize();
   myPreHighlightActor->PickableOff();
@@ -267,6 +323,8 @@ SALOME_Actor
 ::setIO(const Handle(SALOME_InteractiveObject)& theIO) 
 { 
   myIO = theIO; 
+  // to let the renderers update their entry index
+  InvokeEvent(SVTK::IOChangedEvent, NULL);
 }
 
 /*!
@@ -449,7 +507,7 @@ SALOME_Actor
 
   if(mySelector.GetPointer()){
     if(mySelectionMode != ActorSelection){
-      SVTK_TIndexedMapOfVtkId aMapIndex;
+      SVTK_IdBitmap aMapIndex;
       mySelector->GetIndex( getIO(), aMapIndex );
       switch( mySelectionMode ) {
       case NodeSelection:
@@ -523,7 +581,6 @@ SALOME_Actor
 
   double x = theSelectionEvent->myX;
   double y = theSelectionEvent->myY;
-  double z = 0.0;
 
   if( !theIsHighlight ) {
     if ( hasIO() ) {
@@ -539,10 +596,7 @@ SALOME_Actor
     switch(aSelectionMode) {
     case NodeSelection: 
     {
-      SVTK::TPickLimiter aPickLimiter( myPointPicker, this );
-      myPointPicker->Pick( x, y, z, aRenderer );
-      
-      vtkIdType aVtkId = myPointPicker->GetPointId();
+      vtkIdType aVtkId = PickPoint( aRenderer, x, y );
       if( aVtkId >= 0 && mySelector->IsValid( this, aVtkId, true ) ) {
         vtkIdType anObjId = GetNodeObjId( aVtkId );
         myIsPreselected = (anObjId >= 0);
@@ -569,10 +623,8 @@ SALOME_Actor
     case Elem0DSelection:        
     case BallSelection: 
     {
-      SVTK::TPickLimiter aPickLimiter( myCellPicker, this );
-      myCellPicker->Pick( x, y, z, aRenderer );
-      
-      vtkIdType aVtkId = myCellPicker->GetCellId();
+      double aPickPosition[3];
+      vtkIdType aVtkId = PickCell( aRenderer, x, y, aPickPosition );
       if ( aVtkId >= 0 && mySelector->IsValid( this, aVtkId ) && hasIO() ) {
         vtkIdType anObjId = GetElemObjId (aVtkId );
         if ( anObjId >= 0 ) {
@@ -596,15 +648,13 @@ SALOME_Actor
     }
     case EdgeOfCellSelection:
     {
-      SVTK::TPickLimiter aPickLimiter( myCellPicker, this );
-      myCellPicker->Pick( x, y, z, aRenderer );
-      
-      vtkIdType aVtkId = myCellPicker->GetCellId();
+      double aPickPosition[3];
+      vtkIdType aVtkId = PickCell( aRenderer, x, y, aPickPosition );
       if ( aVtkId >= 0 && mySelector->IsValid( this, aVtkId )) {
         vtkIdType anObjId = GetElemObjId( aVtkId );
         if ( anObjId >= 0 ) {
           vtkIdType aFNId, aSNId;
-          int anEdgeId = GetEdgeAndNodesId(this,myCellPicker.GetPointer(),anObjId,aFNId,aSNId);
+          int anEdgeId = GetEdgeAndNodesId(this,aPickPosition,anObjId,aFNId,aSNId);
           myIsPreselected = anEdgeId < 0;
           if(myIsPreselected){
 	    vtkIdType aFNObjId = GetNodeObjId( aFNId );
@@ -709,7 +759,7 @@ SALOME_Actor
 
       const SVTK_AreaPicker::TVectorIdsMap& aVectorIdsMap = myPointAreaPicker->GetPointIdsMap();
       SVTK_AreaPicker::TVectorIdsMap::const_iterator aMapIter = aVectorIdsMap.find(this);
-      SVTK_TVtkIDsMap anIndexes;
+      SVTK_IdBitmap anIndexes;
       if(aMapIter != aVectorIdsMap.end()){
         const SVTK_AreaPicker::TVectorIds& aVectorIds = aMapIter->second;
         vtkIdType anEnd = (int)aVectorIds.size(); //!< TODO: conversion from size_t to int
@@ -785,7 +835,7 @@ SALOME_Actor
 
       const SVTK_AreaPicker::TVectorIdsMap& aVectorIdsMap = myCellAreaPicker->GetCellIdsMap();
       SVTK_AreaPicker::TVectorIdsMap::const_iterator aMapIter = aVectorIdsMap.find(this);
-      SVTK_TVtkIDsMap anIndexes;
+      SVTK_IdBitmap anIndexes;
       if(aMapIter != aVectorIdsMap.end()){
         const SVTK_AreaPicker::TVectorIds& aVectorIds = aMapIter->second;
         vtkIdType anEnd = (int)aVectorIds.size(); //!< TODO: conversion from size_t to int
@@ -835,7 +885,7 @@ SALOME_Actor
           vtkIdType anObjId = GetElemObjId( aCellId );
           if( anObjId != -1 ) {
             vtkIdType aFNId, aSNId;
-            int anEdgeId = GetEdgeAndNodesId(this,myCellPicker.GetPointer(),anObjId,aFNId,aSNId);
+            int anEdgeId = GetEdgeAndNodesId(this,myCellPicker->GetPickPosition(),anObjId,aFNId,aSNId);
             if( anEdgeId < 0 ) {
 	      SVTK_ListOfVtk aCompositeID;
               aCompositeID.push_back( GetNodeObjId( aFNId ) );
@@ -863,10 +913,7 @@ SALOME_Actor
   else {
     switch(aSelectionMode){
     case NodeSelection: {
-      SVTK::TPickLimiter aPickLimiter( myPointPicker, this );
-      myPointPicker->Pick( x, y, 0.0, aRenderer );
-
-      vtkIdType aVtkId = myPointPicker->GetPointId();
+      vtkIdType aVtkId = PickPoint( aRenderer, x, y );
       if( aVtkId >= 0 && mySelector->IsValid( this, aVtkId, true ) ) {
         vtkIdType anObjId = GetNodeObjId( aVtkId );
         if( hasIO() && anObjId >= 0 ) {
@@ -883,10 +930,8 @@ SALOME_Actor
     case Elem0DSelection:
     case BallSelection:
     {
-      SVTK::TPickLimiter aPickLimiter( myCellPicker, this );
-      myCellPicker->Pick( x, y, 0.0, aRenderer );
-
-      vtkIdType aVtkId = myCellPicker->GetCellId();
+      double aPickPosition[3];
+      vtkIdType aVtkId = PickCell( aRenderer, x, y, aPickPosition );
       if( aVtkId >= 0 && mySelector->IsValid( this, aVtkId ) ) {
         vtkIdType anObjId = GetElemObjId( aVtkId );
         if( anObjId >= 0 ) {
@@ -900,15 +945,13 @@ SALOME_Actor
     }
     case EdgeOfCellSelection:
     {
-      SVTK::TPickLimiter aPickLimiter( myCellPicker, this );
-      myCellPicker->Pick( x, y, 0.0, aRenderer );
-
-      vtkIdType aVtkId = myCellPicker->GetCellId();
+      double aPickPosition[3];
+      vtkIdType aVtkId = PickCell( aRenderer, x, y, aPickPosition );
       if( aVtkId >= 0 && mySelector->IsValid( this, aVtkId ) ) {
         vtkIdType anObjId = GetElemObjId( aVtkId );
         if( anObjId >= 0 ) {
           vtkIdType aFNId, aSNId;
-          int anEdgeId = GetEdgeAndNodesId(this,myCellPicker.GetPointer(),anObjId,aFNId,aSNId);
+          int anEdgeId = GetEdgeAndNodesId(this,aPickPosition,anObjId,aFNId,aSNId);
           if( hasIO() && anEdgeId < 0 ) {
 	    SVTK_ListOfVtk aCompositeID;
 	    aCompositeID.push_back( GetNodeObjId( aFNId ) );
@@ -1077,6 +1120,128 @@ SALOME_Actor
   myCellAreaPicker = theAreaPicker;
 }
 
+/*!
+  To get the point locator of the mapper input, used by the point picker
+*/
+vtkStaticPointLocator*
+SALOME_Actor
+::GetPointLocator()
+{
+  vtkDataSet* anInput = GetMapper() ? GetMapper()->GetInput() : NULL;
+  return UpdateLocator(myPointLocator, myPointLocatorMTime, anInput,
+                       anInput ? anInput->GetNumberOfPoints() : 0);
+}
+
+/*!
+  To get the cell locator of the mapper input, used by the cell picker
+*/
+vtkStaticCellLocator*
+SALOME_Actor
+::GetCellLocator()
+{
+  vtkDataSet* anInput = GetMapper() ? GetMapper()->GetInput() : NULL;
+  return UpdateLocator(myCellLocator, myCellLocatorMTime, anInput,
+                       anInput ? anInput->GetNumberOfCells() : 0);
+}
+
+/*!
+  To pick a point of the actor at the given display position.
+  The pick is done through the point locator, unless the same pixel
+  was already picked and neither the camera nor the actor changed since.
+*/
+vtkIdType
+SALOME_Actor
+::PickPoint(vtkRenderer* theRenderer, 
+            double theX, 
+            double theY)
+{
+  TPickCache aPick;
+  aPick.Init(false, theX, theY, myPointPicker->GetTolerance(), theRenderer, GetPickMTime(theRenderer));
+  if(!aPick.IsSame(myPickCache)){
+    SVTK::TPickLimiter aPickLimiter( myPointPicker, this );
+    TPickLocator<SVTK_PointPicker, vtkStaticPointLocator> 
+      aPickLocator( SVTK_PointPicker::SafeDownCast( myPointPicker ), GetPointLocator() );
+    myPointPicker->Pick( theX, theY, 0.0, theRenderer );
+
+    aPick.myId = myPointPicker->GetPointId();
+    myPointPicker->GetPickPosition( aPick.myPosition );
+    myPickCache = aPick;
+  }
+  return myPickCache.myId;
+}
+
+/*!
+  To pick a cell of the actor at the given display position (see PickPoint)
+*/
+vtkIdType
+SALOME_Actor
+::PickCell(vtkRenderer* theRenderer, 
+           double theX, 
+           double theY,
+           double thePickPosition[3])
+{
+  TPickCache aPick;
+  aPick.Init(true, theX, theY, myCellPicker->GetTolerance(), theRenderer, GetPickMTime(theRenderer));
+  if(!aPick.IsSame(myPickCache)){
+    SVTK::TPickLimiter aPickLimiter( myCellPicker, this );
+    TPickLocator<vtkCellPicker, vtkStaticCellLocator> 
+      aPickLocator( myCellPicker.GetPointer(), GetCellLocator() );
+    myCellPicker->Pick( theX, theY, 0.0, theRenderer );
+
+    aPick.myId = myCellPicker->GetCellId();
+    myCellPicker->GetPickPosition( aPick.myPosition );
+    myPickCache = aPick;
+  }
+  for(int i = 0; i < 3; i++)
+    thePickPosition[i] = myPickCache.myPosition[i];
+  return myPickCache.myId;
+}
+
+/*!
+  \return the latest modification time among those a pick depends on
+*/
+vtkMTimeType
+SALOME_Actor
+::GetPickMTime(vtkRenderer* theRenderer)
+{
+  // vtkActor::GetMTime() also accounts for the properties, changed by highlighting
+  vtkMTimeType aMTime = vtkProp3D::GetMTime();
+  if(vtkCamera* aCamera = theRenderer->GetActiveCamera())
+    aMTime = std::max(aMTime, aCamera->GetMTime());
+  if(vtkDataSet* anInput = GetMapper() ? GetMapper()->GetInput() : NULL)
+    aMTime = std::max(aMTime, anInput->GetMTime());
+  return aMTime;
+}
+
+void
+SALOME_Actor::TPickCache
+::Init(bool theIsCellPick, double theX, double theY, double theTolerance,
+       vtkRenderer* theRenderer, vtkMTimeType theMTime)
+{
+  myIsCellPick = theIsCellPick;
+  myX = theX;
+  myY = theY;
+  myTolerance = theTolerance;
+  int* aSize = theRenderer->GetSize();
+  mySize[0] = aSize[0];
+  mySize[1] = aSize[1];
+  myMTime = theMTime;
+  myId = -1;
+  myPosition[0] = myPosition[1] = myPosition[2] = 0.0;
+}
+
+bool
+SALOME_Actor::TPickCache
+::IsSame(const TPickCache& theOther) const
+{
+  // modification times being global, any change makes the latest one increase
+  return myMTime != 0 && myMTime == theOther.myMTime &&
+    myIsCellPick == theOther.myIsCellPick &&
+    myX == theOther.myX && myY == theOther.myY &&
+    myTolerance == theOther.myTolerance &&
+    mySize[0] == theOther.mySize[0] && mySize[1] == theOther.mySize[1];
+}
+
 /*!
   To find a gravity center of object
   \param theObjId - identification of object
@@ -46,6 +46,8 @@ class SALOME_InteractiveObject;
 class vtkAbstractPicker;
 class vtkPointPicker;
 class vtkCellPicker;
+class vtkStaticPointLocator;
+class vtkStaticCellLocator;
 class vtkOutlineSource;
 class vtkInteractorStyle;
 class vtkRenderWindowInteractor;
@@ -257,6 +259,14 @@ class SVTK_EXPORT SALOME_Actor : public VTKViewer_Actor
   void
   SetCellAreaPicker(SVTK_AreaPicker* theAreaPicker);
 
+  //! To get the point locator of the mapper input (built on demand, rebuilt when the input is modified)
+  vtkStaticPointLocator*
+  GetPointLocator();
+
+  //! To get the cell locator of the mapper input (built on demand, rebuilt when the input is modified)
+  vtkStaticCellLocator*
+  GetCellLocator();
+
   //----------------------------------------------------------------------------
   //! To find a gravity center of object
   double* GetGravityCenter( int );
@@ -280,6 +290,23 @@ class SVTK_EXPORT SALOME_Actor : public VTKViewer_Actor
   SALOME_Actor();
   ~SALOME_Actor();
 
+  //! To pick a point of the actor with the point picker, returns its VTK id
+  vtkIdType
+  PickPoint(vtkRenderer* theRenderer, 
+            double theX, 
+            double theY);
+
+  //! To pick a cell of the actor with the cell picker, returns its VTK id
+  vtkIdType
+  PickCell(vtkRenderer* theRenderer, 
+           double theX, 
+           double theY,
+           double thePickPosition[3]);
+
+  //! To get the latest modification time among those a pick depends on
+  vtkMTimeType
+  GetPickMTime(vtkRenderer* theRenderer);
+
  protected:
   Selection_Mode mySelectionMode;
   vtkSmartPointer<SVTK_Selector> mySelector;
@@ -292,6 +319,29 @@ class SVTK_EXPORT SALOME_Actor : public VTKViewer_Actor
   vtkSmartPointer<SVTK_AreaPicker> myPointAreaPicker;
   vtkSmartPointer<SVTK_AreaPicker> myCellAreaPicker;
 
+  vtkSmartPointer<vtkStaticPointLocator> myPointLocator;
+  vtkMTimeType myPointLocatorMTime;
+  vtkSmartPointer<vtkStaticCellLocator> myCellLocator;
+  vtkMTimeType myCellLocatorMTime;
+
+  //! Result of the last pick, reused while the same pixel is picked in an unchanged scene
+  struct TPickCache
+  {
+    void Init(bool theIsCellPick, double theX, double theY, double theTolerance,
+              vtkRenderer* theRenderer, vtkMTimeType theMTime);
+    bool IsSame(const TPickCache& theOther) const;
+
+    bool myIsCellPick;
+    double myX;
+    double myY;
+    double myTolerance;
+    int mySize[2];
+    vtkMTimeType myMTime;
+    vtkIdType myId;
+    double myPosition[3];
+  };
+  TPickCache myPickCache;
+
   vtkSmartPointer<SVTK_Actor> myPreHighlightActor;
   vtkSmartPointer<SVTK_Actor> myHighlightActor;
 
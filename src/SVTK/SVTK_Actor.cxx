@@ -51,6 +51,7 @@ vtkStandardNewMacro(SVTK_Actor)
 */
 SVTK_Actor
 ::SVTK_Actor():
+  myIsMapIndexValid(true),
   myUnstructuredGrid(vtkUnstructuredGrid::New())
 {
   myIsShaded = true;
@@ -96,10 +97,88 @@ SVTK_Actor
 {
 }
 
+namespace
+{
+  //! Gives the ids of an indexed map with the same interface as SVTK_IdBitmap::Iterator
+  class TMapIndexIterator
+  {
+    const SVTK_TIndexedMapOfVtkId& myMapIndex;
+    int myIndex;
+  public:
+    TMapIndexIterator(const SVTK_TIndexedMapOfVtkId& theMapIndex):
+      myMapIndex(theMapIndex),
+      myIndex(1)
+    {}
+
+    bool More() const { return myIndex <= myMapIndex.Extent(); }
+    void Next() { myIndex++; }
+    vtkIdType Value() const { return myMapIndex(myIndex); }
+  };
+
+  template<class TIterator>
+  void
+  InsertCells(SALOME_Actor* theMapActor,
+              vtkUnstructuredGrid* theGrid,
+              TIterator theIter)
+  {
+    for(; theIter.More(); theIter.Next()){
+      vtkIdType aPartId = theIter.Value();
+      if(vtkCell* aCell = theMapActor->GetElemCell(aPartId))
+        {
+#if VTK_XVERSION > 50700
+        if (aCell->GetCellType() != VTK_POLYHEDRON)
+#endif
+          theGrid->InsertNextCell(aCell->GetCellType(),aCell->GetPointIds());
+#if VTK_XVERSION > 50700
+        else
+          {
+            vtkPolyhedron *polyhedron = dynamic_cast<vtkPolyhedron*>(aCell);
+            if (!polyhedron)
+              throw SALOME_Exception(LOCALIZED ("not a polyhedron"));
+            vtkIdType *pts = polyhedron->GetFaces();
+            theGrid->InsertNextCell(aCell->GetCellType(),pts[0], pts+1);
+          }
+#endif
+        }
+    }
+  }
+
+  template<class TIterator>
+  void
+  InsertPoints(SALOME_Actor* theMapActor,
+               vtkUnstructuredGrid* theGrid,
+               vtkIdType theNbOfParts,
+               TIterator theIter)
+  {
+    if(theNbOfParts == 0)
+      return;
+    vtkPoints *aPoints = vtkPoints::New();
+    aPoints->SetNumberOfPoints(theNbOfParts);
+    for(vtkIdType i = 0; theIter.More(); theIter.Next(), i++){
+      vtkIdType aPartId = theIter.Value();
+      if(double* aCoord = theMapActor->GetNodeCoord(aPartId)){
+        aPoints->SetPoint(i,aCoord);
+        // Change the type from int to vtkIdType in order to avoid compilation errors while using VTK
+        // from ParaView-3.4.0 compiled on 64-bit Debian platform with VTK_USE_64BIT_IDS = ON
+        theGrid->InsertNextCell(VTK_VERTEX,(vtkIdType) 1,&i);
+      }
+    }
+    theGrid->SetPoints(aPoints);
+    aPoints->Delete();
+  }
+}
+
+/*!
+  The map is built on demand when the actor has been mapped from a bitmap
+*/
 const SVTK_TIndexedMapOfVtkId&
 SVTK_Actor
 ::GetMapIndex() const
 {
+  if(!myIsMapIndexValid){
+    myMapIds.ToMap(myMapIndex);
+    myIsMapIndexValid = true;
+  }
   return myMapIndex;
 }
 
@@ -111,6 +190,24 @@ SVTK_Actor
   return myMapCompositeIndex;
 }
 
+void
+SVTK_Actor
+::SetMapIndex(const SVTK_TIndexedMapOfVtkId& theMapIndex)
+{
+  myMapIndex = theMapIndex;
+  myMapIds.Clear();
+  myIsMapIndexValid = true;
+}
+
+void
+SVTK_Actor
+::SetMapIndex(const SVTK_IdBitmap& theMapIndex)
+{
+  myMapIds = theMapIndex;
+  myMapIndex.Clear();
+  myIsMapIndexValid = false;
+}
+
 void
 SVTK_Actor
 ::MapCells(SALOME_Actor* theMapActor,
@@ -122,35 +219,37 @@ SVTK_Actor
   vtkUnstructuredGrid * aSourceGrid = (vtkUnstructuredGrid *)theMapActor->GetInput();
   GetSource()->SetPoints( aSourceGrid->GetPoints() );
 
-  int aNbOfParts = theMapIndex.Extent();
-  for(int ind = 1; ind <= aNbOfParts; ind++){
-    int aPartId = theMapIndex( ind );
-    if(vtkCell* aCell = theMapActor->GetElemCell(aPartId))
-      {
-#if VTK_XVERSION > 50700
-      if (aCell->GetCellType() != VTK_POLYHEDRON)
-#endif
-        myUnstructuredGrid->InsertNextCell(aCell->GetCellType(),aCell->GetPointIds());
-#if VTK_XVERSION > 50700
-      else
-        {
-          vtkPolyhedron *polyhedron = dynamic_cast<vtkPolyhedron*>(aCell);
-          if (!polyhedron)
-            throw SALOME_Exception(LOCALIZED ("not a polyhedron"));
-          vtkIdType *pts = polyhedron->GetFaces();
-          myUnstructuredGrid->InsertNextCell(aCell->GetCellType(),pts[0], pts+1);
-        }
-#endif
-      }
+  InsertCells(theMapActor, myUnstructuredGrid, TMapIndexIterator(theMapIndex));
+
+  UnShrink();
+  if(theMapActor->IsShrunk()){
+    SetShrinkFactor(theMapActor->GetShrinkFactor());
+    SetShrink();
   }
 
+  SetMapIndex(theMapIndex);
+}
+
+void
+SVTK_Actor
+::MapCells(SALOME_Actor* theMapActor,
+           const SVTK_IdBitmap& theMapIndex)
+{
+  myUnstructuredGrid->Initialize();
+  myUnstructuredGrid->Allocate(theMapIndex.Extent());
+
+  vtkUnstructuredGrid * aSourceGrid = (vtkUnstructuredGrid *)theMapActor->GetInput();
+  GetSource()->SetPoints( aSourceGrid->GetPoints() );
+
+  InsertCells(theMapActor, myUnstructuredGrid, SVTK_IdBitmap::Iterator(theMapIndex));
+
   UnShrink();
   if(theMapActor->IsShrunk()){
     SetShrinkFactor(theMapActor->GetShrinkFactor());
     SetShrink();
   }
 
-  myMapIndex = theMapIndex;
+  SetMapIndex(theMapIndex);
 }
 
 void 
@@ -161,25 +260,26 @@ SVTK_Actor
   myUnstructuredGrid->Initialize();
   myUnstructuredGrid->Allocate();
 
-  if(int aNbOfParts = theMapIndex.Extent()){
-    vtkPoints *aPoints = vtkPoints::New();
-    aPoints->SetNumberOfPoints(aNbOfParts);
-    for(vtkIdType i = 0; i < aNbOfParts; i++){
-	  vtkIdType aPartId = theMapIndex( i+1 );
-      if(double* aCoord = theMapActor->GetNodeCoord(aPartId)){
-        aPoints->SetPoint(i,aCoord);
-        // Change the type from int to vtkIdType in order to avoid compilation errors while using VTK
-        // from ParaView-3.4.0 compiled on 64-bit Debian platform with VTK_USE_64BIT_IDS = ON
-        myUnstructuredGrid->InsertNextCell(VTK_VERTEX,(vtkIdType) 1,&i);
-      }
-    }
-    myUnstructuredGrid->SetPoints(aPoints);
-    aPoints->Delete();
-  }
+  InsertPoints(theMapActor, myUnstructuredGrid, theMapIndex.Extent(), TMapIndexIterator(theMapIndex));
 
   UnShrink();
 
-  myMapIndex = theMapIndex;
+  SetMapIndex(theMapIndex);
+}
+
+void 
+SVTK_Actor
+::MapPoints(SALOME_Actor* theMapActor,
+            const SVTK_IdBitmap& theMapIndex)
+{
+  myUnstructuredGrid->Initialize();
+  myUnstructuredGrid->Allocate(theMapIndex.Extent());
+
+  InsertPoints(theMapActor, myUnstructuredGrid, theMapIndex.Extent(), SVTK_IdBitmap::Iterator(theMapIndex));
+
+  UnShrink();
+
+  SetMapIndex(theMapIndex);
 }
 
 void
@@ -218,7 +318,7 @@ SVTK_Actor
     SetShrink();
   }
 
-  myMapIndex = theMapIndex;
+  SetMapIndex(theMapIndex);
 }
 
 void
@@ -34,6 +34,7 @@ class vtkUnstructuredGrid;
 #include "SVTK.h"
 #include "SVTK_DeviceActor.h"
 #include "SVTK_Hash.h"
+#include "SVTK_IdBitmap.h"
 #include <vtkSmartPointer.h>
 
 class SALOME_Actor;
@@ -74,11 +75,21 @@ public:
   MapCells(SALOME_Actor* theMapActor, 
            const SVTK_TIndexedMapOfVtkId& theMapIndex);
 
+  //! Allow to recostruct selected cells from source SALOME_Actor and bitmap of subindexes
+  virtual void
+  MapCells(SALOME_Actor* theMapActor, 
+           const SVTK_IdBitmap& theMapIndex);
+
   //! Allow to recostruct selected points from source SALOME_Actor and map of subindexes
   virtual void 
   MapPoints(SALOME_Actor* theMapActor, 
             const SVTK_TIndexedMapOfVtkId& theMapIndex);
 
+  //! Allow to recostruct selected points from source SALOME_Actor and bitmap of subindexes
+  virtual void 
+  MapPoints(SALOME_Actor* theMapActor, 
+            const SVTK_IdBitmap& theMapIndex);
+
   //! Allow to recostruct selected edges from source SALOME_Actor and map of subindexes
   virtual void 
   MapEdge(SALOME_Actor* theMapActor, 
@@ -97,7 +108,15 @@ public:
   GetMapCompositeIndex() const;
 
  protected:
-  SVTK_TIndexedMapOfVtkId        myMapIndex;
+  void
+  SetMapIndex(const SVTK_TIndexedMapOfVtkId& theMapIndex);
+
+  void
+  SetMapIndex(const SVTK_IdBitmap& theMapIndex);
+
+  mutable SVTK_TIndexedMapOfVtkId myMapIndex;
+  SVTK_IdBitmap                  myMapIds; //!< mapped subindexes, when they are given as a bitmap
+  mutable bool                   myIsMapIndexValid;
   SVTK_IndexedMapOfVtkIds        myMapCompositeIndex;
 
   vtkSmartPointer<vtkUnstructuredGrid> myUnstructuredGrid;
@@ -27,7 +27,9 @@
 //
 #include "SVTK_AreaPicker.h"
 
-#include <set>
+#include <algorithm>
+#include <cmath>
+#include <limits>
 
 #include <vtkObjectFactory.h>
 #include <vtkCommand.h>
@@ -44,13 +46,19 @@
 #include <vtkRenderer.h>
 #include <vtkPoints.h>
 #include <vtkCamera.h>
-#include <vtkCell.h>
+#include <vtkIdList.h>
+#include <vtkPointSet.h>
+#include <vtkFloatArray.h>
+#include <vtkDoubleArray.h>
+#include <vtkSMPTools.h>
+#include <vtkSMPThreadLocalObject.h>
+#include <vtkNew.h>
 
 namespace
 {
   //----------------------------------------------------------------------------
   inline
-  double GetZ( float* theZPtr, int theSelection[4], int theDX, int theDY )
+  double GetZ( const float* theZPtr, const int theSelection[4], int theDX, int theDY )
   {
     return theZPtr[theDX - theSelection[0]
         + ( theDY - theSelection[1] )
@@ -59,7 +67,7 @@ namespace
 
   //----------------------------------------------------------------------------
   inline
-  int Check( float* theZPtr, int theSelection[4], double theTolerance,
+  int Check( const float* theZPtr, const int theSelection[4], double theTolerance,
       double theDZ, int theDX, int theDY )
   {
     int aRet = 0;
@@ -86,6 +94,233 @@ namespace
     theCenter[2] = ( theBounds[5] + theBounds[4] ) / 2.0;
   }
 
+  //----------------------------------------------------------------------------
+  /*!
+    Probes the z-buffer at the given display position, then on squares of
+    growing radius around it, until a depth matching theDZ is found
+  */
+  int CheckNeighbourhood( const float* theZPtr, const int theSelection[4], double theTolerance,
+      double theDZ, int theDX, int theDY )
+  {
+    int aRet = Check( theZPtr, theSelection, theTolerance, theDZ, theDX, theDY );
+
+    static const int aMaxRadius = 5;
+    for ( int aRadius = 1; aRadius < aMaxRadius && aRet == 0; aRadius++ ) {
+      int aStartDX[2] = { theDX - aRadius, theDY - aRadius };
+      for ( int i = 0; i <= aRadius && aRet == 0; i++ )
+        aRet = Check( theZPtr, theSelection, theTolerance, theDZ,
+            aStartDX[0]++, aStartDX[1] );
+      for ( int i = 0; i <= aRadius && aRet == 0; i++ )
+        aRet = Check( theZPtr, theSelection, theTolerance, theDZ,
+            aStartDX[0], aStartDX[1]++ );
+      for ( int i = 0; i <= aRadius && aRet == 0; i++ )
+        aRet = Check( theZPtr, theSelection, theTolerance, theDZ,
+            aStartDX[0]--, aStartDX[1] );
+      for ( int i = 0; i <= aRadius && aRet == 0; i++ )
+        aRet = Check( theZPtr, theSelection, theTolerance, theDZ,
+            aStartDX[0], aStartDX[1]-- );
+    }
+    return aRet;
+  }
+
+  //----------------------------------------------------------------------------
+  //! Number of points projected at once, the projection loop being vectorizable
+  const vtkIdType PROJECTION_BLOCK_SIZE = 256;
+
+  //! Minimal number of points or cells processed by a thread
+  const vtkIdType SMP_GRAIN_SIZE = 10000;
+
+  //! State of a point regarding the selection
+  enum EPointState { ePointOutside = 0, ePointVisible, ePointInvisible };
+
+  typedef std::vector< unsigned char > TPointsState;
+
+  //----------------------------------------------------------------------------
+  /*!
+    World to display transformation, computed once for all the points.
+    vtkRenderer provides WorldToView() and ViewToDisplay() methods, but they
+    recompute the composite perspective transform on each call and store the
+    result in the renderer, which also prevents from using them in several threads.
+  */
+  struct TProjection
+  {
+    double myMatrix[4][4];
+    double myDisplayOrigin[2];
+    double myDisplayScale[2];
+
+    TProjection( vtkRenderer* theRenderer )
+    {
+      vtkMatrix4x4* aMatrix =
+        theRenderer->GetActiveCamera()->GetCompositeProjectionTransformMatrix(
+          theRenderer->GetTiledAspectRatio(), 0, 1 );
+      for ( int i = 0; i < 4; i++ )
+        for ( int j = 0; j < 4; j++ )
+          myMatrix[i][j] = aMatrix->GetElement( i, j );
+
+      // View to display transformation is affine along x and y, and keeps z
+      double aDisplay0[3], aDisplay1[3];
+      theRenderer->SetViewPoint( 0.0, 0.0, 0.0 );
+      theRenderer->ViewToDisplay();
+      theRenderer->GetDisplayPoint( aDisplay0 );
+      theRenderer->SetViewPoint( 1.0, 1.0, 0.0 );
+      theRenderer->ViewToDisplay();
+      theRenderer->GetDisplayPoint( aDisplay1 );
+      for ( int i = 0; i < 2; i++ ) {
+        myDisplayOrigin[i] = aDisplay0[i];
+        myDisplayScale[i] = aDisplay1[i] - aDisplay0[i];
+      }
+    }
+
+    //! Projects theNbPts points to display; points which can not be projected get NaN coordinates
+    template< class TCoord >
+    void Project( const TCoord* theCoords, vtkIdType theNbPts, double* theDisplay ) const
+    {
+      const double (&m)[4][4] = myMatrix;
+      for ( vtkIdType i = 0; i < theNbPts; i++ ) {
+        const double aX = theCoords[3*i];
+        const double aY = theCoords[3*i + 1];
+        const double aZ = theCoords[3*i + 2];
+        const double aW = m[3][0] * aX + m[3][1] * aY + m[3][2] * aZ + m[3][3];
+        const double anInvW = aW != 0.0 ? 1.0 / aW : std::numeric_limits< double >::quiet_NaN();
+        theDisplay[3*i] = myDisplayOrigin[0] + myDisplayScale[0] * anInvW
+          * ( m[0][0] * aX + m[0][1] * aY + m[0][2] * aZ + m[0][3] );
+        theDisplay[3*i + 1] = myDisplayOrigin[1] + myDisplayScale[1] * anInvW
+          * ( m[1][0] * aX + m[1][1] * aY + m[1][2] * aZ + m[1][3] );
+        theDisplay[3*i + 2] = anInvW * ( m[2][0] * aX + m[2][1] * aY + m[2][2] * aZ + m[2][3] );
+      }
+    }
+  };
+
+  //----------------------------------------------------------------------------
+  //! Thread safe access to the points, reading the coordinates array directly when possible
+  struct TPointsAccessor
+  {
+    vtkDataSet* myInput;
+    const float* myFloatCoords;
+    const double* myDoubleCoords;
+
+    TPointsAccessor( vtkDataSet* theInput ):
+      myInput( theInput ),
+      myFloatCoords( 0 ),
+      myDoubleCoords( 0 )
+    {
+      if ( vtkPointSet* aPointSet = vtkPointSet::SafeDownCast( theInput ) ) {
+        if ( vtkPoints* aPoints = aPointSet->GetPoints() ) {
+          if ( vtkFloatArray* anArray = vtkFloatArray::SafeDownCast( aPoints->GetData() ) )
+            myFloatCoords = anArray->GetPointer( 0 );
+          else if ( vtkDoubleArray* anArray = vtkDoubleArray::SafeDownCast( aPoints->GetData() ) )
+            myDoubleCoords = anArray->GetPointer( 0 );
+        }
+      }
+      // vtkDataSet::GetPoint() is thread safe once called from a single thread
+      if ( theInput->GetNumberOfPoints() > 0 ) {
+        double aX[3];
+        theInput->GetPoint( 0, aX );
+      }
+    }
+
+    void GetPoint( vtkIdType theId, double theX[3] ) const
+    {
+      if ( myFloatCoords ) {
+        for ( int i = 0; i < 3; i++ )
+          theX[i] = myFloatCoords[3*theId + i];
+      }
+      else if ( myDoubleCoords ) {
+        for ( int i = 0; i < 3; i++ )
+          theX[i] = myDoubleCoords[3*theId + i];
+      }
+      else
+        myInput->GetPoint( theId, theX );
+    }
+
+    //! Projects theNbPts points starting from theFirst; theBuffer is used if coordinates have to be copied
+    void Project( const TProjection& theProjection, vtkIdType theFirst, vtkIdType theNbPts,
+                  double* theBuffer, double* theDisplay ) const
+    {
+      if ( myFloatCoords )
+        theProjection.Project( myFloatCoords + 3*theFirst, theNbPts, theDisplay );
+      else if ( myDoubleCoords )
+        theProjection.Project( myDoubleCoords + 3*theFirst, theNbPts, theDisplay );
+      else {
+        for ( vtkIdType i = 0; i < theNbPts; i++ )
+          myInput->GetPoint( theFirst + i, theBuffer + 3*i );
+        theProjection.Project( theBuffer, theNbPts, theDisplay );
+      }
+    }
+  };
+
+  //----------------------------------------------------------------------------
+  //! Selection area and z-buffer captured in the selection window
+  struct TSelection
+  {
+    const int* myBox;
+    const QVector< QPoint >& myPolygon;
+    SVTK_AreaPicker::SelectionMode myMode;
+    const float* myZPtr;
+    double myTolerance;
+
+    bool IsInSelection( const double theDisplay[3] ) const
+    {
+      if ( std::isnan( theDisplay[0] ) )
+        return false;
+      if ( myMode == SVTK_AreaPicker::RectangleMode )
+        return theDisplay[0] >= myBox[0] && theDisplay[0] <= myBox[2]
+          && theDisplay[1] >= myBox[1] && theDisplay[1] <= myBox[3];
+      if ( myMode == SVTK_AreaPicker::PolygonMode )
+        return SVTK_AreaPicker::isPointInPolygon( QPoint( (int)theDisplay[0], (int)theDisplay[1] ),
+                                                  myPolygon );
+      return false;
+    }
+
+    unsigned char Classify( const double theDisplay[3] ) const
+    {
+      if ( !IsInSelection( theDisplay ) )
+        return ePointOutside;
+      // check whether visible in selection window
+      int aRet = CheckNeighbourhood( myZPtr, myBox, myTolerance, theDisplay[2],
+          int( theDisplay[0] ), int( theDisplay[1] ) );
+      if ( aRet > 0 )
+        return ePointVisible;
+      if ( aRet < 0 )
+        return ePointInvisible;
+      return ePointOutside;
+    }
+  };
+
+  //----------------------------------------------------------------------------
+  //! Computes the state of a range of points, by blocks of PROJECTION_BLOCK_SIZE
+  struct TPointsClassifier
+  {
+    const TPointsAccessor& myPoints;
+    const TProjection& myProjection;
+    const TSelection& mySelection;
+    TPointsState& myState;
+
+    void operator()( vtkIdType theFirst, vtkIdType theLast ) const
+    {
+      double aCoords[3 * PROJECTION_BLOCK_SIZE];
+      double aDisplay[3 * PROJECTION_BLOCK_SIZE];
+      for ( vtkIdType aBlock = theFirst; aBlock < theLast; aBlock += PROJECTION_BLOCK_SIZE ) {
+        vtkIdType aNbPts = std::min( PROJECTION_BLOCK_SIZE, theLast - aBlock );
+        myPoints.Project( myProjection, aBlock, aNbPts, aCoords, aDisplay );
+        for ( vtkIdType i = 0; i < aNbPts; i++ )
+          myState[ aBlock + i ] = mySelection.Classify( aDisplay + 3*i );
+      }
+    }
+  };
+
+  //----------------------------------------------------------------------------
+  void ComputePointsState( vtkIdType theNbPts,
+                           const TPointsAccessor& thePoints,
+                           const TProjection& theProjection,
+                           const TSelection& theSelection,
+                           TPointsState& theState )
+  {
+    theState.assign( theNbPts, ePointOutside );
+    TPointsClassifier aClassifier = { thePoints, theProjection, theSelection, theState };
+    vtkSMPTools::For( 0, theNbPts, SMP_GRAIN_SIZE, aClassifier );
+  }
+
   //----------------------------------------------------------------------------
   /* Unused
   void CalculatePickPosition( vtkRenderer *theRenderer, double theSelectionX,
@@ -233,91 +468,28 @@ void SVTK_AreaPicker::SelectVisiblePoints( QVector< QPoint >& thePoints,
   vtkIdType aNumPts = theInput->GetNumberOfPoints();
   if ( aNumPts < 1 ) return;
 
-  theVisibleIds.reserve( aNumPts / 2 + 1 );
-  theInVisibleIds.reserve( aNumPts / 2 + 1 );
-
-  // Grab the composite perspective transform.  This matrix is used to convert
-  // each point to view coordinates.  vtkRenderer provides a WorldToView()
-  // method but it computes the composite perspective transform each time
-  // WorldToView() is called.  This is expensive, so we get the matrix once
-  // and handle the transformation ourselves.
-  vtkMatrix4x4 *aMatrix = vtkMatrix4x4::New();
-  aMatrix->DeepCopy(
-      theRenderer->GetActiveCamera()->GetCompositeProjectionTransformMatrix(
-          theRenderer->GetTiledAspectRatio(), 0, 1 ) );
-
   // We grab the z-buffer for the selection region all at once and probe the resulting array.
   float *aZPtr = theRenderer->GetRenderWindow()->GetZbufferData( mySelection[0],
       mySelection[1], mySelection[2], mySelection[3] );
+  if ( !aZPtr ) return;
 
-  for ( vtkIdType aPntId = 0; aPntId < aNumPts; aPntId++ ) {
-    // perform conversion
-    double aX[4] = { 1.0, 1.0, 1.0, 1.0 };
-    theInput->GetPoint( aPntId, aX );
-
-    double aView[4];
-    aMatrix->MultiplyPoint( aX, aView );
-    if ( aView[3] == 0.0 ) continue;
-    theRenderer->SetViewPoint( aView[0] / aView[3], aView[1] / aView[3],
-        aView[2] / aView[3] );
-    theRenderer->ViewToDisplay();
-
-    double aDX[3];
-    theRenderer->GetDisplayPoint( aDX );
-
-    bool isInSelection = false;
-    if ( theMode == RectangleMode ) isInSelection = aDX[0] >= mySelection[0]
-        && aDX[0] <= mySelection[2] && aDX[1] >= mySelection[1]
-        && aDX[1] <= mySelection[3];
-    else
-      if ( theMode == PolygonMode ) isInSelection =
-	isPointInPolygon( QPoint( (int)aDX[0], (int)aDX[1] ), thePoints );
-
-    // check whether visible and in selection window
-    if ( isInSelection ) {
-      int aDX0 = int( aDX[0] );
-      int aDX1 = int( aDX[1] );
-
-      int aRet = Check( aZPtr, mySelection, theTolerance, aDX[2], aDX0, aDX1 );
-      if ( aRet > 0 ) goto ADD_VISIBLE;
-      if ( aRet < 0 ) goto ADD_INVISIBLE;
-
-      static int aMaxRadius = 5;
-      for ( int aRadius = 1; aRadius < aMaxRadius; aRadius++ ) {
-        int aStartDX[2] = { aDX0 - aRadius, aDX1 - aRadius };
-        for ( int i = 0; i <= aRadius; i++ ) {
-          int aRet = Check( aZPtr, mySelection, theTolerance, aDX[2],
-              aStartDX[0]++, aStartDX[1] );
-          if ( aRet > 0 ) goto ADD_VISIBLE;
-          if ( aRet < 0 ) goto ADD_INVISIBLE;
-        }
-        for ( int i = 0; i <= aRadius; i++ ) {
-          int aRet = Check( aZPtr, mySelection, theTolerance, aDX[2],
-              aStartDX[0], aStartDX[1]++ );
-          if ( aRet > 0 ) goto ADD_VISIBLE;
-          if ( aRet < 0 ) goto ADD_INVISIBLE;
-        }
-        for ( int i = 0; i <= aRadius; i++ ) {
-          int aRet = Check( aZPtr, mySelection, theTolerance, aDX[2],
-              aStartDX[0]--, aStartDX[1] );
-          if ( aRet > 0 ) goto ADD_VISIBLE;
-          if ( aRet < 0 ) goto ADD_INVISIBLE;
-        }
-        for ( int i = 0; i <= aRadius; i++ ) {
-          int aRet = Check( aZPtr, mySelection, theTolerance, aDX[2],
-              aStartDX[0], aStartDX[1]-- );
-          if ( aRet > 0 ) goto ADD_VISIBLE;
-          if ( aRet < 0 ) goto ADD_INVISIBLE;
-        }
-      }
-      if ( false ) ADD_VISIBLE:theVisibleIds.push_back( aPntId );
-      if ( false ) ADD_INVISIBLE:theInVisibleIds.push_back( aPntId );
-    }
-  }  //for all points
+  TProjection aProjection( theRenderer );
+  TPointsAccessor aPoints( theInput );
+  TSelection aSelection = { mySelection, thePoints, theMode, aZPtr, theTolerance };
 
-  aMatrix->Delete();
+  TPointsState aState;
+  ComputePointsState( aNumPts, aPoints, aProjection, aSelection, aState );
 
-  if ( aZPtr ) delete[] aZPtr;
+  delete[] aZPtr;
+
+  theVisibleIds.reserve( std::count( aState.begin(), aState.end(), (unsigned char)ePointVisible ) );
+  theInVisibleIds.reserve( std::count( aState.begin(), aState.end(), (unsigned char)ePointInvisible ) );
+  for ( vtkIdType aPntId = 0; aPntId < aNumPts; aPntId++ ) {
+    if ( aState[ aPntId ] == ePointVisible )
+      theVisibleIds.push_back( aPntId );
+    else if ( aState[ aPntId ] == ePointInvisible )
+      theInVisibleIds.push_back( aPntId );
+  }
 }
 
 void SVTK_AreaPicker::SelectVisibleCells( QVector< QPoint >& thePoints,
@@ -330,68 +502,68 @@ void SVTK_AreaPicker::SelectVisibleCells( QVector< QPoint >& thePoints,
   vtkIdType aNumCells = theInput->GetNumberOfCells();
   if ( aNumCells < 1 ) return;
 
-  theVectorIds.reserve( aNumCells / 2 + 1 );
-
-  SVTK_AreaPicker::TVectorIds aVisiblePntIds;
-  SVTK_AreaPicker::TVectorIds anInVisiblePntIds;
-  SelectVisiblePoints( thePoints, theRenderer, theInput, aVisiblePntIds,
-      anInVisiblePntIds, theTolerance, theMode );
-
-  typedef std::set< vtkIdType > TIdsSet;
-  TIdsSet aVisibleIds( aVisiblePntIds.begin(), aVisiblePntIds.end() );
-  TIdsSet anInVisibleIds( anInVisiblePntIds.begin(), anInVisiblePntIds.end() );
-
-  // Grab the composite perspective transform.  This matrix is used to convert
-  // each point to view coordinates.  vtkRenderer provides a WorldToView()
-  // method but it computes the composite perspective transform each time
-  // WorldToView() is called.  This is expensive, so we get the matrix once
-  // and handle the transformation ourselves.
-  vtkMatrix4x4 *aMatrix = vtkMatrix4x4::New();
-  aMatrix->DeepCopy(
-      theRenderer->GetActiveCamera()->GetCompositeProjectionTransformMatrix(
-          theRenderer->GetTiledAspectRatio(), 0, 1 ) );
-
-  for ( vtkIdType aCellId = 0; aCellId < aNumCells; aCellId++ ) {
-    vtkCell* aCell = theInput->GetCell( aCellId );
-
-    double aBounds[6];
-    aCell->GetBounds( aBounds );
-
-    double aCenter[3];
-    GetCenter( aBounds, aCenter );
-
-    double aView[4];
-    double aX[4] = { aCenter[0], aCenter[1], aCenter[2], 1.0 };
-    aMatrix->MultiplyPoint( aX, aView );
-
-    if ( aView[3] == 0.0 ) continue;
-
-    theRenderer->SetViewPoint( aView[0] / aView[3], aView[1] / aView[3],
-        aView[2] / aView[3] );
-    theRenderer->ViewToDisplay();
-
-    double aDX[3];
-    theRenderer->GetDisplayPoint( aDX );
-
-    bool isInSelection = false;
-    if ( theMode == RectangleMode ) isInSelection = aDX[0] >= mySelection[0]
-        && aDX[0] <= mySelection[2] && aDX[1] >= mySelection[1]
-        && aDX[1] <= mySelection[3];
-    else
-      if ( theMode == PolygonMode ) isInSelection =
-	isPointInPolygon( QPoint( (int)aDX[0], (int)aDX[1] ), thePoints );
-    // check whether visible and in selection window
-    if ( isInSelection ) {
-      vtkIdType aNumPts = aCell->GetNumberOfPoints();
-      bool anIsVisible = true;
-      for ( vtkIdType anId = 0; anId < aNumPts; anId++ ) {
-        vtkIdType aPntId = aCell->GetPointId( anId );
-        anIsVisible = aVisibleIds.find( aPntId ) != aVisibleIds.end();
-        if ( !anIsVisible ) break;
+  vtkIdType aNumPts = theInput->GetNumberOfPoints();
+  if ( aNumPts < 1 ) return;
+
+  float *aZPtr = theRenderer->GetRenderWindow()->GetZbufferData( mySelection[0],
+      mySelection[1], mySelection[2], mySelection[3] );
+  if ( !aZPtr ) return;
+
+  TProjection aProjection( theRenderer );
+  TPointsAccessor aPoints( theInput );
+  TSelection aSelection = { mySelection, thePoints, theMode, aZPtr, theTolerance };
+
+  TPointsState aPointsState;
+  ComputePointsState( aNumPts, aPoints, aProjection, aSelection, aPointsState );
+
+  delete[] aZPtr;
+
+  // vtkDataSet::GetCellPoints() is thread safe once called from a single thread
+  {
+    vtkNew< vtkIdList > aPointIds;
+    theInput->GetCellPoints( 0, aPointIds.GetPointer() );
+  }
+
+  // A cell is selected if all its points are visible and the center of its
+  // bounding box is inside the selection; point ids are read from the
+  // connectivity, no vtkCell being built
+  std::vector< unsigned char > aCellsState( aNumCells, 0 );
+  vtkSMPThreadLocalObject< vtkIdList > aThreadPointIds;
+  vtkSMPTools::For( 0, aNumCells, SMP_GRAIN_SIZE, [&]( vtkIdType theFirst, vtkIdType theLast )
+  {
+    vtkIdList* aPointIds = aThreadPointIds.Local();
+    for ( vtkIdType aCellId = theFirst; aCellId < theLast; aCellId++ ) {
+      theInput->GetCellPoints( aCellId, aPointIds );
+      vtkIdType aNbCellPts = aPointIds->GetNumberOfIds();
+      bool anIsVisible = aNbCellPts > 0;
+      for ( vtkIdType i = 0; i < aNbCellPts && anIsVisible; i++ )
+        anIsVisible = aPointsState[ aPointIds->GetId( i ) ] == ePointVisible;
+      if ( !anIsVisible )
+        continue;
+
+      double aBounds[6];
+      for ( vtkIdType i = 0; i < aNbCellPts; i++ ) {
+        double aX[3];
+        aPoints.GetPoint( aPointIds->GetId( i ), aX );
+        for ( int j = 0; j < 3; j++ ) {
+          if ( i == 0 || aX[j] < aBounds[2*j] ) aBounds[2*j] = aX[j];
+          if ( i == 0 || aX[j] > aBounds[2*j + 1] ) aBounds[2*j + 1] = aX[j];
+        }
       }
-      if ( anIsVisible ) theVectorIds.push_back( aCellId );
+
+      double aCenter[3];
+      GetCenter( aBounds, aCenter );
+
+      double aDX[3];
+      aProjection.Project( aCenter, 1, aDX );
+      aCellsState[ aCellId ] = aSelection.IsInSelection( aDX );
     }
-  }  //for all parts
+  });
+
+  theVectorIds.reserve( std::count( aCellsState.begin(), aCellsState.end(), 1 ) );
+  for ( vtkIdType aCellId = 0; aCellId < aNumCells; aCellId++ )
+    if ( aCellsState[ aCellId ] )
+      theVectorIds.push_back( aCellId );
 }
 
 bool SVTK_AreaPicker::isPointInPolygon( const QPoint& thePoint, const QVector<QPoint>& thePolygon )
@@ -72,6 +72,8 @@ SVTK_DeviceActor
   myFeatureEdges = vtkFeatureEdges::New();
 
   myGeomFilter = VTKViewer_GeometryFilter::New();
+  // switching the representation must not compute the boundary of the mesh again
+  myGeomFilter->SetTopologyCaching(true);
 
   myTransformFilter = VTKViewer_TransformFilter::New();
 
@@ -79,6 +79,8 @@ namespace SVTK
     OperationFinished, // rnv: invoked when SpinXY, RotateXY, DollyXY or PanXY operation is finished.
 
     StopCurrentOperation,
+
+    IOChangedEvent, // invoked by SALOME_Actor when its SALOME_InteractiveObject is changed
     LastEvent
   };
 }
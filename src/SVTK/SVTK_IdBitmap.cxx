@@ -0,0 +1,582 @@
+// Copyright (C) 2007-2026  CEA, EDF, OPEN CASCADE
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+//
+// See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+//
+
+#include "SVTK_IdBitmap.h"
+
+#include <algorithm>
+#include <bitset>
+#include <iterator>
+#include <utility>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace
+{
+  //----------------------------------------------------------------------------
+  const vtkIdType CHUNK_SIZE = 65536;
+  const size_t NB_WORDS = CHUNK_SIZE / 64;
+  //! A chunk becomes a bitmap above this count (the array would be bigger than the bitmap)
+  const int ARRAY_MAX_COUNT = 4096;
+  //! A bitmap becomes an array again below this count (not at once, to avoid round trips)
+  const int BITMAP_MIN_COUNT = ARRAY_MAX_COUNT / 2;
+
+  inline
+  vtkIdType
+  GetKey(vtkIdType theId)
+  {
+    // rounded down, so the negative ids are kept ordered too
+    return theId >= 0 ? theId / CHUNK_SIZE : -((-theId - 1) / CHUNK_SIZE) - 1;
+  }
+
+  inline
+  unsigned short
+  GetPosition(vtkIdType theId, vtkIdType theKey)
+  {
+    return (unsigned short)(theId - theKey * CHUNK_SIZE);
+  }
+
+  inline
+  vtkIdType
+  GetId(vtkIdType theKey, size_t thePosition)
+  {
+    return theKey * CHUNK_SIZE + vtkIdType(thePosition);
+  }
+
+  inline
+  int
+  CountBits(unsigned long long theWord)
+  {
+    return (int)std::bitset<64>(theWord).count();
+  }
+
+  inline
+  int
+  CountBits(const std::vector<unsigned long long>& theBits)
+  {
+    int aCount = 0;
+    for(size_t i = 0; i < theBits.size(); i++)
+      aCount += CountBits(theBits[i]);
+    return aCount;
+  }
+
+  inline
+  size_t
+  TrailingZeros(unsigned long long theWord)
+  {
+#if defined(__GNUC__)
+    return (size_t)__builtin_ctzll(theWord);
+#elif defined(_MSC_VER) && defined(_WIN64)
+    unsigned long anIndex;
+    _BitScanForward64(&anIndex, theWord);
+    return (size_t)anIndex;
+#else
+    size_t aNb = 0;
+    for(; !(theWord & 1); theWord >>= 1)
+      aNb++;
+    return aNb;
+#endif
+  }
+
+  inline
+  bool
+  TestBit(const std::vector<unsigned long long>& theBits, unsigned short thePos)
+  {
+    return (theBits[thePos >> 6] & (1ull << (thePos & 63))) != 0;
+  }
+
+  struct TKeyLess
+  {
+    template<class TChunk>
+    bool
+    operator()(const TChunk& theChunk, vtkIdType theKey) const
+    {
+      return theChunk.myKey < theKey;
+    }
+  };
+}
+
+
+//----------------------------------------------------------------------------
+bool
+SVTK_IdBitmap::TChunk
+::Add(unsigned short thePos)
+{
+  if(IsBitmap()){
+    unsigned long long& aWord = myBits[thePos >> 6];
+    unsigned long long aBit = 1ull << (thePos & 63);
+    if(aWord & aBit)
+      return false;
+    aWord |= aBit;
+  }else{
+    std::vector<unsigned short>::iterator anIter =
+      std::lower_bound(myArray.begin(), myArray.end(), thePos);
+    if(anIter != myArray.end() && *anIter == thePos)
+      return false;
+    myArray.insert(anIter, thePos);
+  }
+  myCount++;
+  Optimize();
+  return true;
+}
+
+bool
+SVTK_IdBitmap::TChunk
+::Remove(unsigned short thePos)
+{
+  if(IsBitmap()){
+    unsigned long long& aWord = myBits[thePos >> 6];
+    unsigned long long aBit = 1ull << (thePos & 63);
+    if(!(aWord & aBit))
+      return false;
+    aWord &= ~aBit;
+  }else{
+    std::vector<unsigned short>::iterator anIter =
+      std::lower_bound(myArray.begin(), myArray.end(), thePos);
+    if(anIter == myArray.end() || *anIter != thePos)
+      return false;
+    myArray.erase(anIter);
+  }
+  myCount--;
+  Optimize();
+  return true;
+}
+
+bool
+SVTK_IdBitmap::TChunk
+::Contains(unsigned short thePos) const
+{
+  if(IsBitmap())
+    return TestBit(myBits, thePos);
+  return std::binary_search(myArray.begin(), myArray.end(), thePos);
+}
+
+void
+SVTK_IdBitmap::TChunk
+::Union(const TChunk& theOther)
+{
+  if(theOther.IsBitmap()){
+    if(!IsBitmap()){
+      std::vector<unsigned long long> aBits(theOther.myBits);
+      for(size_t i = 0; i < myArray.size(); i++)
+        aBits[myArray[i] >> 6] |= 1ull << (myArray[i] & 63);
+      myBits.swap(aBits);
+      std::vector<unsigned short>().swap(myArray);
+    }else{
+      for(size_t i = 0; i < NB_WORDS; i++)
+        myBits[i] |= theOther.myBits[i];
+    }
+    myCount = CountBits(myBits);
+  }else if(IsBitmap()){
+    for(size_t i = 0; i < theOther.myArray.size(); i++){
+      unsigned short aPos = theOther.myArray[i];
+      unsigned long long& aWord = myBits[aPos >> 6];
+      unsigned long long aBit = 1ull << (aPos & 63);
+      if(!(aWord & aBit)){
+        aWord |= aBit;
+        myCount++;
+      }
+    }
+  }else{
+    std::vector<unsigned short> anArray;
+    anArray.reserve(myArray.size() + theOther.myArray.size());
+    std::set_union(myArray.begin(), myArray.end(),
+                   theOther.myArray.begin(), theOther.myArray.end(),
+                   std::back_inserter(anArray));
+    myArray.swap(anArray);
+    myCount = (int)myArray.size();
+  }
+  Optimize();
+}
+
+void
+SVTK_IdBitmap::TChunk
+::Subtract(const TChunk& theOther)
+{
+  if(IsBitmap()){
+    if(theOther.IsBitmap()){
+      for(size_t i = 0; i < NB_WORDS; i++)
+        myBits[i] &= ~theOther.myBits[i];
+    }else{
+      for(size_t i = 0; i < theOther.myArray.size(); i++){
+        unsigned short aPos = theOther.myArray[i];
+        myBits[aPos >> 6] &= ~(1ull << (aPos & 63));
+      }
+    }
+    myCount = CountBits(myBits);
+  }else{
+    std::vector<unsigned short>::iterator anEnd = myArray.begin();
+    for(size_t i = 0; i < myArray.size(); i++)
+      if(!theOther.Contains(myArray[i]))
+        *anEnd++ = myArray[i];
+    myArray.erase(anEnd, myArray.end());
+    myCount = (int)myArray.size();
+  }
+  Optimize();
+}
+
+void
+SVTK_IdBitmap::TChunk
+::Intersect(const TChunk& theOther)
+{
+  if(IsBitmap() && theOther.IsBitmap()){
+    for(size_t i = 0; i < NB_WORDS; i++)
+      myBits[i] &= theOther.myBits[i];
+    myCount = CountBits(myBits);
+  }else if(IsBitmap()){
+    // the result is not bigger than the array of the other chunk
+    std::vector<unsigned short> anArray;
+    anArray.reserve(theOther.myArray.size());
+    for(size_t i = 0; i < theOther.myArray.size(); i++)
+      if(TestBit(myBits, theOther.myArray[i]))
+        anArray.push_back(theOther.myArray[i]);
+    myArray.swap(anArray);
+    std::vector<unsigned long long>().swap(myBits);
+    myCount = (int)myArray.size();
+  }else{
+    std::vector<unsigned short>::iterator anEnd = myArray.begin();
+    for(size_t i = 0; i < myArray.size(); i++)
+      if(theOther.Contains(myArray[i]))
+        *anEnd++ = myArray[i];
+    myArray.erase(anEnd, myArray.end());
+    myCount = (int)myArray.size();
+  }
+  Optimize();
+}
+
+bool
+SVTK_IdBitmap::TChunk
+::IsEqual(const TChunk& theOther) const
+{
+  if(myCount != theOther.myCount)
+    return false;
+  if(IsBitmap() == theOther.IsBitmap())
+    return IsBitmap() ? myBits == theOther.myBits : myArray == theOther.myArray;
+  // same count, so it is enough to check the positions of the array
+  const TChunk& anArrayChunk = IsBitmap() ? theOther : *this;
+  const TChunk& aBitmapChunk = IsBitmap() ? *this : theOther;
+  for(size_t i = 0; i < anArrayChunk.myArray.size(); i++)
+    if(!TestBit(aBitmapChunk.myBits, anArrayChunk.myArray[i]))
+      return false;
+  return true;
+}
+
+void
+SVTK_IdBitmap::TChunk
+::Optimize()
+{
+  if(!IsBitmap()){
+    if(myCount > ARRAY_MAX_COUNT){
+      myBits.assign(NB_WORDS, 0);
+      for(size_t i = 0; i < myArray.size(); i++)
+        myBits[myArray[i] >> 6] |= 1ull << (myArray[i] & 63);
+      std::vector<unsigned short>().swap(myArray);
+    }
+  }else if(myCount < BITMAP_MIN_COUNT){
+    myArray.reserve(myCount);
+    for(size_t i = 0; i < NB_WORDS; i++)
+      for(unsigned long long aWord = myBits[i]; aWord; aWord &= aWord - 1)
+        myArray.push_back((unsigned short)(64*i + TrailingZeros(aWord)));
+    std::vector<unsigned long long>().swap(myBits);
+  }
+}
+
+
+//----------------------------------------------------------------------------
+SVTK_IdBitmap
+::SVTK_IdBitmap():
+  myExtent(0)
+{}
+
+SVTK_IdBitmap::TChunks::iterator
+SVTK_IdBitmap
+::FindChunk(vtkIdType theKey)
+{
+  TChunks::iterator anIter = std::lower_bound(myChunks.begin(), myChunks.end(), theKey, TKeyLess());
+  if(anIter != myChunks.end() && anIter->myKey == theKey)
+    return anIter;
+  return myChunks.end();
+}
+
+SVTK_IdBitmap::TChunks::const_iterator
+SVTK_IdBitmap
+::FindChunk(vtkIdType theKey) const
+{
+  TChunks::const_iterator anIter = std::lower_bound(myChunks.begin(), myChunks.end(), theKey, TKeyLess());
+  if(anIter != myChunks.end() && anIter->myKey == theKey)
+    return anIter;
+  return myChunks.end();
+}
+
+bool
+SVTK_IdBitmap
+::Add(vtkIdType theId)
+{
+  vtkIdType aKey = GetKey(theId);
+  TChunks::iterator anIter = std::lower_bound(myChunks.begin(), myChunks.end(), aKey, TKeyLess());
+  if(anIter == myChunks.end() || anIter->myKey != aKey)
+    anIter = myChunks.insert(anIter, TChunk(aKey));
+  if(!anIter->Add(GetPosition(theId, aKey)))
+    return false;
+  myExtent++;
+  return true;
+}
+
+bool
+SVTK_IdBitmap
+::Remove(vtkIdType theId)
+{
+  vtkIdType aKey = GetKey(theId);
+  TChunks::iterator anIter = FindChunk(aKey);
+  if(anIter == myChunks.end() || !anIter->Remove(GetPosition(theId, aKey)))
+    return false;
+  if(anIter->myCount == 0)
+    myChunks.erase(anIter);
+  myExtent--;
+  return true;
+}
+
+bool
+SVTK_IdBitmap
+::Contains(vtkIdType theId) const
+{
+  vtkIdType aKey = GetKey(theId);
+  TChunks::const_iterator anIter = FindChunk(aKey);
+  return anIter != myChunks.end() && anIter->Contains(GetPosition(theId, aKey));
+}
+
+void
+SVTK_IdBitmap
+::Clear()
+{
+  TChunks().swap(myChunks);
+  myExtent = 0;
+}
+
+void
+SVTK_IdBitmap
+::Union(const SVTK_IdBitmap& theOther)
+{
+  if(&theOther == this || theOther.IsEmpty())
+    return;
+  if(IsEmpty()){
+    *this = theOther;
+    return;
+  }
+
+  TChunks aChunks;
+  aChunks.reserve(myChunks.size() + theOther.myChunks.size());
+  TChunks::iterator anIter = myChunks.begin();
+  TChunks::const_iterator anOther = theOther.myChunks.begin();
+  while(anIter != myChunks.end() || anOther != theOther.myChunks.end()){
+    if(anOther == theOther.myChunks.end() ||
+       (anIter != myChunks.end() && anIter->myKey < anOther->myKey)){
+      aChunks.push_back(std::move(*anIter++));
+    }else if(anIter == myChunks.end() || anOther->myKey < anIter->myKey){
+      aChunks.push_back(*anOther++);
+    }else{
+      anIter->Union(*anOther++);
+      aChunks.push_back(std::move(*anIter++));
+    }
+  }
+  myChunks.swap(aChunks);
+
+  myExtent = 0;
+  for(size_t i = 0; i < myChunks.size(); i++)
+    myExtent += myChunks[i].myCount;
+}
+
+void
+SVTK_IdBitmap
+::Subtract(const SVTK_IdBitmap& theOther)
+{
+  if(&theOther == this){
+    Clear();
+    return;
+  }
+
+  TChunks::iterator anEnd = myChunks.begin();
+  TChunks::const_iterator anOther = theOther.myChunks.begin();
+  myExtent = 0;
+  for(TChunks::iterator anIter = myChunks.begin(); anIter != myChunks.end(); anIter++){
+    while(anOther != theOther.myChunks.end() && anOther->myKey < anIter->myKey)
+      anOther++;
+    if(anOther != theOther.myChunks.end() && anOther->myKey == anIter->myKey)
+      anIter->Subtract(*anOther);
+    if(anIter->myCount == 0)
+      continue;
+    myExtent += anIter->myCount;
+    if(anEnd != anIter)
+      *anEnd = std::move(*anIter);
+    anEnd++;
+  }
+  myChunks.erase(anEnd, myChunks.end());
+}
+
+void
+SVTK_IdBitmap
+::Intersect(const SVTK_IdBitmap& theOther)
+{
+  if(&theOther == this)
+    return;
+
+  TChunks::iterator anEnd = myChunks.begin();
+  TChunks::const_iterator anOther = theOther.myChunks.begin();
+  myExtent = 0;
+  for(TChunks::iterator anIter = myChunks.begin(); anIter != myChunks.end(); anIter++){
+    while(anOther != theOther.myChunks.end() && anOther->myKey < anIter->myKey)
+      anOther++;
+    if(anOther == theOther.myChunks.end() || anOther->myKey != anIter->myKey)
+      continue;
+    anIter->Intersect(*anOther);
+    if(anIter->myCount == 0)
+      continue;
+    myExtent += anIter->myCount;
+    if(anEnd != anIter)
+      *anEnd = std::move(*anIter);
+    anEnd++;
+  }
+  myChunks.erase(anEnd, myChunks.end());
+}
+
+bool
+SVTK_IdBitmap
+::IsEqual(const SVTK_IdBitmap& theOther) const
+{
+  if(myExtent != theOther.myExtent || myChunks.size() != theOther.myChunks.size())
+    return false;
+  for(size_t i = 0; i < myChunks.size(); i++)
+    if(myChunks[i].myKey != theOther.myChunks[i].myKey ||
+       !myChunks[i].IsEqual(theOther.myChunks[i]))
+      return false;
+  return true;
+}
+
+/*!
+  Sorts the ids to build the chunks one after the other, rather than
+  looking for the chunk of each id, then merges them into the set
+*/
+void
+SVTK_IdBitmap
+::UnionSorted(std::vector<vtkIdType>& theIds)
+{
+  std::sort(theIds.begin(), theIds.end());
+
+  SVTK_IdBitmap aBitmap;
+  for(size_t i = 0; i < theIds.size(); i++){
+    vtkIdType aKey = GetKey(theIds[i]);
+    if(aBitmap.myChunks.empty() || aBitmap.myChunks.back().myKey != aKey)
+      aBitmap.myChunks.push_back(TChunk(aKey));
+    if(aBitmap.myChunks.back().Add(GetPosition(theIds[i], aKey)))
+      aBitmap.myExtent++;
+  }
+
+  if(IsEmpty()){
+    myChunks.swap(aBitmap.myChunks);
+    myExtent = aBitmap.myExtent;
+  }else
+    Union(aBitmap);
+}
+
+void
+SVTK_IdBitmap
+::Union(const SVTK_TIndexedMapOfVtkId& theMap)
+{
+  std::vector<vtkIdType> anIds;
+  anIds.reserve(theMap.Extent());
+  for(int i = 1, iEnd = theMap.Extent(); i <= iEnd; i++)
+    anIds.push_back(theMap(i));
+  UnionSorted(anIds);
+}
+
+void
+SVTK_IdBitmap
+::Union(const SVTK_TVtkIDsMap& theMap)
+{
+  std::vector<vtkIdType> anIds;
+  anIds.reserve(theMap.Extent());
+  for(SVTK_TVtkIDsMapIterator anIter(theMap); anIter.More(); anIter.Next())
+    anIds.push_back(anIter.Key());
+  UnionSorted(anIds);
+}
+
+void
+SVTK_IdBitmap
+::ToMap(SVTK_TIndexedMapOfVtkId& theMap) const
+{
+  theMap.Clear();
+  if(IsEmpty())
+    return;
+  theMap.ReSize((int)myExtent);
+  for(Iterator anIter(*this); anIter.More(); anIter.Next())
+    theMap.Add(anIter.Value());
+}
+
+
+//----------------------------------------------------------------------------
+SVTK_IdBitmap::Iterator
+::Iterator(const SVTK_IdBitmap& theBitmap):
+  myChunk(theBitmap.myChunks.begin()),
+  myEnd(theBitmap.myChunks.end()),
+  myPosition(0),
+  myWord(0),
+  myValue(0)
+{
+  Init();
+}
+
+/*!
+  Goes to the first id of the current chunk (the chunks are never empty)
+*/
+void
+SVTK_IdBitmap::Iterator
+::Init()
+{
+  if(!More())
+    return;
+  myPosition = 0;
+  if(myChunk->IsBitmap()){
+    myWord = myChunk->myBits[0];
+    while(!myWord)
+      myWord = myChunk->myBits[++myPosition];
+    myValue = GetId(myChunk->myKey, 64*myPosition + TrailingZeros(myWord));
+  }else
+    myValue = GetId(myChunk->myKey, myChunk->myArray[0]);
+}
+
+void
+SVTK_IdBitmap::Iterator
+::Next()
+{
+  if(myChunk->IsBitmap()){
+    myWord &= myWord - 1;
+    while(!myWord && ++myPosition < NB_WORDS)
+      myWord = myChunk->myBits[myPosition];
+    if(myWord){
+      myValue = GetId(myChunk->myKey, 64*myPosition + TrailingZeros(myWord));
+      return;
+    }
+  }else if(++myPosition < myChunk->myArray.size()){
+    myValue = GetId(myChunk->myKey, myChunk->myArray[myPosition]);
+    return;
+  }
+  myChunk++;
+  Init();
+}
@@ -0,0 +1,179 @@
+// Copyright (C) 2007-2026  CEA, EDF, OPEN CASCADE
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+//
+// See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+//
+
+#ifndef SVTK_IDBITMAP_H
+#define SVTK_IDBITMAP_H
+
+#include "SVTK.h"
+#include "SVTK_Hash.h"
+
+#include <cstddef>
+#include <vector>
+
+#ifdef WIN32
+#pragma warning ( disable:4251 )
+#endif
+
+//! Compressed set of ids, used to store big subselections
+/*!
+  The ids are split into chunks of 65536 consecutive values (the high bits of the id
+  give the chunk, the low 16 bits the position in it). A chunk is stored as a sorted
+  array of positions while it is sparse and as a plain bitmap of 8 Kb once it holds
+  more than 4096 ids, so that a set of millions of ids costs about one bit per id
+  in the worst case. Union, difference and intersection are done chunk by chunk,
+  without rehashing the ids. The ids are always iterated in ascending order.
+*/
+class SVTK_EXPORT SVTK_IdBitmap
+{
+ public:
+  SVTK_IdBitmap();
+
+  //! Adds the id, returns false if it was already there
+  bool
+  Add(vtkIdType theId);
+
+  //! Removes the id, returns false if it was not there
+  bool
+  Remove(vtkIdType theId);
+
+  bool
+  Contains(vtkIdType theId) const;
+
+  void
+  Clear();
+
+  bool
+  IsEmpty() const { return myExtent == 0; }
+
+  //! Number of ids in the set
+  vtkIdType
+  Extent() const { return myExtent; }
+
+  //! Adds the ids of the other set
+  void
+  Union(const SVTK_IdBitmap& theOther);
+
+  //! Adds the ids of the map
+  void
+  Union(const SVTK_TIndexedMapOfVtkId& theMap);
+
+  //! Adds the ids of the map
+  void
+  Union(const SVTK_TVtkIDsMap& theMap);
+
+  //! Removes the ids of the other set
+  void
+  Subtract(const SVTK_IdBitmap& theOther);
+
+  //! Keeps only the ids present in the other set
+  void
+  Intersect(const SVTK_IdBitmap& theOther);
+
+  bool
+  IsEqual(const SVTK_IdBitmap& theOther) const;
+
+  //! Fills the map with the ids, in ascending order
+  void
+  ToMap(SVTK_TIndexedMapOfVtkId& theMap) const;
+
+ private:
+  struct TChunk
+  {
+    vtkIdType myKey;                     //!< high bits of the ids
+    int myCount;                         //!< number of ids in the chunk
+    std::vector<unsigned short> myArray; //!< sorted positions, while the chunk is sparse
+    std::vector<unsigned long long> myBits; //!< bitmap of positions, once the chunk is dense
+
+    TChunk(vtkIdType theKey = 0): myKey(theKey), myCount(0) {}
+
+    bool
+    IsBitmap() const { return !myBits.empty(); }
+
+    bool
+    Add(unsigned short thePos);
+
+    bool
+    Remove(unsigned short thePos);
+
+    bool
+    Contains(unsigned short thePos) const;
+
+    void
+    Union(const TChunk& theOther);
+
+    void
+    Subtract(const TChunk& theOther);
+
+    void
+    Intersect(const TChunk& theOther);
+
+    bool
+    IsEqual(const TChunk& theOther) const;
+
+    //! Switches between the array and the bitmap storages according to the count
+    void
+    Optimize();
+  };
+  typedef std::vector<TChunk> TChunks;
+
+  TChunks myChunks; //!< sorted by key
+  vtkIdType myExtent;
+
+  TChunks::iterator
+  FindChunk(vtkIdType theKey);
+
+  TChunks::const_iterator
+  FindChunk(vtkIdType theKey) const;
+
+  void
+  UnionSorted(std::vector<vtkIdType>& theIds);
+
+ public:
+  //! Iterates the ids in ascending order, in the same way as OCCT iterators
+  class SVTK_EXPORT Iterator
+  {
+   public:
+    Iterator(const SVTK_IdBitmap& theBitmap);
+
+    bool
+    More() const { return myChunk != myEnd; }
+
+    void
+    Next();
+
+    vtkIdType
+    Value() const { return myValue; }
+
+   private:
+    TChunks::const_iterator myChunk;
+    TChunks::const_iterator myEnd;
+    size_t myPosition;   //!< index in the array or in the bitmap words
+    unsigned long long myWord; //!< remaining bits of the current bitmap word
+    vtkIdType myValue;
+
+    void
+    Init();
+  };
+};
+
+#ifdef WIN32
+#pragma warning ( default:4251 )
+#endif
+
+#endif
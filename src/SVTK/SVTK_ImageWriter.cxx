@@ -18,12 +18,10 @@
 //
 
 #include "SVTK_ImageWriter.h"
+#include "SVTK_ImageWriterMgr.h"
 
 #include "utilities.h"
 
-#include <QSemaphore>
-
-#include <vtkAlgorithm.h>
 #include <vtkImageData.h>
 #include <vtkImageClip.h>
 #include <vtkJPEGWriter.h>
@@ -33,19 +31,8 @@
 
 //----------------------------------------------------------------------------
 SVTK_ImageWriter
-::SVTK_ImageWriter(QSemaphore* theSemaphore,
-                   vtkAlgorithm* theAlgorithm,
-                   vtkImageData* theImageData,
-                   const std::string& theName,
-                   int theProgressive,
-                   int theQuality):
-  mySemaphore(theSemaphore),
-  myAlgorithm(theAlgorithm),
-  myImageData(theImageData),
-  myName(theName),
-  myProgressive(theProgressive),
-  myQuality(theQuality),
-  myConstraint16Flag(true)
+::SVTK_ImageWriter(SVTK_ImageWriterMgr* theManager):
+  myManager(theManager)
 {}
 
 //----------------------------------------------------------------------------
@@ -62,48 +49,44 @@ void
 SVTK_ImageWriter
 ::run()
 {
-  vtkJPEGWriter *aWriter = vtkJPEGWriter::New();
-  vtkAlgorithmOutput *anImageData = 0;
-  vtkSmartPointer<vtkImageClip> anImageClip;
-  //
-  if(myConstraint16Flag){ 
-    int uExtent[6];
-    myAlgorithm->UpdateInformation();
-    myAlgorithm->GetUpdateExtent(uExtent);
-    unsigned int width = uExtent[1] - uExtent[0] + 1;
-    unsigned int height = uExtent[3] - uExtent[2] + 1;
-    width = (width / 16) * 16;
-    height= (height / 16) * 16;
-    uExtent[1] = uExtent[0] + width - 1;
-    uExtent[3] = uExtent[2] + height - 1;
-    //
-    anImageClip = vtkImageClip::New();
-    anImageClip->Delete();
+  SVTK_ImageWriterMgr::TFrame aFrame;
+  while(myManager->Pop(aFrame))
+    myManager->Write(aFrame);
+
+  if(SALOME::VerbosityActivated())
+    std::cout << "SVTK_ImageWriter::run - finished; this = " << this << endl;
+}
+
 
-    anImageClip->SetInputData(myImageData);
-    anImageClip->SetOutputWholeExtent(uExtent);
-    anImageClip->ClipDataOn();
-    anImageData = anImageClip->GetOutputPort();
-  }
+//----------------------------------------------------------------------------
+void
+SVTK_ImageWriter
+::WriteJPEG(vtkImageData* theImageData,
+            const std::string& theName,
+            int theProgressive,
+            int theQuality)
+{
+  // The extent is taken from the copied image, the recording filter
+  // may be already updated for the next frame
+  int uExtent[6];
+  theImageData->GetExtent(uExtent);
+  unsigned int width = uExtent[1] - uExtent[0] + 1;
+  unsigned int height = uExtent[3] - uExtent[2] + 1;
+  width = (width / 16) * 16;
+  height= (height / 16) * 16;
+  uExtent[1] = uExtent[0] + width - 1;
+  uExtent[3] = uExtent[2] + height - 1;
   //
+  vtkSmartPointer<vtkImageClip> anImageClip = vtkSmartPointer<vtkImageClip>::New();
+  anImageClip->SetInputData(theImageData);
+  anImageClip->SetOutputWholeExtent(uExtent);
+  anImageClip->ClipDataOn();
+  //
+  vtkSmartPointer<vtkJPEGWriter> aWriter = vtkSmartPointer<vtkJPEGWriter>::New();
   aWriter->WriteToMemoryOff();
-  aWriter->SetFileName(myName.c_str());
-  aWriter->SetQuality(myQuality);
-  aWriter->SetProgressive(myProgressive);
-  if(myConstraint16Flag)
-    aWriter->SetInputConnection(anImageData);
-  else
-    aWriter->SetInputData(myImageData);
+  aWriter->SetFileName(theName.c_str());
+  aWriter->SetQuality(theQuality);
+  aWriter->SetProgressive(theProgressive);
+  aWriter->SetInputConnection(anImageClip->GetOutputPort());
   aWriter->Write();
-
-  aWriter->Delete();
-  myImageData->Delete();
-
-  if(SALOME::VerbosityActivated())
-    std::cout << "SVTK_ImageWriter::run - this = " << this <<
-    //"; total = "<<mySemaphore->total()<<
-    "; available = " << mySemaphore->available() << endl;
-    
-  mySemaphore->release();
 }
-
@@ -23,35 +23,35 @@
 #include <QThread>
 #include <string>
 
-class vtkAlgorithm;
 class vtkImageData;
-class QSemaphore;
+class SVTK_ImageWriterMgr;
 
+/*!
+  Worker of SVTK_ImageWriterMgr: takes the recorded frames from the queue
+  of the manager and writes them until the manager is stopped.
+*/
 class SVTK_ImageWriter : public QThread 
 {
 public:
-  SVTK_ImageWriter(QSemaphore* theSemaphore,
-                   vtkAlgorithm* theAlgorithm,
-                   vtkImageData* theImageData,
-                   const std::string& theName,
-                   int theProgressive,
-                   int theQuality);
+  SVTK_ImageWriter(SVTK_ImageWriterMgr* theManager);
 
   ~SVTK_ImageWriter();
 
+  //! Writes the image as a JPEG file, cropped to a multiple of 16 pixels
+  static
+  void
+  WriteJPEG(vtkImageData* theImageData,
+            const std::string& theName,
+            int theProgressive,
+            int theQuality);
+
  protected:
   virtual
   void
   run();
   
  protected:
-  QSemaphore* mySemaphore;
-  vtkAlgorithm *myAlgorithm;
-  vtkImageData *myImageData;
-  std::string myName;
-  int   myProgressive;
-  int   myQuality;
-  bool  myConstraint16Flag;
+  SVTK_ImageWriterMgr* myManager;
 };
 
 #endif
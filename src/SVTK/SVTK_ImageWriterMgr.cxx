@@ -19,26 +19,29 @@
 
 #include "SVTK_ImageWriterMgr.h"
 #include "SVTK_ImageWriter.h"
+#include "SVTK_VideoWriter.h"
 
 #include "utilities.h"
 
-#include <vtkAlgorithm.h>
 #include <vtkImageData.h>
 
-#include <QSemaphore>
+#include <QMutexLocker>
+#include <QThread>
 
+#include <algorithm>
 #include <iostream>
-#include <limits>
 
 //----------------------------------------------------------------------------
 SVTK_ImageWriterMgr
-::SVTK_ImageWriterMgr()
+::SVTK_ImageWriterMgr():
+  myNbThreads(std::max(1, std::min(QThread::idealThreadCount(), 4))),
+  myQueueSize(2*myNbThreads),
+  myIsStopping(false),
+  myVideoWriter(NULL)
 {
-  int aMax = std::numeric_limits<int>::max() / 2;
-  mySemaphore = new QSemaphore(aMax);
-  mySemaphore->acquire( aMax );
   if(SALOME::VerbosityActivated())
-    std::cout << "SVTK_ImageWriterMgr::SVTK_ImageWriterMgr; available = " << mySemaphore->available() << endl;
+    std::cout << "SVTK_ImageWriterMgr::SVTK_ImageWriterMgr; myNbThreads = " << myNbThreads <<
+    "; myQueueSize = " << myQueueSize << endl;
 }
 
 
@@ -47,30 +50,111 @@ SVTK_ImageWriterMgr
 ::~SVTK_ImageWriterMgr()
 {
   Stop();
-  delete mySemaphore;
 }
 
 
 //----------------------------------------------------------------------------
 void
 SVTK_ImageWriterMgr
-::StartImageWriter(vtkAlgorithm *theAlgorithm,
-                   vtkImageData *theImageData,
+::SetLimits(int theNbThreads,
+            int theQueueSize)
+{
+  Stop();
+  myNbThreads = std::max(1, theNbThreads);
+  myQueueSize = std::max(1, theQueueSize);
+}
+
+
+//----------------------------------------------------------------------------
+void
+SVTK_ImageWriterMgr
+::SetVideoWriter(SVTK_VideoWriter* theVideoWriter)
+{
+  Stop();
+  myVideoWriter = theVideoWriter;
+}
+
+
+//----------------------------------------------------------------------------
+void
+SVTK_ImageWriterMgr
+::StartImageWriter(vtkImageData *theImageData,
                    const std::string& theName,
                    const int theProgressive,
                    const int theQuality)
 {
-  SVTK_ImageWriter *anImageWriter = 
-    new SVTK_ImageWriter(mySemaphore,
-                         theAlgorithm,
-                         theImageData,
-                         theName,
-                         theProgressive,
-                         theQuality);
-  myThreads.push_back(anImageWriter);
+  TFrame aFrame = { theImageData, theName, theProgressive, theQuality, 0 };
+  Push(aFrame);
+}
+
+
+//----------------------------------------------------------------------------
+void
+SVTK_ImageWriterMgr
+::StartVideoWriter(vtkImageData *theImageData,
+                   const int theNbRepeats)
+{
+  TFrame aFrame = { theImageData, std::string(), 0, 0, theNbRepeats };
+  Push(aFrame);
+}
+
 
-  anImageWriter->start();
+//----------------------------------------------------------------------------
+void
+SVTK_ImageWriterMgr
+::Push(const TFrame& theFrame)
+{
+  // The writers are started with the first frame; the video is written by
+  // only one thread to keep the order of the frames
+  if(myThreads.empty()){
+    int aNbThreads = myVideoWriter ? 1 : myNbThreads;
+    for(int anId = 0; anId < aNbThreads; anId++){
+      SVTK_ImageWriter* anImageWriter = new SVTK_ImageWriter(this);
+      myThreads.push_back(anImageWriter);
+      anImageWriter->start();
+    }
+  }
 
+  QMutexLocker aLocker(&myMutex);
+  while((int)myFrames.size() >= myQueueSize)
+    myNotFull.wait(&myMutex);
+  myFrames.push_back(theFrame);
+  myNotEmpty.wakeOne();
+}
+
+
+//----------------------------------------------------------------------------
+bool
+SVTK_ImageWriterMgr
+::Pop(TFrame& theFrame)
+{
+  QMutexLocker aLocker(&myMutex);
+  while(myFrames.empty() && !myIsStopping)
+    myNotEmpty.wait(&myMutex);
+  if(myFrames.empty())
+    return false;
+
+  theFrame = myFrames.front();
+  myFrames.pop_front();
+  myNotFull.wakeOne();
+  return true;
+}
+
+
+//----------------------------------------------------------------------------
+void
+SVTK_ImageWriterMgr
+::Write(TFrame& theFrame)
+{
+  if(myVideoWriter)
+    myVideoWriter->Write(theFrame.myImageData, theFrame.myNbRepeats);
+  else
+    SVTK_ImageWriter::WriteJPEG(theFrame.myImageData,
+                                theFrame.myName,
+                                theFrame.myProgressive,
+                                theFrame.myQuality);
+  theFrame.myImageData->Delete();
+  theFrame.myImageData = NULL;
 }
 
 
@@ -80,19 +164,23 @@ SVTK_ImageWriterMgr
 ::Stop()
 {
   if(SALOME::VerbosityActivated())
-    std::cout << "SVTK_ImageWriterMgr::Stop " <<
-    //"- total = "<<mySemaphore->total()<<
-    "; available = " << mySemaphore->available() << endl;
+    std::cout << "SVTK_ImageWriterMgr::Stop - threads = " << myThreads.size() <<
+    "; pending frames = " << myFrames.size() << endl;
 
-  if(SALOME::VerbosityActivated())
-    std::cout << "SVTK_ImageWriterMgr::Stop - *mySemaphore += " << myThreads.size() << endl;
-    
-  mySemaphore->acquire( (int)myThreads.size() ); //!< TODO: conversion from size_t to int
+  {
+    QMutexLocker aLocker(&myMutex);
+    myIsStopping = true;
+    myNotEmpty.wakeAll();
+  }
 
+  // The threads leave once the queue is empty
   for(size_t anId = 0, anEnd = myThreads.size(); anId < anEnd; anId++){
     SVTK_ImageWriter* anImageWriter = myThreads[anId];
     anImageWriter->wait();
     delete anImageWriter;
   }
   myThreads.clear();
+
+  QMutexLocker aLocker(&myMutex);
+  myIsStopping = false;
 }
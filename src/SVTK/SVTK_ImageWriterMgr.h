@@ -20,38 +20,92 @@
 #ifndef SVTK_IMAGEWRITERMGR_H
 #define SVTK_IMAGEWRITERMGR_H
 
+#include <QMutex>
+#include <QWaitCondition>
+
+#include <deque>
 #include <string>
 #include <vector>
 
-class QString;
-class vtkAlgorithm;
 class vtkImageData;
 class SVTK_ImageWriter;
-class QSemaphore;
+class SVTK_VideoWriter;
 
+/*!
+  Writes the recorded frames with a fixed number of threads. The frames are
+  queued; when the queue is full, the recording thread waits for the writers,
+  so that the memory used by the pending frames stays bounded.
+  The frames are either written as JPEG files (in parallel), or streamed into
+  a video file (by one thread, in the order of the recording).
+*/
 class SVTK_ImageWriterMgr
 {
  public:
   SVTK_ImageWriterMgr();
   ~SVTK_ImageWriterMgr();
-  
+
+  //! Frame waiting to be written; the manager owns the image data
+  struct TFrame
+  {
+    vtkImageData* myImageData;
+    std::string   myName;       //!< JPEG file name
+    int           myProgressive;
+    int           myQuality;
+    int           myNbRepeats;  //!< video: number of copies of the previous frame to insert before
+  };
+
+  //! Sets the number of writer threads and of the frames that can wait for them
+  void
+  SetLimits(int theNbThreads,
+            int theQueueSize);
+
+  //! Streams the next frames into the video writer (not owned) instead of
+  //! writing JPEG files; NULL to get back to the JPEG files
   void
-  StartImageWriter(vtkAlgorithm *theAlgorithm,
-                   vtkImageData *theImageData,
+  SetVideoWriter(SVTK_VideoWriter* theVideoWriter);
+
+  //! Queues a frame to be written as a JPEG file; takes ownership of the image
+  void
+  StartImageWriter(vtkImageData *theImageData,
                    const std::string& theName,
                    const int theProgressive,
                    const int theQuality);
 
+  //! Queues a frame for the video writer; takes ownership of the image
+  void
+  StartVideoWriter(vtkImageData *theImageData,
+                   const int theNbRepeats);
+
+  //! Waits for all the queued frames to be written and stops the threads
   void
   Stop();
 
+  //! Called by the writer threads: waits for a frame, false when stopped
+  bool
+  Pop(TFrame& theFrame);
+
+  //! Called by the writer threads: writes a frame and releases its image
+  void
+  Write(TFrame& theFrame);
+
   typedef std::vector<SVTK_ImageWriter*> TWriterThreads;
 
+ protected:
+  void
+  Push(const TFrame& theFrame);
+
  protected:
   TWriterThreads myThreads;
+  int myNbThreads;
+  int myQueueSize;
 
-  QSemaphore* mySemaphore;
+  std::deque<TFrame> myFrames;
+  bool myIsStopping;
+  QMutex myMutex;
+  QWaitCondition myNotEmpty;
+  QWaitCondition myNotFull;
+
+  SVTK_VideoWriter* myVideoWriter;
 };
 
 #endif
-
@@ -0,0 +1,171 @@
+// Copyright (C) 2007-2026  CEA, EDF, OPEN CASCADE
+//
+// Copyright (C) 2003-2007  OPEN CASCADE, EADS/CCR, LIP6, CEA/DEN,
+// CEDRAT, EDF R&D, LEG, PRINCIPIA R&D, BUREAU VERITAS
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+//
+// See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+//
+
+//  SALOME VTKViewer : build VTK viewer into Salome desktop
+//  File   : SVTK_PointPicker.cxx
+//  Module : SALOME
+//
+#include "SVTK_PointPicker.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <vtkObjectFactory.h>
+#include <vtkStaticPointLocator.h>
+#include <vtkMapper.h>
+#include <vtkDataSet.h>
+#include <vtkIdList.h>
+#include <vtkBox.h>
+#include <vtkMath.h>
+
+vtkStandardNewMacro( SVTK_PointPicker )
+
+SVTK_PointPicker::SVTK_PointPicker()
+{
+}
+
+SVTK_PointPicker::~SVTK_PointPicker()
+{
+}
+
+void SVTK_PointPicker::AddLocator( vtkStaticPointLocator* theLocator )
+{
+  if ( !theLocator || std::find( myLocators.begin(), myLocators.end(), theLocator ) != myLocators.end() )
+    return;
+  myLocators.push_back( theLocator );
+  this->Modified();
+}
+
+void SVTK_PointPicker::RemoveLocator( vtkStaticPointLocator* theLocator )
+{
+  TLocators::iterator anIter = std::find( myLocators.begin(), myLocators.end(), theLocator );
+  if ( anIter == myLocators.end() )
+    return;
+  myLocators.erase( anIter );
+  this->Modified();
+}
+
+void SVTK_PointPicker::RemoveAllLocators()
+{
+  if ( myLocators.empty() )
+    return;
+  myLocators.clear();
+  this->Modified();
+}
+
+/*!
+  Picks the point of the mapper input which is the closest to the line,
+  like vtkPointPicker::IntersectWithLine(). When a locator is available for
+  the mapper input, only the points found by the locator near the line are
+  tested instead of all the points.
+*/
+double SVTK_PointPicker::IntersectWithLine( const double p1[3], const double p2[3], double tol,
+    vtkAssemblyPath* path, vtkProp3D* p, vtkAbstractMapper3D* m )
+{
+  vtkMapper* aMapper = vtkMapper::SafeDownCast( m );
+  vtkDataSet* anInput = aMapper ? aMapper->GetInput() : NULL;
+
+  vtkStaticPointLocator* aLocator = NULL;
+  if ( anInput ) {
+    TLocators::const_iterator anIter = myLocators.begin();
+    for ( ; anIter != myLocators.end() && !aLocator; anIter++ )
+      if ( (*anIter)->GetDataSet() == anInput )
+        aLocator = *anIter;
+  }
+
+  if ( !aLocator || this->UseCells || tol <= 0.0 )
+    return Superclass::IntersectWithLine( p1, p2, tol, path, p, m );
+
+  double aRay[3] = { p2[0] - p1[0], p2[1] - p1[1], p2[2] - p1[2] };
+  double aRayFactor = vtkMath::Dot( aRay, aRay );
+  if ( aRayFactor == 0.0 )
+    return Superclass::IntersectWithLine( p1, p2, tol, path, p, m );
+
+  // Only the part of the line crossing the dataset bounds (enlarged
+  // by the tolerance) can hold the points within the tolerance
+  double aBounds[6];
+  anInput->GetBounds( aBounds );
+  for ( int i = 0; i < 3; i++ ) {
+    aBounds[2*i]   -= tol;
+    aBounds[2*i+1] += tol;
+  }
+  double aT1, aT2, aX1[3], aX2[3];
+  int aPlane1, aPlane2;
+  if ( !vtkBox::IntersectWithLine( aBounds, p1, p2, aT1, aT2, aX1, aX2, aPlane1, aPlane2 ) )
+    return VTK_DOUBLE_MAX;
+
+  // A point within the tolerance (for each coordinate) of the line is in
+  // the cylinder of radius sqrt(3)*tol around it. The cylinder is covered
+  // by the spheres of radius sqrt(6)*tol centred on the line every 2*sqrt(3)*tol.
+  double aRadius = sqrt( 6.0 ) * tol;
+  double aStep = 2.0 * sqrt( 3.0 ) * tol;
+  double aLength = sqrt( vtkMath::Distance2BetweenPoints( aX1, aX2 ) );
+  vtkIdType aNbSteps = (vtkIdType)ceil( aLength / aStep ) + 1;
+  if ( aNbSteps > anInput->GetNumberOfPoints() )
+    return Superclass::IntersectWithLine( p1, p2, tol, path, p, m );
+
+  std::vector<vtkIdType> aCandidates;
+  vtkIdList* anIds = vtkIdList::New();
+  for ( vtkIdType aStepId = 0; aStepId < aNbSteps; aStepId++ ) {
+    double aCoef = aNbSteps > 1 ? double( aStepId ) / double( aNbSteps - 1 ) : 0.0;
+    double aCenter[3];
+    for ( int i = 0; i < 3; i++ )
+      aCenter[i] = aX1[i] + aCoef * ( aX2[i] - aX1[i] );
+    aLocator->FindPointsWithinRadius( aRadius, aCenter, anIds );
+    for ( vtkIdType anId = 0; anId < anIds->GetNumberOfIds(); anId++ )
+      aCandidates.push_back( anIds->GetId( anId ) );
+  }
+  anIds->Delete();
+
+  // Candidates are tested in the order of vtkPointPicker
+  std::sort( aCandidates.begin(), aCandidates.end() );
+  aCandidates.erase( std::unique( aCandidates.begin(), aCandidates.end() ), aCandidates.end() );
+
+  vtkIdType aMinPntId = -1;
+  double aTMin = VTK_DOUBLE_MAX, aMinPntDist = VTK_DOUBLE_MAX, aMinXYZ[3];
+  std::vector<vtkIdType>::const_iterator anIter = aCandidates.begin();
+  for ( ; anIter != aCandidates.end(); anIter++ ) {
+    double aX[3];
+    anInput->GetPoint( *anIter, aX );
+    double aT = ( aRay[0] * ( aX[0] - p1[0] ) + aRay[1] * ( aX[1] - p1[1] ) + aRay[2] * ( aX[2] - p1[2] ) ) / aRayFactor;
+    // keep the point closest to the line, with a fudge factor
+    // for the points nearly the same distance away
+    if ( aT >= 0.0 && aT <= 1.0 && aT <= aTMin + this->Tolerance ) {
+      double aMaxDist = 0.0;
+      for ( int i = 0; i < 3; i++ )
+        aMaxDist = std::max( aMaxDist, fabs( aX[i] - ( p1[i] + aT * aRay[i] ) ) );
+      if ( aMaxDist <= tol && aMaxDist < aMinPntDist ) {
+        aMinPntId = *anIter;
+        aMinPntDist = aMaxDist;
+        aTMin = aT;
+        aMinXYZ[0] = aX[0]; aMinXYZ[1] = aX[1]; aMinXYZ[2] = aX[2];
+      }
+    }
+  }
+
+  // Now compare this against other actors.
+  if ( aMinPntId > -1 && aTMin < this->GlobalTMin ) {
+    this->MarkPicked( path, p, m, aTMin, aMinXYZ );
+    this->PointId = aMinPntId;
+  }
+  return aTMin;
+}
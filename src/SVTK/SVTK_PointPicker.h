@@ -0,0 +1,96 @@
+// Copyright (C) 2007-2026  CEA, EDF, OPEN CASCADE
+//
+// Copyright (C) 2003-2007  OPEN CASCADE, EADS/CCR, LIP6, CEA/DEN,
+// CEDRAT, EDF R&D, LEG, PRINCIPIA R&D, BUREAU VERITAS
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+//
+
+//  SALOME VTKViewer : build VTK viewer into Salome desktop
+//  File   : SVTK_PointPicker.h
+//  Module : SALOME
+//
+#ifndef __SVTK_PointPicker_h
+#define __SVTK_PointPicker_h
+
+#include "SVTK.h"
+
+#include <vector>
+
+#include <vtkPointPicker.h>
+#include <vtkSmartPointer.h>
+
+class vtkStaticPointLocator;
+
+#ifdef WIN32
+#pragma warning ( disable:4251 )
+#endif
+
+/*! \class vtkPointPicker
+ * \brief For more information see <a href="http://www.vtk.org/">VTK documentation
+ */
+/*! \class SVTK_PointPicker
+ * \brief Point picker which can use point locators.
+ *
+ * Like locators of vtkCellPicker, a locator is used for the picked actors
+ * whose mapper input is the locator dataset: the points near the pick ray
+ * are found through the locator instead of testing all the points.
+ */
+class SVTK_EXPORT SVTK_PointPicker : public vtkPointPicker
+{
+ public:
+  static
+  SVTK_PointPicker *New();
+
+  vtkTypeMacro(SVTK_PointPicker,vtkPointPicker)
+
+  //! Add a locator to be used for its dataset
+  void
+  AddLocator( vtkStaticPointLocator* theLocator );
+
+  //! Remove a locator
+  void
+  RemoveLocator( vtkStaticPointLocator* theLocator );
+
+  //! Remove all the locators
+  void
+  RemoveAllLocators();
+
+ protected:
+  SVTK_PointPicker();
+  ~SVTK_PointPicker();
+
+  virtual
+  double
+  IntersectWithLine( const double p1[3],
+                     const double p2[3],
+                     double tol,
+                     vtkAssemblyPath* path,
+                     vtkProp3D* p,
+                     vtkAbstractMapper3D* m ) override;
+
+  typedef std::vector< vtkSmartPointer<vtkStaticPointLocator> > TLocators;
+  TLocators myLocators;
+
+ private:
+  SVTK_PointPicker( const SVTK_PointPicker& ) = delete;
+  void operator=( const SVTK_PointPicker& ) = delete;
+};
+
+#ifdef WIN32
+#pragma warning ( default:4251 )
+#endif
+
+#endif
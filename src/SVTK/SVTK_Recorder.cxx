@@ -21,6 +21,7 @@
 
 #include "SVTK_ImageWriter.h"
 #include "SVTK_ImageWriterMgr.h"
+#include "SVTK_VideoWriter.h"
 
 #include <vtkObjectFactory.h>
 #include <vtkObject.h>
@@ -76,6 +77,7 @@ SVTK_Recorder
   myTimeStart(0.0),
   myFrameIndex(0),
   myNbWrittenFrames(0),
+  myOutputFormat(SVTK_Recorder_AVIMaker),
   myNbFPS(5.5),
   myQuality(100),
   myProgressiveMode(true),
@@ -84,7 +86,8 @@ SVTK_Recorder
   myCommand(vtkCallbackCommand::New()),
   myRenderWindow(NULL),
   myFilter(vtkWindowToImageFilter::New()),
-  myWriterMgr(new SVTK_ImageWriterMgr)
+  myWriterMgr(new SVTK_ImageWriterMgr),
+  myVideoWriter(new SVTK_VideoWriter)
 {
   myCommand->SetClientData(this);
   myCommand->SetCallback(SVTK_Recorder::ProcessEvents);
@@ -98,6 +101,7 @@ SVTK_Recorder
   myCommand->Delete();
   myFilter->Delete();
   delete myWriterMgr;
+  delete myVideoWriter;
 }
 
 
@@ -107,6 +111,10 @@ SVTK_Recorder
 ::CheckExistAVIMaker()
 {
   myErrorStatus = 0;
+  // the video is written in-process, no external tool is needed
+  if(myOutputFormat != SVTK_Recorder_AVIMaker)
+    return;
+
   std::ostringstream aStream;
 #ifndef WIN32
   aStream<<"which "<<myNameAVIMaker<<" 2> /dev/null";
@@ -215,6 +223,22 @@ SVTK_Recorder
 }
 
 
+//----------------------------------------------------------------------------
+void
+SVTK_Recorder
+::SetOutputFormat(int theOutputFormat)
+{
+  myOutputFormat = theOutputFormat;
+}
+
+int
+SVTK_Recorder
+::GetOutputFormat() const
+{
+  return myOutputFormat;
+}
+
+
 //----------------------------------------------------------------------------
 int
 SVTK_Recorder
@@ -258,6 +282,18 @@ SVTK_Recorder
 {
   if(myState == SVTK_Recorder_Stop){
     if(myRenderWindow){
+      myErrorStatus = 0;
+      if(myOutputFormat == SVTK_Recorder_AVIMaker){
+        myWriterMgr->SetVideoWriter(NULL);
+      }else{
+        SVTK_VideoWriter::EFormat aFormat = myOutputFormat == SVTK_Recorder_Y4M ?
+          SVTK_VideoWriter::SVTK_VideoWriter_Y4M : SVTK_VideoWriter::SVTK_VideoWriter_AVI;
+        if(!myVideoWriter->Open(myName,aFormat,myNbFPS)){
+          myErrorStatus = 1;
+          return;
+        }
+        myWriterMgr->SetVideoWriter(myVideoWriter);
+      }
       myState = SVTK_Recorder_Record;
       myFilter->SetInput(myRenderWindow);
       myFrameIndex = -1;
@@ -285,12 +321,19 @@ SVTK_Recorder
 
     myWriterMgr->Stop();
 
-    if(myUseSkippedFrames)
-      AddSkippedFrames();
+    if(myOutputFormat == SVTK_Recorder_AVIMaker){
+      if(myUseSkippedFrames)
+        AddSkippedFrames();
+
+      myFrameIndexes.clear();
 
-    myFrameIndexes.clear();
+      MakeFileAVI();
+    }else{
+      myFrameIndexes.clear();
 
-    MakeFileAVI();
+      if(!myVideoWriter->Close())
+        myErrorStatus = 1;
+    }
   }
   myState = SVTK_Recorder_Stop;
   myPaused = 0;
@@ -360,6 +403,11 @@ SVTK_Recorder
     myFrameIndex = aFrameIndex;
   }
 
+  // Number of frames skipped since the previous recorded one, out of a pause
+  int aNbSkipped = 0;
+  if(myUseSkippedFrames && !myFrameIndexes.empty() && myFrameIndexes.back() >= 0)
+    aNbSkipped = myFrameIndex - myFrameIndexes.back() - 1;
+
   myFrameIndexes.push_back(myFrameIndex);
   if(SALOME::VerbosityActivated())
     std::cout << "SVTK_Recorder::DoRecord - myFrameIndex = " << myFrameIndex << endl;
@@ -367,16 +415,21 @@ SVTK_Recorder
   myRenderWindow->RemoveObserver(myCommand);
   myFilter->Modified();
 
-  std::string aName;
-  GetNameJPEG(myName,myFrameIndex,aName);
-
   PreWrite();
 
   vtkImageData *anImageData = vtkImageData::New();
   anImageData->DeepCopy(myFilter->GetOutput());
 
-  myWriterMgr->StartImageWriter(myFilter,anImageData,aName,myProgressiveMode,myQuality);
-  myNbWrittenFrames++;
+  // Waits here if the writers are late, to bound the memory used by the frames
+  if(myOutputFormat == SVTK_Recorder_AVIMaker){
+    std::string aName;
+    GetNameJPEG(myName,myFrameIndex,aName);
+    myWriterMgr->StartImageWriter(anImageData,aName,myProgressiveMode,myQuality);
+    myNbWrittenFrames++;
+  }else{
+    myWriterMgr->StartVideoWriter(anImageData,aNbSkipped);
+    myNbWrittenFrames += aNbSkipped + 1;
+  }
 
   myRenderWindow->AddObserver(vtkCommand::EndEvent,
                               myCommand,
@@ -30,6 +30,7 @@ class vtkRenderWindow;
 class vtkCallbackCommand;
 class vtkWindowToImageFilter;
 class SVTK_ImageWriterMgr;
+class SVTK_VideoWriter;
 
 class SVTK_Recorder : public vtkObject 
 {
@@ -41,6 +42,12 @@ class SVTK_Recorder : public vtkObject
   };
   
  public:
+  enum OutputFormat {
+    SVTK_Recorder_AVIMaker=0, //!< JPEG frames encoded by the external AVI maker
+    SVTK_Recorder_RawAVI,     //!< uncompressed AVI written in-process
+    SVTK_Recorder_Y4M         //!< YUV4MPEG2 written in-process
+  };
+
   static SVTK_Recorder *New();
   vtkTypeMacro(SVTK_Recorder,vtkObject)
 
@@ -80,6 +87,12 @@ class SVTK_Recorder : public vtkObject
   bool
   UseSkippedFrames() const;
 
+  void
+  SetOutputFormat(int theOutputFormat);
+
+  int
+  GetOutputFormat() const;
+
   void
   Record();
 
@@ -132,6 +145,7 @@ protected :
 
   int myFrameIndex;
   int myNbWrittenFrames;
+  int myOutputFormat;
 
   double myNbFPS;
   int myQuality;
@@ -148,6 +162,7 @@ protected :
   vtkRenderWindow *myRenderWindow;
   vtkWindowToImageFilter *myFilter;
   SVTK_ImageWriterMgr *myWriterMgr;
+  SVTK_VideoWriter *myVideoWriter;
 
 private:
   SVTK_Recorder(const SVTK_Recorder&);  //Not implemented
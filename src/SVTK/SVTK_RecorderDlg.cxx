@@ -73,6 +73,13 @@ SVTK_RecorderDlg::SVTK_RecorderDlg( QWidget* theParent, SVTK_Recorder* theRecord
   myRecordingModeComboBox->addItem( tr( "ALL_DISLPAYED_FRAMES" ) );
   myRecordingModeComboBox->setCurrentIndex( aResourceMgr->integerValue( "VTKViewer", "recorder_mode", 1 ) );
 
+  QLabel* aFormatLabel = new QLabel( tr( "OUTPUT_FORMAT" ), mySettingsBox );
+  myFormatComboBox = new QComboBox( mySettingsBox );
+  myFormatComboBox->addItem( tr( "FORMAT_AVI_MAKER" ) );
+  myFormatComboBox->addItem( tr( "FORMAT_RAW_AVI" ) );
+  myFormatComboBox->addItem( tr( "FORMAT_Y4M" ) );
+  myFormatComboBox->setCurrentIndex( aResourceMgr->integerValue( "VTKViewer", "recorder_format", 0 ) );
+
   QLabel* aFPSLabel = new QLabel( tr( "FPS" ), mySettingsBox );
   myFPSSpinBox = new QtxDoubleSpinBox( 0.1, 100.0, 1.0, mySettingsBox );
   myFPSSpinBox->setValue( aResourceMgr->doubleValue( "VTKViewer", "recorder_fps", 10.0 ) );
@@ -88,11 +95,16 @@ SVTK_RecorderDlg::SVTK_RecorderDlg( QWidget* theParent, SVTK_Recorder* theRecord
   aSettingsLayout->addWidget( myFileNameLineEdit, 1, 0, 1, 2 );
   aSettingsLayout->addWidget( aRecordingModeLabel, 2, 0 );
   aSettingsLayout->addWidget( myRecordingModeComboBox, 2, 1 );
-  aSettingsLayout->addWidget( aFPSLabel, 3, 0 );
-  aSettingsLayout->addWidget( myFPSSpinBox, 3, 1 );
-  aSettingsLayout->addWidget( aQualityLabel, 4, 0 );
-  aSettingsLayout->addWidget( myQualitySpinBox, 4, 1 );
-  aSettingsLayout->addWidget( myProgressiveCheckBox, 5, 0 );
+  aSettingsLayout->addWidget( aFormatLabel, 3, 0 );
+  aSettingsLayout->addWidget( myFormatComboBox, 3, 1 );
+  aSettingsLayout->addWidget( aFPSLabel, 4, 0 );
+  aSettingsLayout->addWidget( myFPSSpinBox, 4, 1 );
+  aSettingsLayout->addWidget( aQualityLabel, 5, 0 );
+  aSettingsLayout->addWidget( myQualitySpinBox, 5, 1 );
+  aSettingsLayout->addWidget( myProgressiveCheckBox, 6, 0 );
+
+  connect( myFormatComboBox, SIGNAL( currentIndexChanged( int ) ), this, SLOT( onFormatChanged( int ) ) );
+  onFormatChanged( myFormatComboBox->currentIndex() );
 
   aTopLayout->addWidget( mySettingsBox );
 
@@ -139,11 +151,20 @@ void SVTK_RecorderDlg::onStart()
   myRecorder->SetNbFPS( myFPSSpinBox->value() );
   myRecorder->SetQuality( myQualitySpinBox->value() );
   myRecorder->SetProgressiveMode( myProgressiveCheckBox->isChecked() );
+  myRecorder->SetOutputFormat( myFormatComboBox->currentIndex() );
 
   accept();
 
 }
 
+void SVTK_RecorderDlg::onFormatChanged( int theFormat )
+{
+  // quality and progressive mode are the JPEG ones
+  bool isJPEG = theFormat == SVTK_Recorder::SVTK_Recorder_AVIMaker;
+  myQualitySpinBox->setEnabled( isJPEG );
+  myProgressiveCheckBox->setEnabled( isJPEG );
+}
+
 void SVTK_RecorderDlg::onClose()
 {
   reject();
@@ -174,6 +195,7 @@ bool SVTK_RecorderDlg::onBrowseFile()
 {
   QStringList aFilter;
   aFilter.append( tr( "FLT_AVI_FILES" ) );
+  aFilter.append( tr( "FLT_Y4M_FILES" ) );
   aFilter.append( tr( "FLT_ALL_FILES" ) );
 
   QString aFileName = SUIT_FileDlg::getFileName( this, QDir::homePath(), aFilter,
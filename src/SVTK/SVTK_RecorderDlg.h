@@ -56,6 +56,7 @@ protected slots:
   void             onHelp();
 
   bool             onBrowseFile();
+  void             onFormatChanged( int );
 
 private:
   SVTK_Recorder*   myRecorder;
@@ -64,6 +65,7 @@ private:
   QLineEdit*       myFileNameLineEdit;
 
   QComboBox*        myRecordingModeComboBox;
+  QComboBox*        myFormatComboBox;
   QtxDoubleSpinBox* myFPSSpinBox;
   QtxIntSpinBox*    myQualitySpinBox;
   QCheckBox*        myProgressiveCheckBox;
@@ -29,6 +29,8 @@
 #include "SVTK_Trihedron.h"
 #include "SVTK_CubeAxesActor2D.h"
 #include "SVTK_AreaPicker.h"
+#include "SVTK_PointPicker.h"
+#include "SVTK_Event.h"
 
 #include "SALOME_Actor.h"
 #include "VTKViewer_Actor.h"
@@ -67,7 +69,7 @@ SVTK_Renderer
   myDevice(VTKViewer_OpenGLRenderer::New()),
   myInteractor(NULL),
   myTransform(VTKViewer_Transform::New()),
-  myPointPicker(vtkPointPicker::New()),
+  myPointPicker(SVTK_PointPicker::New()),
   myCellPicker(vtkCellPicker::New()),
   myPointAreaPicker(SVTK_AreaPicker::New()),
   myCellAreaPicker(SVTK_AreaPicker::New()),
@@ -179,6 +181,12 @@ SVTK_Renderer
   }
 
   anActors2->Delete();
+
+  // The actors removed directly from the device are still observed
+  TObservedActors::iterator anIter = myObservedActors.begin();
+  for(; anIter != myObservedActors.end(); anIter++)
+    if(SALOME_Actor* anActor = anIter->second.myActor.GetPointer())
+      anActor->RemoveObserver(myEventCallbackCommand.GetPointer());
 }
 
 
@@ -187,7 +195,7 @@ SVTK_Renderer
 */
 void 
 SVTK_Renderer
-::ProcessEvents(vtkObject* vtkNotUsed(theObject), 
+::ProcessEvents(vtkObject* theObject, 
                 unsigned long theEvent,
                 void* theClientData, 
                 void* vtkNotUsed(theCallData))
@@ -195,6 +203,12 @@ SVTK_Renderer
   SVTK_Renderer* self = reinterpret_cast<SVTK_Renderer*>(theClientData);
 
   switch(theEvent){
+  case SVTK::IOChangedEvent:
+    if(SALOME_Actor* anActor = SALOME_Actor::SafeDownCast(theObject)){
+      self->UnindexActor(anActor);
+      self->IndexActor(anActor);
+    }
+    break;
   case vtkCommand::ConfigureEvent:
     self->OnResetView();
     break;
@@ -251,9 +265,23 @@ SVTK_Renderer
     anActor->SetPreHighlightProperty(myPreHighlightProperty.GetPointer());
     anActor->SetHighlightProperty(myHighlightProperty.GetPointer());
 
-    anActor->AddToRender(GetDevice());
+    // Publishing again an already published actor is a no-op for the device,
+    // but costs a search among all its props
+    if(!anActor->IsConsumer(GetDevice()))
+      anActor->AddToRender(GetDevice());
     anActor->UpdateNameActors();
 
+    TObservedActor& anObserved = myObservedActors[anActor];
+    if(anObserved.myActor.GetPointer() != anActor){
+      anObserved.myActor = anActor;
+      anObserved.myIsIndexed = false;
+      anActor->AddObserver(SVTK::IOChangedEvent,
+                           myEventCallbackCommand.GetPointer(),
+                           myPriority);
+    }
+    UnindexActor(anActor);
+    IndexActor(anActor);
+
     if(theIsAdjustActors)
       AdjustActors();
   }
@@ -284,6 +312,10 @@ SVTK_Renderer
 
     anActor->RemoveFromRender(GetDevice());
 
+    UnindexActor(anActor);
+    anActor->RemoveObserver(myEventCallbackCommand.GetPointer());
+    myObservedActors.erase(anActor);
+
     while ( int i = myPointPicker->GetProp3Ds()->IsItemPresent( theActor ))
       myPointPicker->GetProp3Ds()->RemoveItem( i-1 );
     while ( int i = myCellPicker->GetProp3Ds()->IsItemPresent( theActor ))
@@ -299,6 +331,85 @@ SVTK_Renderer
   }
 }
 
+/*!
+  Files the actor in the entry index under its current entry
+*/
+void
+SVTK_Renderer
+::IndexActor(SALOME_Actor* theActor)
+{
+  TObservedActors::iterator anIter = myObservedActors.find(theActor);
+  if(anIter == myObservedActors.end() || anIter->second.myIsIndexed)
+    return;
+
+  if(theActor->hasIO() && theActor->getIO()->hasEntry()){
+    TObservedActor& anObserved = anIter->second;
+    anObserved.myEntry = theActor->getIO()->getEntry();
+    anObserved.myIsIndexed = true;
+    myEntry2Actors[anObserved.myEntry].push_back(theActor);
+  }
+}
+
+/*!
+  Removes the actor from the entry index
+*/
+void
+SVTK_Renderer
+::UnindexActor(SALOME_Actor* theActor)
+{
+  TObservedActors::iterator anIter = myObservedActors.find(theActor);
+  if(anIter == myObservedActors.end() || !anIter->second.myIsIndexed)
+    return;
+
+  TObservedActor& anObserved = anIter->second;
+  anObserved.myIsIndexed = false;
+
+  TEntry2Actors::iterator aBucket = myEntry2Actors.find(anObserved.myEntry);
+  if(aBucket == myEntry2Actors.end())
+    return;
+
+  TIndexedActors& anActors = aBucket->second;
+  for(size_t anId = 0; anId < anActors.size(); anId++){
+    if(anActors[anId].GetPointer() == theActor){
+      anActors.erase(anActors.begin() + anId);
+      break;
+    }
+  }
+  if(anActors.empty())
+    myEntry2Actors.erase(aBucket);
+}
+
+/*!
+  Collects the published actors with the given entry
+*/
+void
+SVTK_Renderer
+::FindActors(const char* theEntry, TActors& theActors)
+{
+  theActors.clear();
+  if(!theEntry)
+    return;
+
+  TEntry2Actors::iterator aBucket = myEntry2Actors.find(theEntry);
+  if(aBucket == myEntry2Actors.end())
+    return;
+
+  // Forget the deleted actors, skip the ones removed directly from the device
+  TIndexedActors& anActors = aBucket->second;
+  size_t aNbAlive = 0;
+  for(size_t anId = 0; anId < anActors.size(); anId++){
+    SALOME_Actor* anActor = anActors[anId].GetPointer();
+    if(!anActor)
+      continue;
+    anActors[aNbAlive++] = anActors[anId];
+    if(anActor->IsConsumer(GetDevice()))
+      theActors.push_back(anActor);
+  }
+  anActors.resize(aNbAlive);
+  if(anActors.empty())
+    myEntry2Actors.erase(aBucket);
+}
+
 /*!
   Get special container that keeps scaling of the scene
 */
@@ -33,6 +33,11 @@
 
 #include <vtkObject.h>
 #include <vtkSmartPointer.h>
+#include <vtkWeakPointer.h>
+
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 class vtkRenderer;
 class vtkCallbackCommand;
@@ -49,6 +54,7 @@ class VTKViewer_Trihedron;
 class VTKViewer_Transform;
 class SVTK_CubeAxesActor2D;
 class VTKViewer_Actor;
+class SALOME_Actor;
 class SVTK_Selector;
 
 #ifdef WIN32
@@ -90,6 +96,12 @@ class SVTK_EXPORT SVTK_Renderer : public vtkObject
   void 
   RemoveActor(VTKViewer_Actor* theActor, bool theIsAdjustActors = true);
 
+  typedef std::vector<SALOME_Actor*> TActors;
+
+  //! Collects the published actors with the given entry, using an index kept by #AddActor / #RemoveActor
+  void
+  FindActors(const char* theEntry, TActors& theActors);
+
   //! Get special container that keeps scaling of the scene 
   VTKViewer_Transform* 
   GetTransform();
@@ -243,6 +255,14 @@ protected:
                             void* clientdata, 
                             void* calldata);
   
+  //! Files the actor in the entry index under its current entry
+  void
+  IndexActor(SALOME_Actor* theActor);
+
+  //! Removes the actor from the entry index
+  void
+  UnindexActor(SALOME_Actor* theActor);
+
   vtkSmartPointer<vtkRenderer> myDevice;
   vtkRenderWindowInteractor* myInteractor;
   vtkSmartPointer<SVTK_Selector> mySelector;
@@ -267,6 +287,22 @@ protected:
   double myTrihedronSize;
   bool myIsTrihedronRelative;
   double myBndBox[6];
+
+  //----------------------------------------------------------------------------
+  // Index of the published actors by entry; weak pointers and the check of
+  // consumers protect from the actors removed directly from the device
+  typedef std::vector< vtkWeakPointer<SALOME_Actor> > TIndexedActors;
+  typedef std::unordered_map<std::string, TIndexedActors> TEntry2Actors;
+  TEntry2Actors myEntry2Actors;
+
+  struct TObservedActor
+  {
+    vtkWeakPointer<SALOME_Actor> myActor;
+    std::string myEntry; //!< entry the actor is indexed with
+    bool myIsIndexed;
+  };
+  typedef std::unordered_map<SALOME_Actor*, TObservedActor> TObservedActors;
+  TObservedActors myObservedActors; //!< published actors, observed for IO changes
 };
 
 #ifdef WIN32
@@ -39,6 +39,8 @@
 #include <vtkActorCollection.h>
 #include <vtkCellPicker.h>
 
+#include <algorithm>
+
 
 /*!
   \return new SVTK_Selector
@@ -255,6 +257,127 @@ SVTK_SelectorDef
   return (int)myIObjects.size(); //!< TODO: conversion from size_t to int
 }
 
+/*!
+  Max number of indices for which the order of selection is kept
+*/
+static const vtkIdType MAX_ORDERED_EXTENT = 1024;
+
+/*!
+  Adds index to the subselection
+*/
+void
+SVTK_SelectorDef::TSubIndex
+::Add(vtkIdType theIndex)
+{
+  if(!myIds.Add(theIndex) || !myIsOrdered)
+    return;
+  if(myIds.Extent() <= MAX_ORDERED_EXTENT)
+    myOrder.push_back(theIndex);
+  else{
+    myIsOrdered = false;
+    std::vector<vtkIdType>().swap(myOrder);
+  }
+}
+
+/*!
+  Adds indices to the subselection, in their order for the small subselections
+*/
+void
+SVTK_SelectorDef::TSubIndex
+::Add(const SVTK_TIndexedMapOfVtkId& theIndices)
+{
+  if(myIsOrdered && myIds.Extent() + theIndices.Extent() <= MAX_ORDERED_EXTENT){
+    for(int i = 1, iEnd = theIndices.Extent(); i <= iEnd; i++)
+      Add(theIndices(i));
+    return;
+  }
+  myIds.Union(theIndices);
+  myIsOrdered = false;
+  std::vector<vtkIdType>().swap(myOrder);
+}
+
+/*!
+  Adds indices to the subselection
+*/
+void
+SVTK_SelectorDef::TSubIndex
+::Add(const SVTK_IdBitmap& theIndices)
+{
+  if(myIsOrdered && myIds.Extent() + theIndices.Extent() <= MAX_ORDERED_EXTENT){
+    for(SVTK_IdBitmap::Iterator anIter(theIndices); anIter.More(); anIter.Next())
+      Add(anIter.Value());
+    return;
+  }
+  myIds.Union(theIndices);
+  myIsOrdered = false;
+  std::vector<vtkIdType>().swap(myOrder);
+}
+
+/*!
+  Removes index from the subselection
+*/
+void
+SVTK_SelectorDef::TSubIndex
+::Remove(vtkIdType theIndex)
+{
+  if(!myIds.Remove(theIndex))
+    return;
+  if(myIds.IsEmpty())
+    Clear();
+  else if(myIsOrdered)
+    myOrder.erase(std::find(myOrder.begin(), myOrder.end(), theIndex));
+}
+
+/*!
+  Removes indices from the subselection
+*/
+void
+SVTK_SelectorDef::TSubIndex
+::Remove(const SVTK_IdBitmap& theIndices)
+{
+  myIds.Subtract(theIndices);
+  if(myIds.IsEmpty())
+    Clear();
+  else if(myIsOrdered){
+    std::vector<vtkIdType>::iterator anEnd = myOrder.begin();
+    for(size_t i = 0; i < myOrder.size(); i++)
+      if(myIds.Contains(myOrder[i]))
+        *anEnd++ = myOrder[i];
+    myOrder.erase(anEnd, myOrder.end());
+  }
+}
+
+/*!
+  Clears the subselection
+*/
+void
+SVTK_SelectorDef::TSubIndex
+::Clear()
+{
+  myIds.Clear();
+  std::vector<vtkIdType>().swap(myOrder);
+  myIsOrdered = true;
+}
+
+/*!
+  Converts the subselection to the map of indices
+*/
+void
+SVTK_SelectorDef::TSubIndex
+::GetIndex(SVTK_TIndexedMapOfVtkId& theIndex) const
+{
+  if(!myIsOrdered){
+    myIds.ToMap(theIndex);
+    return;
+  }
+  theIndex.Clear();
+  if(myOrder.empty())
+    return;
+  theIndex.ReSize((int)myOrder.size());
+  for(size_t i = 0; i < myOrder.size(); i++)
+    theIndex.Add(myOrder[i]);
+}
+
 /*!
   \return true if the SALOME_InteractiveObject has a subselection
   \param theIO - SALOME_InteractiveObject
@@ -277,7 +400,23 @@ SVTK_SelectorDef
 {
   TMapIOSubIndex::const_iterator anIter = myMapIOSubIndex.find(theIO);
   if(anIter != myMapIOSubIndex.end())
-    theIndex = anIter->second.myMap;
+    anIter->second.GetIndex(theIndex);
+  else
+    theIndex.Clear();
+}
+
+/*!
+  Gets indices of subselection for SALOME_InteractiveObject
+  \param theIO - SALOME_InteractiveObject
+*/
+void 
+SVTK_SelectorDef
+::GetIndex( const Handle(SALOME_InteractiveObject)& theIO, 
+            SVTK_IdBitmap& theIndex)
+{
+  TMapIOSubIndex::const_iterator anIter = myMapIOSubIndex.find(theIO);
+  if(anIter != myMapIOSubIndex.end())
+    theIndex = anIter->second.myIds;
   else
     theIndex.Clear();
 }
@@ -293,36 +432,12 @@ SVTK_SelectorDef
                   int theIndex) const
 {
   TMapIOSubIndex::const_iterator anIter = myMapIOSubIndex.find(theIO);
-  if(anIter != myMapIOSubIndex.end()){
-    const SVTK_TIndexedMapOfVtkId& aMapIndex = anIter->second.myMap;
-    return aMapIndex.Contains( theIndex ) == Standard_True;
-  }
+  if(anIter != myMapIOSubIndex.end())
+    return anIter->second.myIds.Contains( theIndex );
 
   return false;
 }
 
-static bool removeIndex(SVTK_TIndexedMapOfVtkId& theMapIndex, const int theIndex)
-{
-  int anId = theMapIndex.FindIndex(theIndex); // i==0 if Index is not in the MapIndex
-  if(anId){
-    // only the last key can be removed
-    int aLastId = theMapIndex.FindKey(theMapIndex.Extent());
-    if(aLastId == anId)
-      theMapIndex.RemoveLast();
-    else{
-      SVTK_TIndexedMapOfVtkId aNewMap;
-      aNewMap.ReSize(theMapIndex.Extent()-1);
-      for(int j = 1; j <= theMapIndex.Extent(); j++){
-        int anIndex = theMapIndex(j);
-        if ( anIndex != theIndex )
-          aNewMap.Add( anIndex );
-      }
-      theMapIndex = aNewMap;
-    }
-  }
-  return anId != 0;
-}
-
 static bool removeCompositeIndex( SVTK_IndexedMapOfVtkIds& theMapIndex, const SVTK_ListOfVtk theIds )
 {
   int anId = theMapIndex.FindIndex( theIds ); // i==0 if Index is not in the MapIndex
@@ -360,20 +475,18 @@ SVTK_SelectorDef
 {
   TMapIOSubIndex::iterator aMapIter = myMapIOSubIndex.find(theIO);
   if(aMapIter == myMapIOSubIndex.end()){
-    TIndexedMapOfInteger anEmpty;
     aMapIter = myMapIOSubIndex.
-      insert(TMapIOSubIndex::value_type(theIO,anEmpty)).first;
+      insert(TMapIOSubIndex::value_type(theIO,TSubIndex())).first;
   }
-  SVTK_TIndexedMapOfVtkId& aMapIndex = aMapIter->second.myMap;
+  TSubIndex& aSubIndex = aMapIter->second;
 
   if(!theIsModeShift)
-    aMapIndex.Clear();
+    aSubIndex.Clear();
   
-  for(int i = 1, iEnd = theIndices.Extent(); i <= iEnd; i++)
-    aMapIndex.Add(theIndices(i));
+  aSubIndex.Add(theIndices);
   
-  if(aMapIndex.IsEmpty()) {
-    myMapIOSubIndex.erase(theIO);
+  if(aSubIndex.myIds.IsEmpty()) {
+    myMapIOSubIndex.erase(aMapIter);
     return false;
   }
 
@@ -392,24 +505,39 @@ SVTK_SelectorDef
 ::AddOrRemoveIndex( const Handle(SALOME_InteractiveObject)& theIO, 
                     const SVTK_TVtkIDsMap& theIndices, 
                     bool theIsModeShift)
+{
+  SVTK_IdBitmap anIndices;
+  anIndices.Union(theIndices);
+  return AddOrRemoveIndex(theIO, anIndices, theIsModeShift);
+}
+
+
+/*!
+  Changes indices of subselection for SALOME_InteractiveObject
+  \param theIO - SALOME_InteractiveObject
+  \param theIndices - indices
+  \param theIsModeShift - if it is false, then map will be cleared before indices are added
+*/
+bool
+SVTK_SelectorDef
+::AddOrRemoveIndex( const Handle(SALOME_InteractiveObject)& theIO, 
+                    const SVTK_IdBitmap& theIndices, 
+                    bool theIsModeShift)
 {
   TMapIOSubIndex::iterator aMapIter = myMapIOSubIndex.find(theIO);
   if(aMapIter == myMapIOSubIndex.end()){
-    TIndexedMapOfInteger anEmpty;
     aMapIter = myMapIOSubIndex.
-      insert(TMapIOSubIndex::value_type(theIO,anEmpty)).first;
+      insert(TMapIOSubIndex::value_type(theIO,TSubIndex())).first;
   }
-  SVTK_TIndexedMapOfVtkId& aMapIndex = aMapIter->second.myMap;
+  TSubIndex& aSubIndex = aMapIter->second;
 
   if(!theIsModeShift)
-    aMapIndex.Clear();
+    aSubIndex.Clear();
   
-  SVTK_TVtkIDsMapIterator anIter(theIndices);
-  for(; anIter.More(); anIter.Next())
-    aMapIndex.Add(anIter.Key());
+  aSubIndex.Add(theIndices);
   
-  if(aMapIndex.IsEmpty()) {
-    myMapIOSubIndex.erase(theIO);
+  if(aSubIndex.myIds.IsEmpty()) {
+    myMapIOSubIndex.erase(aMapIter);
     return false;
   }
 
@@ -431,24 +559,23 @@ SVTK_SelectorDef
 {
   TMapIOSubIndex::iterator anIter = myMapIOSubIndex.find(theIO);
   if(anIter == myMapIOSubIndex.end()){
-    TIndexedMapOfInteger anEmpty;
     anIter = myMapIOSubIndex.
-      insert(TMapIOSubIndex::value_type(theIO,anEmpty)).first;
+      insert(TMapIOSubIndex::value_type(theIO,TSubIndex())).first;
   }
-  SVTK_TIndexedMapOfVtkId& aMapIndex = anIter->second.myMap;
+  TSubIndex& aSubIndex = anIter->second;
 
-  bool anIsConatains = aMapIndex.Contains( theIndex ) == Standard_True;
+  bool anIsConatains = aSubIndex.myIds.Contains( theIndex );
   if ( anIsConatains )
-    removeIndex( aMapIndex, theIndex );
+    aSubIndex.Remove( theIndex );
   
   if ( !theIsModeShift )
-    aMapIndex.Clear();
+    aSubIndex.Clear();
   
   if ( !anIsConatains )
-    aMapIndex.Add( theIndex );
+    aSubIndex.Add( theIndex );
 
-  if ( aMapIndex.IsEmpty() )
-    myMapIOSubIndex.erase( theIO );
+  if ( aSubIndex.myIds.IsEmpty() )
+    myMapIOSubIndex.erase( anIter );
 
   return false;
 }
@@ -464,11 +591,24 @@ SVTK_SelectorDef
 ::RemoveIndex( const Handle(SALOME_InteractiveObject)& theIO, 
                int theIndex)
 {
-  if(IsIndexSelected(theIO,theIndex)){
-    TMapIOSubIndex::iterator anIter = myMapIOSubIndex.find(theIO);
-    SVTK_TIndexedMapOfVtkId& aMapIndex = anIter->second.myMap;
-    removeIndex(aMapIndex,theIndex);
-  }
+  TMapIOSubIndex::iterator anIter = myMapIOSubIndex.find(theIO);
+  if(anIter != myMapIOSubIndex.end())
+    anIter->second.Remove(theIndex);
+}
+
+/*!
+  Removes indices of subselection for SALOME_InteractiveObject
+  \param theIO - SALOME_InteractiveObject
+  \param theIndices - indices
+*/
+void
+SVTK_SelectorDef
+::RemoveIndex( const Handle(SALOME_InteractiveObject)& theIO, 
+               const SVTK_IdBitmap& theIndices)
+{
+  TMapIOSubIndex::iterator anIter = myMapIOSubIndex.find(theIO);
+  if(anIter != myMapIOSubIndex.end())
+    anIter->second.Remove(theIndices);
 }
 
 /*!
@@ -30,6 +30,7 @@
 #include "SVTK.h"
 #include "SVTK_Selection.h"
 #include "SVTK_Hash.h"
+#include "SVTK_IdBitmap.h"
 
 #include "SALOME_ListIO.hxx"
 
@@ -131,6 +132,12 @@ public:
   void 
   GetIndex( const Handle(SALOME_InteractiveObject)& theIO, 
             SVTK_TIndexedMapOfVtkId& theIndex ) = 0;
+
+  //! Get indexes of subslection for given #SALOME_InteractiveObject, without converting them
+  virtual
+  void 
+  GetIndex( const Handle(SALOME_InteractiveObject)& theIO, 
+            SVTK_IdBitmap& theIndex ) = 0;
         
   //! Change indices of subselection for given #SALOME_InteractiveObject
   virtual
@@ -146,6 +153,13 @@ public:
                     const SVTK_TVtkIDsMap& theIndices, 
                     bool theIsModeShift) = 0;
 
+  //! Change indexes of subslection for given #SALOME_InteractiveObject (union with the current ones)
+  virtual
+  bool 
+  AddOrRemoveIndex( const Handle(SALOME_InteractiveObject)& theIO, 
+                    const SVTK_IdBitmap& theIndices, 
+                    bool theIsModeShift) = 0;
+
   //! Change index of subslection for given #SALOME_InteractiveObject
   virtual
   bool
@@ -159,6 +173,12 @@ public:
   RemoveIndex( const Handle(SALOME_InteractiveObject)& theIO, 
                int theIndex) = 0;
 
+  //! Remove indexes from subslection of given #SALOME_InteractiveObject (difference)
+  virtual
+  void 
+  RemoveIndex( const Handle(SALOME_InteractiveObject)& theIO, 
+               const SVTK_IdBitmap& theIndices) = 0;
+
   //! Check, if the given index is present in subselection 
   virtual
   bool 
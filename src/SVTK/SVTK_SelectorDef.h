@@ -28,9 +28,11 @@
 #define SVTK_SELECTORDEF_H
 
 #include "SVTK_Selector.h"
+#include "SVTK_IdBitmap.h"
 
 #include <set>
 #include <map>
+#include <vector>
 
 #include <TColStd_IndexedMapOfInteger.hxx>
 #include <TColStd_MapOfInteger.hxx>
@@ -107,6 +109,11 @@ public:
   void 
   GetIndex( const Handle(SALOME_InteractiveObject)& theIO, 
             SVTK_TIndexedMapOfVtkId& theIndex );
+
+  virtual
+  void 
+  GetIndex( const Handle(SALOME_InteractiveObject)& theIO, 
+            SVTK_IdBitmap& theIndex );
         
   virtual
   bool 
@@ -119,6 +126,11 @@ public:
                     const SVTK_TVtkIDsMap& theIndices, 
                     bool theIsModeShift);
   virtual
+  bool 
+  AddOrRemoveIndex( const Handle(SALOME_InteractiveObject)& theIO, 
+                    const SVTK_IdBitmap& theIndices, 
+                    bool theIsModeShift);
+  virtual
   bool
   AddOrRemoveIndex( const Handle(SALOME_InteractiveObject)& theIO, 
                     int theIndex, 
@@ -128,6 +140,10 @@ public:
   RemoveIndex( const Handle(SALOME_InteractiveObject)& theIO, 
                int theIndex);
   virtual
+  void 
+  RemoveIndex( const Handle(SALOME_InteractiveObject)& theIO, 
+               const SVTK_IdBitmap& theIndices);
+  virtual
   bool 
   IsIndexSelected(const Handle(SALOME_InteractiveObject)& theIO, 
                   int theIndex) const;
@@ -253,15 +269,40 @@ private:
     }
   };
 
-  struct TIndexedMapOfInteger
+  //! Subselection of an object
+  /*!
+    The indices are kept in a compressed bitmap. The order in which they have been
+    selected is also kept while the subselection is small (elements picked one by one),
+    as some of the clients rely on it; the big ones are given in ascending order.
+  */
+  struct TSubIndex
   {
-    SVTK_TIndexedMapOfVtkId myMap;
-    TIndexedMapOfInteger()
-    {}
-    TIndexedMapOfInteger(const TIndexedMapOfInteger& theIndexedMapOfInteger)
-    {
-      myMap = theIndexedMapOfInteger.myMap;
-    }
+    SVTK_IdBitmap myIds;
+    std::vector<vtkIdType> myOrder;
+    bool myIsOrdered;
+
+    TSubIndex(): myIsOrdered(true) {}
+
+    void
+    Add(vtkIdType theIndex);
+
+    void
+    Add(const SVTK_TIndexedMapOfVtkId& theIndices);
+
+    void
+    Add(const SVTK_IdBitmap& theIndices);
+
+    void
+    Remove(vtkIdType theIndex);
+
+    void
+    Remove(const SVTK_IdBitmap& theIndices);
+
+    void
+    Clear();
+
+    void
+    GetIndex(SVTK_TIndexedMapOfVtkId& theIndex) const;
   };
 
   mutable SALOME_ListIO myIObjectList;
@@ -275,7 +316,7 @@ private:
   TIO2Actors myIO2Actors;
 
   typedef std::map<Handle(SALOME_InteractiveObject),
-                   TIndexedMapOfInteger,
+                   TSubIndex,
                    TIOLessThan> TMapIOSubIndex;
   TMapIOSubIndex myMapIOSubIndex;
 
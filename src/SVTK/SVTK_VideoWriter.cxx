@@ -0,0 +1,425 @@
+// Copyright (C) 2007-2026  CEA, EDF, OPEN CASCADE
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+//
+// See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+//
+
+#include "SVTK_VideoWriter.h"
+
+#include "utilities.h"
+
+#include <vtkImageData.h>
+#include <vtkType.h>
+
+#include <iostream>
+#include <sstream>
+#include <math.h>
+
+namespace
+{
+  //----------------------------------------------------------------------------
+  // AVI headers are little endian, whatever the platform is
+  inline
+  void
+  PutUInt32(std::ostream& theStream, unsigned int theValue)
+  {
+    char aBytes[4] = { char(theValue & 0xFF), char((theValue >> 8) & 0xFF),
+                       char((theValue >> 16) & 0xFF), char((theValue >> 24) & 0xFF) };
+    theStream.write(aBytes, 4);
+  }
+
+  inline
+  void
+  PutUInt16(std::ostream& theStream, unsigned int theValue)
+  {
+    char aBytes[2] = { char(theValue & 0xFF), char((theValue >> 8) & 0xFF) };
+    theStream.write(aBytes, 2);
+  }
+
+  inline
+  void
+  PutFourCC(std::ostream& theStream, const char* theFourCC)
+  {
+    theStream.write(theFourCC, 4);
+  }
+
+  //----------------------------------------------------------------------------
+  // Offsets of the fields patched when the AVI file is closed
+  const std::streamoff AVI_RIFF_SIZE = 4;
+  const std::streamoff AVI_TOTAL_FRAMES = 48;
+  const std::streamoff AVI_STREAM_LENGTH = 140;
+  const std::streamoff AVI_MOVI_SIZE = 216;
+  const std::streamoff AVI_MOVI_LIST = 220;
+
+  const unsigned long long AVI_MAX_SIZE = 0xFFFFFFFFull;
+
+  inline
+  int
+  GetAVIRowSize(int theWidth)
+  {
+    return (3*theWidth + 3) & ~3; // DIB rows are aligned on 4 bytes
+  }
+
+  //----------------------------------------------------------------------------
+  // Frame rate as a ratio of integers, as it is stored in the files
+  inline
+  void
+  GetRate(double theNbFPS, unsigned int& theRate, unsigned int& theScale)
+  {
+    theScale = 1000;
+    theRate = (unsigned int)floor(theNbFPS*theScale + 0.5);
+    if(theRate == 0)
+      theRate = 1;
+  }
+
+  //----------------------------------------------------------------------------
+  inline
+  unsigned char
+  ClampByte(int theValue)
+  {
+    return (unsigned char)(theValue < 0 ? 0 : (theValue > 255 ? 255 : theValue));
+  }
+}
+
+
+//----------------------------------------------------------------------------
+SVTK_VideoWriter
+::SVTK_VideoWriter():
+  myFormat(SVTK_VideoWriter_Y4M),
+  myNbFPS(0.0),
+  myIsOk(false),
+  myWidth(0),
+  myHeight(0),
+  myNbFrames(0),
+  myMoviOffset(0)
+{}
+
+
+//----------------------------------------------------------------------------
+SVTK_VideoWriter
+::~SVTK_VideoWriter()
+{
+  Close();
+}
+
+
+//----------------------------------------------------------------------------
+bool
+SVTK_VideoWriter
+::Open(const std::string& theName,
+       EFormat theFormat,
+       double theNbFPS)
+{
+  Close();
+
+  myFormat = theFormat;
+  myNbFPS = theNbFPS;
+  myWidth = myHeight = myNbFrames = 0;
+  myFrame.clear();
+
+  myStream.open(theName.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+  myIsOk = myStream.is_open();
+
+  if(SALOME::VerbosityActivated())
+    std::cout << "SVTK_VideoWriter::Open - " << theName << "; myIsOk = " << myIsOk << endl;
+
+  return myIsOk;
+}
+
+
+//----------------------------------------------------------------------------
+bool
+SVTK_VideoWriter
+::IsOpen() const
+{
+  return myStream.is_open();
+}
+
+
+//----------------------------------------------------------------------------
+int
+SVTK_VideoWriter
+::NbWrittenFrames() const
+{
+  return myNbFrames;
+}
+
+
+//----------------------------------------------------------------------------
+bool
+SVTK_VideoWriter
+::Write(vtkImageData* theImageData,
+        int theNbRepeats)
+{
+  if(!myIsOk || !theImageData)
+    return false;
+
+  if(myNbFrames == 0){
+    int aDims[3];
+    theImageData->GetDimensions(aDims);
+    // 4:2:0 chroma subsampling needs even sizes
+    myWidth = aDims[0] & ~1;
+    myHeight = aDims[1] & ~1;
+    if(myWidth <= 0 || myHeight <= 0 || !WriteHeader())
+      return myIsOk = false;
+  }
+  else{
+    for(int anId = 0; anId < theNbRepeats && myIsOk; anId++)
+      myIsOk = WriteFrame();
+  }
+
+  if(myIsOk){
+    ConvertFrame(theImageData);
+    myIsOk = WriteFrame();
+  }
+
+  return myIsOk;
+}
+
+
+//----------------------------------------------------------------------------
+bool
+SVTK_VideoWriter
+::WriteHeader()
+{
+  unsigned int aRate, aScale;
+  GetRate(myNbFPS, aRate, aScale);
+
+  if(myFormat == SVTK_VideoWriter_Y4M){
+    std::ostringstream aHeader;
+    aHeader<<"YUV4MPEG2 W"<<myWidth<<" H"<<myHeight<<" F"<<aRate<<":"<<aScale<<" Ip A1:1 C420jpeg\n";
+    myStream<<aHeader.str();
+    return myStream.good();
+  }
+
+  // The sizes and the number of frames are patched by Close()
+  unsigned int aFrameSize = GetAVIRowSize(myWidth)*myHeight;
+  unsigned int aMicroSecPerFrame = (unsigned int)floor(1.0E6/myNbFPS + 0.5);
+
+  PutFourCC(myStream, "RIFF");
+  PutUInt32(myStream, 0);
+  PutFourCC(myStream, "AVI ");
+
+  PutFourCC(myStream, "LIST");
+  PutUInt32(myStream, 192);
+  PutFourCC(myStream, "hdrl");
+
+  PutFourCC(myStream, "avih");
+  PutUInt32(myStream, 56);
+  PutUInt32(myStream, aMicroSecPerFrame);
+  PutUInt32(myStream, (unsigned int)(aFrameSize*myNbFPS)); // max bytes per second
+  PutUInt32(myStream, 0);          // padding granularity
+  PutUInt32(myStream, 0x10);       // AVIF_HASINDEX
+  PutUInt32(myStream, 0);          // total frames
+  PutUInt32(myStream, 0);          // initial frames
+  PutUInt32(myStream, 1);          // streams
+  PutUInt32(myStream, aFrameSize); // suggested buffer size
+  PutUInt32(myStream, myWidth);
+  PutUInt32(myStream, myHeight);
+  for(int anId = 0; anId < 4; anId++)
+    PutUInt32(myStream, 0);        // reserved
+
+  PutFourCC(myStream, "LIST");
+  PutUInt32(myStream, 116);
+  PutFourCC(myStream, "strl");
+
+  PutFourCC(myStream, "strh");
+  PutUInt32(myStream, 56);
+  PutFourCC(myStream, "vids");
+  PutFourCC(myStream, "DIB ");
+  PutUInt32(myStream, 0);          // flags
+  PutUInt16(myStream, 0);          // priority
+  PutUInt16(myStream, 0);          // language
+  PutUInt32(myStream, 0);          // initial frames
+  PutUInt32(myStream, aScale);
+  PutUInt32(myStream, aRate);
+  PutUInt32(myStream, 0);          // start
+  PutUInt32(myStream, 0);          // length
+  PutUInt32(myStream, aFrameSize); // suggested buffer size
+  PutUInt32(myStream, 0xFFFFFFFF); // default quality
+  PutUInt32(myStream, aFrameSize); // sample size
+  PutUInt16(myStream, 0);
+  PutUInt16(myStream, 0);
+  PutUInt16(myStream, myWidth);
+  PutUInt16(myStream, myHeight);
+
+  PutFourCC(myStream, "strf");
+  PutUInt32(myStream, 40);
+  PutUInt32(myStream, 40);         // BITMAPINFOHEADER size
+  PutUInt32(myStream, myWidth);
+  PutUInt32(myStream, myHeight);   // positive height: bottom-up rows
+  PutUInt16(myStream, 1);          // planes
+  PutUInt16(myStream, 24);         // bits per pixel
+  PutUInt32(myStream, 0);          // BI_RGB
+  PutUInt32(myStream, aFrameSize);
+  PutUInt32(myStream, 0);
+  PutUInt32(myStream, 0);
+  PutUInt32(myStream, 0);
+  PutUInt32(myStream, 0);
+
+  PutFourCC(myStream, "LIST");
+  PutUInt32(myStream, 0);
+  myMoviOffset = myStream.tellp();
+  PutFourCC(myStream, "movi");
+
+  return myStream.good() && myMoviOffset == AVI_MOVI_LIST;
+}
+
+
+//----------------------------------------------------------------------------
+void
+SVTK_VideoWriter
+::ConvertFrame(vtkImageData* theImageData)
+{
+  int aDims[3];
+  theImageData->GetDimensions(aDims);
+  int aNbComp = theImageData->GetNumberOfScalarComponents();
+  const unsigned char* aData = NULL;
+  if(theImageData->GetScalarType() == VTK_UNSIGNED_CHAR && aNbComp >= 3)
+    aData = static_cast<const unsigned char*>(theImageData->GetScalarPointer());
+
+  // Pixels are addressed from the bottom-left corner, as in vtkImageData;
+  // the parts out of the image are black
+  auto GetRGB = [&](int theX, int theY, int theRGB[3])
+  {
+    if(aData && theX < aDims[0] && theY < aDims[1]){
+      const unsigned char* aPixel = aData + ((size_t)theY*aDims[0] + theX)*aNbComp;
+      theRGB[0] = aPixel[0];
+      theRGB[1] = aPixel[1];
+      theRGB[2] = aPixel[2];
+    }
+    else
+      theRGB[0] = theRGB[1] = theRGB[2] = 0;
+  };
+
+  if(myFormat == SVTK_VideoWriter_AVI){
+    int aRowSize = GetAVIRowSize(myWidth);
+    myFrame.assign((size_t)aRowSize*myHeight, 0);
+    for(int aY = 0; aY < myHeight; aY++){
+      unsigned char* aRow = &myFrame[(size_t)aY*aRowSize];
+      for(int aX = 0; aX < myWidth; aX++){
+        int aRGB[3];
+        GetRGB(aX, aY, aRGB);
+        aRow[3*aX + 0] = (unsigned char)aRGB[2];
+        aRow[3*aX + 1] = (unsigned char)aRGB[1];
+        aRow[3*aX + 2] = (unsigned char)aRGB[0];
+      }
+    }
+    return;
+  }
+
+  // BT.601 studio range, chroma averaged over 2x2 pixels
+  size_t aLumaSize = (size_t)myWidth*myHeight;
+  size_t aChromaSize = aLumaSize/4;
+  myFrame.resize(aLumaSize + 2*aChromaSize);
+  unsigned char* aY = &myFrame[0];
+  unsigned char* aU = aY + aLumaSize;
+  unsigned char* aV = aU + aChromaSize;
+  for(int aRow = 0; aRow < myHeight; aRow += 2){
+    for(int aCol = 0; aCol < myWidth; aCol += 2){
+      int aSumU = 0, aSumV = 0;
+      for(int aDY = 0; aDY < 2; aDY++){
+        for(int aDX = 0; aDX < 2; aDX++){
+          int aRGB[3];
+          // Y4M rows are top-down
+          GetRGB(aCol + aDX, myHeight - 1 - (aRow + aDY), aRGB);
+          int aLuma = ((66*aRGB[0] + 129*aRGB[1] + 25*aRGB[2] + 128) >> 8) + 16;
+          aY[(size_t)(aRow + aDY)*myWidth + aCol + aDX] = ClampByte(aLuma);
+          aSumU += ((-38*aRGB[0] - 74*aRGB[1] + 112*aRGB[2] + 128) >> 8) + 128;
+          aSumV += ((112*aRGB[0] - 94*aRGB[1] - 18*aRGB[2] + 128) >> 8) + 128;
+        }
+      }
+      size_t aChromaId = (size_t)(aRow/2)*(myWidth/2) + aCol/2;
+      aU[aChromaId] = ClampByte((aSumU + 2) / 4);
+      aV[aChromaId] = ClampByte((aSumV + 2) / 4);
+    }
+  }
+}
+
+
+//----------------------------------------------------------------------------
+bool
+SVTK_VideoWriter
+::WriteFrame()
+{
+  if(myFrame.empty())
+    return false;
+
+  if(myFormat == SVTK_VideoWriter_Y4M){
+    myStream<<"FRAME\n";
+  }
+  else{
+    // The file, including the index written on close, has to fit in the RIFF limits
+    unsigned long long aSize = (unsigned long long)myStream.tellp() + 8 + myFrame.size() +
+      8 + 16ull*(myNbFrames + 1);
+    if(aSize > AVI_MAX_SIZE){
+      if(SALOME::VerbosityActivated())
+        std::cout << "SVTK_VideoWriter::WriteFrame - AVI size limit is reached" << endl;
+      return false;
+    }
+    PutFourCC(myStream, "00db");
+    PutUInt32(myStream, (unsigned int)myFrame.size());
+  }
+  myStream.write(reinterpret_cast<const char*>(&myFrame[0]), myFrame.size());
+  if(!myStream.good())
+    return false;
+
+  myNbFrames++;
+  return true;
+}
+
+
+//----------------------------------------------------------------------------
+bool
+SVTK_VideoWriter
+::Close()
+{
+  if(!myStream.is_open())
+    return myIsOk;
+
+  if(myFormat == SVTK_VideoWriter_AVI && myNbFrames > 0){
+    unsigned int aChunkSize = 8 + (unsigned int)myFrame.size();
+    unsigned int aMoviSize = 4 + myNbFrames*aChunkSize;
+
+    PutFourCC(myStream, "idx1");
+    PutUInt32(myStream, 16*myNbFrames);
+    for(int anId = 0; anId < myNbFrames; anId++){
+      PutFourCC(myStream, "00db");
+      PutUInt32(myStream, 0x10); // AVIIF_KEYFRAME
+      PutUInt32(myStream, 4 + anId*aChunkSize);
+      PutUInt32(myStream, (unsigned int)myFrame.size());
+    }
+    unsigned int aFileSize = (unsigned int)myStream.tellp();
+
+    myStream.seekp(AVI_RIFF_SIZE);
+    PutUInt32(myStream, aFileSize - 8);
+    myStream.seekp(AVI_TOTAL_FRAMES);
+    PutUInt32(myStream, myNbFrames);
+    myStream.seekp(AVI_STREAM_LENGTH);
+    PutUInt32(myStream, myNbFrames);
+    myStream.seekp(AVI_MOVI_SIZE);
+    PutUInt32(myStream, aMoviSize);
+  }
+
+  myIsOk = myIsOk && myStream.good();
+  myStream.close();
+  myFrame.clear();
+
+  if(SALOME::VerbosityActivated())
+    std::cout << "SVTK_VideoWriter::Close - myNbFrames = " << myNbFrames << "; myIsOk = " << myIsOk << endl;
+
+  return myIsOk;
+}
@@ -0,0 +1,97 @@
+// Copyright (C) 2007-2026  CEA, EDF, OPEN CASCADE
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+//
+// See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+//
+
+#ifndef SVTK_VIDEOWRITER_H
+#define SVTK_VIDEOWRITER_H
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+class vtkImageData;
+
+/*!
+  Streams the recorded frames into a single video file, without any external tool:
+  - YUV4MPEG2 (4:2:0), readable by most of the video encoders and players;
+  - uncompressed AVI (24 bits DIB), limited to 4 GB as the RIFF format is.
+  The size of the video is defined by the first frame (made even), the next frames
+  are cropped or padded to it. Not thread-safe: the frames have to be written in order.
+*/
+class SVTK_VideoWriter
+{
+ public:
+  enum EFormat {
+    SVTK_VideoWriter_Y4M = 0,
+    SVTK_VideoWriter_AVI
+  };
+
+  SVTK_VideoWriter();
+
+  ~SVTK_VideoWriter();
+
+  //! Creates the file; the header is written with the first frame
+  bool
+  Open(const std::string& theName,
+       EFormat theFormat,
+       double theNbFPS);
+
+  //! Repeats the previous frame \a theNbRepeats times, then appends the given one
+  bool
+  Write(vtkImageData* theImageData,
+        int theNbRepeats);
+
+  //! Finalizes the headers and closes the file
+  bool
+  Close();
+
+  bool
+  IsOpen() const;
+
+  int
+  NbWrittenFrames() const;
+
+ protected:
+  bool
+  WriteHeader();
+
+  bool
+  WriteFrame();
+
+  void
+  ConvertFrame(vtkImageData* theImageData);
+
+ protected:
+  std::ofstream myStream;
+  EFormat myFormat;
+  double myNbFPS;
+  bool myIsOk;
+
+  int myWidth;
+  int myHeight;
+  int myNbFrames;
+
+  std::vector<unsigned char> myFrame; //!< last frame, in the format of the file
+  std::streamoff myMoviOffset;        //!< AVI: position of 'movi' list
+
+ private:
+  SVTK_VideoWriter(const SVTK_VideoWriter&);  //Not implemented
+  void operator=(const SVTK_VideoWriter&);    //Not implemented
+};
+
+#endif
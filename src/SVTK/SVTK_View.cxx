@@ -39,6 +39,52 @@
 #include <vtkRenderer.h>
 #include <vtkProperty.h>
 
+namespace SVTK
+{
+  /*!
+    Applies the action to the actors having the same #SALOME_InteractiveObject;
+    when the object has an entry, the actors are taken from the index of the renderer
+  */
+  template<class TAction>
+  void
+  ForEachIObjectActor(SVTK_Renderer* theRenderer,
+                      const Handle(SALOME_InteractiveObject)& theIObject,
+                      TAction theAction)
+  {
+    TIsSameIObject<SALOME_Actor> aPredicate(theIObject);
+    if(!theIObject.IsNull() && theIObject->hasEntry()){
+      SVTK_Renderer::TActors anActors;
+      theRenderer->FindActors(theIObject->getEntry(), anActors);
+      for(size_t anId = 0; anId < anActors.size(); anId++)
+        if(aPredicate(anActors[anId]))
+          theAction(anActors[anId]);
+      return;
+    }
+    VTK::ActorCollectionCopy aCopy(theRenderer->GetDevice()->GetActors());
+    ForEachIf<SALOME_Actor>(aCopy.GetActors(), aPredicate, theAction);
+  }
+
+  /*!
+    Finds the first actor having the same #SALOME_InteractiveObject
+  */
+  SALOME_Actor*
+  FindIObjectActor(SVTK_Renderer* theRenderer,
+                   const Handle(SALOME_InteractiveObject)& theIObject)
+  {
+    TIsSameIObject<SALOME_Actor> aPredicate(theIObject);
+    if(!theIObject.IsNull() && theIObject->hasEntry()){
+      SVTK_Renderer::TActors anActors;
+      theRenderer->FindActors(theIObject->getEntry(), anActors);
+      for(size_t anId = 0; anId < anActors.size(); anId++)
+        if(aPredicate(anActors[anId]))
+          return anActors[anId];
+      return NULL;
+    }
+    VTK::ActorCollectionCopy aCopy(theRenderer->GetDevice()->GetActors());
+    return Find<SALOME_Actor>(aCopy.GetActors(), aPredicate);
+  }
+}
+
 /*!
   Constructor
 */
@@ -152,9 +198,9 @@ SVTK_SignalHandler
   const SALOME_ListIO& aListIO = aSelector->StoredIObjects();
   SALOME_ListIteratorOfListIO anIter(aListIO);
   for(; anIter.More(); anIter.Next()){
-    ForEachIf<SALOME_Actor>(anActors,
-                            TIsSameIObject<SALOME_Actor>(anIter.Value()),
-                            THighlightAction(true));
+    ForEachIObjectActor(myMainWindow->GetRenderer(),
+                        anIter.Value(),
+                        THighlightAction(true));
   }
 
   myMainWindow->Repaint(false);
@@ -204,10 +250,9 @@ SVTK_View
              bool /*theIsUpdate*/ ) 
 {
   using namespace SVTK;
-  VTK::ActorCollectionCopy aCopy(getRenderer()->GetActors());
-  ForEachIf<SALOME_Actor>(aCopy.GetActors(),
-                          TIsSameIObject<SALOME_Actor>( theIO ),
-                          THighlightAction(theIsHighlight));
+  ForEachIObjectActor(GetRenderer(),
+                      theIO,
+                      THighlightAction(theIsHighlight));
   Repaint();
 }
 
@@ -220,12 +265,12 @@ SVTK_View
 ::FindIObject(const char* theEntry) 
 {
   using namespace SVTK;
-  VTK::ActorCollectionCopy aCopy(getRenderer()->GetActors());
-  SALOME_Actor* anActor = 
-    Find<SALOME_Actor>(aCopy.GetActors(),
-                       TIsSameEntry<SALOME_Actor>(theEntry));
-  if(anActor != NULL)
-    return anActor->getIO();
+  SVTK_Renderer::TActors anActors;
+  GetRenderer()->FindActors(theEntry, anActors);
+  TIsSameEntry<SALOME_Actor> aPredicate(theEntry);
+  for(size_t anId = 0; anId < anActors.size(); anId++)
+    if(aPredicate(anActors[anId]))
+      return anActors[anId]->getIO();
  
   return NULL;
 }
@@ -277,10 +322,7 @@ SVTK_View
 ::isInViewer(const Handle(SALOME_InteractiveObject)& theIObject)
 {
   using namespace SVTK;
-  VTK::ActorCollectionCopy aCopy(getRenderer()->GetActors());
-  SALOME_Actor* anActor = 
-    Find<SALOME_Actor>(aCopy.GetActors(),
-                       TIsSameIObject<SALOME_Actor>(theIObject));
+  SALOME_Actor* anActor = FindIObjectActor(GetRenderer(), theIObject);
   return anActor != NULL;
 }
 
@@ -313,10 +355,9 @@ SVTK_View
 {
   using namespace SVTK;
   bool aResult;
-  VTK::ActorCollectionCopy aCopy(getRenderer()->GetActors());
-  ForEachIf<SALOME_Actor>(aCopy.GetActors(),
-                          TIsSameIObject<SALOME_Actor>(theIObject),
-                          TIsActorVisibleAction(aResult));
+  ForEachIObjectActor(GetRenderer(),
+                      theIObject,
+                      TIsActorVisibleAction(aResult));
   return aResult;
 }
 
@@ -331,11 +372,10 @@ SVTK_View
          const QString& theName)
 {
   using namespace SVTK;
-  VTK::ActorCollectionCopy aCopy(getRenderer()->GetActors());
-  ForEachIf<SALOME_Actor>(aCopy.GetActors(),
-                          TIsSameIObject<SALOME_Actor>(theIObject),
-                          TSetFunction<SALOME_Actor,const char*,const char*>
-                          (&SALOME_Actor::setName,theName.toUtf8().data()));
+  ForEachIObjectActor(GetRenderer(),
+                      theIObject,
+                      TSetFunction<SALOME_Actor,const char*,const char*>
+                      (&SALOME_Actor::setName,theName.toUtf8().data()));
 }
 
 /*!
@@ -378,11 +418,10 @@ SVTK_View
                  int theMode)
 {
   using namespace SVTK;
-  VTK::ActorCollectionCopy aCopy(getRenderer()->GetActors());
-  ForEachIf<SALOME_Actor>(aCopy.GetActors(),
-                          TIsSameIObject<SALOME_Actor>(theIObject),
-                          TSetFunction<SALOME_Actor,int>
-                          (&SALOME_Actor::setDisplayMode,theMode));
+  ForEachIObjectActor(GetRenderer(),
+                      theIObject,
+                      TSetFunction<SALOME_Actor,int>
+                      (&SALOME_Actor::setDisplayMode,theMode));
 }
 
 /*!
@@ -540,10 +579,9 @@ SVTK_View
         bool theIsUpdate)
 {
   using namespace SVTK;
-  VTK::ActorCollectionCopy aCopy(getRenderer()->GetActors());
-  ForEachIf<SALOME_Actor>(aCopy.GetActors(),
-                          TIsSameIObject<SALOME_Actor>(theIObject),
-                          TErase());
+  ForEachIObjectActor(GetRenderer(),
+                      theIObject,
+                      TErase());
   if(theIsUpdate)
     Repaint();
 }
@@ -572,10 +610,9 @@ SVTK_View
           bool theIsUpdate)
 {
   using namespace SVTK;
-  VTK::ActorCollectionCopy aCopy(getRenderer()->GetActors());
-  ForEachIf<SALOME_Actor>(aCopy.GetActors(),
-                          TIsSameIObject<SALOME_Actor>(theIObject),
-                          TSetVisibility<SALOME_Actor>(true));
+  ForEachIObjectActor(GetRenderer(),
+                      theIObject,
+                      TSetVisibility<SALOME_Actor>(true));
 
   if(theIsUpdate)
     Repaint();
@@ -618,10 +655,9 @@ SVTK_View
          bool theIsUpdate)
 {
   using namespace SVTK;
-  VTK::ActorCollectionCopy aCopy(getRenderer()->GetActors());
-  ForEachIf<SALOME_Actor>(aCopy.GetActors(),
-                          TIsSameIObject<SALOME_Actor>(theIObject),
-                          TRemoveAction(GetRenderer()));
+  ForEachIObjectActor(GetRenderer(),
+                      theIObject,
+                      TRemoveAction(GetRenderer()));
   if(theIsUpdate)
     Repaint();
 }
@@ -646,16 +682,17 @@ void
 SVTK_View
 ::RemoveAll(bool theIsUpdate)
 {
-  vtkRenderer* aRenderer = getRenderer();
+  SVTK_Renderer* aRenderer = GetRenderer();
   VTK::ActorCollectionCopy aCopy(getRenderer()->GetActors());
   if(vtkActorCollection* anActors = aCopy.GetActors()){
     anActors->InitTraversal();
     while(vtkActor *anAct = anActors->GetNextActor()){
       if(SALOME_Actor* aSAct = SALOME_Actor::SafeDownCast(anAct)){
         if(aSAct->hasIO() && aSAct->getIO()->hasEntry())
-          aRenderer->RemoveActor( anAct );
+          aRenderer->RemoveActor( aSAct, false );
       }
     }
+    aRenderer->AdjustActors();
 
     if(theIsUpdate)
       Repaint();
@@ -671,10 +708,7 @@ SVTK_View
 ::GetTransparency(const Handle(SALOME_InteractiveObject)& theIObject) 
 {
   using namespace SVTK;
-  VTK::ActorCollectionCopy aCopy(getRenderer()->GetActors());
-  SALOME_Actor* anActor = 
-    Find<SALOME_Actor>(aCopy.GetActors(),
-                       TIsSameIObject<SALOME_Actor>(theIObject));
+  SALOME_Actor* anActor = FindIObjectActor(GetRenderer(), theIObject);
   if(anActor)
     return 1.0 - anActor->GetOpacity();
   return -1.0;
@@ -693,11 +727,10 @@ SVTK_View
 {
   double anOpacity = 1.0 - theTrans;
   using namespace SVTK;
-  VTK::ActorCollectionCopy aCopy(getRenderer()->GetActors());
-  ForEachIf<SALOME_Actor>(aCopy.GetActors(),
-                          TIsSameIObject<SALOME_Actor>(theIObject),
-                          TSetFunction<SALOME_Actor,double>
-                          (&SALOME_Actor::SetOpacity,anOpacity));
+  ForEachIObjectActor(GetRenderer(),
+                      theIObject,
+                      TSetFunction<SALOME_Actor,double>
+                      (&SALOME_Actor::SetOpacity,anOpacity));
 }
 
 /*!
@@ -713,11 +746,10 @@ SVTK_View
   double aColor[3] = {theColor.red()/255., theColor.green()/255., theColor.blue()/255.};
 
   using namespace SVTK;
-  VTK::ActorCollectionCopy aCopy(getRenderer()->GetActors());
-  ForEachIf<SALOME_Actor>(aCopy.GetActors(),
-                          TIsSameIObject<SALOME_Actor>(theIObject),
-                          TSetFunction<SALOME_Actor,const double*>
-                          (&SALOME_Actor::SetColor,aColor));
+  ForEachIObjectActor(GetRenderer(),
+                      theIObject,
+                      TSetFunction<SALOME_Actor,const double*>
+                      (&SALOME_Actor::SetColor,aColor));
 }
 
 
@@ -730,10 +762,7 @@ SVTK_View
 ::GetColor(const Handle(SALOME_InteractiveObject)& theIObject) 
 {
   using namespace SVTK;
-  VTK::ActorCollectionCopy aCopy(getRenderer()->GetActors());
-  SALOME_Actor* anActor = 
-    Find<SALOME_Actor>(aCopy.GetActors(),
-                       TIsSameIObject<SALOME_Actor>(theIObject));
+  SALOME_Actor* anActor = FindIObjectActor(GetRenderer(), theIObject);
   if(anActor){
     double r,g,b;
     anActor->GetColor(r,g,b);
@@ -755,14 +784,13 @@ SVTK_View
 	      vtkProperty* thePropF, vtkProperty* thePropB)
 {
   using namespace SVTK;
-  VTK::ActorCollectionCopy aCopy(getRenderer()->GetActors());
   std::vector<vtkProperty*> aProps;
   aProps.push_back( thePropF );
   aProps.push_back( thePropB );
-  ForEachIf<SALOME_Actor>(aCopy.GetActors(),
-                          TIsSameIObject<SALOME_Actor>(theIObject),
-                          TSetFunction<SALOME_Actor,std::vector<vtkProperty*> >
-                          (&SALOME_Actor::SetMaterial,aProps));
+  ForEachIObjectActor(GetRenderer(),
+                      theIObject,
+                      TSetFunction<SALOME_Actor,std::vector<vtkProperty*> >
+                      (&SALOME_Actor::SetMaterial,aProps));
 }
 
 /*!
@@ -775,10 +803,7 @@ SVTK_View
 ::GetFrontMaterial(const Handle(SALOME_InteractiveObject)& theIObject)
 {
   using namespace SVTK;
-  VTK::ActorCollectionCopy aCopy(getRenderer()->GetActors());
-  SALOME_Actor* anActor = 
-    Find<SALOME_Actor>(aCopy.GetActors(),
-                       TIsSameIObject<SALOME_Actor>(theIObject));
+  SALOME_Actor* anActor = FindIObjectActor(GetRenderer(), theIObject);
   if(anActor)
     return anActor->GetFrontMaterial();
   return NULL;
@@ -794,10 +819,7 @@ SVTK_View
 ::GetBackMaterial(const Handle(SALOME_InteractiveObject)& theIObject)
 {
   using namespace SVTK;
-  VTK::ActorCollectionCopy aCopy(getRenderer()->GetActors());
-  SALOME_Actor* anActor = 
-    Find<SALOME_Actor>(aCopy.GetActors(),
-                       TIsSameIObject<SALOME_Actor>(theIObject));
+  SALOME_Actor* anActor = FindIObjectActor(GetRenderer(), theIObject);
   if(anActor)
     return anActor->GetBackMaterial();
   return NULL;
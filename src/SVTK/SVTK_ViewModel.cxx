@@ -842,17 +842,10 @@ SALOME_Prs* SVTK_Viewer::CreatePrs( const char* entry )
   if ( entry ) {
     if(SVTK_ViewWindow* aViewWindow = dynamic_cast<SVTK_ViewWindow*>(getViewManager()->getActiveView()))
       if(SVTK_View* aView = aViewWindow->getView()){
-        vtkRenderer* aRenderer =  aView->getRenderer();
-        VTK::ActorCollectionCopy aCopy(aRenderer->GetActors());
-        vtkActorCollection* theActors = aCopy.GetActors();
-        theActors->InitTraversal();
-        vtkActor* ac;
-        while( ( ac = theActors->GetNextActor() ) ) {
-          SALOME_Actor* anActor = SALOME_Actor::SafeDownCast( ac );
-          if ( anActor && anActor->hasIO() && !strcmp( anActor->getIO()->getEntry(), entry ) ) {
-            prs->AddObject( ac );
-          }
-        }
+        SVTK_Renderer::TActors anActors;
+        aView->GetRenderer()->FindActors( entry, anActors );
+        for ( size_t i = 0; i < anActors.size(); i++ )
+          prs->AddObject( anActors[i] );
       }
   }
   return prs;
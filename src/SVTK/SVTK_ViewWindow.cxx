@@ -2663,15 +2663,22 @@ void SVTK_ViewWindow::activateGlobalPanning()
 
 void SVTK_ViewWindow::onStartRecording()
 {
+  SVTK_RecorderDlg* aRecorderDlg = new SVTK_RecorderDlg( this, myRecorder );
+
+  if( !aRecorderDlg->exec() )
+    return;
+
+  // the external tool is needed only for the JPEG based recording
   myRecorder->CheckExistAVIMaker();
   if (myRecorder->ErrorStatus()) {
     SUIT_MessageBox::warning(this, tr("ERROR"), tr("MSG_NO_AVI_MAKER") );
   }
   else {
-    SVTK_RecorderDlg* aRecorderDlg = new SVTK_RecorderDlg( this, myRecorder );
-
-    if( !aRecorderDlg->exec() )
+    myRecorder->Record();
+    if (myRecorder->ErrorStatus()) {
+      SUIT_MessageBox::warning(this, tr("ERROR"), tr("MSG_CANT_WRITE_VIDEO") );
       return;
+    }
 
     myStartAction->setEnabled( false );
     myPlayAction->setEnabled( false );
@@ -2682,8 +2689,6 @@ void SVTK_ViewWindow::onStartRecording()
     myPreRecordingMinSize = minimumSize();
     myPreRecordingMaxSize = maximumSize();
     setFixedSize( size() );
-
-    myRecorder->Record();
   }
 }
 
@@ -2715,6 +2720,8 @@ void SVTK_ViewWindow::onStopRecording()
   myStopAction->setEnabled( false );
 
   myRecorder->Stop();
+  if ( myRecorder->GetOutputFormat() != SVTK_Recorder::SVTK_Recorder_AVIMaker && myRecorder->ErrorStatus() )
+    SUIT_MessageBox::warning(this, tr("ERROR"), tr("MSG_CANT_WRITE_VIDEO") );
 
   setMinimumSize( myPreRecordingMinSize );
   setMaximumSize( myPreRecordingMaxSize );
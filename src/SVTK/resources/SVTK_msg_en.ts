@@ -346,6 +346,10 @@
         <translation>Tool jpeg2yuv, necessary for AVI recording, is not available.
 Please, refer to the documentation.</translation>
     </message>
+    <message>
+        <source>MSG_CANT_WRITE_VIDEO</source>
+        <translation>The video file can not be written.</translation>
+    </message>
 </context>
 <context>
     <name>SVTK_NonIsometricDlg</name>
@@ -435,6 +439,26 @@ Please, refer to the documentation.</translation>
         <source>FLT_AVI_FILES</source>
         <translation>AVI Files (*.avi)</translation>
     </message>
+    <message>
+        <source>FLT_Y4M_FILES</source>
+        <translation>Y4M Files (*.y4m)</translation>
+    </message>
+    <message>
+        <source>OUTPUT_FORMAT</source>
+        <translation>Output format : </translation>
+    </message>
+    <message>
+        <source>FORMAT_AVI_MAKER</source>
+        <translation>AVI (jpeg2yuv)</translation>
+    </message>
+    <message>
+        <source>FORMAT_RAW_AVI</source>
+        <translation>AVI (uncompressed)</translation>
+    </message>
+    <message>
+        <source>FORMAT_Y4M</source>
+        <translation>YUV4MPEG2 (Y4M)</translation>
+    </message>
     <message>
         <source>FPS</source>
         <translation>FPS : </translation>
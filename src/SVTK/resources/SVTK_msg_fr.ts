@@ -346,6 +346,10 @@
         <translation>L&apos;outil jpeg2yuv, requis pour enregistrer les fichiers AVI, n&apos;est pas disponible.
 Veuillez consulter la documentation.</translation>
     </message>
+    <message>
+        <source>MSG_CANT_WRITE_VIDEO</source>
+        <translation>Le fichier vidéo ne peut pas être écrit.</translation>
+    </message>
 </context>
 <context>
     <name>SVTK_NonIsometricDlg</name>
@@ -435,6 +439,26 @@ Veuillez consulter la documentation.</translation>
         <source>FLT_AVI_FILES</source>
         <translation>Fichiers AVI (*.avi)</translation>
     </message>
+    <message>
+        <source>FLT_Y4M_FILES</source>
+        <translation>Fichiers Y4M (*.y4m)</translation>
+    </message>
+    <message>
+        <source>OUTPUT_FORMAT</source>
+        <translation>Format de sortie : </translation>
+    </message>
+    <message>
+        <source>FORMAT_AVI_MAKER</source>
+        <translation>AVI (jpeg2yuv)</translation>
+    </message>
+    <message>
+        <source>FORMAT_RAW_AVI</source>
+        <translation>AVI (non compressé)</translation>
+    </message>
+    <message>
+        <source>FORMAT_Y4M</source>
+        <translation>YUV4MPEG2 (Y4M)</translation>
+    </message>
     <message>
         <source>FPS</source>
         <translation>FPS : </translation>
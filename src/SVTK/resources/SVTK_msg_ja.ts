@@ -345,6 +345,10 @@
       <source>MSG_NO_AVI_MAKER</source>
       <translation>AVI ファイルを保存するために必要な jpeg2yuv ツールは利用できません。マニュアルを参照してください。</translation>
     </message>
+    <message>
+      <source>MSG_CANT_WRITE_VIDEO</source>
+      <translation>ビデオファイルを書き込めません。</translation>
+    </message>
   </context>
   <context>
     <name>SVTK_NonIsometricDlg</name>
@@ -434,6 +438,26 @@
       <source>FLT_AVI_FILES</source>
       <translation>AVI (*.avi) ファイル</translation>
     </message>
+    <message>
+      <source>FLT_Y4M_FILES</source>
+      <translation>Y4M ファイル (*.y4m)</translation>
+    </message>
+    <message>
+      <source>OUTPUT_FORMAT</source>
+      <translation>出力形式 : </translation>
+    </message>
+    <message>
+      <source>FORMAT_AVI_MAKER</source>
+      <translation>AVI (jpeg2yuv)</translation>
+    </message>
+    <message>
+      <source>FORMAT_RAW_AVI</source>
+      <translation>AVI (非圧縮)</translation>
+    </message>
+    <message>
+      <source>FORMAT_Y4M</source>
+      <translation>YUV4MPEG2 (Y4M)</translation>
+    </message>
     <message>
       <source>FPS</source>
       <translation>FPS:</translation>
@@ -1508,6 +1508,9 @@ void SalomeApp_Application::updateObjectBrowser( const bool updateModels )
   SalomeApp_Study* study = dynamic_cast<SalomeApp_Study*>(activeStudy());
   if ( study )
   {
+    // apply the modifications of the study not processed by the observer yet
+    study->flushNotifications();
+
     for ( _PTR(SComponentIterator) it ( getStudy()->NewComponentIterator() ); it->More(); it->Next() )
     {
       _PTR(SComponent) aComponent ( it->Value() );
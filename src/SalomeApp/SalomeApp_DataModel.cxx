@@ -34,10 +34,13 @@
 
 #include <SUIT_TreeSync.h>
 #include <SUIT_DataObjectIterator.h>
+#include <SUIT_DataBrowser.h>
 
 #include <SALOMEconfig.h>
 #include CORBA_SERVER_HEADER(SALOME_Exception)
 
+#include <QHash>
+
 typedef _PTR(SObject)     kerPtr;
 typedef SUIT_DataObject*  suitPtr;
 
@@ -48,7 +51,7 @@ typedef SUIT_DataObject*  suitPtr;
 class SalomeApp_DataModelSync
 {
 public:
-  SalomeApp_DataModelSync( _PTR( Study ), SUIT_DataObject* );
+  SalomeApp_DataModelSync( _PTR( Study ), SUIT_DataObject*, const bool = false );
 
   bool           isEqual( const kerPtr&, const suitPtr& ) const;
   kerPtr         nullSrc() const;
@@ -62,18 +65,30 @@ public:
 
 private:
   bool           isCorrect( const kerPtr& ) const;
+  bool           isExpandable( const kerPtr& ) const;
+  bool           hasChildren( const kerPtr& ) const;
 
 private:
+  typedef QHash<QString, SalomeApp_DataObject*> TargetMap;
+
   _PTR( Study )     myStudy;
   SUIT_DataObject*  myRoot;
+  bool              myIsLazy;
+  mutable TargetMap myTargets; // lazy mode: SUIT objects of the synchronized kernel objects
 };
 
 /*!
   Constructor
+  \param aStudy study
+  \param aRoot root object
+  \param isLazy if true, the children of the created objects are not created
+  until the objects are fetched (see SalomeApp_DataModel::fetchChildren())
 */
-SalomeApp_DataModelSync::SalomeApp_DataModelSync( _PTR( Study ) aStudy, SUIT_DataObject* aRoot )
+SalomeApp_DataModelSync::SalomeApp_DataModelSync( _PTR( Study ) aStudy, SUIT_DataObject* aRoot,
+                                                  const bool isLazy )
 : myStudy( aStudy ),
-  myRoot( aRoot )
+  myRoot( aRoot ),
+  myIsLazy( isLazy )
 {
 }
 
@@ -114,8 +129,14 @@ suitPtr SalomeApp_DataModelSync::createItem( const kerPtr& so,
     return 0;
 
   _PTR(SComponent) aSComp( so );
-  suitPtr nitem = aSComp ? new SalomeApp_ModuleObject( aSComp, 0 ) :
-                           new SalomeApp_DataObject( so, 0 );
+  SalomeApp_DataObject* nitem = aSComp ? new SalomeApp_ModuleObject( aSComp, 0 ) :
+                                         new SalomeApp_DataObject( so, 0 );
+
+  if( myIsLazy ) {
+    // the children are created when the object is fetched
+    nitem->setFetched( false );
+    myTargets.insert( so->GetID().c_str(), nitem );
+  }
 
   if( parent ) {
     int pos = after ? parent->childPos( after ) : 0;
@@ -185,14 +206,16 @@ QList<kerPtr> SalomeApp_DataModelSync::children( const kerPtr& obj ) const
 {
   QList<kerPtr> ch;
 
-  _PTR( GenericAttribute ) anAttr;
-  bool expandable = true;
-  if ( obj && obj->FindAttribute( anAttr, "AttributeExpandable" ) ) {
-    _PTR(AttributeExpandable) aAttrExp = anAttr;
-    expandable = aAttrExp->IsExpandable();
+  if ( myIsLazy && obj ) {
+    // the object is not fetched yet: only check if it has something to fetch
+    SalomeApp_DataObject* trg = myTargets.value( obj->GetID().c_str() );
+    if ( trg && !trg->isFetched() ) {
+      trg->setChildrenToFetch( isExpandable( obj ) && hasChildren( obj ) );
+      return ch;
+    }
   }
 
-  if ( expandable ) {
+  if ( isExpandable( obj ) ) {
     // tmp??
     _PTR(UseCaseBuilder) aUseCaseBuilder = myStudy->GetUseCaseBuilder();
     if (aUseCaseBuilder->HasChildren(obj)) {
@@ -210,6 +233,34 @@ QList<kerPtr> SalomeApp_DataModelSync::children( const kerPtr& obj ) const
   return ch;
 }
 
+/*!
+  \return false if the children of kernel object must not be shown
+  \param obj - kernel object
+*/
+bool SalomeApp_DataModelSync::isExpandable( const kerPtr& obj ) const
+{
+  _PTR( GenericAttribute ) anAttr;
+  bool expandable = true;
+  if ( obj && obj->FindAttribute( anAttr, "AttributeExpandable" ) ) {
+    _PTR(AttributeExpandable) aAttrExp = anAttr;
+    expandable = aAttrExp->IsExpandable();
+  }
+  return expandable;
+}
+
+/*!
+  \return true if kernel object has children, without iterating all of them
+  \param obj - kernel object
+*/
+bool SalomeApp_DataModelSync::hasChildren( const kerPtr& obj ) const
+{
+  _PTR(UseCaseBuilder) aUseCaseBuilder = myStudy->GetUseCaseBuilder();
+  if ( aUseCaseBuilder->HasChildren( obj ) )
+    return true;
+  _PTR(ChildIterator) it ( myStudy->NewChildIterator( obj ) );
+  return it->More();
+}
+
 /*!
   Fills list with children of SUIT object
   \param p - SUIT object
@@ -236,8 +287,14 @@ suitPtr SalomeApp_DataModelSync::parent( const suitPtr& p ) const
   Updates SUIT object
   \param p - SUIT object
 */
-void SalomeApp_DataModelSync::updateItem( const kerPtr&, const suitPtr& ) const
+void SalomeApp_DataModelSync::updateItem( const kerPtr& so, const suitPtr& suit ) const
 {
+  // the SALOMEDS attributes of the object may have been changed
+  SalomeApp_DataObject* sobj = dynamic_cast<SalomeApp_DataObject*>( suit );
+  if ( sobj )
+    sobj->resetCache();
+  if ( sobj && so && myIsLazy )
+    myTargets.insert( so->GetID().c_str(), sobj );
 }
 
 /*!
@@ -365,7 +422,10 @@ SUIT_DataObject* SalomeApp_DataModel::synchronize( const _PTR( SComponent )& sob
     return suitObj;
 #endif
 
-  SalomeApp_DataModelSync sync( study->studyDS(), study->root() );
+  SalomeApp_DataModelSync sync( study->studyDS(), study->root(), isLazy( study ) );
+
+  // the Object Browser is notified once, when the component is synchronized
+  SUIT_DataObject::Transaction aTransaction;
 
   if( !suitObj || dynamic_cast<SalomeApp_DataObject*>( suitObj ) )
     suitObj= ::synchronize<kerPtr,suitPtr,SalomeApp_DataModelSync>( sobj, suitObj, sync );
@@ -375,6 +435,37 @@ SUIT_DataObject* SalomeApp_DataModel::synchronize( const _PTR( SComponent )& sob
   return suitObj;
 }
 
+/*!
+  Creates the children of data object which has not been fetched yet
+  (in the lazy mode of the Object Browser, see SalomeApp_DataObject::fetchChildren())
+*/
+void SalomeApp_DataModel::fetchChildren( SalomeApp_DataObject* obj, SalomeApp_Study* study )
+{
+  if( !obj || !study || obj->isFetched() )
+    return;
+
+  obj->setFetched( true );
+  kerPtr so = obj->object();
+  if( !so )
+    return;
+
+  // the next level is created on demand as well
+  SalomeApp_DataModelSync sync( study->studyDS(), study->root(), isLazy( study ) );
+
+  SUIT_DataObject::Transaction aTransaction;
+  ::synchronize<kerPtr,suitPtr,SalomeApp_DataModelSync>( so, obj, sync );
+}
+
+/*!
+  \return true if the data objects are created on demand (lazy mode of the Object Browser)
+*/
+bool SalomeApp_DataModel::isLazy( SalomeApp_Study* study )
+{
+  SalomeApp_Application* app = study ? dynamic_cast<SalomeApp_Application*>( study->application() ) : 0;
+  SUIT_DataBrowser* ob = app ? app->objectBrowser() : 0;
+  return ob && ob->lazyLoading();
+}
+
 /*!
   Updates tree.
 */
@@ -40,6 +40,7 @@ class SalomeApp_Module;
 class SalomeApp_Study;
 class SUIT_DataObject;
 class LightApp_DataObject;
+class SalomeApp_DataObject;
 
 //   Class       : SalomeApp_DataModel
 ///  Description : Base class of data model
@@ -49,6 +50,8 @@ class SALOMEAPPIMPL_EXPORT SalomeApp_DataModel : public LightApp_DataModel
 
 public:
   static SUIT_DataObject*             synchronize( const _PTR( SComponent )&, SalomeApp_Study* );
+  static void                         fetchChildren( SalomeApp_DataObject*, SalomeApp_Study* );
+  static bool                         isLazy( SalomeApp_Study* );
 
   SalomeApp_DataModel ( CAM_Module* theModule );
   virtual ~SalomeApp_DataModel();
@@ -59,6 +59,8 @@ namespace
   }
 }
 
+int SalomeApp_DataObject::ourCacheVersion = 0;
+
 /*!
   \class SalomeApp_DataObject
   \brief Implementation of the data object for use in CORBA-based
@@ -71,7 +73,12 @@ namespace
 */
 SalomeApp_DataObject::SalomeApp_DataObject( SUIT_DataObject* parent )
 : CAM_DataObject( parent ),
-  LightApp_DataObject( parent )
+  LightApp_DataObject( parent ),
+  myCacheFlags( 0 ),
+  myCacheVersion( ourCacheVersion ),
+  myCachedIsReference( false ),
+  myIsFetched( true ),
+  myHasChildrenToFetch( false )
 {
 }
 
@@ -83,7 +90,12 @@ SalomeApp_DataObject::SalomeApp_DataObject( SUIT_DataObject* parent )
 SalomeApp_DataObject::SalomeApp_DataObject( const _PTR(SObject)& sobj, 
                                             SUIT_DataObject* parent )
 : CAM_DataObject( parent ),
-  LightApp_DataObject( parent )
+  LightApp_DataObject( parent ),
+  myCacheFlags( 0 ),
+  myCacheVersion( ourCacheVersion ),
+  myCachedIsReference( false ),
+  myIsFetched( true ),
+  myHasChildrenToFetch( false )
 {
   myObject = sobj;
 }
@@ -101,6 +113,11 @@ SalomeApp_DataObject::~SalomeApp_DataObject()
 */
 QString SalomeApp_DataObject::name() const
 {
+  // the name of a reference depends on the referenced object: it is not cached
+  bool isRef = isReference();
+  if ( !isRef && isCached( NameCached ) )
+    return myCachedName;
+
   QString str;
   if ( myObject )
     str = fromUtf8( myObject->GetName() );
@@ -111,12 +128,16 @@ QString SalomeApp_DataObject::name() const
       str = fromUtf8( refObj->GetName() );
   }
   
-  if ( isReference() ) {
+  if ( isRef ) {
     if ( !(QString(referencedObject()->GetName().c_str()).isEmpty()) )
       str = QString( "* " ) + str;
     else
       str = QString( "<Invalid Reference>" );
   }
+  else {
+    myCachedName = str;
+    myCacheFlags |= NameCached;
+  }
   return str;
 }
 
@@ -150,10 +171,17 @@ QString SalomeApp_DataObject::text( const int id ) const
   switch ( id )
   {
   case ValueId:
+    if ( isCached( ValueCached ) )
+      return myCachedValue;
     if ( componentObject() != (SUIT_DataObject*)this )
       txt = value( object() );
     if ( txt.isEmpty() )
       txt = value( referencedObject() );
+    // the value of a reference depends on the referenced object: it is not cached
+    if ( !isReference() ) {
+      myCachedValue = txt;
+      myCacheFlags |= ValueCached;
+    }
     break;
   case IORId:
     txt = ior( referencedObject() );
@@ -175,7 +203,14 @@ QString SalomeApp_DataObject::text( const int id ) const
 QPixmap SalomeApp_DataObject::icon( const int id ) const
 {
   // we display icon only for the first (NameId ) column
-  if ( id == NameId ) {
+  if ( id == NameId && isCached( IconCached ) ) {
+    if ( !myCachedIcon.isNull() )
+      return myCachedIcon;
+  }
+  else if ( id == NameId ) {
+    // a null cached icon means that the object has no pixmap attribute
+    myCachedIcon = QPixmap();
+    myCacheFlags |= IconCached;
     _PTR(GenericAttribute) anAttr;
     if ( myObject && myObject->FindAttribute( anAttr, "AttributePixMap" ) ){
       _PTR(AttributePixMap) aPixAttr ( anAttr );
@@ -192,7 +227,11 @@ QPixmap SalomeApp_DataObject::icon( const int id ) const
         LightApp_RootObject* aRoot = dynamic_cast<LightApp_RootObject*>( root() );
         if ( aRoot && aRoot->study() ) {
           SUIT_ResourceMgr* mgr = aRoot->study()->application()->resourceMgr();
-          return mgr->loadPixmap( componentType, pixmapName, false ); 
+          myCachedIcon = mgr->loadPixmap( componentType, pixmapName, false );
+          // try again later if the pixmap is not available yet
+          if ( myCachedIcon.isNull() )
+            myCacheFlags &= ~IconCached;
+          return myCachedIcon;
         }
       }
     }
@@ -220,6 +259,8 @@ QColor SalomeApp_DataObject::color( const ColorRole role, const int id ) const
       if ( QString(referencedObject()->GetName().c_str()).isEmpty() )
         c = QColor( 200, 200, 200 );  // invalid reference (grayed)
     }
+    else if ( isCached( TextColorCached ) )
+      c = myCachedTextColor;
     else if ( myObject ) {
       // get color atrtribute value
       _PTR(GenericAttribute) anAttr;
@@ -227,6 +268,8 @@ QColor SalomeApp_DataObject::color( const ColorRole role, const int id ) const
         _PTR(AttributeTextColor) aColAttr = anAttr;
         c = QColor( (int)aColAttr->TextColor().R, (int)aColAttr->TextColor().G, (int)aColAttr->TextColor().B );
       }
+      myCachedTextColor = c;
+      myCacheFlags |= TextColorCached;
     }
     break;
 
@@ -236,6 +279,8 @@ QColor SalomeApp_DataObject::color( const ColorRole role, const int id ) const
       if ( QString(referencedObject()->GetName().c_str()).isEmpty() )
         c = QColor( 200, 200, 200 );  // invalid reference (grayed)
     }
+    else if ( isCached( HighlightColorCached ) )
+      c = myCachedHighlightColor;
     else if ( myObject ) {
       // get color atrtribute value
       _PTR(GenericAttribute) anAttr;
@@ -245,6 +290,8 @@ QColor SalomeApp_DataObject::color( const ColorRole role, const int id ) const
                     (int)(aHighColAttr->TextHighlightColor().G), 
                     (int)(aHighColAttr->TextHighlightColor().B));
       }
+      myCachedHighlightColor = c;
+      myCacheFlags |= HighlightColorCached;
     }
     break;
   default:
@@ -267,7 +314,20 @@ QString SalomeApp_DataObject::toolTip( const int /*id*/ ) const
 {
   // we ignore parameter <id> in order to use the same tooltip for 
   // all columns
-  
+  if ( isCached( ToolTipCached ) )
+    return myCachedToolTip;
+
+  myCachedToolTip = customToolTip();
+  myCacheFlags |= ToolTipCached;
+  return myCachedToolTip;
+}
+
+/*!
+  \brief Compute the tooltip of the data object (not cached).
+  \return object tooltip
+*/
+QString SalomeApp_DataObject::customToolTip() const
+{
   // Get customized tooltip in case of it exists
   const SalomeApp_DataObject* compObj = dynamic_cast<SalomeApp_DataObject*>( componentObject() );
   // Check if the component has been loaded.
@@ -369,12 +429,17 @@ QString SalomeApp_DataObject::refEntry() const
 */
 bool SalomeApp_DataObject::isReference() const
 {
+  if ( isCached( ReferenceCached ) )
+    return myCachedIsReference;
+
   bool isRef = false;
   if ( myObject )
   {
     _PTR(SObject) refObj;
     isRef = myObject->ReferencedObject( refObj );
   }
+  myCachedIsReference = isRef;
+  myCacheFlags |= ReferenceCached;
   return isRef;
 }
 
@@ -624,10 +689,107 @@ void SalomeApp_DataObject::insertChildAtTag( SalomeApp_DataObject* obj, int tag
 
 void SalomeApp_DataObject::updateItem()
 {
+  // the attributes of the object may have been changed
+  resetCache();
   if ( modified() ) return;
   setModified( true );
 }
 
+/*!
+  \brief Check if the object has children which are not created yet.
+
+  In the lazy mode of the Object Browser, the children of the object
+  are created from the SALOMEDS study only when the object is fetched
+  (e.g. expanded in the Object Browser).
+
+  \return \c true if the object is not fetched yet and has children
+  \sa fetchChildren()
+*/
+bool SalomeApp_DataObject::canFetchChildren() const
+{
+  return !myIsFetched && myHasChildrenToFetch;
+}
+
+/*!
+  \brief Create the children of the object from the SALOMEDS study.
+  \sa canFetchChildren()
+*/
+void SalomeApp_DataObject::fetchChildren()
+{
+  if ( myIsFetched )
+    return;
+
+  LightApp_RootObject* aRoot = dynamic_cast<LightApp_RootObject*>( root() );
+  SalomeApp_Study* aStudy = aRoot ? dynamic_cast<SalomeApp_Study*>( aRoot->study() ) : 0;
+  if ( aStudy )
+    aStudy->fetchChildren( this );
+}
+
+/*!
+  \brief Check if the children of the object are created.
+  \return \c false if the children are to be created on demand
+  \sa setFetched()
+*/
+bool SalomeApp_DataObject::isFetched() const
+{
+  return myIsFetched;
+}
+
+/*!
+  \brief Set if the children of the object are created.
+  \param on \c false if the children are to be created on demand
+  \sa isFetched()
+*/
+void SalomeApp_DataObject::setFetched( const bool on )
+{
+  myIsFetched = on;
+}
+
+/*!
+  \brief Set if the object has children to be created on demand.
+  \param on \c true if the SALOMEDS object has children
+  \sa canFetchChildren()
+*/
+void SalomeApp_DataObject::setChildrenToFetch( const bool on )
+{
+  myHasChildrenToFetch = on;
+}
+
+/*!
+  \brief Forget the cached attributes of the object.
+
+  Name, value, icon, colors and tooltip are read from the study once
+  and cached; this method has to be called when the SALOMEDS object is modified.
+  \sa resetAllCaches()
+*/
+void SalomeApp_DataObject::resetCache()
+{
+  myCacheFlags = 0;
+}
+
+/*!
+  \brief Forget the cached attributes of all the objects.
+  \sa resetCache()
+*/
+void SalomeApp_DataObject::resetAllCaches()
+{
+  ourCacheVersion++;
+}
+
+/*!
+  \brief Check if the attribute is in the cache.
+  \param flag attribute flag
+  \return \c true if the cached value can be used
+*/
+bool SalomeApp_DataObject::isCached( const int flag ) const
+{
+  if ( myCacheVersion != ourCacheVersion ) {
+    myCacheFlags = 0;
+    myCacheVersion = ourCacheVersion;
+  }
+  return ( myCacheFlags & flag ) != 0;
+}
+
 /*!
   \class SalomeApp_ModuleObject
   \brief This class is used for optimized access to the SALOMEDS-based 
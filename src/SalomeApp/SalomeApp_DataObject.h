@@ -30,6 +30,8 @@
 #include <LightApp_DataObject.h>
 #include <SALOMEDSClient.hxx>
 
+#include <QColor>
+
 class SalomeApp_Study;
 
 class SALOMEAPPIMPL_EXPORT SalomeApp_DataObject : public virtual LightApp_DataObject
@@ -76,13 +78,53 @@ public:
   virtual void           insertChildAtTag( SalomeApp_DataObject*, int );
   virtual void           updateItem();
 
+  virtual bool           canFetchChildren() const;
+  virtual void           fetchChildren();
+
+  bool                   isFetched() const;
+  void                   setFetched( const bool );
+  void                   setChildrenToFetch( const bool );
+
+  void                   resetCache();
+  static void            resetAllCaches();
+
 private:
   QString                ior( const _PTR(SObject)& ) const;
   QString                entry( const _PTR(SObject)& ) const;
   QString                value( const _PTR(SObject)& ) const;
+  QString                customToolTip() const;
+
+  //! Attributes kept in the cache
+  enum {
+    NameCached           = 0x01,
+    ValueCached          = 0x02,
+    IconCached           = 0x04,
+    ToolTipCached        = 0x08,
+    TextColorCached      = 0x10,
+    HighlightColorCached = 0x20,
+    ReferenceCached      = 0x40
+  };
+  bool                   isCached( const int ) const;
 
 private:
   _PTR(SObject)          myObject;
+
+  // cache of the SALOMEDS attributes used for display
+  mutable int            myCacheFlags;
+  mutable int            myCacheVersion;
+  mutable bool           myCachedIsReference;
+  mutable QString        myCachedName;
+  mutable QString        myCachedValue;
+  mutable QString        myCachedToolTip;
+  mutable QPixmap        myCachedIcon;
+  mutable QColor         myCachedTextColor;
+  mutable QColor         myCachedHighlightColor;
+
+  // lazy mode: children are created when the object is fetched
+  bool                   myIsFetched;
+  bool                   myHasChildrenToFetch;
+
+  static int             ourCacheVersion;
 };
 
 class SALOMEAPPIMPL_EXPORT SalomeApp_ModuleObject : public SalomeApp_DataObject,
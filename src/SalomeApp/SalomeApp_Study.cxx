@@ -37,8 +37,12 @@
 //#include <OB_Browser.h>
 
 #include <QCoreApplication>
+#include <QElapsedTimer>
 #include <QEvent>
 #include <QFileInfo>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QThread>
 #include "SALOME_Event.h"
 #include "Basics_Utils.hxx"
 
@@ -53,6 +57,9 @@
 
 #include "utilities.h"
 
+#include <set>
+#include <vector>
+
 #include "SALOMEDS_Tool.hxx"
 
 #include "SALOMEDSClient_ClientFactory.hxx"
@@ -61,60 +68,172 @@
 #include CORBA_SERVER_HEADER(SALOME_Exception)
 
 
-//#define NOTIFY_BY_EVENT
+// Notifications are accumulated and applied by batches, in the GUI thread:
+// a batch is applied at the latest when it holds OBSERVER_BATCH_SIZE notifications
+// or when its first notification is older than OBSERVER_BATCH_TIME ms.
+#define OBSERVER_BATCH_SIZE 1000
+#define OBSERVER_BATCH_TIME 100
+// batches of at least OBSERVER_BATCH_SYNC notifications synchronize the Object Browser once
+#define OBSERVER_BATCH_SYNC 64
 
-class ObserverEvent : public QEvent
+namespace
 {
-public:
-  ObserverEvent(const char* theID, CORBA::Long event):QEvent(QEvent::User)
+  //! Father of the SALOMEDS object in the Object Browser (null for a component)
+  _PTR(SObject) fatherObject( const _PTR(UseCaseBuilder)& theBuilder, const _PTR(SObject)& theSObj )
   {
-    _anID=theID;
-    _event=event;
+    _PTR(SComponent) aComp( theSObj );
+    if ( aComp )
+      return _PTR(SObject)();
+    if ( theBuilder->IsUseCaseNode( theSObj ) )
+      return theBuilder->GetFather( theSObj );
+    return theSObj->GetFather();
   }
-
-  std::string _anID;
-  CORBA::Long _event;
-};
+}
 
 class SalomeApp_Study::Observer_i : public virtual POA_SALOMEDS::Observer, QObject
 {
   typedef std::map<std::string, SalomeApp_DataObject*>           EntryMap;
   typedef std::map<std::string, SalomeApp_DataObject*>::iterator EntryMapIter;
 
+  typedef std::pair<std::string, long> Notification;
+  typedef std::vector<Notification>    NotificationList;
+
+  enum { CANCELLED = -1 }; //!< event of a notification cancelled within its batch
+
 public:
 
   Observer_i( SalomeApp_Study* aStudy):QObject(aStudy)
   {
     myStudy=aStudy;
+    myIsFlushPosted = false;
+    myIsFlushing = false;
     fillEntryMap();
   }
 
-  SUIT_DataObject* findObject( const char* theID ) const
+  SUIT_DataObject* findObject( const char* theID )
   {
+    // make the pending notifications visible to the caller
+    if ( QThread::currentThread() == thread() )
+      flush();
+
     EntryMap::const_iterator it = entry2SuitObject.find( theID );
     return it != entry2SuitObject.end() ? it->second : 0;
   }
 
   virtual void notifyObserverID(const char* theID, CORBA::Long event)
   {
-#ifdef NOTIFY_BY_EVENT
-    QCoreApplication::postEvent(this,new ObserverEvent(theID,event));
-#else
-    notifyObserverID_real(theID,event);
-#endif
+    bool isFull = false;
+    {
+      QMutexLocker lock( &myBatchMutex );
+
+      if ( event == 0 ) {
+        // several modifications of the same object give a single update
+        if ( !myModified.insert( theID ).second )
+          return;
+      }
+      else if ( event == 1 || event == 2 ) {
+        // a modification after adding or removing the object must not be merged
+        // with the one queued before
+        myModified.erase( theID );
+      }
+
+      if ( event == 1 ) {
+        myAdded[theID] = myBatch.size();
+      }
+      else if ( event == 2 ) {
+        // an object added and removed within the batch is never shown:
+        // cancel its notifications, the removal is still applied in case
+        // the object existed before (e.g. it has been moved in the use case tree)
+        std::map<std::string, size_t>::iterator it = myAdded.find( theID );
+        if ( it != myAdded.end() ) {
+          for ( size_t i = it->second; i < myBatch.size(); i++ ) {
+            if ( myBatch[i].first == theID )
+              myBatch[i].second = CANCELLED;
+          }
+          myAdded.erase( it );
+        }
+      }
+
+      if ( myBatch.empty() )
+        myBatchTimer.start();
+      myBatch.push_back( Notification( theID, event ) );
+
+      // a single event is posted for the whole batch
+      if ( !myIsFlushPosted ) {
+        myIsFlushPosted = true;
+        QCoreApplication::postEvent( this, new QEvent( QEvent::User ) );
+      }
+      isFull = myBatch.size() >= OBSERVER_BATCH_SIZE || myBatchTimer.elapsed() >= OBSERVER_BATCH_TIME;
+    }
+
+    // the GUI thread may be busy (e.g. by a Python script): do not wait for the event loop
+    if ( isFull && QThread::currentThread() == thread() )
+      flush();
   }
 
   virtual bool event(QEvent *event)
   {
     if (event->type() == QEvent::User )
     {
+      {
+        QMutexLocker lock( &myBatchMutex );
+        myIsFlushPosted = false;
+      }
       //START_TIMING(notify);
-      notifyObserverID_real(static_cast<ObserverEvent *>(event)->_anID.c_str(),static_cast<ObserverEvent *>(event)->_event);
+      flush();
       //END_TIMING(notify,100);
     }
     return true;
   }
 
+  //! Apply the pending notifications
+  void flush()
+  {
+    if ( myIsFlushing )
+      return;
+
+    NotificationList aBatch;
+    {
+      QMutexLocker lock( &myBatchMutex );
+      aBatch.swap( myBatch );
+      myModified.clear();
+      myAdded.clear();
+    }
+    if ( aBatch.empty() )
+      return;
+
+    myIsFlushing = true;
+
+    // with the automatic update, the tree model synchronizes the parent of each
+    // inserted or removed object: for big batches, synchronize the tree once instead
+    SUIT_DataBrowser* ob = 0;
+    SalomeApp_Application* app = dynamic_cast<SalomeApp_Application*>( myStudy->application() );
+    if ( app && aBatch.size() >= OBSERVER_BATCH_SYNC )
+      ob = app->objectBrowser();
+    const bool isAutoUpdate = ob && ob->autoUpdate();
+    if ( isAutoUpdate )
+      ob->setAutoUpdate( false );
+
+    for ( NotificationList::const_iterator it = aBatch.begin(); it != aBatch.end(); ++it ) {
+      if ( it->second != CANCELLED )
+        notifyObserverID_real( it->first, it->second );
+    }
+
+    if ( isAutoUpdate )
+      ob->setAutoUpdate( true );
+
+    myIsFlushing = false;
+  }
+
+  //! Drop the pending notifications (the study is being closed)
+  void clear()
+  {
+    QMutexLocker lock( &myBatchMutex );
+    myBatch.clear();
+    myModified.clear();
+    myAdded.clear();
+  }
+
   void notifyObserverID_real(const std::string& theID, long event)
   {
     SalomeApp_DataObject* suit_obj = 0;
@@ -123,6 +242,11 @@ public:
     case 1:
       { //Add sobject
         _PTR(SObject) aSObj = SalomeApp_Application::getStudy()->FindObjectID(theID);
+        if (!aSObj) {
+          // the object has been removed before the notification is applied
+          MESSAGE("Entry " << theID << " does not exist anymore");
+          return;
+        }
         _PTR(SComponent) aSComp = aSObj->GetFatherComponent();
 
         if (!aSComp || aSComp->IsNull()) {
@@ -154,6 +278,19 @@ public:
 
           SalomeApp_DataObject* aFatherDO = it->second;
 
+          if (!aFatherDO->isFetched()) {
+            // the children of the father are created when it is fetched
+            it = entry2SuitObject.find(theID);
+            if (it != entry2SuitObject.end()) { // this SOobject is moved from somewhere
+              suit_obj = it->second;
+              unregisterObjects(suit_obj);
+              if (suit_obj->parent())
+                suit_obj->parent()->removeChild(suit_obj);
+            }
+            addToNotFetched(aFatherDO);
+            return;
+          }
+
           it = entry2SuitObject.find(theID);
           if (it != entry2SuitObject.end()) { // this SOobject is already added somewhere
             suit_obj = it->second;
@@ -211,6 +348,10 @@ public:
             return;
           }
 
+          // the object is created when its father is fetched
+          if ( isNotFetched( theID ) )
+            return;
+
           int last2Pnt_pos = (int)theID.rfind( ":" ); //!< TODO: conversion from size_t to int
           std::string parent_id = theID.substr( 0, last2Pnt_pos );
           int tag = atoi( theID.substr( last2Pnt_pos+1 ).c_str() );
@@ -322,6 +463,11 @@ public:
 
         /* Define visibility state */
         bool isComponent = dynamic_cast<SalomeApp_ModuleObject*>( suit_obj ) != 0;
+        // tooltips depend on the loading of the component: the whole cache is outdated
+        if ( isComponent )
+          SalomeApp_DataObject::resetAllCaches();
+        else if ( SalomeApp_DataObject* sobj = dynamic_cast<SalomeApp_DataObject*>( suit_obj ) )
+          sobj->resetCache();
         if ( suit_obj && !isComponent ) {
           LightApp_Displayer* aDisplayer = LightApp_Displayer::FindDisplayer
             (suit_obj->componentDataType(),false);
@@ -347,7 +493,60 @@ public:
     } //switch
   } //notifyObserverID_real
 
+  //! Register the data objects created when the object is fetched
+  void registerChildren( SUIT_DataObject* theObj )
+  {
+    DataObjectList aList;
+    theObj->children( aList, true );
+    for ( DataObjectList::const_iterator it = aList.begin(); it != aList.end(); ++it ) {
+      SalomeApp_DataObject* so = dynamic_cast<SalomeApp_DataObject*>( *it );
+      if ( so )
+        entry2SuitObject[so->entry().toUtf8().constData()] = so;
+    }
+  }
+
 private:
+  //! Unregister the data object with all its children
+  void unregisterObjects( SalomeApp_DataObject* theObj )
+  {
+    DataObjectList aList;
+    theObj->children( aList, true );
+    aList.prepend( theObj );
+    for ( DataObjectList::const_iterator it = aList.begin(); it != aList.end(); ++it ) {
+      SalomeApp_DataObject* so = dynamic_cast<SalomeApp_DataObject*>( *it );
+      if ( so )
+        entry2SuitObject.erase( so->entry().toUtf8().constData() );
+    }
+  }
+
+  //! Check if the object is below a data object whose children are not created yet
+  bool isNotFetched( const std::string& theID )
+  {
+    // the nearest ancestor which is created, e.g. "0:1:2:3" for "0:1:2:3:1:1"
+    std::string::size_type pos = theID.rfind( ':' );
+    for ( ; pos != std::string::npos && pos > 3; pos = theID.rfind( ':', pos - 1 ) ) {
+      EntryMapIter it = entry2SuitObject.find( theID.substr( 0, pos ) );
+      if ( it == entry2SuitObject.end() )
+        continue;
+      SalomeApp_DataObject* anObj = it->second;
+      if ( anObj->isFetched() )
+        return false;
+      addToNotFetched( anObj );
+      return true;
+    }
+    return false;
+  }
+
+  //! An object is added below a data object whose children are not created yet
+  void addToNotFetched( SalomeApp_DataObject* theObj )
+  {
+    theObj->setChildrenToFetch( true );
+    if ( SalomeApp_DataModel::isLazy( myStudy ) )
+      theObj->updateItem(); // the object can be expanded now
+    else
+      myStudy->fetchChildren( theObj ); // the lazy mode has been switched off
+  }
+
   void fillEntryMap()
   {
     entry2SuitObject.clear();
@@ -383,6 +582,14 @@ private:
 private:
   SalomeApp_Study* myStudy;
   EntryMap         entry2SuitObject;
+
+  NotificationList      myBatch;          //!< pending notifications, in order
+  std::set<std::string> myModified;       //!< objects with a pending modification
+  std::map<std::string, size_t> myAdded;  //!< objects with a pending addition -> position in batch
+  QMutex                myBatchMutex;     //!< notifications may come from the CORBA threads
+  QElapsedTimer         myBatchTimer;     //!< age of the pending batch
+  bool                  myIsFlushPosted;  //!< an event is already posted to apply the batch
+  bool                  myIsFlushing;
 };
 
 
@@ -705,8 +912,10 @@ void SalomeApp_Study::closeDocument(bool permanently)
   LightApp_Study::closeDocument(permanently);
 
   // close SALOMEDS document
-  if ( myObserver )
+  if ( myObserver ) {
     myStudyDS->detach( myObserver->_this() );
+    myObserver->clear();
+  }
   if ( permanently ) {
     SUIT_Desktop* desk = SUIT_Session::session()->activeApplication()->desktop();
     bool isBlocked = desk->signalsBlocked();
@@ -1153,7 +1362,68 @@ void SalomeApp_Study::updateFromNotebook( const QString& theFileName, bool isSav
 }
 #endif
 
+/*!
+  Applies the study modifications notified to the observer and not processed yet
+*/
+void SalomeApp_Study::flushNotifications()
+{
+  if ( myObserver )
+    myObserver->flush();
+}
+
+/*!
+  Creates the children of data object, in the lazy mode of the Object Browser
+  \param theObj - data object which is not fetched yet
+*/
+void SalomeApp_Study::fetchChildren( SalomeApp_DataObject* theObj )
+{
+  if ( !theObj || theObj->isFetched() )
+    return;
+
+  SalomeApp_DataModel::fetchChildren( theObj, this );
+  if ( myObserver )
+    myObserver->registerChildren( theObj );
+}
+
 LightApp_DataObject* SalomeApp_Study::findObjectByEntry( const QString& theEntry )
+{
+  LightApp_DataObject* o = findCreatedObject( theEntry );
+  if ( o || !SalomeApp_DataModel::isLazy( this ) )
+    return o;
+
+  // in the lazy mode of the Object Browser, the data object may be not created yet:
+  // fetch the branch containing it, from its nearest ancestor which is created
+  _PTR(UseCaseBuilder) aUseCaseBuilder = studyDS()->GetUseCaseBuilder();
+  QStringList aPath;
+  SalomeApp_DataObject* anObj = 0;
+  _PTR(SObject) aSObj = studyDS()->FindObjectID( theEntry.toUtf8().constData() );
+  for ( ; aSObj && !anObj; aSObj = fatherObject( aUseCaseBuilder, aSObj ) ) {
+    QString anEntry = aSObj->GetID().c_str();
+    if ( !aPath.isEmpty() )
+      anObj = dynamic_cast<SalomeApp_DataObject*>( findCreatedObject( anEntry ) );
+    if ( !anObj )
+      aPath.prepend( anEntry );
+  }
+
+  while ( anObj && !aPath.isEmpty() ) {
+    fetchChildren( anObj );
+    QString anEntry = aPath.takeFirst();
+    DataObjectList aChildren = anObj->children();
+    anObj = 0;
+    for ( DataObjectList::const_iterator it = aChildren.begin(); it != aChildren.end() && !anObj; ++it ) {
+      SalomeApp_DataObject* aChild = dynamic_cast<SalomeApp_DataObject*>( *it );
+      if ( aChild && aChild->entry() == anEntry )
+        anObj = aChild;
+    }
+  }
+  return anObj;
+}
+
+/*!
+  \return data object with the given entry if it is created, without fetching it
+  \param theEntry - object entry
+*/
+LightApp_DataObject* SalomeApp_Study::findCreatedObject( const QString& theEntry )
 {
   LightApp_DataObject* o = 0;
   if ( myObserver ) {
@@ -33,6 +33,8 @@
 
 #include "SALOMEDSClient.hxx"
 
+class SalomeApp_DataObject;
+
 class SALOMEAPPIMPL_EXPORT SalomeApp_Study : public LightApp_Study
 {
   Q_OBJECT
@@ -87,6 +89,8 @@ public:
 #endif
 
   virtual LightApp_DataObject* findObjectByEntry( const QString& theEntry );
+  void                flushNotifications();
+  void                fetchChildren( SalomeApp_DataObject* );
 
   virtual void        RemoveTemporaryFiles ( const char*, bool, bool = false );
 
@@ -112,6 +116,9 @@ protected slots:
   void                onNoteBookVarUpdate( QString theVarName );
 #endif
 
+private:
+  LightApp_DataObject* findCreatedObject( const QString& );
+
 private:
   _PTR(Study)         myStudyDS;
   Observer_i*         myObserver;
@@ -0,0 +1,641 @@
+// Copyright (C) 2007-2026  CEA, EDF, OPEN CASCADE
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+//
+// See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+//
+
+//  File   : VTKViewerBenchmark.cxx
+//
+//  Times the filters of the VTKViewer pipeline on generated unstructured grids.
+//  Nothing is rendered, so it runs headless and without any GPU.
+//
+//  Usage: VTKViewerBenchmark [--sizes 1e4,1e5,1e6] [--meshes linear,quadratic,polyhedral]
+//                            [--filters geometry,append,extract,shrink,centers,arcs]
+//                            [--repeat 3] [--format json|csv] [--output <file>]
+//
+//  For each mesh, size, filter and mode the best and mean times of the repeated runs
+//  are reported, with the throughput (input cells per second of the best run) and the
+//  peak resident memory of the process so far (it never decreases, the sizes are run
+//  in ascending order so that it is given by the biggest mesh of the current size).
+
+#include "VTKViewer_AppendFilter.h"
+#include "VTKViewer_ArcBuilder.h"
+#include "VTKViewer_CellCenters.h"
+#include "VTKViewer_ExtractUnstructuredGrid.h"
+#include "VTKViewer_GeometryFilter.h"
+#include "VTKViewer_ShrinkFilter.h"
+
+#include <vtkIdList.h>
+#include <vtkNew.h>
+#include <vtkPoints.h>
+#include <vtkPolyData.h>
+#include <vtkSMPTools.h>
+#include <vtkSmartPointer.h>
+#include <vtkUnstructuredGrid.h>
+#include <vtkVersion.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifdef WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+namespace
+{
+  //----------------------------------------------------------------------------
+  //! Peak resident memory of the process, in Kb (-1 if unknown)
+  long
+  GetPeakRSS()
+  {
+#ifdef WIN32
+    PROCESS_MEMORY_COUNTERS aCounters;
+    if(GetProcessMemoryInfo(GetCurrentProcess(), &aCounters, sizeof(aCounters)))
+      return long(aCounters.PeakWorkingSetSize / 1024);
+    return -1;
+#else
+    struct rusage aUsage;
+    if(getrusage(RUSAGE_SELF, &aUsage) != 0)
+      return -1;
+#ifdef __APPLE__
+    return long(aUsage.ru_maxrss / 1024); // bytes on Mac OS
+#else
+    return long(aUsage.ru_maxrss);
+#endif
+#endif
+  }
+
+  //----------------------------------------------------------------------------
+  //! Smoothly bent lattice, so that the quadratic edges are real arcs
+  void
+  GetCoord(double theI, double theJ, double theK, double theStep, double theCoord[3])
+  {
+    double aX = theI * theStep, aY = theJ * theStep, aZ = theK * theStep;
+    theCoord[0] = aX + 0.05 * sin(3.0 * aY);
+    theCoord[1] = aY + 0.05 * sin(3.0 * aZ);
+    theCoord[2] = aZ + 0.05 * sin(3.0 * aX);
+  }
+
+  // corners of a hexahedron in the VTK order, as offsets in the lattice
+  const int HEX_CORNERS[8][3] = {
+    {0,0,0}, {1,0,0}, {1,1,0}, {0,1,0},
+    {0,0,1}, {1,0,1}, {1,1,1}, {0,1,1}
+  };
+
+  // edges of a hexahedron in the order of the middle nodes of VTK_QUADRATIC_HEXAHEDRON
+  const int HEX_EDGES[12][2] = {
+    {0,1}, {1,2}, {2,3}, {3,0},
+    {4,5}, {5,6}, {6,7}, {7,4},
+    {0,4}, {1,5}, {2,6}, {3,7}
+  };
+
+  // faces of a hexahedron, oriented outwards
+  const int HEX_FACES[6][4] = {
+    {0,3,2,1}, {4,5,6,7},
+    {0,1,5,4}, {1,2,6,5},
+    {2,3,7,6}, {3,0,4,7}
+  };
+
+  //----------------------------------------------------------------------------
+  //! Gives ids to the nodes of a lattice on demand
+  class TLattice
+  {
+    vtkIdType myNb;
+    std::vector<vtkIdType> myIds;
+    vtkSmartPointer<vtkPoints> myPoints;
+    double myStep;
+
+  public:
+    TLattice(vtkIdType theNbNodes, double theStep):
+      myNb(theNbNodes),
+      myIds(theNbNodes * theNbNodes * theNbNodes, -1),
+      myPoints(vtkSmartPointer<vtkPoints>::New()),
+      myStep(theStep)
+    {
+      myPoints->SetDataTypeToDouble();
+    }
+
+    vtkIdType
+    GetId(vtkIdType theI, vtkIdType theJ, vtkIdType theK)
+    {
+      vtkIdType& anId = myIds[theI + myNb * (theJ + myNb * theK)];
+      if(anId < 0){
+        double aCoord[3];
+        GetCoord(double(theI), double(theJ), double(theK), myStep, aCoord);
+        anId = myPoints->InsertNextPoint(aCoord);
+      }
+      return anId;
+    }
+
+    vtkPoints*
+    GetPoints() { return myPoints; }
+  };
+
+  enum EMesh { eLinear, eQuadratic, ePolyhedral };
+
+  const char* MESH_NAMES[] = { "linear", "quadratic", "polyhedral" };
+
+  /*!
+    Builds a block of about theNbCells hexahedra: linear ones, quadratic ones
+    (with their boundary as quadratic quadrangles, as the meshers give them)
+    or the same hexahedra described as polyhedra.
+  */
+  vtkSmartPointer<vtkUnstructuredGrid>
+  BuildGrid(EMesh theMesh, vtkIdType theNbCells)
+  {
+    vtkIdType aNb = std::max<vtkIdType>(1, vtkIdType(std::cbrt(double(theNbCells)) + 0.5));
+    // the quadratic nodes are at the odd positions of a twice finer lattice
+    vtkIdType aRatio = theMesh == eQuadratic ? 2 : 1;
+    TLattice aLattice(aRatio * aNb + 1, 1.0 / double(aRatio * aNb));
+
+    vtkSmartPointer<vtkUnstructuredGrid> aGrid = vtkSmartPointer<vtkUnstructuredGrid>::New();
+    aGrid->Allocate(aNb * aNb * aNb + (theMesh == eQuadratic ? 6 * aNb * aNb : 0));
+
+    vtkNew<vtkIdList> aFaceStream;
+    for(vtkIdType k = 0; k < aNb; k++)
+      for(vtkIdType j = 0; j < aNb; j++)
+        for(vtkIdType i = 0; i < aNb; i++){
+          vtkIdType anIds[20];
+          for(int c = 0; c < 8; c++)
+            anIds[c] = aLattice.GetId(aRatio * (i + HEX_CORNERS[c][0]),
+                                      aRatio * (j + HEX_CORNERS[c][1]),
+                                      aRatio * (k + HEX_CORNERS[c][2]));
+          switch(theMesh){
+          case eLinear:
+            aGrid->InsertNextCell(VTK_HEXAHEDRON, 8, anIds);
+            break;
+          case eQuadratic:
+            for(int e = 0; e < 12; e++){
+              const int* aFirst = HEX_CORNERS[HEX_EDGES[e][0]];
+              const int* aLast = HEX_CORNERS[HEX_EDGES[e][1]];
+              anIds[8 + e] = aLattice.GetId(2 * i + aFirst[0] + aLast[0],
+                                            2 * j + aFirst[1] + aLast[1],
+                                            2 * k + aFirst[2] + aLast[2]);
+            }
+            aGrid->InsertNextCell(VTK_QUADRATIC_HEXAHEDRON, 20, anIds);
+            break;
+          case ePolyhedral:
+            aFaceStream->Reset();
+            aFaceStream->InsertNextId(6);
+            for(int f = 0; f < 6; f++){
+              aFaceStream->InsertNextId(4);
+              for(int n = 0; n < 4; n++)
+                aFaceStream->InsertNextId(anIds[HEX_FACES[f][n]]);
+            }
+            aGrid->InsertNextCell(VTK_POLYHEDRON, aFaceStream);
+            break;
+          }
+        }
+
+    if(theMesh == eQuadratic){
+      // boundary quadrangles: the two sides of the block along each axis
+      vtkIdType aLast = 2 * aNb;
+      for(int anAxis = 0; anAxis < 3; anAxis++)
+        for(vtkIdType aSide = 0; aSide <= aLast; aSide += aLast)
+          for(vtkIdType v = 0; v < aNb; v++)
+            for(vtkIdType u = 0; u < aNb; u++){
+              // corners and middle nodes in the (u, v) plane of the side, in the lattice steps
+              const int aQuad[8][2] = { {0,0}, {2,0}, {2,2}, {0,2}, {1,0}, {2,1}, {1,2}, {0,1} };
+              vtkIdType anIds[8];
+              for(int n = 0; n < 8; n++){
+                vtkIdType aPos[3];
+                aPos[anAxis] = aSide;
+                aPos[(anAxis + 1) % 3] = 2 * u + aQuad[n][0];
+                aPos[(anAxis + 2) % 3] = 2 * v + aQuad[n][1];
+                anIds[n] = aLattice.GetId(aPos[0], aPos[1], aPos[2]);
+              }
+              aGrid->InsertNextCell(VTK_QUADRATIC_QUAD, 8, anIds);
+            }
+    }
+
+    aGrid->SetPoints(aLattice.GetPoints());
+    aGrid->BuildLinks();
+    return aGrid;
+  }
+
+  //----------------------------------------------------------------------------
+  //! Result of one filter in one mode; the modes which do not apply are -1
+  struct TRecord
+  {
+    std::string myMesh;
+    std::string myFilter;
+    vtkIdType myNbCells;
+    vtkIdType myNbPoints;
+    int myIsWireframe;
+    int myIsStoreMapping;
+    int myIsArc;
+    int myIsParallel;
+    int myNbRepeats;
+    double myBest;
+    double myMean;
+    vtkIdType myNbOutCells;
+    long myPeakRSS;
+  };
+
+  struct TMode
+  {
+    int myIsWireframe;
+    int myIsStoreMapping;
+    int myIsArc;
+    int myIsParallel;
+
+    TMode(int theIsWireframe = -1, int theIsStoreMapping = -1, int theIsArc = -1, int theIsParallel = -1):
+      myIsWireframe(theIsWireframe),
+      myIsStoreMapping(theIsStoreMapping),
+      myIsArc(theIsArc),
+      myIsParallel(theIsParallel)
+    {}
+  };
+
+  //! Runs theRun theNbRepeats times; it returns the number of output cells
+  TRecord
+  Measure(EMesh theMesh,
+          vtkUnstructuredGrid* theGrid,
+          const std::string& theFilter,
+          const TMode& theMode,
+          int theNbRepeats,
+          const std::function<vtkIdType()>& theRun)
+  {
+    TRecord aRecord;
+    aRecord.myMesh = MESH_NAMES[theMesh];
+    aRecord.myFilter = theFilter;
+    aRecord.myNbCells = theGrid->GetNumberOfCells();
+    aRecord.myNbPoints = theGrid->GetNumberOfPoints();
+    aRecord.myIsWireframe = theMode.myIsWireframe;
+    aRecord.myIsStoreMapping = theMode.myIsStoreMapping;
+    aRecord.myIsArc = theMode.myIsArc;
+    aRecord.myIsParallel = theMode.myIsParallel;
+    aRecord.myNbRepeats = theNbRepeats;
+    aRecord.myBest = 0.0;
+    aRecord.myMean = 0.0;
+    aRecord.myNbOutCells = 0;
+
+    for(int r = 0; r < theNbRepeats; r++){
+      std::chrono::steady_clock::time_point aStart = std::chrono::steady_clock::now();
+      aRecord.myNbOutCells = theRun();
+      double aTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - aStart).count();
+      aRecord.myBest = r == 0 ? aTime : std::min(aRecord.myBest, aTime);
+      aRecord.myMean += aTime / theNbRepeats;
+    }
+    aRecord.myPeakRSS = GetPeakRSS();
+
+    std::cerr << aRecord.myMesh << " " << aRecord.myNbCells << " " << theFilter
+              << ": " << aRecord.myBest << " s" << std::endl;
+    return aRecord;
+  }
+
+  //! Re-executes the filter (the input does not change between the runs)
+  template<class TFilter>
+  vtkIdType
+  Execute(TFilter* theFilter)
+  {
+    theFilter->Modified();
+    theFilter->Update();
+    return theFilter->GetOutput()->GetNumberOfCells();
+  }
+
+  //----------------------------------------------------------------------------
+  void
+  RunGeometry(EMesh theMesh, vtkUnstructuredGrid* theGrid, int theNbRepeats, std::vector<TRecord>& theRecords)
+  {
+    vtkNew<VTKViewer_GeometryFilter> aFilter;
+    aFilter->SetInputData(theGrid);
+    // the cache would make all the runs but the first one much faster
+    aFilter->SetTopologyCaching(false);
+    for(int aIsWireframe = 0; aIsWireframe <= 1; aIsWireframe++)
+      for(int aIsStoreMapping = 0; aIsStoreMapping <= 1; aIsStoreMapping++)
+        for(int aIsParallel = 0; aIsParallel <= 1; aIsParallel++){
+          aFilter->SetWireframeMode(aIsWireframe);
+          aFilter->SetStoreMapping(aIsStoreMapping);
+          aFilter->SetParallelMode(aIsParallel != 0);
+          aFilter->SetQuadraticArcMode(false);
+          TMode aMode(aIsWireframe, aIsStoreMapping, 0, aIsParallel);
+          theRecords.push_back(Measure(theMesh, theGrid, "geometry", aMode, theNbRepeats,
+                                       [&]() { return Execute(aFilter.Get()); }));
+        }
+  }
+
+  void
+  RunArcs(EMesh theMesh, vtkUnstructuredGrid* theGrid, int theNbRepeats, std::vector<TRecord>& theRecords)
+  {
+    if(theMesh != eQuadratic)
+      return;
+
+    // the whole pipeline in arc mode (only the quadratic edges and faces are concerned)
+    vtkNew<VTKViewer_GeometryFilter> aFilter;
+    aFilter->SetInputData(theGrid);
+    aFilter->SetTopologyCaching(false);
+    aFilter->SetQuadraticArcMode(true);
+    for(int aIsWireframe = 0; aIsWireframe <= 1; aIsWireframe++){
+      aFilter->SetWireframeMode(aIsWireframe);
+      TMode aMode(aIsWireframe, 0, 1, 0);
+      theRecords.push_back(Measure(theMesh, theGrid, "geometry", aMode, theNbRepeats,
+                                   [&]() { return Execute(aFilter.Get()); }));
+    }
+
+    // the arc builder alone, on the edges of the boundary quadrangles
+    double anAngle = aFilter->GetQuadraticArcAngle();
+    theRecords.push_back(Measure(theMesh, theGrid, "arc_builder", TMode(), theNbRepeats, [&]() {
+      vtkIdType aNbArcs = 0;
+      vtkPoints* aPoints = theGrid->GetPoints();
+      for(vtkIdType aCellId = 0; aCellId < theGrid->GetNumberOfCells(); aCellId++){
+        if(theGrid->GetCellType(aCellId) != VTK_QUADRATIC_QUAD)
+          continue;
+        vtkIdType aNbPts;
+        const vtkIdType* aPts;
+        theGrid->GetCellPoints(aCellId, aNbPts, aPts);
+        for(int e = 0; e < 4; e++){
+          double aCoord[3][3];
+          aPoints->GetPoint(aPts[e], aCoord[0]);
+          aPoints->GetPoint(aPts[4 + e], aCoord[1]);
+          aPoints->GetPoint(aPts[(e + 1) % 4], aCoord[2]);
+          Pnt aP0(aCoord[0][0], aCoord[0][1], aCoord[0][2], 0.0);
+          Pnt aP1(aCoord[1][0], aCoord[1][1], aCoord[1][2], 0.0);
+          Pnt aP2(aCoord[2][0], aCoord[2][1], aCoord[2][2], 0.0);
+          VTKViewer_ArcBuilder aBuilder(aP0, aP1, aP2, anAngle);
+          if(aBuilder.GetStatus() == VTKViewer_ArcBuilder::Arc_Done)
+            aNbArcs++;
+        }
+      }
+      return aNbArcs;
+    }));
+  }
+
+  void
+  RunAppend(EMesh theMesh, vtkUnstructuredGrid* theGrid, int theNbRepeats, std::vector<TRecord>& theRecords)
+  {
+    // two halves of the mesh sharing the same points, as the mesh actors append their parts
+    vtkSmartPointer<vtkUnstructuredGrid> aParts[2];
+    vtkIdType aNbCells = theGrid->GetNumberOfCells();
+    vtkNew<vtkIdList> aFaceStream;
+    vtkIdType aBounds[3] = { 0, aNbCells / 2, aNbCells };
+    for(int p = 0; p < 2; p++){
+      aParts[p] = vtkSmartPointer<vtkUnstructuredGrid>::New();
+      aParts[p]->SetPoints(theGrid->GetPoints());
+      aParts[p]->Allocate(aBounds[p + 1] - aBounds[p]);
+      for(vtkIdType aCellId = aBounds[p]; aCellId < aBounds[p + 1]; aCellId++){
+        if(theGrid->GetCellType(aCellId) == VTK_POLYHEDRON){
+          theGrid->GetFaceStream(aCellId, aFaceStream);
+          aParts[p]->InsertNextCell(VTK_POLYHEDRON, aFaceStream);
+        }else{
+          vtkIdType aNbPts;
+          const vtkIdType* aPts;
+          theGrid->GetCellPoints(aCellId, aNbPts, aPts);
+          aParts[p]->InsertNextCell(theGrid->GetCellType(aCellId), aNbPts, aPts);
+        }
+      }
+    }
+
+    vtkNew<VTKViewer_AppendFilter> aFilter;
+    aFilter->SetSharedPointsDataSet(theGrid);
+    aFilter->AddInputData(aParts[0]);
+    aFilter->AddInputData(aParts[1]);
+    for(int aIsStoreMapping = 0; aIsStoreMapping <= 1; aIsStoreMapping++){
+      aFilter->SetDoMappingFlag(aIsStoreMapping != 0);
+      TMode aMode(-1, aIsStoreMapping);
+      theRecords.push_back(Measure(theMesh, theGrid, "append", aMode, theNbRepeats,
+                                   [&]() { return Execute(aFilter.Get()); }));
+    }
+  }
+
+  void
+  RunExtract(EMesh theMesh, vtkUnstructuredGrid* theGrid, int theNbRepeats, std::vector<TRecord>& theRecords)
+  {
+    // every other cell, as a selection of elements would give
+    vtkNew<VTKViewer_ExtractUnstructuredGrid> aFilter;
+    aFilter->SetInputData(theGrid);
+    aFilter->SetModeOfChanging(VTKViewer_ExtractUnstructuredGrid::eAdding);
+    for(vtkIdType aCellId = 0; aCellId < theGrid->GetNumberOfCells(); aCellId += 2)
+      aFilter->RegisterCell(aCellId);
+    for(int aIsStoreMapping = 0; aIsStoreMapping <= 1; aIsStoreMapping++)
+      for(int aIsParallel = 0; aIsParallel <= 1; aIsParallel++){
+        aFilter->SetStoreMapping(aIsStoreMapping);
+        aFilter->SetParallelMode(aIsParallel != 0);
+        TMode aMode(-1, aIsStoreMapping, -1, aIsParallel);
+        theRecords.push_back(Measure(theMesh, theGrid, "extract", aMode, theNbRepeats,
+                                     [&]() { return Execute(aFilter.Get()); }));
+      }
+  }
+
+  void
+  RunShrink(EMesh theMesh, vtkUnstructuredGrid* theGrid, int theNbRepeats, std::vector<TRecord>& theRecords)
+  {
+    vtkNew<VTKViewer_ShrinkFilter> aFilter;
+    aFilter->SetInputData(theGrid);
+    aFilter->SetShrinkFactor(0.8);
+    for(int aIsStoreMapping = 0; aIsStoreMapping <= 1; aIsStoreMapping++){
+      aFilter->SetStoreMapping(aIsStoreMapping);
+      TMode aMode(-1, aIsStoreMapping);
+      theRecords.push_back(Measure(theMesh, theGrid, "shrink", aMode, theNbRepeats,
+                                   [&]() { return Execute(aFilter.Get()); }));
+    }
+  }
+
+  void
+  RunCenters(EMesh theMesh, vtkUnstructuredGrid* theGrid, int theNbRepeats, std::vector<TRecord>& theRecords)
+  {
+    vtkNew<VTKViewer_CellCenters> aFilter;
+    aFilter->SetInputData(theGrid);
+    aFilter->VertexCellsOn(); // as for the labels of the cells
+    theRecords.push_back(Measure(theMesh, theGrid, "centers", TMode(), theNbRepeats,
+                                 [&]() { return Execute(aFilter.Get()); }));
+  }
+
+  //----------------------------------------------------------------------------
+  void
+  PrintMode(std::ostream& theStream, int theValue, bool theIsJSON)
+  {
+    if(theValue >= 0)
+      theStream << (theIsJSON ? (theValue ? "true" : "false") : (theValue ? "1" : "0"));
+    else if(theIsJSON)
+      theStream << "null";
+  }
+
+  void
+  PrintJSON(std::ostream& theStream, const std::vector<TRecord>& theRecords)
+  {
+    theStream << "{\n"
+              << "  \"benchmark\": \"VTKViewer\",\n"
+              << "  \"vtk_version\": \"" << vtkVersion::GetVTKVersion() << "\",\n"
+              << "  \"threads\": " << vtkSMPTools::GetEstimatedNumberOfThreads() << ",\n"
+              << "  \"results\": [";
+    for(size_t i = 0; i < theRecords.size(); i++){
+      const TRecord& aRecord = theRecords[i];
+      double aThroughput = aRecord.myBest > 0.0 ? aRecord.myNbCells / aRecord.myBest : 0.0;
+      theStream << (i ? ",\n" : "\n")
+                << "    {\"mesh\": \"" << aRecord.myMesh << "\""
+                << ", \"filter\": \"" << aRecord.myFilter << "\""
+                << ", \"cells\": " << aRecord.myNbCells
+                << ", \"points\": " << aRecord.myNbPoints
+                << ", \"wireframe\": "; PrintMode(theStream, aRecord.myIsWireframe, true);
+      theStream << ", \"store_mapping\": "; PrintMode(theStream, aRecord.myIsStoreMapping, true);
+      theStream << ", \"arc\": "; PrintMode(theStream, aRecord.myIsArc, true);
+      theStream << ", \"parallel\": "; PrintMode(theStream, aRecord.myIsParallel, true);
+      theStream << ", \"repeat\": " << aRecord.myNbRepeats
+                << ", \"best_s\": " << aRecord.myBest
+                << ", \"mean_s\": " << aRecord.myMean
+                << ", \"cells_per_s\": " << aThroughput
+                << ", \"output_cells\": " << aRecord.myNbOutCells
+                << ", \"peak_rss_kb\": " << aRecord.myPeakRSS << "}";
+    }
+    theStream << "\n  ]\n}\n";
+  }
+
+  void
+  PrintCSV(std::ostream& theStream, const std::vector<TRecord>& theRecords)
+  {
+    theStream << "mesh,filter,cells,points,wireframe,store_mapping,arc,parallel,"
+              << "repeat,best_s,mean_s,cells_per_s,output_cells,peak_rss_kb\n";
+    for(size_t i = 0; i < theRecords.size(); i++){
+      const TRecord& aRecord = theRecords[i];
+      double aThroughput = aRecord.myBest > 0.0 ? aRecord.myNbCells / aRecord.myBest : 0.0;
+      theStream << aRecord.myMesh << "," << aRecord.myFilter << ","
+                << aRecord.myNbCells << "," << aRecord.myNbPoints << ",";
+      PrintMode(theStream, aRecord.myIsWireframe, false); theStream << ",";
+      PrintMode(theStream, aRecord.myIsStoreMapping, false); theStream << ",";
+      PrintMode(theStream, aRecord.myIsArc, false); theStream << ",";
+      PrintMode(theStream, aRecord.myIsParallel, false); theStream << ",";
+      theStream << aRecord.myNbRepeats << "," << aRecord.myBest << "," << aRecord.myMean << ","
+                << aThroughput << "," << aRecord.myNbOutCells << "," << aRecord.myPeakRSS << "\n";
+    }
+  }
+
+  std::vector<std::string>
+  Split(const std::string& theList)
+  {
+    std::vector<std::string> aList;
+    std::istringstream aStream(theList);
+    std::string anItem;
+    while(std::getline(aStream, anItem, ','))
+      if(!anItem.empty())
+        aList.push_back(anItem);
+    return aList;
+  }
+
+  bool
+  Contains(const std::vector<std::string>& theList, const char* theItem)
+  {
+    return std::find(theList.begin(), theList.end(), theItem) != theList.end();
+  }
+
+  int
+  Usage(const char* theName)
+  {
+    std::cerr << "Usage: " << theName << " [--sizes 1e4,1e5,1e6] [--meshes linear,quadratic,polyhedral]\n"
+              << "         [--filters geometry,append,extract,shrink,centers,arcs]\n"
+              << "         [--repeat 3] [--format json|csv] [--output <file>]\n"
+              << "Sizes are numbers of cells, rounded to a cube; up to 1e8 can be given\n"
+              << "if the memory allows it." << std::endl;
+    return 2;
+  }
+}
+
+//----------------------------------------------------------------------------
+int
+main(int argc, char** argv)
+{
+  std::vector<std::string> aSizes = Split("1e4,1e5,1e6");
+  std::vector<std::string> aMeshes = Split("linear,quadratic,polyhedral");
+  std::vector<std::string> aFilters = Split("geometry,append,extract,shrink,centers,arcs");
+  int aNbRepeats = 3;
+  std::string aFormat = "json";
+  std::string anOutput;
+
+  for(int i = 1; i < argc; i++){
+    std::string anArg = argv[i];
+    if(i + 1 >= argc)
+      return Usage(argv[0]);
+    std::string aValue = argv[++i];
+    if(anArg == "--sizes")
+      aSizes = Split(aValue);
+    else if(anArg == "--meshes")
+      aMeshes = Split(aValue);
+    else if(anArg == "--filters")
+      aFilters = Split(aValue);
+    else if(anArg == "--repeat")
+      aNbRepeats = std::max(1, atoi(aValue.c_str()));
+    else if(anArg == "--format" && (aValue == "json" || aValue == "csv"))
+      aFormat = aValue;
+    else if(anArg == "--output")
+      anOutput = aValue;
+    else
+      return Usage(argv[0]);
+  }
+
+  std::vector<vtkIdType> aNbCells;
+  for(size_t i = 0; i < aSizes.size(); i++)
+    aNbCells.push_back(vtkIdType(strtod(aSizes[i].c_str(), 0)));
+  std::sort(aNbCells.begin(), aNbCells.end());
+
+  std::vector<TRecord> aRecords;
+  bool anIsOk = true;
+  for(size_t s = 0; s < aNbCells.size(); s++)
+    for(int m = eLinear; m <= ePolyhedral; m++){
+      EMesh aMesh = EMesh(m);
+      if(!Contains(aMeshes, MESH_NAMES[aMesh]))
+        continue;
+
+      vtkSmartPointer<vtkUnstructuredGrid> aGrid = BuildGrid(aMesh, aNbCells[s]);
+      size_t aFirst = aRecords.size();
+      if(Contains(aFilters, "geometry"))
+        RunGeometry(aMesh, aGrid, aNbRepeats, aRecords);
+      if(Contains(aFilters, "arcs"))
+        RunArcs(aMesh, aGrid, aNbRepeats, aRecords);
+      if(Contains(aFilters, "append"))
+        RunAppend(aMesh, aGrid, aNbRepeats, aRecords);
+      if(Contains(aFilters, "extract"))
+        RunExtract(aMesh, aGrid, aNbRepeats, aRecords);
+      if(Contains(aFilters, "shrink"))
+        RunShrink(aMesh, aGrid, aNbRepeats, aRecords);
+      if(Contains(aFilters, "centers"))
+        RunCenters(aMesh, aGrid, aNbRepeats, aRecords);
+
+      // a filter giving nothing is broken, whatever its speed is
+      for(size_t r = aFirst; r < aRecords.size(); r++)
+        if(aRecords[r].myNbOutCells == 0){
+          std::cerr << "ERROR: empty output for " << aRecords[r].myFilter
+                    << " on the " << aRecords[r].myMesh << " mesh" << std::endl;
+          anIsOk = false;
+        }
+    }
+
+  std::ofstream aFile;
+  if(!anOutput.empty()){
+    aFile.open(anOutput.c_str());
+    if(!aFile){
+      std::cerr << "ERROR: can not write " << anOutput << std::endl;
+      return 1;
+    }
+  }
+  std::ostream& aStream = anOutput.empty() ? std::cout : aFile;
+  if(aFormat == "csv")
+    PrintCSV(aStream, aRecords);
+  else
+    PrintJSON(aStream, aRecords);
+
+  return anIsOk ? 0 : 1;
+}
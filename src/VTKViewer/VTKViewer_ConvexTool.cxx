@@ -75,6 +75,195 @@ namespace
   };
 
   typedef std::vector<TPolygon> TPolygons;
+
+  //! Maximum number of triangulations stored per signature
+  const size_t MAX_CACHE_CANDIDATES = 8;
+}
+
+
+//----------------------------------------------------------------------------
+VTKViewer_TriangulationCache
+::VTKViewer_TriangulationCache()
+{}
+
+
+//----------------------------------------------------------------------------
+bool
+VTKViewer_TriangulationCache
+::IsValid(vtkPoints* thePoints,
+          double theDistEps,
+          const TTriangles& theTriangles)
+{
+  vtkIdType aNumPts = thePoints->GetNumberOfPoints();
+  size_t aNbTriangles = theTriangles.size() / 3;
+  if(aNumPts < 4 || aNbTriangles < 4 || theTriangles.size() % 3 != 0)
+    return false;
+
+  // Each edge has to be used by two triangles, in opposite directions
+  typedef std::pair<vtkIdType,vtkIdType> TEdge;
+  std::set<TEdge> anEdges;
+  std::set<vtkIdType> aVertices;
+  for(size_t aTriaId = 0; aTriaId < aNbTriangles; aTriaId++){
+    const vtkIdType* aTria = &theTriangles[3*aTriaId];
+    for(int i = 0; i < 3; i++){
+      if(aTria[i] < 0 || aTria[i] >= aNumPts)
+        return false;
+      if(!anEdges.insert(TEdge(aTria[i],aTria[(i+1)%3])).second)
+        return false;
+      aVertices.insert(aTria[i]);
+    }
+  }
+  for(const TEdge& anEdge : anEdges)
+    if(anEdges.find(TEdge(anEdge.second,anEdge.first)) == anEdges.end())
+      return false;
+
+  // The surface has to be a single sphere (V - E + F = 2)
+  if(vtkIdType(aVertices.size()) - vtkIdType(anEdges.size()/2) + vtkIdType(aNbTriangles) != 2)
+    return false;
+
+  for(size_t aTriaId = 0; aTriaId < aNbTriangles; aTriaId++){
+    const vtkIdType* aTria = &theTriangles[3*aTriaId];
+    double aCoord[3][3];
+    for(int i = 0; i < 3; i++)
+      thePoints->GetPoint(aTria[i],aCoord[i]);
+
+    double aVector01[3], aVector02[3], aNormal[3];
+    vtkMath::Subtract(aCoord[1],aCoord[0],aVector01);
+    vtkMath::Subtract(aCoord[2],aCoord[0],aVector02);
+    vtkMath::Cross(aVector01,aVector02,aNormal);
+    if(vtkMath::Normalize(aNormal) <= theDistEps*theDistEps)
+      return false;
+
+    // All the points have to be at the inner side of the (outward) triangle
+    for(vtkIdType aPntId = 0; aPntId < aNumPts; aPntId++){
+      double aPntCoord[3];
+      thePoints->GetPoint(aPntId,aPntCoord);
+      if(vtkPlane::Evaluate(aNormal,aCoord[0],aPntCoord) > theDistEps)
+        return false;
+    }
+  }
+
+  return true;
+}
+
+
+//----------------------------------------------------------------------------
+void
+VTKViewer_TriangulationCache
+::GetSignature(vtkPoints* thePoints,
+               double theDistEps,
+               TSignature& theSignature)
+{
+  vtkIdType aNumPts = thePoints->GetNumberOfPoints();
+  theSignature.assign(1,aNumPts);
+  for(vtkIdType aPntId = 0; aPntId < aNumPts; aPntId++){
+    double aCoord[3];
+    thePoints->GetPoint(aPntId,aCoord);
+    vtkIdType aNearestId = -1;
+    double aMinDist = VTK_DOUBLE_MAX;
+    for(vtkIdType anId = 0; anId < aNumPts; anId++){
+      if(anId == aPntId)
+        continue;
+      double anOtherCoord[3];
+      thePoints->GetPoint(anId,anOtherCoord);
+      double aDist = sqrt(vtkMath::Distance2BetweenPoints(aCoord,anOtherCoord));
+      // the lowest id is taken among the points at the same distance
+      if(aDist < aMinDist - theDistEps){
+        aMinDist = aDist;
+        aNearestId = anId;
+      }
+    }
+    theSignature.push_back(aNearestId);
+  }
+}
+
+
+//----------------------------------------------------------------------------
+bool
+VTKViewer_TriangulationCache
+::Find(vtkPoints* thePoints,
+       double theDistEps,
+       TTriangles& theTriangles)
+{
+  TSignature aSignature;
+  GetSignature(thePoints,theDistEps,aSignature);
+
+  TCandidates aCandidates;
+  {
+    std::lock_guard<std::mutex> aLock(myMutex);
+    auto anIter = mySignature2Candidates.find(aSignature);
+    if(anIter == mySignature2Candidates.end())
+      return false;
+    aCandidates = anIter->second;
+  }
+
+  // The (costly) checks are done outside of the lock
+  for(const TTrianglesPtr& aCandidate : aCandidates){
+    if(IsValid(thePoints,theDistEps,*aCandidate)){
+      theTriangles = *aCandidate;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+
+//----------------------------------------------------------------------------
+void
+VTKViewer_TriangulationCache
+::Add(vtkPoints* thePoints,
+      double theDistEps,
+      const TTriangles& theTriangles)
+{
+  // The triangles are stored oriented outwards
+  TTriangles anOriented(theTriangles);
+  vtkIdType aNumPts = thePoints->GetNumberOfPoints();
+  for(size_t aTriaId = 0; aTriaId + 2 < anOriented.size(); aTriaId += 3){
+    vtkIdType* aTria = &anOriented[aTriaId];
+    double aCoord[3][3];
+    for(int i = 0; i < 3; i++){
+      if(aTria[i] < 0 || aTria[i] >= aNumPts)
+        return;
+      thePoints->GetPoint(aTria[i],aCoord[i]);
+    }
+    double aVector01[3], aVector02[3], aNormal[3];
+    vtkMath::Subtract(aCoord[1],aCoord[0],aVector01);
+    vtkMath::Subtract(aCoord[2],aCoord[0],aVector02);
+    vtkMath::Cross(aVector01,aVector02,aNormal);
+    vtkMath::Normalize(aNormal);
+    for(vtkIdType aPntId = 0; aPntId < aNumPts; aPntId++){
+      double aPntCoord[3];
+      thePoints->GetPoint(aPntId,aPntCoord);
+      if(vtkPlane::Evaluate(aNormal,aCoord[0],aPntCoord) > theDistEps){
+        std::swap(aTria[1],aTria[2]);
+        break;
+      }
+    }
+  }
+
+  if(!IsValid(thePoints,theDistEps,anOriented))
+    return;
+
+  TSignature aSignature;
+  GetSignature(thePoints,theDistEps,aSignature);
+  TTrianglesPtr aTriangles = std::make_shared<const TTriangles>(anOriented);
+
+  std::lock_guard<std::mutex> aLock(myMutex);
+  TCandidates& aCandidates = mySignature2Candidates[aSignature];
+  aCandidates.push_front(aTriangles);
+  if(aCandidates.size() > MAX_CACHE_CANDIDATES)
+    aCandidates.pop_back();
+}
+
+
+//----------------------------------------------------------------------------
+void
+VTKViewer_TriangulationCache
+::Clear()
+{
+  std::lock_guard<std::mutex> aLock(myMutex);
+  mySignature2Candidates.clear();
 }
 
 
@@ -82,6 +271,7 @@ namespace
 VTKViewer_Triangulator
 ::VTKViewer_Triangulator():
   myCellIds(vtkIdList::New()),
+  myCache(NULL),
   myPointIds(NULL),
   myFaceIds(vtkIdList::New()),
   myPoints(vtkPoints::New())
@@ -98,6 +288,15 @@ VTKViewer_Triangulator
 }
 
 
+//----------------------------------------------------------------------------
+void
+VTKViewer_Triangulator
+::SetCache(VTKViewer_TriangulationCache* theCache)
+{
+  myCache = theCache;
+}
+
+
 //----------------------------------------------------------------------------
 vtkPoints*
 VTKViewer_Triangulator
@@ -167,14 +366,13 @@ void
 VTKViewer_Triangulator
 ::GetCellNeighbors(vtkUnstructuredGrid *theInput,
                    vtkIdType theCellId,
-                   vtkCell* theFace,
+                   const vtkIdType theFace[3],
                    vtkIdList* theCellIds)
 {
   myFaceIds->Reset();
-  vtkIdList *anIdList = theFace->PointIds;  
-  myFaceIds->InsertNextId(myPointIds[anIdList->GetId(0)]);
-  myFaceIds->InsertNextId(myPointIds[anIdList->GetId(1)]);
-  myFaceIds->InsertNextId(myPointIds[anIdList->GetId(2)]);
+  myFaceIds->InsertNextId(myPointIds[theFace[0]]);
+  myFaceIds->InsertNextId(myPointIds[theFace[1]]);
+  myFaceIds->InsertNextId(myPointIds[theFace[2]]);
 
   theInput->GetCellNeighbors(theCellId, myFaceIds, theCellIds);
 }
@@ -206,7 +404,66 @@ VTKViewer_Triangulator
           std::vector< std::vector<vtkIdType> >& theDimension2VTK2ObjIds,
           bool theIsCheckConvex)
 {
-  vtkPoints *aPoints = InitPoints(theInput, theCellId);
+  std::vector< std::vector<vtkIdType> > aPolygons;
+  if(!Execute(theInput,
+              theCellId,
+              theShowInside,
+              theAllVisible,
+              theAppendCoincident3D,
+              theCellsVisibility,
+              aPolygons,
+              theIsCheckConvex))
+    return false;
+
+  // To pass resulting set of the polygons to the output
+  size_t aNbPolygons = aPolygons.size();
+  for (size_t aPolygonId = 0; aPolygonId < aNbPolygons; aPolygonId++) {
+    TConnectivities& aConnectivities = aPolygons[aPolygonId];
+    int aNbPoints = (int)aConnectivities.size();
+    vtkIdType aNewCellId = theOutput->InsertNextCell(VTK_POLYGON,aNbPoints,&aConnectivities[0]);
+    if(theStoreMapping)
+      VTKViewer_GeometryFilter::InsertId( theCellId, VTK_POLYGON, theVTK2ObjIds, theDimension2VTK2ObjIds );
+    theOutputCD->CopyData(thInputCD,theCellId,aNewCellId);
+  }
+
+  return true;
+}
+
+
+//----------------------------------------------------------------------------
+bool 
+VTKViewer_Triangulator
+::Execute(vtkUnstructuredGrid *theInput,
+          vtkIdType theCellId,
+          int theShowInside,
+          int theAllVisible,
+          int theAppendCoincident3D,
+          const char* theCellsVisibility,
+          std::vector< std::vector<vtkIdType> >& thePolygons,
+          bool theIsCheckConvex)
+{
+  thePolygons.clear();
+
+  // To reuse a triangulation of a similar cell, if any, instead of the triangulating
+  vtkPoints *aPoints = NULL;
+  bool anIsCached = false;
+  if(myCache){
+    aPoints = VTKViewer_Triangulator::InitPoints(theInput, theCellId);
+    anIsCached = myCache->Find(aPoints, GetCellLength()/3.0 * 1.0E-2, myTriangles);
+  }
+  if(!anIsCached){
+    aPoints = InitPoints(theInput, theCellId);
+    myTriangles.clear();
+    for (vtkIdType aFaceId = 0, aNbFaces = GetNumFaces(); aFaceId < aNbFaces; aFaceId++) {
+      vtkIdList *anIdList = GetFace(aFaceId)->PointIds;
+      myTriangles.push_back(anIdList->GetId(0));
+      myTriangles.push_back(anIdList->GetId(1));
+      myTriangles.push_back(anIdList->GetId(2));
+    }
+    if(myCache)
+      myCache->Add(aPoints, GetCellLength()/3.0 * 1.0E-2, myTriangles);
+  }
+
   vtkIdType aNumPts = GetNbOfPoints();
   if(DEBUG_TRIA_EXECUTE) std::cout<<"Triangulator - aNumPts = "<<aNumPts<<"\n";
 
@@ -230,7 +487,7 @@ VTKViewer_Triangulator
   }
 
   double aCellLength = GetCellLength();
-  vtkIdType aNumFaces = GetNumFaces();
+  vtkIdType aNumFaces = (vtkIdType)myTriangles.size() / 3;
 
   static double EPS = 1.0E-2;
   double aDistEps = aCellLength/3.0 * EPS;
@@ -250,7 +507,7 @@ VTKViewer_Triangulator
   TFace2PointIds aFace2PointIds;
 
   for (auto aFaceId = 0; aFaceId < aNumFaces; aFaceId++) {
-    vtkCell* aFace = GetFace(aFaceId);
+    const vtkIdType* aFace = &myTriangles[3*aFaceId];
     
     GetCellNeighbors(theInput, theCellId, aFace, myCellIds);
     bool process = myCellIds->GetNumberOfIds() <= 0 ? true : theAppendCoincident3D;
@@ -258,10 +515,9 @@ VTKViewer_Triangulator
        myCellIds->GetNumberOfIds() <= 0 || theShowInside || process)
     {
       TPointIds aPointIds;
-      vtkIdList *anIdList = aFace->PointIds;  
-      aPointIds.insert(anIdList->GetId(0));
-      aPointIds.insert(anIdList->GetId(1));
-      aPointIds.insert(anIdList->GetId(2));
+      aPointIds.insert(aFace[0]);
+      aPointIds.insert(aFace[1]);
+      aPointIds.insert(aFace[2]);
       
       aFace2PointIds.insert(aPointIds);
       aFace2Visibility.insert(aFaceId);
@@ -275,10 +531,8 @@ VTKViewer_Triangulator
     if(aFace2Visibility.find(aFaceId) == aFace2Visibility.end())
       continue;
 
-    vtkCell* aFace = GetFace(aFaceId);
-
-    vtkIdList *anIdList = aFace->PointIds;
-    vtkIdType aNewPts[3] = {anIdList->GetId(0), anIdList->GetId(1), anIdList->GetId(2)};
+    const vtkIdType* aFace = &myTriangles[3*aFaceId];
+    vtkIdType aNewPts[3] = {aFace[0], aFace[1], aFace[2]};
             
     // To initialize set of points for the plane where the trinangle face belong to
     TPointIds aPointIds;
@@ -568,9 +822,10 @@ VTKViewer_Triangulator
   }
 
 
-  // To pass resulting set of the polygons to the output
+  // To pass resulting set of the polygons to the caller
   {
     size_t aNbPolygons = aPolygons.size();
+    thePolygons.reserve(aNbPolygons);
     for (size_t aPolygonId = 0; aPolygonId < aNbPolygons; aPolygonId++) {
       ::TPolygon& aPolygon = aPolygons[aPolygonId];
       if(DEBUG_TRIA_EXECUTE) std::cout << "PoilygonId="<<aPolygonId<<" | ";
@@ -580,11 +835,7 @@ VTKViewer_Triangulator
           std::cout << aConnectivities[i] << ",";
         std::cout << endl;
       }
-      int aNbPoints = (int)aConnectivities.size();
-      vtkIdType aNewCellId = theOutput->InsertNextCell(VTK_POLYGON,aNbPoints,&aConnectivities[0]);
-      if(theStoreMapping)
-        VTKViewer_GeometryFilter::InsertId( theCellId, VTK_POLYGON, theVTK2ObjIds, theDimension2VTK2ObjIds );
-      theOutputCD->CopyData(thInputCD,theCellId,aNewCellId);
+      thePolygons.push_back(aConnectivities);
     }
   }
 
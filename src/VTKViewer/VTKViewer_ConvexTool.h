@@ -25,7 +25,10 @@
 
 #include "VTKViewer.h"
 
+#include <list>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <vector>
 
 #include <vtkSystemIncludes.h>
@@ -44,6 +47,66 @@ class vtkTriangle;
 class vtkOrderedTriangulator;
 
 
+//----------------------------------------------------------------------------
+/*! Stores triangulations of the cells boundary to reuse them for other cells
+ *  with the same signature of the local numbering (number of points and nearest
+ *  point of each point). As the boundary of a convex point set depends on its
+ *  geometry, a stored triangulation is reused only after it has been checked
+ *  against the points of the current cell: it must be a closed surface (each
+ *  edge used twice, in opposite directions), each triangle must be non-degenerated,
+ *  oriented outwards and have all the cell points at its inner side.
+ *  Thread-safe, so one instance can be shared by several triangulators.
+ */
+class VTKVIEWER_EXPORT VTKViewer_TriangulationCache
+{
+ public:
+  //! Local point ids of the boundary triangles, three per triangle
+  typedef std::vector<vtkIdType> TTriangles;
+
+  //! Number of points followed by the local id of the nearest point of each point
+  typedef std::vector<vtkIdType> TSignature;
+
+  VTKViewer_TriangulationCache();
+
+  //! Looks for a stored triangulation valid for the given points
+  bool
+  Find(vtkPoints* thePoints,
+       double theDistEps,
+       TTriangles& theTriangles);
+
+  //! Stores the triangulation, if it is valid for the given points
+  void
+  Add(vtkPoints* thePoints,
+      double theDistEps,
+      const TTriangles& theTriangles);
+
+  //! Removes all the stored triangulations
+  void
+  Clear();
+
+  //! Checks that the triangles bound the convex hull of the given points
+  static
+  bool
+  IsValid(vtkPoints* thePoints,
+          double theDistEps,
+          const TTriangles& theTriangles);
+
+  //! Computes the signature of the local numbering of the given points
+  static
+  void
+  GetSignature(vtkPoints* thePoints,
+               double theDistEps,
+               TSignature& theSignature);
+
+ private:
+  typedef std::shared_ptr<const TTriangles> TTrianglesPtr;
+  typedef std::list<TTrianglesPtr> TCandidates;
+
+  std::mutex myMutex;
+  std::map<TSignature,TCandidates> mySignature2Candidates;
+};
+
+
 //----------------------------------------------------------------------------
 class VTKVIEWER_EXPORT VTKViewer_Triangulator
 {
@@ -67,8 +130,29 @@ class VTKVIEWER_EXPORT VTKViewer_Triangulator
           std::vector< std::vector<vtkIdType> >& theDimension2VTK2ObjIds,
           bool theIsCheckConvex);
 
+  /*! Same as above, but the boundary polygons of the cell are returned in
+   *  \a thePolygons (as connectivities in the input point ids) instead of being
+   *  inserted into an output data set. Does not touch any shared data, so it can
+   *  be called from several threads as soon as the input cell links are built.
+   */
+  bool 
+  Execute(vtkUnstructuredGrid *theInput,
+          vtkIdType theCellId,
+          int theShowInside,
+          int theAllVisible,
+          int theAppendCoincident3D,
+          const char* theCellsVisibility,
+          std::vector< std::vector<vtkIdType> >& thePolygons,
+          bool theIsCheckConvex);
+
+  //! Sets the cache of triangulations to be used (not owned, can be NULL)
+  void
+  SetCache(VTKViewer_TriangulationCache* theCache);
+
  private:
   vtkIdList* myCellIds;
+  VTKViewer_TriangulationCache* myCache;
+  VTKViewer_TriangulationCache::TTriangles myTriangles;
 
  protected:
   vtkIdType *myPointIds;
@@ -100,7 +184,7 @@ class VTKVIEWER_EXPORT VTKViewer_Triangulator
   void 
   GetCellNeighbors(vtkUnstructuredGrid *theInput,
                    vtkIdType theCellId,
-                   vtkCell* theFace,
+                   const vtkIdType theFace[3],
                    vtkIdList* theCellIds);
 
   vtkIdType 
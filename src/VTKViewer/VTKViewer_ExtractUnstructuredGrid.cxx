@@ -35,8 +35,14 @@
 #include <vtkCellData.h>
 #include <vtkInformation.h>
 #include <vtkInformationVector.h>
+#include <vtkCellTypes.h>
+#include <vtkSMPTools.h>
+#include <vtkNew.h>
 #include <vtkVersion.h>
 
+#include <algorithm>
+#include <numeric>
+
 #include "utilities.h"
 
 #if defined __GNUC__
@@ -51,7 +57,8 @@ vtkStandardNewMacro(VTKViewer_ExtractUnstructuredGrid)
 
 
 VTKViewer_ExtractUnstructuredGrid::VTKViewer_ExtractUnstructuredGrid():
-  myExtractionMode(eCells), myChangeMode(ePassAll), myStoreMapping( false ), myPassAll( false )
+  myExtractionMode(eCells), myChangeMode(ePassAll), myNbCellIds( 0 ),
+  myStoreMapping( false ), myPassAll( false ), myIsParallel( false ), myIsMappingFilled( false )
 {}
 
 
@@ -60,8 +67,16 @@ VTKViewer_ExtractUnstructuredGrid::~VTKViewer_ExtractUnstructuredGrid()
 
 void VTKViewer_ExtractUnstructuredGrid::RegisterCell(vtkIdType theCellId)
 {
-  if ( myCellIds.insert(theCellId).second )
+  if ( theCellId < 0 )
+    return;
+  if ( theCellId >= (vtkIdType) myCellIds.size() )
+    myCellIds.resize( std::max( theCellId + 1, vtkIdType( 2 * myCellIds.size() )), false );
+  if ( !myCellIds[ theCellId ] )
+  {
+    myCellIds[ theCellId ] = true;
+    myNbCellIds++;
     Modified();
+  }
 }
 
 
@@ -83,7 +98,7 @@ void VTKViewer_ExtractUnstructuredGrid::SetStoreMapping(int theStoreMapping)
 
 vtkIdType VTKViewer_ExtractUnstructuredGrid::GetInputId(vtkIdType theOutId) const
 {
-  if ( myPassAll || ( myCellIds.empty() && myCellTypes.empty() ))
+  if ( myPassAll || ( myNbCellIds == 0 && myCellTypes.empty() ))
     return theOutId;
 
   if ( theOutId < 0 || theOutId >= (vtkIdType) myOut2InId.size() )
@@ -93,205 +108,143 @@ vtkIdType VTKViewer_ExtractUnstructuredGrid::GetInputId(vtkIdType theOutId) cons
 
 void VTKViewer_ExtractUnstructuredGrid::BuildOut2InMap()
 {
-  if ( myPassAll || !myOut2InId.empty() ) return;
+  // the map is filled by RequestData(); compute it here only if the filter was not executed
+  if ( myPassAll || myIsMappingFilled ) return;
 
   vtkUnstructuredGrid *anInput = dynamic_cast< vtkUnstructuredGrid*>( this->GetInput() );
   if ( !anInput ) return;
 
-  // use a vector of cellTypes to avoid searching in myCellTypes map
-  // for a better performance (IPAL53103)
-  TVectorId cellTypesVec( VTK_NUMBER_OF_CELL_TYPES, -1 );
-  for ( TSetId::iterator type = myCellTypes.begin(); type != myCellTypes.end(); ++type )
+  FillOut2InMap( anInput );
+
+  vtkIdType aNbElems = ( myExtractionMode == eCells ) ? anInput->GetNumberOfCells() : anInput->GetNumberOfPoints();
+  if ((vtkIdType) myOut2InId.size() == aNbElems )
   {
-    if ( *type >= (int)cellTypesVec.size() ) cellTypesVec.resize( *type+1, -1 );
-    if ( *type > 0 )
-      cellTypesVec[ *type ] = *type;
+    myPassAll = true;
+    TVectorId().swap( myOut2InId );
   }
+}
 
-  // same code as in RequestData() excluding cells copying
-  vtkIdType aNbElems = 0;
-  if ( myExtractionMode == eCells )
+// vtkIdType VTKViewer_ExtractUnstructuredGrid::GetOutputId(int theInId) const{
+//   if(myCellIds.empty() && myCellTypes.empty()) return theInId;
+//   TMapId::const_iterator anIter = myIn2OutId.find(theInId);
+//   if(anIter == myIn2OutId.end()) return -1;
+//   return anIter->second;
+// }
+
+namespace
+{
+  //! Minimal number of elements processed by a thread
+  const vtkIdType MIN_PARALLEL_CHUNK_SIZE = 10000;
+
+  //! Tells whether an input element (cell or node) is passed to the output
+  struct TExtractionFilter
   {
-    aNbElems = anInput->GetNumberOfCells();
-    if (( myChangeMode == ePassAll ) ||
-        ( myCellIds.empty() && myCellTypes.empty() && myChangeMode == eRemoving))
-    {
-      myPassAll = true;
-    }
-    else
+    const VTKViewer_ExtractUnstructuredGrid::TBitmapId& myCellIds;
+    bool                                                myIsIdsFilter;
+    const VTKViewer_ExtractUnstructuredGrid::TVectorId& myCellTypesVec;
+    bool                                                myIsTypesFilter;
+    const unsigned char*                                myInputTypes;
+    vtkIdType                                           myNbInputCells;
+    bool                                                myIsAdding;
+
+    bool operator()( vtkIdType theId ) const
     {
-      if ( !myCellIds.empty() && myCellTypes.empty() )
+      if ( myIsTypesFilter )
       {
-        if ( myChangeMode == eAdding )
-        {
-          myOut2InId.reserve(myCellIds.size());
-
-          for(vtkIdType aCellId = 0, anOutId = 0; aCellId < aNbElems; aCellId++,anOutId++)
-            if ( myCellIds.find(aCellId) != myCellIds.end() )
-              myOut2InId.push_back( aCellId );
-        }
-        else
-        {
-          myOut2InId.reserve( std::max( vtkIdType(0), vtkIdType(aNbElems - myCellIds.size())));
-
-          for(vtkIdType aCellId = 0, anOutId = 0; aCellId < aNbElems; aCellId++,anOutId++)
-            if ( myCellIds.find(aCellId) == myCellIds.end() )
-              myOut2InId.push_back( aCellId );
-        }
+        vtkIdType aType = theId < myNbInputCells ? myInputTypes[ theId ] : VTK_EMPTY_CELL;
+        if (( myCellTypesVec[ aType ] == aType ) != myIsAdding )
+          return false;
       }
-      else if ( myCellIds.empty() && !myCellTypes.empty() )
+      if ( myIsIdsFilter )
       {
-        myOut2InId.reserve( aNbElems );
-        if ( myChangeMode == eAdding )
-        {
-          for(vtkIdType aCellId = 0, anOutId = 0; aCellId < aNbElems; aCellId++,anOutId++)
-          {
-            vtkIdType aType = anInput->GetCellType(aCellId);
-            if ( cellTypesVec[ aType ] == aType )
-              myOut2InId.push_back( aCellId );
-          }
-        }
-        else
-        {
-          for(vtkIdType aCellId = 0, anOutId = 0; aCellId < aNbElems; aCellId++,anOutId++)
-          {
-            vtkIdType aType = anInput->GetCellType(aCellId);
-            if ( cellTypesVec[ aType ] != aType )
-              myOut2InId.push_back( aCellId );
-          }
-        }
+        bool anIsRegistered = theId < (vtkIdType) myCellIds.size() && myCellIds[ theId ];
+        if ( anIsRegistered != myIsAdding )
+          return false;
       }
-      else if ( !myCellIds.empty() && !myCellTypes.empty())
-      {
-        myOut2InId.reserve( aNbElems );
+      // nothing is added if nothing is registered
+      return !myIsAdding || myIsIdsFilter || myIsTypesFilter;
+    }
+  };
+}
 
-        if ( myChangeMode == eAdding )
-        {
-          for(vtkIdType aCellId = 0, anOutId = 0; aCellId < aNbElems; aCellId++,anOutId++)
-          {
-            vtkIdType aType = anInput->GetCellType(aCellId);
-            if ( cellTypesVec[ aType ] == aType )
-              if ( myCellIds.find(aCellId) != myCellIds.end() )
-                myOut2InId.push_back( aCellId );
-          }
-        }
-        else
-        {
-          for(vtkIdType aCellId = 0, anOutId = 0; aCellId < aNbElems; aCellId++,anOutId++)
-          {
-            vtkIdType aType = anInput->GetCellType(aCellId);
-            if ( cellTypesVec[ aType ] != aType )
-              if ( myCellIds.find(aCellId) == myCellIds.end())
-                myOut2InId.push_back( aCellId );
-          }
-        }
-      }
-    } // not ePassAll 
+void VTKViewer_ExtractUnstructuredGrid::FillOut2InMap(vtkUnstructuredGrid* theInput)
+{
+  myPassAll = false;
+  TVectorId().swap( myOut2InId );
+
+  bool isIdsFilter   = myNbCellIds > 0;
+  bool isTypesFilter = !myCellTypes.empty();
+
+  // additional condition on the types array has been added to treat a case described
+  // in IPAL21372; note that it is significant only when myExtractionMode == ePoints
+  if (( myChangeMode == ePassAll ) ||
+      ( !isIdsFilter && !isTypesFilter && myChangeMode == eRemoving ) ||
+      ( myExtractionMode == ePoints && !theInput->GetCellTypesArray() ))
+  {
+    myPassAll = true;
+    return;
   }
-  else // nodes
+
+  // use a vector of cellTypes to avoid searching in myCellTypes map
+  // for a better performance (IPAL53103)
+  TVectorId cellTypesVec( VTK_NUMBER_OF_CELL_TYPES, -1 );
+  for ( TSetId::iterator type = myCellTypes.begin(); type != myCellTypes.end(); ++type )
   {
-    aNbElems = anInput->GetNumberOfPoints();
+    if ( *type >= (int)cellTypesVec.size() ) cellTypesVec.resize( *type+1, -1 );
+    if ( *type > 0 )
+      cellTypesVec[ *type ] = *type;
+  }
 
-    if (( myChangeMode == ePassAll ) ||
-        ( myCellIds.empty() && myCellTypes.empty() && myChangeMode == eRemoving) ||
-        ( !anInput->GetCellTypesArray() ))
-    {
-      myPassAll = true;
-    }
-    else if ( !myCellIds.empty() && myCellTypes.empty())
-    {
-      if ( myChangeMode == eAdding )
-      {
-        myOut2InId.reserve( myCellIds.size() );
+  vtkUnsignedCharArray* anInputTypes = theInput->GetCellTypesArray();
+  TExtractionFilter aFilter = { myCellIds, isIdsFilter, cellTypesVec, isTypesFilter,
+                                anInputTypes ? anInputTypes->GetPointer( 0 ) : 0,
+                                anInputTypes ? anInputTypes->GetNumberOfTuples() : 0,
+                                myChangeMode == eAdding };
 
-        for(vtkIdType aCellId = 0, anOutId = 0; aCellId < aNbElems; aCellId++,anOutId++)
-          if ( myCellIds.find(aCellId) != myCellIds.end())
-            myOut2InId.push_back( aCellId );
-      }
-      else
-      {
-        myOut2InId.reserve( std::max( vtkIdType(0), vtkIdType(aNbElems - myCellIds.size())));
+  vtkIdType aNbElems = ( myExtractionMode == eCells ) ? theInput->GetNumberOfCells() : theInput->GetNumberOfPoints();
+  if ( myChangeMode == eAdding && !isTypesFilter )
+    myOut2InId.reserve( myNbCellIds );
+  else
+    myOut2InId.reserve( aNbElems );
 
-        for(vtkIdType aCellId = 0, anOutId = 0; aCellId < aNbElems; aCellId++,anOutId++)
-          if ( myCellIds.find(aCellId) == myCellIds.end())
-            myOut2InId.push_back( aCellId );
-      }
-    }
-    else if ( myCellIds.empty() && !myCellTypes.empty())
+  if ( myIsParallel && aNbElems >= 2 * MIN_PARALLEL_CHUNK_SIZE )
+  {
+    // each chunk collects its ids, chunks are appended in order
+    vtkIdType aNbChunks = std::min<vtkIdType>( aNbElems / MIN_PARALLEL_CHUNK_SIZE,
+                                               8 * vtkSMPTools::GetEstimatedNumberOfThreads() );
+    vtkIdType aChunkSize = ( aNbElems + aNbChunks - 1 ) / aNbChunks;
+    std::vector< TVectorId > aChunks( aNbChunks );
+    vtkSMPTools::For( 0, aNbChunks, 1, [&]( vtkIdType theFirstChunk, vtkIdType theLastChunk )
     {
-      myOut2InId.reserve( aNbElems );
-
-      if ( myChangeMode == eAdding )
+      for ( vtkIdType aChunkId = theFirstChunk; aChunkId < theLastChunk; ++aChunkId )
       {
-        for(vtkIdType aCellId = 0, anOutId = 0; aCellId < aNbElems; aCellId++,anOutId++)
-        {
-          vtkIdType aType = anInput->GetCellType(aCellId);
-          if ( cellTypesVec[ aType ] == aType )
-            myOut2InId.push_back( aCellId );
-        }
-      }
-      else
-      {
-        for(vtkIdType aCellId = 0, anOutId = 0; aCellId < aNbElems; aCellId++,anOutId++)
-        {
-          vtkIdType aType = anInput->GetCellType(aCellId);
-          if ( cellTypesVec[ aType ] != aType )
-            myOut2InId.push_back( aCellId );
-        }
+        vtkIdType aLast = std::min( aNbElems, ( aChunkId + 1 ) * aChunkSize );
+        for ( vtkIdType anId = aChunkId * aChunkSize; anId < aLast; ++anId )
+          if ( aFilter( anId ))
+            aChunks[ aChunkId ].push_back( anId );
       }
-    }
-    else if ( !myCellIds.empty() && !myCellTypes.empty() )
+    });
+    for ( size_t iChunk = 0; iChunk < aChunks.size(); ++iChunk )
     {
-      if ( myChangeMode == eAdding )
-      {
-        for(vtkIdType aCellId = 0, anOutId = 0; aCellId < aNbElems; aCellId++,anOutId++)
-        {
-          vtkIdType aType = anInput->GetCellType(aCellId);
-          if ( cellTypesVec[ aType ] == aType )
-            if ( myCellIds.find(aCellId) != myCellIds.end())
-              myOut2InId.push_back( aCellId );
-        }
-      }
-      else
-      {
-        for(vtkIdType aCellId = 0, anOutId = 0; aCellId < aNbElems; aCellId++,anOutId++)
-        {
-          vtkIdType aType = anInput->GetCellType(aCellId);
-          if ( cellTypesVec[ aType ] != aType )
-            if ( myCellIds.find(aCellId) == myCellIds.end())
-              myOut2InId.push_back( aCellId );
-        }
-      }
+      myOut2InId.insert( myOut2InId.end(), aChunks[ iChunk ].begin(), aChunks[ iChunk ].end() );
+      TVectorId().swap( aChunks[ iChunk ] );
     }
-  } // nodes
-
-  if ((vtkIdType) myOut2InId.size() == aNbElems )
+  }
+  else
   {
-    myPassAll = true;
-    TVectorId().swap( myOut2InId );
+    for ( vtkIdType anId = 0; anId < aNbElems; ++anId )
+      if ( aFilter( anId ))
+        myOut2InId.push_back( anId );
   }
-  return;
 }
 
-// vtkIdType VTKViewer_ExtractUnstructuredGrid::GetOutputId(int theInId) const{
-//   if(myCellIds.empty() && myCellTypes.empty()) return theInId;
-//   TMapId::const_iterator anIter = myIn2OutId.find(theInId);
-//   if(anIter == myIn2OutId.end()) return -1;
-//   return anIter->second;
-// }
-
 
 inline vtkIdType InsertCell(vtkUnstructuredGrid *theInput,
                       vtkCellArray *theConnectivity,
                       vtkUnsignedCharArray* theCellTypesArray,
                       vtkIdTypeArray*& theFaces,
                       vtkIdTypeArray*& theFaceLocations,
-                      vtkIdType theCellId,
-                      vtkIdList* /*theIdList*/,
-                      bool theStoreMapping,
-                      vtkIdType /*theOutId*/,
-                      VTKViewer_ExtractUnstructuredGrid::TVectorId& theOut2InId/*,
-                      VTKViewer_ExtractUnstructuredGrid::TMapId& theIn2OutId*/)
+                      vtkIdType theCellId)
 {
   vtkCell      *aCell = theInput->GetCell(theCellId);
   vtkIdType aCellType = aCell->GetCellType();
@@ -332,31 +285,9 @@ inline vtkIdType InsertCell(vtkUnstructuredGrid *theInput,
 #endif
 
   /*vtkIdType anID = */theCellTypesArray->InsertNextValue(aCellType);
-  if(theStoreMapping){
-    theOut2InId.push_back( theCellId );
-    //theIn2OutId.insert( theIn2OutId.end(), std::make_pair( theCellId, theOutId ));
-  }
   return aCellId;
 }
 
-inline void InsertPointCell(vtkCellArray *theConnectivity, 
-                            vtkUnsignedCharArray* theCellTypesArray,
-                            vtkIdType theCellId,
-                            vtkIdList *theIdList,
-                            bool theStoreMapping,
-                            vtkIdType /*theOutId*/, 
-                            VTKViewer_ExtractUnstructuredGrid::TVectorId& theOut2InId/*,
-                            VTKViewer_ExtractUnstructuredGrid::TMapId& theIn2OutId*/)
-{
-  theIdList->SetId(0,theCellId);
-  theConnectivity->InsertNextCell(theIdList);
-  theCellTypesArray->InsertNextValue(VTK_VERTEX);
-  if(theStoreMapping){
-    theOut2InId.push_back(theCellId);
-    //theIn2OutId.insert( theIn2OutId.end(), std::make_pair( theCellId, theOutId ));
-  }
-}
-
 #if VTK_XVERSION > 50700
 // Method dealing VTK93 -> VTK94 in case of presence of polyhedra
 static void AssignDataSetWithPolyhedra(vtkUnstructuredGrid *anOutput, vtkUnsignedCharArray* aCellTypesArray, vtkIdTypeArray* aCellLocationsArray, vtkCellArray *aConnectivity, vtkIdTypeArray *newFaceLocations, vtkIdTypeArray *newFaces)
@@ -430,243 +361,146 @@ int VTKViewer_ExtractUnstructuredGrid::RequestData(vtkInformation *vtkNotUsed(re
   vtkUnstructuredGrid *anOutput =
     vtkUnstructuredGrid::SafeDownCast(outInfo->Get(vtkDataObject::DATA_OBJECT()));
 
-  //vtkUnstructuredGrid *anInput = this->GetInput();
-  //vtkUnstructuredGrid *anOutput = this->GetOutput();
-
-  myPassAll = false;
-  TVectorId().swap( myOut2InId );
+  // ids of the extracted elements are collected first; they make the out -> in map
+  FillOut2InMap( anInput );
+  myIsMappingFilled = true;
 
-  // use a vector of cellTypes to avoid searching in myCellTypes map
-  // for a better performance (IPAL53103)
-  TVectorId cellTypesVec( VTK_NUMBER_OF_CELL_TYPES, -1 );
-  for ( TSetId::iterator type = myCellTypes.begin(); type != myCellTypes.end(); ++type )
-  {
-    if ( *type >= (int)cellTypesVec.size() ) cellTypesVec.resize( *type+1, -1 );
-    if ( *type > 0 )
-      cellTypesVec[ *type ] = *type;
-  }
-
-/*  
-    MESSAGE("Execute - anInput->GetNumberOfCells() = "<<anInput->GetNumberOfCells());
-    MESSAGE("Execute - myCellTypes.size() = "<<myCellTypes.size());
-    MESSAGE("Execute - myCellIds.size() = "<<myCellIds.size());
-    MESSAGE("Execute - myExtractionMode = "<<myExtractionMode);
-    MESSAGE("Execute - myChangeMode = "<<myChangeMode);
-*/
   vtkIdType aNbElems = 0;
   if(myExtractionMode == eCells)
   {
     aNbElems = anInput->GetNumberOfCells();
-    if(myChangeMode == ePassAll || (myCellIds.empty() && myCellTypes.empty() && myChangeMode == eRemoving)){
-      myPassAll = true;
-      if ( aNbElems > 0 ){
+    if(myPassAll){
+      if ( aNbElems > 0 )
         anOutput->ShallowCopy(anInput);
-        //if(myStoreMapping) myOut2InId.reserve(aNbElems);
-        // if(myStoreMapping){
-        //   for(vtkIdType aCellId = 0, anOutId = 0; aCellId < aNbElems; aCellId++,anOutId++){
-        //     myOut2InId.push_back(aCellId);
-        //     //myIn2OutId.insert( myIn2OutId.end(), std::make_pair( aCellId, anOutId ));
-        //   }
-        // }
-      }
     }else{
-      vtkIdList *anIdList = vtkIdList::New();
-      vtkCellArray *aConnectivity = vtkCellArray::New();
-      aConnectivity->Allocate(2*aNbElems,0);
-      vtkUnsignedCharArray* aCellTypesArray = vtkUnsignedCharArray::New();
-      aCellTypesArray->SetNumberOfComponents(1);
-      aCellTypesArray->Allocate(aNbElems*aCellTypesArray->GetNumberOfComponents());
-      anOutput->GetCellData()->CopyAllocate(anInput->GetCellData(),aNbElems,aNbElems/2);
-
-      vtkIdTypeArray *newFaces = 0;
-      vtkIdTypeArray *newFaceLocations = 0;
-
-      if(!myCellIds.empty() && myCellTypes.empty()){
-        if(myStoreMapping) myOut2InId.reserve(myCellIds.size());
-        if(myChangeMode == eAdding){
-          for(vtkIdType aCellId = 0, anOutId = 0; aCellId < aNbElems; aCellId++,anOutId++){
-            if(myCellIds.find(aCellId) != myCellIds.end()){
-              vtkIdType newId = InsertCell(anInput,aConnectivity,aCellTypesArray,newFaces,newFaceLocations,aCellId,anIdList,
-                                           myStoreMapping,anOutId,myOut2InId/*,myIn2OutId*/);
-              anOutput->GetCellData()->CopyData(anInput->GetCellData(),aCellId,newId);
-            }
-          }
-        }else{
-          for(vtkIdType aCellId = 0, anOutId = 0; aCellId < aNbElems; aCellId++,anOutId++){
-            if(myCellIds.find(aCellId) == myCellIds.end()){
-              vtkIdType newId = InsertCell(anInput,aConnectivity,aCellTypesArray,newFaces,newFaceLocations,aCellId,anIdList,
-                                           myStoreMapping,anOutId,myOut2InId/*,myIn2OutId*/);
-              anOutput->GetCellData()->CopyData(anInput->GetCellData(),aCellId,newId);
-            }
-          }
-        }
-      }else if(myCellIds.empty() && !myCellTypes.empty()){
-        if(myChangeMode == eAdding){
-          for(vtkIdType aCellId = 0, anOutId = 0; aCellId < aNbElems; aCellId++,anOutId++){
-            vtkIdType aType = anInput->GetCellType(aCellId);
-            if ( cellTypesVec[ aType ] == aType ) {
-              vtkIdType newId = InsertCell(anInput,aConnectivity,aCellTypesArray,newFaces,newFaceLocations,aCellId,anIdList,
-                                           myStoreMapping,anOutId,myOut2InId/*,myIn2OutId*/);
-              anOutput->GetCellData()->CopyData(anInput->GetCellData(),aCellId,newId);
-            }
-          }
-        }else{
-          for(vtkIdType aCellId = 0, anOutId = 0; aCellId < aNbElems; aCellId++,anOutId++){
-            vtkIdType aType = anInput->GetCellType(aCellId);
-            if ( cellTypesVec[ aType ] != aType ) {
-              vtkIdType newId = InsertCell(anInput,aConnectivity,aCellTypesArray,newFaces,newFaceLocations,aCellId,anIdList,
-                                           myStoreMapping,anOutId,myOut2InId/*,myIn2OutId*/);
-              anOutput->GetCellData()->CopyData(anInput->GetCellData(),aCellId,newId);
-            }
-          }
-        }
-      }else if(!myCellIds.empty() && !myCellTypes.empty()){
-        if(myChangeMode == eAdding){
-          for(vtkIdType aCellId = 0, anOutId = 0; aCellId < aNbElems; aCellId++,anOutId++){
-            vtkIdType aType = anInput->GetCellType(aCellId);
-            if ( cellTypesVec[ aType ] == aType ) {
-              if(myCellIds.find(aCellId) != myCellIds.end()){
-                vtkIdType newId = InsertCell(anInput,aConnectivity,aCellTypesArray,newFaces,newFaceLocations,aCellId,anIdList,
-                                             myStoreMapping,anOutId,myOut2InId/*,myIn2OutId*/);
-                anOutput->GetCellData()->CopyData(anInput->GetCellData(),aCellId,newId);
-              }
-            }
+      vtkIdType newNbElems = (vtkIdType) myOut2InId.size();
+      vtkCellArray* anInputCells = anInput->GetCells();
+
+      bool isParallel = myIsParallel && newNbElems >= 2 * MIN_PARALLEL_CHUNK_SIZE &&
+                        anInputCells->IsStorageShareable();
+      if ( isParallel )
+      {
+        // polyhedra need the faces stream, they are processed by the serial mode
+        vtkNew<vtkCellTypes> aTypes;
+        anInput->GetCellTypes( aTypes );
+        isParallel = !aTypes->IsType( VTK_POLYHEDRON );
+      }
+
+      if ( isParallel )
+      {
+        const vtkIdType*     anOut2In     = myOut2InId.data();
+        const unsigned char* anInputTypes = anInput->GetCellTypesArray()->GetPointer(0);
+
+        vtkNew<vtkUnsignedCharArray> aCellTypesArray;
+        aCellTypesArray->SetNumberOfTuples( newNbElems );
+        unsigned char* anOutputTypes = aCellTypesArray->GetPointer(0);
+
+        vtkNew<vtkIdTypeArray> anOffsets;
+        anOffsets->SetNumberOfTuples( newNbElems + 1 );
+        vtkIdType* anOffsetsPtr = anOffsets->GetPointer(0);
+        anOffsetsPtr[0] = 0;
+
+        vtkSMPTools::For( 0, newNbElems, MIN_PARALLEL_CHUNK_SIZE, [&]( vtkIdType theFirst, vtkIdType theLast )
+        {
+          for ( vtkIdType anOutId = theFirst; anOutId < theLast; ++anOutId )
+          {
+            anOutputTypes[ anOutId ]    = anInputTypes[ anOut2In[ anOutId ]];
+            anOffsetsPtr[ anOutId + 1 ] = anInputCells->GetCellSize( anOut2In[ anOutId ]);
           }
-        }else{
-          for(vtkIdType aCellId = 0, anOutId = 0; aCellId < aNbElems; aCellId++,anOutId++){
-            vtkIdType aType = anInput->GetCellType(aCellId);
-            if ( cellTypesVec[ aType ] != aType ) {
-              if(myCellIds.find(aCellId) == myCellIds.end()){
-                vtkIdType newId = InsertCell(anInput,aConnectivity,aCellTypesArray,newFaces,newFaceLocations,aCellId,anIdList,
-                                             myStoreMapping,anOutId,myOut2InId/*,myIn2OutId*/);
-                anOutput->GetCellData()->CopyData(anInput->GetCellData(),aCellId,newId);
-              }
-            }
+        });
+        std::partial_sum( anOffsetsPtr, anOffsetsPtr + newNbElems + 1, anOffsetsPtr );
+
+        vtkNew<vtkIdTypeArray> aConnectivityArray;
+        aConnectivityArray->SetNumberOfTuples( anOffsetsPtr[ newNbElems ]);
+        vtkIdType* aConnectivityPtr = aConnectivityArray->GetPointer(0);
+
+        vtkSMPTools::For( 0, newNbElems, MIN_PARALLEL_CHUNK_SIZE, [&]( vtkIdType theFirst, vtkIdType theLast )
+        {
+          vtkIdType npts;
+          const vtkIdType* pts;
+          for ( vtkIdType anOutId = theFirst; anOutId < theLast; ++anOutId )
+          {
+            anInputCells->GetCellAtId( anOut2In[ anOutId ], npts, pts );
+            std::copy( pts, pts + npts, aConnectivityPtr + anOffsetsPtr[ anOutId ]);
           }
-        }
+        });
+
+        vtkNew<vtkCellArray> aConnectivity;
+        aConnectivity->SetData( anOffsets, aConnectivityArray );
+        anOutput->SetCells( aCellTypesArray, aConnectivity );
+        anOutput->SetPoints( anInput->GetPoints() );
+
+        vtkNew<vtkIdList> aFromIds, aToIds;
+        aFromIds->SetNumberOfIds( newNbElems );
+        aToIds->SetNumberOfIds( newNbElems );
+        std::copy( anOut2In, anOut2In + newNbElems, aFromIds->GetPointer(0) );
+        std::iota( aToIds->GetPointer(0), aToIds->GetPointer(0) + newNbElems, vtkIdType(0) );
+        anOutput->GetCellData()->CopyAllocate( anInput->GetCellData(), newNbElems );
+        anOutput->GetCellData()->CopyData( anInput->GetCellData(), aFromIds, aToIds );
       }
-      if ( vtkIdType newNbElems = aConnectivity->GetNumberOfCells() ) {
-        vtkIdTypeArray* aCellLocationsArray = vtkIdTypeArray::New();
-        aCellLocationsArray->SetNumberOfComponents(1);
-        aCellLocationsArray->SetNumberOfTuples(newNbElems);
-        aConnectivity->InitTraversal();
-        vtkIdType const *pts(nullptr);
-        for(vtkIdType i = 0, npts; aConnectivity->GetNextCell(npts,pts); i++){
-          aCellLocationsArray->SetValue(i,aConnectivity->GetTraversalLocation(npts));
+      else
+      {
+        vtkCellArray *aConnectivity = vtkCellArray::New();
+        aConnectivity->Allocate(2*newNbElems,0);
+        vtkUnsignedCharArray* aCellTypesArray = vtkUnsignedCharArray::New();
+        aCellTypesArray->SetNumberOfComponents(1);
+        aCellTypesArray->Allocate(newNbElems*aCellTypesArray->GetNumberOfComponents());
+        anOutput->GetCellData()->CopyAllocate(anInput->GetCellData(),newNbElems,newNbElems/2);
+
+        vtkIdTypeArray *newFaces = 0;
+        vtkIdTypeArray *newFaceLocations = 0;
+
+        for(vtkIdType anOutId = 0; anOutId < newNbElems; anOutId++){
+          vtkIdType aCellId = myOut2InId[anOutId];
+          vtkIdType newId = InsertCell(anInput,aConnectivity,aCellTypesArray,newFaces,newFaceLocations,aCellId);
+          anOutput->GetCellData()->CopyData(anInput->GetCellData(),aCellId,newId);
         }
+        if ( newNbElems ) {
+          vtkIdTypeArray* aCellLocationsArray = vtkIdTypeArray::New();
+          aCellLocationsArray->SetNumberOfComponents(1);
+          aCellLocationsArray->SetNumberOfTuples(newNbElems);
+          aConnectivity->InitTraversal();
+          vtkIdType const *pts(nullptr);
+          for(vtkIdType i = 0, npts; aConnectivity->GetNextCell(npts,pts); i++){
+            aCellLocationsArray->SetValue(i,aConnectivity->GetTraversalLocation(npts));
+          }
 #if VTK_XVERSION > 50700
-        AssignDataSetWithPolyhedra(anOutput,aCellTypesArray,aCellLocationsArray,aConnectivity,newFaceLocations,newFaces);
+          AssignDataSetWithPolyhedra(anOutput,aCellTypesArray,aCellLocationsArray,aConnectivity,newFaceLocations,newFaces);
 #else
-        anOutput->SetCells(aCellTypesArray,aCellLocationsArray,aConnectivity);
+          anOutput->SetCells(aCellTypesArray,aCellLocationsArray,aConnectivity);
 #endif
-        anOutput->SetPoints(anInput->GetPoints());
-        aCellLocationsArray->Delete();
+          anOutput->SetPoints(anInput->GetPoints());
+          aCellLocationsArray->Delete();
+        }
+        aCellTypesArray->Delete();
+        aConnectivity->Delete();
+        if ( newFaceLocations ) newFaceLocations->Delete();
+        if ( newFaces ) newFaces->Delete();
       }
-      aCellTypesArray->Delete();
-      aConnectivity->Delete();
-      anIdList->Delete();
-      if ( newFaceLocations ) newFaceLocations->Delete();
-      if ( newFaces ) newFaces->Delete();
     }
   }
   else
   {
-    vtkIdList *anIdList = vtkIdList::New();
-    anIdList->SetNumberOfIds(1);
-    vtkCellArray *aConnectivity = vtkCellArray::New();
+    // each extracted node makes a VTK_VERTEX cell
     aNbElems = anInput->GetNumberOfPoints();
-    aConnectivity->Allocate(2*aNbElems,0);
-    vtkUnsignedCharArray* aCellTypesArray = vtkUnsignedCharArray::New();
-    aCellTypesArray->SetNumberOfComponents(1);
-    aCellTypesArray->Allocate(aNbElems*aCellTypesArray->GetNumberOfComponents());
-    // additional condition has been added to treat a case described in IPAL21372
-    // note that it is significant only when myExtractionMode == ePoints
-    if(myChangeMode == ePassAll || (myCellIds.empty() && myCellTypes.empty() && myChangeMode == eRemoving) ||
-       !anInput->GetCellTypesArray()){
-      myPassAll = true;
-      //if(myStoreMapping) myOut2InId.reserve(aNbElems);
-      for(vtkIdType aCellId = 0, anOutId = 0; aCellId < aNbElems; aCellId++,anOutId++){
-        InsertPointCell(aConnectivity,aCellTypesArray,aCellId,anIdList,
-                        /*theStoreMapping=*/false,anOutId,myOut2InId/*,myIn2OutId*/);
-      }
-    }else if(!myCellIds.empty() && myCellTypes.empty()){
-      if(myStoreMapping) myOut2InId.reserve(myCellIds.size());
-      if(myChangeMode == eAdding){
-        for(vtkIdType aCellId = 0, anOutId = 0; aCellId < aNbElems; aCellId++,anOutId++){
-          if(myCellIds.find(aCellId) != myCellIds.end()){
-            InsertPointCell(aConnectivity,aCellTypesArray,aCellId,anIdList,
-                            myStoreMapping,anOutId,myOut2InId/*,myIn2OutId*/);
-          }
-        }
-      }else{
-        for(vtkIdType aCellId = 0, anOutId = 0; aCellId < aNbElems; aCellId++,anOutId++){
-          if(myCellIds.find(aCellId) == myCellIds.end()){
-            InsertPointCell(aConnectivity,aCellTypesArray,aCellId,anIdList,
-                            myStoreMapping,anOutId,myOut2InId/*,myIn2OutId*/);
-          }
-        }
-      }
-    }else if(myCellIds.empty() && !myCellTypes.empty()){
-      if(myChangeMode == eAdding){
-        for(vtkIdType aCellId = 0, anOutId = 0; aCellId < aNbElems; aCellId++,anOutId++){
-          vtkIdType aType = anInput->GetCellType(aCellId);
-          if ( cellTypesVec[ aType ] == aType ) {
-            InsertPointCell(aConnectivity,aCellTypesArray,aCellId,anIdList,
-                            myStoreMapping,anOutId,myOut2InId/*,myIn2OutId*/);
-          }
-        }
-      }else{
-        for(vtkIdType aCellId = 0, anOutId = 0; aCellId < aNbElems; aCellId++,anOutId++){
-          vtkIdType aType = anInput->GetCellType(aCellId);
-          if ( cellTypesVec[ aType ] != aType ) {
-            InsertPointCell(aConnectivity,aCellTypesArray,aCellId,anIdList,
-                            myStoreMapping,anOutId,myOut2InId/*,myIn2OutId*/);
-          }
-        }
-      }
-    }else if(!myCellIds.empty() && !myCellTypes.empty()){
-      if(myChangeMode == eAdding){
-        for(vtkIdType aCellId = 0, anOutId = 0; aCellId < aNbElems; aCellId++,anOutId++){
-          vtkIdType aType = anInput->GetCellType(aCellId);
-          if ( cellTypesVec[ aType ] == aType ) {
-            if(myCellIds.find(aCellId) != myCellIds.end()){
-              InsertPointCell(aConnectivity,aCellTypesArray,aCellId,anIdList,
-                              myStoreMapping,anOutId,myOut2InId/*,myIn2OutId*/);
-            }
-          }
-        }
-      }else{
-        for(vtkIdType aCellId = 0, anOutId = 0; aCellId < aNbElems; aCellId++,anOutId++){
-          vtkIdType aType = anInput->GetCellType(aCellId);
-          if ( cellTypesVec[ aType ] != aType ) {
-            if(myCellIds.find(aCellId) == myCellIds.end()){
-              InsertPointCell(aConnectivity,aCellTypesArray,aCellId,anIdList,
-                              myStoreMapping,anOutId,myOut2InId/*,myIn2OutId*/);
-            }
-          }
-        }
-      }
-    }
-    if (vtkIdType newNbElems = aConnectivity->GetNumberOfCells() ) {
-      vtkIdTypeArray* aCellLocationsArray = vtkIdTypeArray::New();
-      aCellLocationsArray->SetNumberOfComponents(1);
-      aCellLocationsArray->SetNumberOfTuples( newNbElems );
-      aConnectivity->InitTraversal();
-      vtkIdType const *pts(nullptr);
-      for(vtkIdType i = 0, npts; aConnectivity->GetNextCell(npts,pts); i++){
-        aCellLocationsArray->SetValue(i,aConnectivity->GetTraversalLocation(npts));
-      }
-#if VTK_XVERSION > 50700
-      anOutput->SetCells(aCellTypesArray,aCellLocationsArray,aConnectivity,0, 0);
-#else
-      anOutput->SetCells(aCellTypesArray,aCellLocationsArray,aConnectivity);
-#endif
+    vtkIdType newNbElems = myPassAll ? aNbElems : (vtkIdType) myOut2InId.size();
+    if ( newNbElems ) {
+      vtkNew<vtkIdTypeArray> anOffsets;
+      anOffsets->SetNumberOfTuples( newNbElems + 1 );
+      std::iota( anOffsets->GetPointer(0), anOffsets->GetPointer(0) + newNbElems + 1, vtkIdType(0) );
+
+      vtkNew<vtkIdTypeArray> aConnectivityArray;
+      aConnectivityArray->SetNumberOfTuples( newNbElems );
+      if ( myPassAll )
+        std::iota( aConnectivityArray->GetPointer(0), aConnectivityArray->GetPointer(0) + newNbElems, vtkIdType(0) );
+      else
+        std::copy( myOut2InId.begin(), myOut2InId.end(), aConnectivityArray->GetPointer(0) );
+
+      vtkNew<vtkCellArray> aConnectivity;
+      aConnectivity->SetData( anOffsets, aConnectivityArray );
+      anOutput->SetCells( VTK_VERTEX, aConnectivity );
       anOutput->SetPoints(anInput->GetPoints());
-      aCellLocationsArray->Delete();
     }
-    aCellTypesArray->Delete();
-    aConnectivity->Delete();
-    anIdList->Delete();
   }
 
   if ( aNbElems == (vtkIdType) myOut2InId.size() )
@@ -674,12 +508,5 @@ int VTKViewer_ExtractUnstructuredGrid::RequestData(vtkInformation *vtkNotUsed(re
     myPassAll = true;
     TVectorId().swap( myOut2InId );
   }
-/*
-    MESSAGE("Execute - anOutput->GetNumberOfCells() = "<<anOutput->GetNumberOfCells());
-    if(myStoreMapping){
-      MESSAGE("Execute - myOut2InId.size() = "<<myOut2InId.size());
-      MESSAGE("Execute - myIn2OutId.size() = "<<myIn2OutId.size());
-    }
-*/
   return 1;
 }
@@ -27,6 +27,8 @@
 
 #include <vtkUnstructuredGridAlgorithm.h>
 
+class vtkUnstructuredGrid;
+
 #include <set>
 #include <map>
 #include <vector>
@@ -66,13 +68,13 @@ public:
   //! Return \a myChangeMode field
   EChanging GetModeOfChanging(){ return myChangeMode; }
 
-  //! Add cell id to \a myCellIds std::set
+  //! Add cell id to \a myCellIds bitmap
   void RegisterCell(vtkIdType theCellId);
   //! Check if myCellIds is empty.
-  int IsCellsRegistered() { return !myCellIds.empty(); }
+  int IsCellsRegistered() { return myNbCellIds > 0; }
   //! Remove the cell from the output
   void ClearRegisteredCells() {
-    if ( !myCellIds.empty() ) { myCellIds.clear(); Modified(); }
+    if ( myNbCellIds > 0 ) { TBitmapId().swap( myCellIds ); myNbCellIds = 0; Modified(); }
   }
 
   //! Add cell type to \a myCellTypes std::set
@@ -87,12 +89,17 @@ public:
   //! \brief Do the filter do some real work
   int IsChanging() { return IsCellsRegistered() || IsCellsWithTypeRegistered(); }
 
-  //! \brief Do it keep the mapping between input's and output's UnstructuredGrid
+  //! \brief Do it keep the mapping between input's and output's UnstructuredGrid (the out -> in map is filled by the extraction whatever this flag)
   void SetStoreMapping(int theStoreMapping);
   //! Get \a myStoreMapping
   int GetStoreMapping(){ return myStoreMapping; }
 
-  //! Computes a map out IDs to in IDs. Call it before GetInputId()!!!
+  //! Sets \a myIsParallel flag: cells are extracted in several threads (see vtkSMPTools)
+  void SetParallelMode(bool theFlag){ myIsParallel = theFlag; }
+  //! Get \a myIsParallel
+  bool GetParallelMode() const { return myIsParallel; }
+
+  //! Computes a map out IDs to in IDs if the filter was not executed yet (the map is filled by the extraction). Call it before GetInputId()!!!
   void BuildOut2InMap();
   //! Gets the input id by output id. Call BuildOut2InMap() before
   vtkIdType GetInputId(vtkIdType theOutId) const;
@@ -102,6 +109,7 @@ public:
   typedef std::vector<vtkIdType>        TVectorId;
   typedef std::map<vtkIdType,vtkIdType> TMapId;
   typedef std::set<vtkIdType>           TSetId;
+  typedef std::vector<bool>             TBitmapId;
 
 protected:
   VTKViewer_ExtractUnstructuredGrid();
@@ -109,13 +117,18 @@ protected:
 
   virtual int RequestData(vtkInformation *, vtkInformationVector **, vtkInformationVector *);
 
+  //! Fills \a myOut2InId by ids of the input elements passed to the output, or sets \a myPassAll
+  void FillOut2InMap(vtkUnstructuredGrid* theInput);
+
   EExtraction myExtractionMode;
   
   EChanging myChangeMode;
-  TSetId myCellIds;
+  TBitmapId myCellIds;   //!< registered cell ids: myCellIds[ id ] is true if id is registered
+  vtkIdType myNbCellIds; //!< number of registered cell ids
   TSetId myCellTypes;
 
-  bool myStoreMapping, myPassAll;
+  bool myStoreMapping, myPassAll, myIsParallel;
+  bool myIsMappingFilled; //!< myOut2InId has been filled by an execution
   TVectorId myOut2InId;
   //TMapId myIn2OutId;
 
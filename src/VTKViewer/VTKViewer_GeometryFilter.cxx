@@ -36,11 +36,13 @@
 #include <vtkInformation.h>
 #include <vtkInformationVector.h>
 #include <vtkMergePoints.h>
+#include <vtkNew.h>
 #include <vtkObjectFactory.h>
 #include <vtkPointData.h>
 #include <vtkPolyData.h>
 #include <vtkPolygon.h>
 #include <vtkPyramid.h>
+#include <vtkSMPTools.h>
 #include <vtkSmartPointer.h>
 #include <vtkStaticCellLinks.h>
 #include <vtkStructuredGrid.h>
@@ -55,6 +57,7 @@
 #include <iterator>
 #include <vector>
 #include <map>
+#include <mutex>
 #include <set>
 
 #include "utilities.h"
@@ -103,7 +106,11 @@ VTKViewer_GeometryFilter
   myIsWireframeMode(0),
   myAppendCoincident3D(0),
   myMaxArcAngle(2),
-  myIsBuildArc(false)
+  myIsBuildArc(false),
+  myIsParallel(false),
+  myUseTopologyCache(false),
+  myTopologyCache(0),
+  myScratchPool(0)
 {
   static int forceDelegateToVtk = -1;
   if ( forceDelegateToVtk < 0 )
@@ -117,7 +124,10 @@ VTKViewer_GeometryFilter
 
 VTKViewer_GeometryFilter
 ::~VTKViewer_GeometryFilter()
-{}
+{
+  ReleaseTopologyCache();
+  ReleaseScratch();
+}
 
 /*!
  * \brief Return true for only one volume including a given edge
@@ -305,6 +315,379 @@ VTKViewer_GeometryFilter
     }
 }
 
+//------------------------------------------------------------------------------
+// Receiver of the cells (and of the additional points of the arcs) produced by
+// VTKViewer_GeometryFilter::ExtractCell().
+struct VTKViewer_GeometryFilter::TCellSink
+{
+  virtual ~TCellSink() {}
+
+  // Add a point to the output, return its id
+  virtual vtkIdType InsertNextPoint( const double theCoord[3], double theScalar ) = 0;
+
+  // Add a cell built from the input cell theCellId; theMappedType is the type the cell
+  // is registered with in myVTK2ObjIds (-1 means theCellType)
+  virtual void InsertNextCell( vtkIdType theCellId,
+                               int theCellType,
+                               vtkIdType theNbPts,
+                               const vtkIdType* thePts,
+                               int theMappedType = -1 ) = 0;
+};
+
+namespace
+{
+  //------------------------------------------------------------------------------
+  // Sink writing directly to the filter output (serial execution)
+  struct TOutputSink : public VTKViewer_GeometryFilter::TCellSink
+  {
+    vtkPolyData*  myOutput;
+    vtkCellData*  myInputCD;
+    vtkCellData*  myOutputCD;
+    vtkDataArray* myOutputScalars;
+    bool          myStoreMapping;
+    VTKViewer_GeometryFilter::TVectorId&      myVTK2ObjIds;
+    VTKViewer_GeometryFilter::TMapOfVectorId& myDimension2VTK2ObjIds;
+
+    TOutputSink( vtkPolyData*  theOutput,
+                 vtkCellData*  theInputCD,
+                 bool          theStoreMapping,
+                 VTKViewer_GeometryFilter::TVectorId&      theVTK2ObjIds,
+                 VTKViewer_GeometryFilter::TMapOfVectorId& theDimension2VTK2ObjIds ):
+      myOutput( theOutput ),
+      myInputCD( theInputCD ),
+      myOutputCD( theOutput->GetCellData() ),
+      myOutputScalars( theOutput->GetPointData()->GetScalars() ),
+      myStoreMapping( theStoreMapping ),
+      myVTK2ObjIds( theVTK2ObjIds ),
+      myDimension2VTK2ObjIds( theDimension2VTK2ObjIds )
+    {}
+
+    vtkIdType InsertNextPoint( const double theCoord[3], double theScalar ) override
+    {
+      vtkIdType anId = myOutput->GetPoints()->InsertNextPoint( theCoord );
+      if ( myOutputScalars )
+        myOutputScalars->InsertNextTuple1( theScalar );
+      return anId;
+    }
+
+    void InsertNextCell( vtkIdType theCellId,
+                         int theCellType,
+                         vtkIdType theNbPts,
+                         const vtkIdType* thePts,
+                         int theMappedType ) override
+    {
+      vtkIdType aNewCellId = myOutput->InsertNextCell( theCellType, theNbPts, thePts );
+      if ( myStoreMapping )
+        VTKViewer_GeometryFilter::InsertId( theCellId, theMappedType < 0 ? theCellType : theMappedType,
+                                            myVTK2ObjIds, myDimension2VTK2ObjIds );
+      myOutputCD->CopyData( myInputCD, theCellId, aNewCellId );
+    }
+  };
+
+  //------------------------------------------------------------------------------
+  // Sink accumulating the cells of a range of input cells (parallel execution).
+  // New points are numbered after the input points and shifted on merge.
+  struct TChunkSink : public VTKViewer_GeometryFilter::TCellSink
+  {
+    vtkIdType                  myNbInputPoints;
+    std::vector<unsigned char> myTypes;
+    std::vector<unsigned char> myMappedTypes;
+    std::vector<vtkIdType>     myCellIds;
+    std::vector<vtkIdType>     myOffsets;
+    std::vector<vtkIdType>     myConnectivity;
+    std::vector<double>        myPoints;
+    std::vector<double>        myScalars;
+
+    TChunkSink(): myNbInputPoints( 0 ), myOffsets( 1, 0 ) {}
+
+    vtkIdType InsertNextPoint( const double theCoord[3], double theScalar ) override
+    {
+      vtkIdType anId = myNbInputPoints + (vtkIdType)myScalars.size();
+      myPoints.insert( myPoints.end(), theCoord, theCoord + 3 );
+      myScalars.push_back( theScalar );
+      return anId;
+    }
+
+    void InsertNextCell( vtkIdType theCellId,
+                         int theCellType,
+                         vtkIdType theNbPts,
+                         const vtkIdType* thePts,
+                         int theMappedType ) override
+    {
+      myTypes.push_back( (unsigned char)theCellType );
+      myMappedTypes.push_back( (unsigned char)( theMappedType < 0 ? theCellType : theMappedType ));
+      myCellIds.push_back( theCellId );
+      myConnectivity.insert( myConnectivity.end(), thePts, thePts + theNbPts );
+      myOffsets.push_back( (vtkIdType)myConnectivity.size() );
+    }
+
+    // Append the accumulated data to the output, in the order it was produced
+    void Flush( vtkPolyData* theOutput,
+                vtkCellData* theInputCD,
+                vtkDataArray* theOutputScalars,
+                bool theStoreMapping,
+                VTKViewer_GeometryFilter::TVectorId&      theVTK2ObjIds,
+                VTKViewer_GeometryFilter::TMapOfVectorId& theDimension2VTK2ObjIds )
+    {
+      vtkIdType aPntShift = 0;
+      if ( !myScalars.empty() )
+      {
+        vtkPoints* anOutputPoints = theOutput->GetPoints();
+        aPntShift = anOutputPoints->GetNumberOfPoints() - myNbInputPoints;
+        for ( size_t i = 0; i < myScalars.size(); ++i )
+        {
+          anOutputPoints->InsertNextPoint( &myPoints[ 3 * i ] );
+          if ( theOutputScalars )
+            theOutputScalars->InsertNextTuple1( myScalars[ i ] );
+        }
+      }
+
+      vtkCellData* anOutputCD = theOutput->GetCellData();
+      std::vector<vtkIdType> aPts;
+      for ( size_t iCell = 0; iCell < myTypes.size(); ++iCell )
+      {
+        vtkIdType aNbPts = myOffsets[ iCell + 1 ] - myOffsets[ iCell ];
+        const vtkIdType* aConn = &myConnectivity[0] + myOffsets[ iCell ];
+        if ( aPntShift )
+        {
+          aPts.assign( aConn, aConn + aNbPts );
+          for ( vtkIdType i = 0; i < aNbPts; ++i )
+            if ( aPts[ i ] >= myNbInputPoints )
+              aPts[ i ] += aPntShift;
+          aConn = &aPts[0];
+        }
+        vtkIdType aNewCellId = theOutput->InsertNextCell( myTypes[ iCell ], aNbPts, aConn );
+        if ( theStoreMapping )
+          VTKViewer_GeometryFilter::InsertId( myCellIds[ iCell ], myMappedTypes[ iCell ],
+                                              theVTK2ObjIds, theDimension2VTK2ObjIds );
+        anOutputCD->CopyData( theInputCD, myCellIds[ iCell ], aNewCellId );
+      }
+
+      // free memory
+      std::vector<unsigned char>().swap( myTypes );
+      std::vector<unsigned char>().swap( myMappedTypes );
+      std::vector<vtkIdType>().swap( myCellIds );
+      std::vector<vtkIdType>().swap( myOffsets );
+      std::vector<vtkIdType>().swap( myConnectivity );
+      std::vector<double>().swap( myPoints );
+      std::vector<double>().swap( myScalars );
+    }
+  };
+
+  // Minimal number of cells processed by one task of the parallel mode
+  const vtkIdType MIN_PARALLEL_CHUNK_SIZE = 10000;
+
+  //------------------------------------------------------------------------------
+  // Result of a neighbour query: only the number of found cells and the first
+  // of them are used to decide whether a face / an edge is shown
+  struct TNeighbors
+  {
+    vtkIdType myNbCells;
+    vtkIdType myFirstCell;
+  };
+
+  // Results of all neighbour queries of an extraction, in the order they are done;
+  // queries of a cell are at [ myOffsets[ cellId ], myOffsets[ cellId + 1 ] )
+  struct TNeighborsStream
+  {
+    std::vector<vtkIdType>  myOffsets;
+    std::vector<TNeighbors> myNeighbors;
+  };
+
+  //------------------------------------------------------------------------------
+  // Return true if the grid contains cells of one of the given types
+  bool hasCellType( vtkUnstructuredGrid* theGrid, const std::set<vtkIdType>& theTypes )
+  {
+    if ( vtkUnsignedCharArray* types = theGrid->GetCellTypesArray() )
+      for ( vtkIdType i = 0; i < types->GetNumberOfTuples(); ++i )
+        if ( theTypes.count( types->GetValue(i) ))
+          return true;
+    return false;
+  }
+}
+
+//------------------------------------------------------------------------------
+// Face / edge topology of the input kept between executions: the results of
+// the neighbour queries, which are the same whatever the representation as long
+// as the input is not modified. There is one stream of results per set of
+// queries (inside or not, wireframe or not for quadratic volumes).
+struct VTKViewer_GeometryFilter::TTopologyCache
+{
+  vtkUnstructuredGrid*            myInput;
+  vtkMTimeType                    myInputMTime;
+  bool                            myHasQuadratic3D;
+  std::map<int, TNeighborsStream> myStreams;
+
+  TTopologyCache(): myInput( 0 ), myInputMTime( 0 ), myHasQuadratic3D( false ) {}
+
+  // Drop data computed for another input
+  void Check( vtkUnstructuredGrid* theInput )
+  {
+    if ( myInput == theInput && myInputMTime == theInput->GetMTime() )
+      return;
+    myStreams.clear();
+    myInput      = theInput;
+    myInputMTime = theInput->GetMTime();
+
+    std::set<vtkIdType> aQuad3DTypes;
+    aQuad3DTypes.insert( VTK_QUADRATIC_TETRA );
+    aQuad3DTypes.insert( VTK_QUADRATIC_HEXAHEDRON );
+    aQuad3DTypes.insert( VTK_TRIQUADRATIC_HEXAHEDRON );
+    aQuad3DTypes.insert( VTK_QUADRATIC_WEDGE );
+    aQuad3DTypes.insert( VTK_BIQUADRATIC_QUADRATIC_WEDGE );
+    aQuad3DTypes.insert( VTK_QUADRATIC_PYRAMID );
+    myHasQuadratic3D = hasCellType( theInput, aQuad3DTypes );
+  }
+};
+
+//------------------------------------------------------------------------------
+// State of the extraction of a range of cells: the shared read-only data and the
+// scratch objects owned by the executing thread. Contexts are kept in TScratchPool
+// and re-initialized by Init(), so that the scratch objects are allocated only once.
+struct VTKViewer_GeometryFilter::TExtractionContext
+{
+  vtkUnstructuredGrid* myInput;
+  vtkCellData*         myInputCD;
+  vtkDataArray*        myInputScalars;
+  int                  myAllVisible;
+  const char*          myCellVis;
+  TCellSink*           mySink;
+
+  vtkNew<vtkGenericCell> myCell;
+  vtkNew<vtkIdList>      myCellIds;
+  vtkNew<vtkIdList>      myFaceIds;
+  vtkNew<vtkIdList>      myCellIdsTmp;
+  vtkNew<vtkIdList>      myFaceIdsTmp;
+  vtkNew<vtkIdList>      myTriaIds;
+  vtkNew<vtkPoints>      myTriaCoords;
+  vtkNew<vtkIdList>      myFaceStream;
+  std::set< vtkIdType >  myMidPoints;
+
+  VTKViewer_OrderedTriangulator          myOrderedTriangulator;
+  VTKViewer_DelaunayTriangulator         myDelaunayTriangulator;
+  std::vector< std::vector<vtkIdType> >  myPolygons;
+
+  // neighbour queries are either recorded in myRecord (if not null) or replayed from myReplay
+  std::vector<TNeighbors>* myRecord;
+  const TNeighbors*        myReplay;
+  bool                     myIsReplay;
+
+  TExtractionContext( VTKViewer_TriangulationCache* theTriangulationCache )
+  {
+    myOrderedTriangulator.SetCache( theTriangulationCache );
+    myDelaunayTriangulator.SetCache( theTriangulationCache );
+    Init( 0, 0, 0, 0 );
+  }
+
+  void Init( vtkUnstructuredGrid* theInput,
+             int theAllVisible,
+             const char* theCellVis,
+             TCellSink* theSink )
+  {
+    myInput        = theInput;
+    myInputCD      = theInput ? theInput->GetCellData() : 0;
+    myInputScalars = theInput ? theInput->GetPointData()->GetScalars() : 0;
+    myAllVisible   = theAllVisible;
+    myCellVis      = theCellVis;
+    mySink         = theSink;
+    myRecord       = 0;
+    myReplay       = 0;
+    myIsReplay     = false;
+  }
+
+  // Same as vtkUnstructuredGrid::GetCellNeighbors(), but when replaying, only the number
+  // of found cells and the first one are valid in theCellIds
+  void GetCellNeighbors( vtkIdType theCellId, vtkIdList* thePtIds, vtkIdList* theCellIds )
+  {
+    if ( myIsReplay )
+    {
+      const TNeighbors& aNeighbors = *myReplay++;
+      theCellIds->SetNumberOfIds( aNeighbors.myNbCells );
+      for ( vtkIdType i = 0; i < aNeighbors.myNbCells; ++i )
+        theCellIds->SetId( i, aNeighbors.myFirstCell );
+      return;
+    }
+    myInput->GetCellNeighbors( theCellId, thePtIds, theCellIds );
+    if ( myRecord )
+    {
+      TNeighbors aNeighbors = { theCellIds->GetNumberOfIds(),
+                                theCellIds->GetNumberOfIds() > 0 ? theCellIds->GetId( 0 ) : -1 };
+      myRecord->push_back( aNeighbors );
+    }
+  }
+
+  // Return true for only one volume including a given edge
+  bool ToShowEdge( vtkIdType theId1, vtkIdType theId2, vtkIdType theCellId )
+  {
+    if ( myIsReplay )
+      return ( myReplay++ )->myNbCells > 0;
+    bool aResult = toShowEdge( theId1, theId2, theCellId, myInput );
+    if ( myRecord )
+    {
+      TNeighbors aNeighbors = { aResult ? 1 : 0, -1 };
+      myRecord->push_back( aNeighbors );
+    }
+    return aResult;
+  }
+};
+
+//------------------------------------------------------------------------------
+// Extraction contexts kept between executions and shared by the threads, and the
+// triangulations of convex point sets reused for the cells of the same shape.
+struct VTKViewer_GeometryFilter::TScratchPool
+{
+  std::mutex                         myMutex;
+  std::vector< TExtractionContext* > myFreeContexts;
+  VTKViewer_TriangulationCache       myTriangulationCache;
+
+  ~TScratchPool()
+  {
+    for ( size_t i = 0; i < myFreeContexts.size(); ++i )
+      delete myFreeContexts[ i ];
+  }
+
+  TExtractionContext* Acquire()
+  {
+    {
+      std::lock_guard<std::mutex> aLock( myMutex );
+      if ( !myFreeContexts.empty() )
+      {
+        TExtractionContext* aContext = myFreeContexts.back();
+        myFreeContexts.pop_back();
+        return aContext;
+      }
+    }
+    return new TExtractionContext( &myTriangulationCache );
+  }
+
+  void Release( TExtractionContext* theContext )
+  {
+    theContext->Init( 0, 0, 0, 0 );
+    std::lock_guard<std::mutex> aLock( myMutex );
+    myFreeContexts.push_back( theContext );
+  }
+};
+
+namespace
+{
+  // Takes an extraction context from the pool for the lifetime of the object
+  template< class TPool, class TContext >
+  struct TScopedContext
+  {
+    TPool*    myPool;
+    TContext* myContext;
+
+    TScopedContext( TPool* thePool ):
+      myPool( thePool ),
+      myContext( thePool->Acquire() )
+    {}
+    ~TScopedContext()
+    {
+      myPool->Release( myContext );
+    }
+  };
+}
+
 int
 VTKViewer_GeometryFilter
 ::UnstructuredGridExecute(vtkDataSet *dataSetInput,
@@ -331,35 +714,14 @@ VTKViewer_GeometryFilter
   vtkCellData *cd = input->GetCellData();
   vtkPointData *outputPD = output->GetPointData();
 
-  VTKViewer_OrderedTriangulator anOrderedTriangulator;
-  VTKViewer_DelaunayTriangulator aDelaunayTriangulator;
-
   vtkCellData *outputCD = output->GetCellData();
-  vtkGenericCell *cell = vtkGenericCell::New();
-
-  vtkIdList *cellIds = vtkIdList::New();
-  vtkIdList *faceIds = vtkIdList::New();
-  vtkIdList *cellIdsTmp = vtkIdList::New();
-  vtkIdList *faceIdsTmp = vtkIdList::New();
-  std::set< vtkIdType > midPoints;
 
   char *cellVis;
-  vtkIdType newCellId;
-  int faceId, numFacePts;
   double *x;
-  vtkIdType PixelConvert[4];
-  // Change the type from int to vtkIdType in order to avoid compilation errors while using VTK
-  // from ParaView-3.4.0 compiled on 64-bit Debian platform with VTK_USE_64BIT_IDS = ON
-  vtkIdType aNewPts[VTK_CELL_SIZE];
   // ghost cell stuff
   unsigned char  updateLevel = (unsigned char)(GetUpdateGhostLevel());
   unsigned char  *cellGhostLevels = 0;
 
-  PixelConvert[0] = 0;
-  PixelConvert[1] = 1;
-  PixelConvert[2] = 3;
-  PixelConvert[3] = 2;
-
   vtkDebugMacro(<<"Executing geometry filter for unstructured grid input");
 
   vtkDataArray* temp = 0;
@@ -463,896 +825,933 @@ VTKViewer_GeometryFilter
     }//for all cells
   }//if not all visible
 
-  if ( input->GetLinks() )
-    input->BuildLinks();
-
   // Loop over all cells now that visibility is known
   // (Have to compute visibility first for 3D cell boundaries)
-  vtkIdType progressInterval = numCells/20 + 1;
   TMapOfVectorId aDimension2VTK2ObjIds;
+
+  // Scratch objects and triangulations are kept between executions
+  if ( !myScratchPool )
+    myScratchPool = new TScratchPool;
+  TScratchPool* aScratchPool = myScratchPool;
   if ( myStoreMapping )
     aDimension2VTK2ObjIds.resize( 3 ); // max dimension is 2
 
-  for (cellId=0, Connectivity->InitTraversal();
-       Connectivity->GetNextCell(npts,pts);
-       cellId++)
+  // Results of neighbour queries are kept only if all cells are treated
+  TNeighborsStream* aReplayStream = 0;
+  TNeighborsStream  aRecordStream;
+  bool isRecording = false;
+  int  aStreamKey  = 0;
+  if ( myUseTopologyCache && allVisible && !cellGhostLevels )
   {
-    //Progress and abort method support
-    if ( !(cellId % progressInterval) )
+    if ( !myTopologyCache )
+      myTopologyCache = new TTopologyCache;
+    myTopologyCache->Check( input );
+
+    // the wireframe mode changes the queries for quadratic volumes only
+    aStreamKey = ( myShowInside ? 2 : 0 ) + ( myIsWireframeMode && myTopologyCache->myHasQuadratic3D ? 1 : 0 );
+    std::map<int, TNeighborsStream>::iterator aStream = myTopologyCache->myStreams.find( aStreamKey );
+    if ( aStream != myTopologyCache->myStreams.end() )
+      aReplayStream = & aStream->second;
+    else
+      isRecording = true;
+  }
+
+  // The parallel mode needs the cell links built beforehand (they are used read-only
+  // by all threads) and the cell points directly accessible in the connectivity array
+  bool isParallel = ( myIsParallel &&
+                      numCells >= 2 * MIN_PARALLEL_CHUNK_SIZE &&
+                      Connectivity->IsStorageShareable() );
+  if ( isParallel )
+  {
+    // when replaying, the links are needed only by the triangulation of convex point sets
+    std::set<vtkIdType> aConvexTypes;
+    aConvexTypes.insert( VTK_CONVEX_POINT_SET );
+    if ( !aReplayStream || hasCellType( input, aConvexTypes ))
+      input->BuildLinks();
+
+    // Each chunk of cells is extracted into its own buffer, then buffers
+    // are appended to the output in the order of chunks, so that the result
+    // is exactly the same as the one of the serial mode
+    vtkIdType aNbChunks = std::min<vtkIdType>( numCells / MIN_PARALLEL_CHUNK_SIZE,
+                                               8 * vtkSMPTools::GetEstimatedNumberOfThreads() );
+    vtkIdType aChunkSize = ( numCells + aNbChunks - 1 ) / aNbChunks;
+    std::vector< TChunkSink > aChunks( aNbChunks );
+    std::vector< TNeighborsStream > aChunkRecords( isRecording ? aNbChunks : 0 );
+
+    vtkSMPTools::For( 0, aNbChunks, 1, [&]( vtkIdType theFirstChunk, vtkIdType theLastChunk )
+    {
+      for ( vtkIdType aChunkId = theFirstChunk; aChunkId < theLastChunk; ++aChunkId )
+      {
+        TChunkSink& aSink = aChunks[ aChunkId ];
+        aSink.myNbInputPoints = input->GetNumberOfPoints();
+        TScopedContext< TScratchPool, TExtractionContext > aScoped( aScratchPool );
+        TExtractionContext& aContext = *aScoped.myContext;
+        aContext.Init( input, allVisible, cellVis, &aSink );
+
+        vtkIdType aFirst = aChunkId * aChunkSize;
+        vtkIdType aLast  = std::min( aFirst + aChunkSize, numCells );
+        if ( aReplayStream )
+        {
+          aContext.myIsReplay = true;
+          aContext.myReplay   = aReplayStream->myNeighbors.data() + aReplayStream->myOffsets[ aFirst ];
+        }
+        TNeighborsStream* aRecord = isRecording ? & aChunkRecords[ aChunkId ] : 0;
+        if ( aRecord )
+          aContext.myRecord = & aRecord->myNeighbors;
+
+        vtkIdType aNbPts = 0;
+        vtkIdType const *aPts = 0;
+        for ( vtkIdType aCellId = aFirst; aCellId < aLast; ++aCellId )
+        {
+          // Do not create surfaces in outer ghost cells.
+          if ( cellGhostLevels && cellGhostLevels[aCellId] > updateLevel )
+            continue;
+          if ( !allVisible && !cellVis[aCellId] )
+            continue;
+          Connectivity->GetCellAtId( aCellId, aNbPts, aPts );
+          this->ExtractCell( aCellId, aNbPts, aPts, aContext );
+          if ( aRecord )
+            aRecord->myOffsets.push_back( (vtkIdType)aRecord->myNeighbors.size() );
+        }
+      }
+    });
+
+    if ( isRecording )
     {
-      vtkDebugMacro(<<"Process cell #" << cellId);
-      this->UpdateProgress ((float)cellId/numCells);
+      // concatenate records of chunks
+      aRecordStream.myOffsets.reserve( numCells + 1 );
+      aRecordStream.myOffsets.push_back( 0 );
+      for ( vtkIdType aChunkId = 0; aChunkId < aNbChunks; ++aChunkId )
+      {
+        TNeighborsStream& aRecord = aChunkRecords[ aChunkId ];
+        vtkIdType aShift = (vtkIdType)aRecordStream.myNeighbors.size();
+        for ( size_t i = 0; i < aRecord.myOffsets.size(); ++i )
+          aRecordStream.myOffsets.push_back( aShift + aRecord.myOffsets[ i ] );
+        aRecordStream.myNeighbors.insert( aRecordStream.myNeighbors.end(),
+                                          aRecord.myNeighbors.begin(), aRecord.myNeighbors.end() );
+        std::vector<TNeighbors>().swap( aRecord.myNeighbors );
+      }
     }
 
-    // Handle ghost cells here.  Another option was used cellVis array.
-    if (cellGhostLevels && cellGhostLevels[cellId] > updateLevel)
-    { // Do not create surfaces in outer ghost cells.
-      continue;
+    vtkDataArray* outputScalars = outputPD->GetScalars();
+    for ( vtkIdType aChunkId = 0; aChunkId < aNbChunks; ++aChunkId )
+    {
+      this->UpdateProgress( (float)aChunkId / aNbChunks );
+      aChunks[ aChunkId ].Flush( output, cd, outputScalars, myStoreMapping,
+                                 myVTK2ObjIds, aDimension2VTK2ObjIds );
+    }
+  }
+  else
+  {
+    if ( input->GetLinks() )
+      input->BuildLinks();
+
+    TOutputSink aSink( output, cd, myStoreMapping, myVTK2ObjIds, aDimension2VTK2ObjIds );
+    TScopedContext< TScratchPool, TExtractionContext > aScoped( aScratchPool );
+    TExtractionContext& aContext = *aScoped.myContext;
+    aContext.Init( input, allVisible, cellVis, &aSink );
+    if ( aReplayStream )
+    {
+      aContext.myIsReplay = true;
+      aContext.myReplay   = aReplayStream->myNeighbors.data();
+    }
+    if ( isRecording )
+    {
+      aContext.myRecord = & aRecordStream.myNeighbors;
+      aRecordStream.myOffsets.reserve( numCells + 1 );
+      aRecordStream.myOffsets.push_back( 0 );
     }
 
-    if (allVisible || cellVis[cellId])  //now if visible extract geometry
+    vtkIdType progressInterval = numCells/20 + 1;
+    for (cellId=0, Connectivity->InitTraversal();
+         Connectivity->GetNextCell(npts,pts);
+         cellId++)
     {
-      //special code for nonlinear cells - rarely occurs, so right now it
-      //is slow.
-      vtkIdType aCellType = input->GetCellType(cellId);
-      switch (aCellType)
-        {
-        case VTK_EMPTY_CELL:
-          break;
+      //Progress and abort method support
+      if ( !(cellId % progressInterval) )
+      {
+        vtkDebugMacro(<<"Process cell #" << cellId);
+        this->UpdateProgress ((float)cellId/numCells);
+      }
 
-        case VTK_VERTEX:
-        case VTK_POLY_VERTEX:
-          newCellId = output->InsertNextCell(aCellType,npts,pts);
-          if(myStoreMapping){
-            InsertId( cellId, aCellType, myVTK2ObjIds, aDimension2VTK2ObjIds );
-          }
-          outputCD->CopyData(cd,cellId,newCellId);
-          break;
+      // Handle ghost cells here.  Another option was used cellVis array.
+      if (cellGhostLevels && cellGhostLevels[cellId] > updateLevel)
+      { // Do not create surfaces in outer ghost cells.
+        continue;
+      }
 
-        case VTK_LINE:
-        case VTK_POLY_LINE:
-          newCellId = output->InsertNextCell(aCellType,npts,pts);
-          if(myStoreMapping)
-            InsertId( cellId, aCellType, myVTK2ObjIds, aDimension2VTK2ObjIds );
-          outputCD->CopyData(cd,cellId,newCellId);
-          break;
+      if (allVisible || cellVis[cellId])  //now if visible extract geometry
+        this->ExtractCell( cellId, npts, pts, aContext );
 
-        case VTK_TRIANGLE:
-        case VTK_QUAD:
-        case VTK_POLYGON:
-          newCellId = output->InsertNextCell(aCellType,npts,pts);
-          if(myStoreMapping)
-            InsertId( cellId, aCellType, myVTK2ObjIds, aDimension2VTK2ObjIds );
-          outputCD->CopyData(cd,cellId,newCellId);
-          break;
+      if ( isRecording )
+        aRecordStream.myOffsets.push_back( (vtkIdType)aRecordStream.myNeighbors.size() );
+    } //for all cells
+  }
 
-        case VTK_TRIANGLE_STRIP:
-          newCellId = output->InsertNextCell(aCellType,npts,pts);
-          if(myStoreMapping)
-            InsertId( cellId, aCellType, myVTK2ObjIds, aDimension2VTK2ObjIds );
-          outputCD->CopyData(cd,cellId,newCellId);
-          break;
+  if ( isRecording )
+  {
+    TNeighborsStream& aStream = myTopologyCache->myStreams[ aStreamKey ];
+    aStream.myOffsets.swap( aRecordStream.myOffsets );
+    aStream.myNeighbors.swap( aRecordStream.myNeighbors );
+  }
 
-        case VTK_PIXEL:
-          newCellId = output->InsertNextCell(aCellType,npts,pts);
-          if(myStoreMapping)
-            InsertId( cellId, aCellType, myVTK2ObjIds, aDimension2VTK2ObjIds );
-          outputCD->CopyData(cd,cellId,newCellId);
-          break;
+  output->Squeeze();
 
-        case VTK_CONVEX_POINT_SET: {
-          bool anIsOk = anOrderedTriangulator.Execute(input,
-                                                      cd,
-                                                      cellId,
-                                                      myShowInside,
-                                                      allVisible,
-                                                      GetAppendCoincident3D(),
-                                                      cellVis,
-                                                      output,
-                                                      outputCD,
-                                                      myStoreMapping,
-                                                      myVTK2ObjIds,
-                                                      aDimension2VTK2ObjIds,
-                                                      true);
-          if(!anIsOk)
-            aDelaunayTriangulator.Execute(input,
-                                          cd,
-                                          cellId,
-                                          myShowInside,
-                                          allVisible,
-                                          GetAppendCoincident3D(),
-                                          cellVis,
-                                          output,
-                                          outputCD,
-                                          myStoreMapping,
-                                          myVTK2ObjIds,
-                                          aDimension2VTK2ObjIds,
-                                          false);
+  vtkDebugMacro(<<"Extracted " << input->GetNumberOfPoints() << " points,"
+                << output->GetNumberOfCells() << " cells.");
 
-          break;
-        }
-        case VTK_TETRA:
+  if ( cellVis )
+  {
+    delete [] cellVis;
+  }
+
+  if ( input->GetLinks() )
+  {
+    input->GetLinks()->Initialize(); // free memory
+  }
+
+  // fill myVTK2ObjIds vector in ascending cell dimension order
+  myVTK2ObjIds.clear();
+  if( myStoreMapping && !aDimension2VTK2ObjIds.empty() )
+  {
+    size_t nbCells = ( aDimension2VTK2ObjIds[0].size() +
+                       aDimension2VTK2ObjIds[1].size() +
+                       aDimension2VTK2ObjIds[2].size() );
+    if ( myVTK2ObjIds.capacity() > nbCells )
+      TVectorId().swap( myVTK2ObjIds );
+    myVTK2ObjIds.reserve( nbCells );
+
+    for( int aDimension = 0; aDimension <= 2; aDimension++ )
+      if ( !aDimension2VTK2ObjIds[ aDimension ].empty() )
+      {
+        myVTK2ObjIds.insert( myVTK2ObjIds.end(),
+                             aDimension2VTK2ObjIds[ aDimension ].begin(),
+                             aDimension2VTK2ObjIds[ aDimension ].end() );
+        TVectorId().swap( aDimension2VTK2ObjIds[ aDimension ]);
+      }
+  }
+
+  return 1;
+}
+
+/*!
+ * \brief Extract faces / edges of a visible cell and pass them to the sink of the context
+ *  \param [in] cellId - the cell to treat
+ *  \param [in] npts - number of points of the cell
+ *  \param [in] pts - the cell connectivity
+ *  \param [in,out] theContext - the extraction state
+ */
+void
+VTKViewer_GeometryFilter
+::ExtractCell(vtkIdType cellId,
+              vtkIdType npts,
+              const vtkIdType* pts,
+              TExtractionContext& theContext)
+{
+  vtkUnstructuredGrid* input = theContext.myInput;
+  TCellSink*           sink  = theContext.mySink;
+  int          allVisible    = theContext.myAllVisible;
+  const char*  cellVis       = theContext.myCellVis;
+  vtkGenericCell* cell       = theContext.myCell.Get();
+  vtkIdList* cellIds         = theContext.myCellIds.Get();
+  vtkIdList* faceIds         = theContext.myFaceIds.Get();
+  vtkIdList* cellIdsTmp      = theContext.myCellIdsTmp.Get();
+  vtkIdList* faceIdsTmp      = theContext.myFaceIdsTmp.Get();
+  std::set< vtkIdType >& midPoints = theContext.myMidPoints;
+
+  vtkIdType i;
+  int faceId, numFacePts;
+  static const vtkIdType PixelConvert[4] = { 0, 1, 3, 2 };
+  // Change the type from int to vtkIdType in order to avoid compilation errors while using VTK
+  // from ParaView-3.4.0 compiled on 64-bit Debian platform with VTK_USE_64BIT_IDS = ON
+  vtkIdType aNewPts[VTK_CELL_SIZE];
+
+  //special code for nonlinear cells - rarely occurs, so right now it
+  //is slow.
+  vtkIdType aCellType = input->GetCellType(cellId);
+  switch (aCellType)
+    {
+    case VTK_EMPTY_CELL:
+      break;
+
+    case VTK_VERTEX:
+    case VTK_POLY_VERTEX:
+    case VTK_LINE:
+    case VTK_POLY_LINE:
+    case VTK_TRIANGLE:
+    case VTK_QUAD:
+    case VTK_POLYGON:
+    case VTK_TRIANGLE_STRIP:
+    case VTK_PIXEL:
+      sink->InsertNextCell(cellId,aCellType,npts,pts);
+      break;
+
+    case VTK_CONVEX_POINT_SET: {
+      std::vector< std::vector<vtkIdType> >& aPolygons = theContext.myPolygons;
+      bool anIsOk = theContext.myOrderedTriangulator.Execute(input,
+                                                             cellId,
+                                                             myShowInside,
+                                                             allVisible,
+                                                             GetAppendCoincident3D(),
+                                                             cellVis,
+                                                             aPolygons,
+                                                             true);
+      if(!anIsOk)
+        theContext.myDelaunayTriangulator.Execute(input,
+                                                  cellId,
+                                                  myShowInside,
+                                                  allVisible,
+                                                  GetAppendCoincident3D(),
+                                                  cellVis,
+                                                  aPolygons,
+                                                  false);
+      for ( size_t iPoly = 0; iPoly < aPolygons.size(); ++iPoly )
+        sink->InsertNextCell(cellId,VTK_POLYGON,(vtkIdType)aPolygons[iPoly].size(),&aPolygons[iPoly][0]);
+      break;
+    }
+    case VTK_TETRA:
+    {
+      if ( myShowInside )
+      {
+        aCellType = VTK_LINE;
+        for ( int edgeID = 0; edgeID < 6; ++edgeID )
         {
-          if ( myShowInside )
+          const vtkIdType *edgeVerts = vtkTetra::GetEdgeArray( edgeID );
+          if ( theContext.ToShowEdge( pts[edgeVerts[0]], pts[edgeVerts[1]], cellId ))
           {
-            aCellType = VTK_LINE;
-            for ( int edgeID = 0; edgeID < 6; ++edgeID )
-            {
-              const vtkIdType *edgeVerts = vtkTetra::GetEdgeArray( edgeID );
-              if ( toShowEdge( pts[edgeVerts[0]], pts[edgeVerts[1]], cellId, input ))
-              {
-                aNewPts[0] = pts[edgeVerts[0]];
-                aNewPts[1] = pts[edgeVerts[1]];
-                newCellId = output->InsertNextCell( aCellType, 2, aNewPts );
-                if(myStoreMapping)
-                  InsertId( cellId, aCellType, myVTK2ObjIds, aDimension2VTK2ObjIds );
-                outputCD->CopyData(cd,cellId,newCellId);
-              }
-            }
-            break;
+            aNewPts[0] = pts[edgeVerts[0]];
+            aNewPts[1] = pts[edgeVerts[1]];
+            sink->InsertNextCell( cellId, aCellType, 2, aNewPts );
           }
-          else
-          {
+        }
+        break;
+      }
+      else
+      {
 #ifdef SHOW_COINCIDING_3D_PAL21924
-            faceIdsTmp->SetNumberOfIds( npts );
-            for ( auto ai = 0; ai < npts; ai++ )
-              faceIdsTmp->SetId( ai, pts[ai] );
-            input->GetCellNeighbors(cellId, faceIdsTmp, cellIdsTmp);
+        faceIdsTmp->SetNumberOfIds( npts );
+        for ( auto ai = 0; ai < npts; ai++ )
+          faceIdsTmp->SetId( ai, pts[ai] );
+        theContext.GetCellNeighbors(cellId, faceIdsTmp, cellIdsTmp);
 #endif
-            aCellType = VTK_TRIANGLE;
-            numFacePts = 3;
-            for (faceId = 0; faceId < 4; faceId++)
-            {
-              faceIds->Reset();
-              const vtkIdType *faceVerts = vtkTetra::GetFaceArray(faceId);
-              faceIds->InsertNextId(pts[faceVerts[0]]);
-              faceIds->InsertNextId(pts[faceVerts[1]]);
-              faceIds->InsertNextId(pts[faceVerts[2]]);
-              input->GetCellNeighbors(cellId, faceIds, cellIds);
-              vtkIdType nbNeighbors = cellIds->GetNumberOfIds() - cellIdsTmp->GetNumberOfIds();
+        aCellType = VTK_TRIANGLE;
+        numFacePts = 3;
+        for (faceId = 0; faceId < 4; faceId++)
+        {
+          faceIds->Reset();
+          const vtkIdType *faceVerts = vtkTetra::GetFaceArray(faceId);
+          faceIds->InsertNextId(pts[faceVerts[0]]);
+          faceIds->InsertNextId(pts[faceVerts[1]]);
+          faceIds->InsertNextId(pts[faceVerts[2]]);
+          theContext.GetCellNeighbors(cellId, faceIds, cellIds);
+          vtkIdType nbNeighbors = cellIds->GetNumberOfIds() - cellIdsTmp->GetNumberOfIds();
 #ifdef SHOW_COINCIDING_3D_PAL21924
-              bool process = nbNeighbors <= 0;
+          bool process = nbNeighbors <= 0;
 #else
-              bool process = nbNeighbors <= 0 || GetAppendCoincident3D();
+          bool process = nbNeighbors <= 0 || GetAppendCoincident3D();
 #endif
-              if ( process || ( !allVisible && !cellVis[cellIds->GetId(0)] ))
-              {
-                for ( i=0; i < numFacePts; i++)
-                  aNewPts[i] = pts[faceVerts[i]];
-                newCellId = output->InsertNextCell(aCellType,numFacePts,aNewPts);
-                if(myStoreMapping)
-                  InsertId( cellId, aCellType, myVTK2ObjIds, aDimension2VTK2ObjIds );
-                outputCD->CopyData(cd,cellId,newCellId);
-              }
-            }
+          if ( process || ( !allVisible && !cellVis[cellIds->GetId(0)] ))
+          {
+            for ( i=0; i < numFacePts; i++)
+              aNewPts[i] = pts[faceVerts[i]];
+            sink->InsertNextCell(cellId,aCellType,numFacePts,aNewPts);
           }
-          break;
         }
-        case VTK_VOXEL:
+      }
+      break;
+    }
+    case VTK_VOXEL:
+    {
+      if ( myShowInside )
+      {
+        aCellType = VTK_LINE;
+        for ( int edgeID = 0; edgeID < 12; ++edgeID )
         {
-          if ( myShowInside )
+          const vtkIdType *edgeVerts = vtkVoxel::GetEdgeArray( edgeID );
+          if ( theContext.ToShowEdge( pts[edgeVerts[0]], pts[edgeVerts[1]], cellId ))
           {
-            aCellType = VTK_LINE;
-            for ( int edgeID = 0; edgeID < 12; ++edgeID )
-            {
-              const vtkIdType *edgeVerts = vtkVoxel::GetEdgeArray( edgeID );
-              if ( toShowEdge( pts[edgeVerts[0]], pts[edgeVerts[1]], cellId, input ))
-              {
-                aNewPts[0] = pts[edgeVerts[0]];
-                aNewPts[1] = pts[edgeVerts[1]];
-                newCellId = output->InsertNextCell( aCellType, 2, aNewPts );
-                if(myStoreMapping)
-                  InsertId( cellId, aCellType, myVTK2ObjIds, aDimension2VTK2ObjIds );
-                outputCD->CopyData(cd,cellId,newCellId);
-              }
-            }
-            break;
+            aNewPts[0] = pts[edgeVerts[0]];
+            aNewPts[1] = pts[edgeVerts[1]];
+            sink->InsertNextCell( cellId, aCellType, 2, aNewPts );
           }
-          else
-          {
-#ifdef SHOW_COINCIDING_3D_PAL21924
-            faceIdsTmp->SetNumberOfIds( npts );
-            for ( auto ai = 0; ai < npts; ai++ )
-              faceIdsTmp->SetId( ai, pts[ai] );
-            input->GetCellNeighbors(cellId, faceIdsTmp, cellIdsTmp);
-#endif
-            for (faceId = 0; faceId < 6; faceId++)
-            {
-              faceIds->Reset();
-              const vtkIdType*faceVerts = vtkVoxel::GetFaceArray(faceId);
-              faceIds->InsertNextId(pts[faceVerts[0]]);
-              faceIds->InsertNextId(pts[faceVerts[1]]);
-              faceIds->InsertNextId(pts[faceVerts[2]]);
-              faceIds->InsertNextId(pts[faceVerts[3]]);
-              aCellType = VTK_QUAD;
-              numFacePts = 4;
-              input->GetCellNeighbors(cellId, faceIds, cellIds);
-              vtkIdType nbNeighbors = cellIds->GetNumberOfIds() - cellIdsTmp->GetNumberOfIds();
+        }
+        break;
+      }
+      else
+      {
 #ifdef SHOW_COINCIDING_3D_PAL21924
-              bool process = nbNeighbors <= 0;
+        faceIdsTmp->SetNumberOfIds( npts );
+        for ( auto ai = 0; ai < npts; ai++ )
+          faceIdsTmp->SetId( ai, pts[ai] );
+        theContext.GetCellNeighbors(cellId, faceIdsTmp, cellIdsTmp);
+#endif
+        for (faceId = 0; faceId < 6; faceId++)
+        {
+          faceIds->Reset();
+          const vtkIdType*faceVerts = vtkVoxel::GetFaceArray(faceId);
+          faceIds->InsertNextId(pts[faceVerts[0]]);
+          faceIds->InsertNextId(pts[faceVerts[1]]);
+          faceIds->InsertNextId(pts[faceVerts[2]]);
+          faceIds->InsertNextId(pts[faceVerts[3]]);
+          aCellType = VTK_QUAD;
+          numFacePts = 4;
+          theContext.GetCellNeighbors(cellId, faceIds, cellIds);
+          vtkIdType nbNeighbors = cellIds->GetNumberOfIds() - cellIdsTmp->GetNumberOfIds();
+#ifdef SHOW_COINCIDING_3D_PAL21924
+          bool process = nbNeighbors <= 0;
 #else
-              bool process = cellIds->GetNumberOfIds() <= 0 || GetAppendCoincident3D();
+          bool process = cellIds->GetNumberOfIds() <= 0 || GetAppendCoincident3D();
 #endif
-              if ( process || ( !allVisible && !cellVis[cellIds->GetId(0)] ))
-              {
-                for ( i=0; i < numFacePts; i++)
-                  aNewPts[i] = pts[faceVerts[PixelConvert[i]]];
-                newCellId = output->InsertNextCell(aCellType,numFacePts,aNewPts);
-                if(myStoreMapping)
-                  InsertId( cellId, aCellType, myVTK2ObjIds, aDimension2VTK2ObjIds );
-                outputCD->CopyData(cd,cellId,newCellId);
-              }
-            }
+          if ( process || ( !allVisible && !cellVis[cellIds->GetId(0)] ))
+          {
+            for ( i=0; i < numFacePts; i++)
+              aNewPts[i] = pts[faceVerts[PixelConvert[i]]];
+            sink->InsertNextCell(cellId,aCellType,numFacePts,aNewPts);
           }
-          break;
         }
-        case VTK_HEXAHEDRON:
+      }
+      break;
+    }
+    case VTK_HEXAHEDRON:
+    {
+      if ( myShowInside )
+      {
+        aCellType = VTK_LINE;
+        for ( int edgeID = 0; edgeID < 12; ++edgeID )
         {
-          if ( myShowInside )
+          const vtkIdType *edgeVerts = vtkHexahedron::GetEdgeArray( edgeID );
+          if ( theContext.ToShowEdge( pts[edgeVerts[0]], pts[edgeVerts[1]], cellId ))
           {
-            aCellType = VTK_LINE;
-            for ( int edgeID = 0; edgeID < 12; ++edgeID )
-            {
-              const vtkIdType *edgeVerts = vtkHexahedron::GetEdgeArray( edgeID );
-              if ( toShowEdge( pts[edgeVerts[0]], pts[edgeVerts[1]], cellId, input ))
-              {
-                aNewPts[0] = pts[edgeVerts[0]];
-                aNewPts[1] = pts[edgeVerts[1]];
-                newCellId = output->InsertNextCell( aCellType, 2, aNewPts );
-                if(myStoreMapping)
-                  InsertId( cellId, aCellType, myVTK2ObjIds, aDimension2VTK2ObjIds );
-                outputCD->CopyData(cd,cellId,newCellId);
-              }
-            }
-            break;
+            aNewPts[0] = pts[edgeVerts[0]];
+            aNewPts[1] = pts[edgeVerts[1]];
+            sink->InsertNextCell( cellId, aCellType, 2, aNewPts );
           }
-          else
-          {
+        }
+        break;
+      }
+      else
+      {
 #ifdef SHOW_COINCIDING_3D_PAL21924
-            faceIdsTmp->SetNumberOfIds( npts );
-            for ( auto ai = 0; ai < npts; ai++ )
-              faceIdsTmp->SetId( ai, pts[ai] );
-            input->GetCellNeighbors(cellId, faceIdsTmp, cellIdsTmp);
+        faceIdsTmp->SetNumberOfIds( npts );
+        for ( auto ai = 0; ai < npts; ai++ )
+          faceIdsTmp->SetId( ai, pts[ai] );
+        theContext.GetCellNeighbors(cellId, faceIdsTmp, cellIdsTmp);
 #endif
-            aCellType = VTK_QUAD;
-            numFacePts = 4;
-            for (faceId = 0; faceId < 6; faceId++)
-            {
-              faceIds->Reset();
-              const vtkIdType *faceVerts = vtkHexahedron::GetFaceArray(faceId);
-              faceIds->InsertNextId(pts[faceVerts[0]]);
-              faceIds->InsertNextId(pts[faceVerts[1]]);
-              faceIds->InsertNextId(pts[faceVerts[2]]);
-              faceIds->InsertNextId(pts[faceVerts[3]]);
-              input->GetCellNeighbors(cellId, faceIds, cellIds);
-              vtkIdType nbNeighbors = cellIds->GetNumberOfIds() - cellIdsTmp->GetNumberOfIds();
+        aCellType = VTK_QUAD;
+        numFacePts = 4;
+        for (faceId = 0; faceId < 6; faceId++)
+        {
+          faceIds->Reset();
+          const vtkIdType *faceVerts = vtkHexahedron::GetFaceArray(faceId);
+          faceIds->InsertNextId(pts[faceVerts[0]]);
+          faceIds->InsertNextId(pts[faceVerts[1]]);
+          faceIds->InsertNextId(pts[faceVerts[2]]);
+          faceIds->InsertNextId(pts[faceVerts[3]]);
+          theContext.GetCellNeighbors(cellId, faceIds, cellIds);
+          vtkIdType nbNeighbors = cellIds->GetNumberOfIds() - cellIdsTmp->GetNumberOfIds();
 #ifdef SHOW_COINCIDING_3D_PAL21924
-              bool process = nbNeighbors <= 0;
+          bool process = nbNeighbors <= 0;
 #else
-              bool process = cellIds->GetNumberOfIds() <= 0 || GetAppendCoincident3D();
+          bool process = cellIds->GetNumberOfIds() <= 0 || GetAppendCoincident3D();
 #endif
-              if ( process || (!allVisible && !cellVis[cellIds->GetId(0)]) )
-              {
-                for ( i=0; i < numFacePts; i++)
-                  aNewPts[i] = pts[faceVerts[i]];
-                newCellId = output->InsertNextCell(aCellType,numFacePts,aNewPts);
-                if(myStoreMapping)
-                  InsertId( cellId, aCellType, myVTK2ObjIds, aDimension2VTK2ObjIds );
-                outputCD->CopyData(cd,cellId,newCellId);
-              }
-            }
+          if ( process || (!allVisible && !cellVis[cellIds->GetId(0)]) )
+          {
+            for ( i=0; i < numFacePts; i++)
+              aNewPts[i] = pts[faceVerts[i]];
+            sink->InsertNextCell(cellId,aCellType,numFacePts,aNewPts);
           }
-          break;
         }
-        case VTK_WEDGE:
+      }
+      break;
+    }
+    case VTK_WEDGE:
+    {
+      if ( myShowInside )
+      {
+        aCellType = VTK_LINE;
+        for ( int edgeID = 0; edgeID < 9; ++edgeID )
         {
-          if ( myShowInside )
+          const vtkIdType *edgeVerts = vtkWedge::GetEdgeArray( edgeID );
+          if ( theContext.ToShowEdge( pts[edgeVerts[0]], pts[edgeVerts[1]], cellId ))
           {
-            aCellType = VTK_LINE;
-            for ( int edgeID = 0; edgeID < 9; ++edgeID )
-            {
-              const vtkIdType *edgeVerts = vtkWedge::GetEdgeArray( edgeID );
-              if ( toShowEdge( pts[edgeVerts[0]], pts[edgeVerts[1]], cellId, input ))
-              {
-                aNewPts[0] = pts[edgeVerts[0]];
-                aNewPts[1] = pts[edgeVerts[1]];
-                newCellId = output->InsertNextCell( aCellType, 2, aNewPts );
-                if(myStoreMapping)
-                  InsertId( cellId, aCellType, myVTK2ObjIds, aDimension2VTK2ObjIds );
-                outputCD->CopyData(cd,cellId,newCellId);
-              }
-            }
-            break;
+            aNewPts[0] = pts[edgeVerts[0]];
+            aNewPts[1] = pts[edgeVerts[1]];
+            sink->InsertNextCell( cellId, aCellType, 2, aNewPts );
           }
-          else
-          {
+        }
+        break;
+      }
+      else
+      {
 #ifdef SHOW_COINCIDING_3D_PAL21924
-            faceIdsTmp->SetNumberOfIds( npts );
-            for ( int ai = 0; ai < npts; ai++ )
-              faceIdsTmp->SetId( ai, pts[ai] );
-            input->GetCellNeighbors(cellId, faceIdsTmp, cellIdsTmp);
+        faceIdsTmp->SetNumberOfIds( npts );
+        for ( int ai = 0; ai < npts; ai++ )
+          faceIdsTmp->SetId( ai, pts[ai] );
+        theContext.GetCellNeighbors(cellId, faceIdsTmp, cellIdsTmp);
 #endif
-            for (faceId = 0; faceId < 5; faceId++)
-            {
-              faceIds->Reset();
-              const vtkIdType *faceVerts = vtkWedge::GetFaceArray(faceId);
-              faceIds->InsertNextId(pts[faceVerts[0]]);
-              faceIds->InsertNextId(pts[faceVerts[1]]);
-              faceIds->InsertNextId(pts[faceVerts[2]]);
-              aCellType = VTK_TRIANGLE;
-              numFacePts = 3;
-              if (faceVerts[3] >= 0)
-              {
-                faceIds->InsertNextId(pts[faceVerts[3]]);
-                aCellType = VTK_QUAD;
-                numFacePts = 4;
-              }
-              input->GetCellNeighbors(cellId, faceIds, cellIds);
-              vtkIdType nbNeighbors = cellIds->GetNumberOfIds() - cellIdsTmp->GetNumberOfIds();
+        for (faceId = 0; faceId < 5; faceId++)
+        {
+          faceIds->Reset();
+          const vtkIdType *faceVerts = vtkWedge::GetFaceArray(faceId);
+          faceIds->InsertNextId(pts[faceVerts[0]]);
+          faceIds->InsertNextId(pts[faceVerts[1]]);
+          faceIds->InsertNextId(pts[faceVerts[2]]);
+          aCellType = VTK_TRIANGLE;
+          numFacePts = 3;
+          if (faceVerts[3] >= 0)
+          {
+            faceIds->InsertNextId(pts[faceVerts[3]]);
+            aCellType = VTK_QUAD;
+            numFacePts = 4;
+          }
+          theContext.GetCellNeighbors(cellId, faceIds, cellIds);
+          vtkIdType nbNeighbors = cellIds->GetNumberOfIds() - cellIdsTmp->GetNumberOfIds();
 #ifdef SHOW_COINCIDING_3D_PAL21924
-              bool process = nbNeighbors <= 0;
+          bool process = nbNeighbors <= 0;
 #else
-              bool process = cellIds->GetNumberOfIds() <= 0 || GetAppendCoincident3D();
+          bool process = cellIds->GetNumberOfIds() <= 0 || GetAppendCoincident3D();
 #endif
-              if ( process || ( !allVisible && !cellVis[cellIds->GetId(0)] ))
-              {
-                for ( i=0; i < numFacePts; i++)
-                  aNewPts[i] = pts[faceVerts[i]];
-                newCellId = output->InsertNextCell(aCellType,numFacePts,aNewPts);
-                if(myStoreMapping)
-                  InsertId( cellId, aCellType, myVTK2ObjIds, aDimension2VTK2ObjIds );
-                outputCD->CopyData(cd,cellId,newCellId);
-              }
-            }
+          if ( process || ( !allVisible && !cellVis[cellIds->GetId(0)] ))
+          {
+            for ( i=0; i < numFacePts; i++)
+              aNewPts[i] = pts[faceVerts[i]];
+            sink->InsertNextCell(cellId,aCellType,numFacePts,aNewPts);
           }
-          break;
         }
-        case VTK_HEXAGONAL_PRISM:
+      }
+      break;
+    }
+    case VTK_HEXAGONAL_PRISM:
+    {
+      if ( myShowInside )
+      {
+        aCellType = VTK_LINE;
+        for ( int edgeID = 0; edgeID < 18; ++edgeID )
         {
-          if ( myShowInside )
+          const vtkIdType *edgeVerts = vtkHexagonalPrism::GetEdgeArray( edgeID );
+          if ( theContext.ToShowEdge( pts[edgeVerts[0]], pts[edgeVerts[1]], cellId ))
           {
-            aCellType = VTK_LINE;
-            for ( int edgeID = 0; edgeID < 18; ++edgeID )
-            {
-              const vtkIdType *edgeVerts = vtkHexagonalPrism::GetEdgeArray( edgeID );
-              if ( toShowEdge( pts[edgeVerts[0]], pts[edgeVerts[1]], cellId, input ))
-              {
-                aNewPts[0] = pts[edgeVerts[0]];
-                aNewPts[1] = pts[edgeVerts[1]];
-                newCellId = output->InsertNextCell( aCellType, 2, aNewPts );
-                if(myStoreMapping)
-                  InsertId( cellId, aCellType, myVTK2ObjIds, aDimension2VTK2ObjIds );
-                outputCD->CopyData(cd,cellId,newCellId);
-              }
-            }
-            break;
+            aNewPts[0] = pts[edgeVerts[0]];
+            aNewPts[1] = pts[edgeVerts[1]];
+            sink->InsertNextCell( cellId, aCellType, 2, aNewPts );
           }
-          else
-          {
+        }
+        break;
+      }
+      else
+      {
 #ifdef SHOW_COINCIDING_3D_PAL21924
-            faceIdsTmp->SetNumberOfIds( npts );
-            for ( auto ai = 0; ai < npts; ai++ )
-              faceIdsTmp->SetId( ai, pts[ai] );
-            input->GetCellNeighbors(cellId, faceIdsTmp, cellIdsTmp);
+        faceIdsTmp->SetNumberOfIds( npts );
+        for ( auto ai = 0; ai < npts; ai++ )
+          faceIdsTmp->SetId( ai, pts[ai] );
+        theContext.GetCellNeighbors(cellId, faceIdsTmp, cellIdsTmp);
 #endif
-            for (faceId = 0; faceId < 8; faceId++)
-            {
-              const vtkIdType *faceVerts = vtkHexagonalPrism::GetFaceArray(faceId);
-              faceIds->Reset();
-              faceIds->InsertNextId(pts[faceVerts[0]]);
-              faceIds->InsertNextId(pts[faceVerts[1]]);
-              faceIds->InsertNextId(pts[faceVerts[2]]);
-              faceIds->InsertNextId(pts[faceVerts[3]]);
-              aCellType = VTK_QUAD;
-              numFacePts = 4;
-              if (faceVerts[5] >= 0)
-              {
-                faceIds->InsertNextId(pts[faceVerts[4]]);
-                faceIds->InsertNextId(pts[faceVerts[5]]);
-                aCellType = VTK_POLYGON;
-                numFacePts = 6;
-              }
-              input->GetCellNeighbors(cellId, faceIds, cellIds);
-              vtkIdType nbNeighbors = cellIds->GetNumberOfIds() - cellIdsTmp->GetNumberOfIds();
+        for (faceId = 0; faceId < 8; faceId++)
+        {
+          const vtkIdType *faceVerts = vtkHexagonalPrism::GetFaceArray(faceId);
+          faceIds->Reset();
+          faceIds->InsertNextId(pts[faceVerts[0]]);
+          faceIds->InsertNextId(pts[faceVerts[1]]);
+          faceIds->InsertNextId(pts[faceVerts[2]]);
+          faceIds->InsertNextId(pts[faceVerts[3]]);
+          aCellType = VTK_QUAD;
+          numFacePts = 4;
+          if (faceVerts[5] >= 0)
+          {
+            faceIds->InsertNextId(pts[faceVerts[4]]);
+            faceIds->InsertNextId(pts[faceVerts[5]]);
+            aCellType = VTK_POLYGON;
+            numFacePts = 6;
+          }
+          theContext.GetCellNeighbors(cellId, faceIds, cellIds);
+          vtkIdType nbNeighbors = cellIds->GetNumberOfIds() - cellIdsTmp->GetNumberOfIds();
 #ifdef SHOW_COINCIDING_3D_PAL21924
-              bool process = nbNeighbors <= 0;
+          bool process = nbNeighbors <= 0;
 #else
-              bool process = cellIds->GetNumberOfIds() <= 0 || GetAppendCoincident3D();
+          bool process = cellIds->GetNumberOfIds() <= 0 || GetAppendCoincident3D();
 #endif
-              if ( process || ( !allVisible && !cellVis[cellIds->GetId(0)] ))
-              {
-                for ( i=0; i < numFacePts; i++)
-                  aNewPts[i] = pts[faceVerts[i]];
-                newCellId = output->InsertNextCell(aCellType,numFacePts,aNewPts);
-                if(myStoreMapping)
-                  InsertId( cellId, aCellType, myVTK2ObjIds, aDimension2VTK2ObjIds );
-                outputCD->CopyData(cd,cellId,newCellId);
-              }
-            }
+          if ( process || ( !allVisible && !cellVis[cellIds->GetId(0)] ))
+          {
+            for ( i=0; i < numFacePts; i++)
+              aNewPts[i] = pts[faceVerts[i]];
+            sink->InsertNextCell(cellId,aCellType,numFacePts,aNewPts);
           }
-          break;
         }
-        case VTK_PYRAMID:
+      }
+      break;
+    }
+    case VTK_PYRAMID:
+    {
+      if ( myShowInside )
+      {
+        aCellType = VTK_LINE;
+        for ( auto edgeID = 0; edgeID < 8; ++edgeID )
         {
-          if ( myShowInside )
+          const vtkIdType *edgeVerts = vtkPyramid::GetEdgeArray( edgeID );
+          if ( theContext.ToShowEdge( pts[edgeVerts[0]], pts[edgeVerts[1]], cellId ))
           {
-            aCellType = VTK_LINE;
-            for ( auto edgeID = 0; edgeID < 8; ++edgeID )
-            {
-              const vtkIdType *edgeVerts = vtkPyramid::GetEdgeArray( edgeID );
-              if ( toShowEdge( pts[edgeVerts[0]], pts[edgeVerts[1]], cellId, input ))
-              {
-                aNewPts[0] = pts[edgeVerts[0]];
-                aNewPts[1] = pts[edgeVerts[1]];
-                newCellId = output->InsertNextCell( aCellType, 2, aNewPts );
-                if(myStoreMapping)
-                  InsertId( cellId, aCellType, myVTK2ObjIds, aDimension2VTK2ObjIds );
-                outputCD->CopyData(cd,cellId,newCellId);
-              }
-            }
-            break;
+            aNewPts[0] = pts[edgeVerts[0]];
+            aNewPts[1] = pts[edgeVerts[1]];
+            sink->InsertNextCell( cellId, aCellType, 2, aNewPts );
           }
-          else
-          {
+        }
+        break;
+      }
+      else
+      {
 #ifdef SHOW_COINCIDING_3D_PAL21924
-            faceIdsTmp->SetNumberOfIds( npts );
-            for ( auto ai = 0; ai < npts; ai++ )
-              faceIdsTmp->SetId( ai, pts[ai] );
-            input->GetCellNeighbors(cellId, faceIdsTmp, cellIdsTmp);
+        faceIdsTmp->SetNumberOfIds( npts );
+        for ( auto ai = 0; ai < npts; ai++ )
+          faceIdsTmp->SetId( ai, pts[ai] );
+        theContext.GetCellNeighbors(cellId, faceIdsTmp, cellIdsTmp);
 #endif
-            for (faceId = 0; faceId < 5; faceId++)
-            {
-              faceIds->Reset();
-              const vtkIdType *faceVerts = vtkPyramid::GetFaceArray(faceId);
-              faceIds->InsertNextId(pts[faceVerts[0]]);
-              faceIds->InsertNextId(pts[faceVerts[1]]);
-              faceIds->InsertNextId(pts[faceVerts[2]]);
-              aCellType = VTK_TRIANGLE;
-              numFacePts = 3;
-              if (faceVerts[3] >= 0)
-              {
-                faceIds->InsertNextId(pts[faceVerts[3]]);
-                aCellType = VTK_QUAD;
-                numFacePts = 4;
-              }
-              input->GetCellNeighbors(cellId, faceIds, cellIds);
-              vtkIdType nbNeighbors = cellIds->GetNumberOfIds() - cellIdsTmp->GetNumberOfIds();
+        for (faceId = 0; faceId < 5; faceId++)
+        {
+          faceIds->Reset();
+          const vtkIdType *faceVerts = vtkPyramid::GetFaceArray(faceId);
+          faceIds->InsertNextId(pts[faceVerts[0]]);
+          faceIds->InsertNextId(pts[faceVerts[1]]);
+          faceIds->InsertNextId(pts[faceVerts[2]]);
+          aCellType = VTK_TRIANGLE;
+          numFacePts = 3;
+          if (faceVerts[3] >= 0)
+          {
+            faceIds->InsertNextId(pts[faceVerts[3]]);
+            aCellType = VTK_QUAD;
+            numFacePts = 4;
+          }
+          theContext.GetCellNeighbors(cellId, faceIds, cellIds);
+          vtkIdType nbNeighbors = cellIds->GetNumberOfIds() - cellIdsTmp->GetNumberOfIds();
 #ifdef SHOW_COINCIDING_3D_PAL21924
-              bool process = nbNeighbors <= 0;
+          bool process = nbNeighbors <= 0;
 #else
-              bool process = cellIds->GetNumberOfIds() <= 0 || GetAppendCoincident3D();
+          bool process = cellIds->GetNumberOfIds() <= 0 || GetAppendCoincident3D();
 #endif
-              if ( process || ( !allVisible && !cellVis[cellIds->GetId(0)] ))
-              {
-                for ( i=0; i < numFacePts; i++)
-                  aNewPts[i] = pts[faceVerts[i]];
-                newCellId = output->InsertNextCell(aCellType,numFacePts,aNewPts);
-                if(myStoreMapping)
-                  InsertId( cellId, aCellType, myVTK2ObjIds, aDimension2VTK2ObjIds );
-                outputCD->CopyData(cd,cellId,newCellId);
-              }
-            }
+          if ( process || ( !allVisible && !cellVis[cellIds->GetId(0)] ))
+          {
+            for ( i=0; i < numFacePts; i++)
+              aNewPts[i] = pts[faceVerts[i]];
+            sink->InsertNextCell(cellId,aCellType,numFacePts,aNewPts);
           }
-          break;
         }
+      }
+      break;
+    }
 
 #if VTK_XVERSION > 50700
-        case VTK_POLYHEDRON:
+    case VTK_POLYHEDRON:
+    {
+      vtkIdList* faces = theContext.myFaceStream;
+      input->GetFaceStream(cellId, faces);
+      vtkIdType nFaces = faces->GetId(0);
+      const vtkIdType* ptIds = faces->GetPointer(1);
+      vtkIdType idp = 0;
+      cellIdsTmp->Reset(); // don't depend on the previously treated cell
+#ifdef SHOW_COINCIDING_3D_PAL21924
+      if ( !myShowInside )
+      {
+        faceIdsTmp->Reset(); // use 2 facets
+        numFacePts = ptIds[idp];
+        for (i = 0; i < numFacePts; i++)
+          faceIdsTmp->InsertNextId(ptIds[idp + i]);
+        idp += numFacePts+1;
+        numFacePts = ptIds[idp];
+        for (i = 0; i < numFacePts; i++)
+          faceIdsTmp->InsertNextId(ptIds[idp + i]);
+        theContext.GetCellNeighbors(cellId, faceIdsTmp, cellIdsTmp);
+        idp = 0;
+      }
+#endif
+      for (faceId = 0; faceId < nFaces; faceId++)
+      {
+        faceIds->Reset();
+        numFacePts = ptIds[idp];
+        vtkIdType pt0 = ++idp;
+        for (i = 0; i < numFacePts; i++)
+        {
+          faceIds->InsertNextId(ptIds[idp + i]);
+        }
+        idp += numFacePts;
+        switch (numFacePts)
+        {
+        case 3: aCellType = VTK_TRIANGLE; break;
+        case 4: aCellType = VTK_QUAD;     break;
+        default:aCellType = VTK_POLYGON;
+        }
+        theContext.GetCellNeighbors(cellId, faceIds, cellIds);
+        vtkIdType nbNeighbors = cellIds->GetNumberOfIds() - cellIdsTmp->GetNumberOfIds();
+        if ( myShowInside && nbNeighbors > 0 && cellId < cellIds->GetId(0) )
+          continue; // don't add twice same internal face in wireframe mode
+#ifdef SHOW_COINCIDING_3D_PAL21924
+        bool process = nbNeighbors <= 0;
+#else
+        bool process = cellIds->GetNumberOfIds() <= 0 || GetAppendCoincident3D();
+#endif
+        if (process || myShowInside
+            || (!allVisible && !cellVis[cellIds->GetId(0)]))
+        {
+          for (i = 0; i < numFacePts; i++)
+            aNewPts[i] = ptIds[pt0 + i];
+          sink->InsertNextCell(cellId, aCellType, numFacePts, aNewPts);
+        }
+      }
+      break;
+    }
+#endif
+    //Quadratic cells
+    case VTK_QUADRATIC_EDGE:
+    case VTK_QUADRATIC_TRIANGLE:
+    case VTK_BIQUADRATIC_TRIANGLE:
+    case VTK_QUADRATIC_QUAD:
+    case VTK_BIQUADRATIC_QUAD:
+    case VTK_QUADRATIC_POLYGON:
+    case VTK_QUADRATIC_TETRA:
+    case VTK_QUADRATIC_HEXAHEDRON:
+    case VTK_TRIQUADRATIC_HEXAHEDRON:
+    case VTK_QUADRATIC_WEDGE:
+    case VTK_BIQUADRATIC_QUADRATIC_WEDGE:
+    case VTK_QUADRATIC_PYRAMID:
+
+      if(!myIsWireframeMode)
+      {
+        input->GetCell(cellId,cell);
+        vtkIdList *lpts = theContext.myTriaIds.Get();
+        vtkPoints *coords = theContext.myTriaCoords.Get();
+
+        if ( cell->GetCellDimension() == 1 ) {
+          if(!myIsBuildArc || !BuildArcedEdge(cellId, pts, theContext)) {
+            aCellType = VTK_LINE;
+            numFacePts = 2;
+            cell->Triangulate(0,lpts,coords);
+            for (i=0; i < lpts->GetNumberOfIds(); i+=2) {
+              aNewPts[0] = lpts->GetId(i);
+              aNewPts[1] = lpts->GetId(i+1);
+              sink->InsertNextCell(cellId,aCellType,numFacePts,aNewPts);
+            }
+          }
+        }
+        else if ( cell->GetCellDimension() == 2 ) {
+          if(!myIsBuildArc) {
+            aCellType = VTK_TRIANGLE;
+            numFacePts = 3;
+            cell->Triangulate(0,lpts,coords);
+            for (i=0; i < lpts->GetNumberOfIds(); i+=3) {
+              aNewPts[0] = lpts->GetId(i);
+              aNewPts[1] = lpts->GetId(i+1);
+              aNewPts[2] = lpts->GetId(i+2);
+              sink->InsertNextCell(cellId,aCellType,numFacePts,aNewPts);
+            }
+          }
+          else{
+            BuildArcedPolygon(cellId,theContext,true);
+          }
+        }
+        else //3D nonlinear cell
         {
-          vtkNew<vtkIdList> faces;
-          input->GetFaceStream(cellId, faces);
-          vtkIdType nFaces = faces->GetId(0);
-          const vtkIdType* ptIds = faces->GetPointer(1);
-          vtkIdType idp = 0;
 #ifdef SHOW_COINCIDING_3D_PAL21924
           if ( !myShowInside )
           {
-            faceIdsTmp->Reset(); // use 2 facets
-            numFacePts = ptIds[idp];
-            for (i = 0; i < numFacePts; i++)
-              faceIdsTmp->InsertNextId(ptIds[idp + i]);
-            idp += numFacePts+1;
-            numFacePts = ptIds[idp];
-            for (i = 0; i < numFacePts; i++)
-              faceIdsTmp->InsertNextId(ptIds[idp + i]);
-            input->GetCellNeighbors(cellId, faceIdsTmp, cellIdsTmp);
-            idp = 0;
+            vtkIdType npts1 = 0;
+            switch (aCellType ){
+            case VTK_QUADRATIC_TETRA:             npts1 = 4; break;
+            case VTK_QUADRATIC_HEXAHEDRON:        npts1 = 8; break;
+            case VTK_TRIQUADRATIC_HEXAHEDRON:     npts1 = 8; break;
+            case VTK_QUADRATIC_WEDGE:             npts1 = 6; break;
+            case VTK_BIQUADRATIC_QUADRATIC_WEDGE: npts1 = 6; break;
+            case VTK_QUADRATIC_PYRAMID:           npts1 = 5; break;
+            }
+            faceIdsTmp->SetNumberOfIds( npts1 );
+            if ( npts1 > 0 ) {
+              for (auto ai=0; ai<npts1; ai++)
+                faceIdsTmp->SetId( ai, pts[ai] );
+              theContext.GetCellNeighbors(cellId, faceIdsTmp, cellIdsTmp);
+            }
           }
 #endif
-          for (faceId = 0; faceId < nFaces; faceId++)
+          aCellType = VTK_TRIANGLE;
+          numFacePts = 3;
+          vtkIdType nbNeighbors = 0;
+          for (auto j=0; j < cell->GetNumberOfFaces(); j++)
           {
-            faceIds->Reset();
-            numFacePts = ptIds[idp];
-            vtkIdType pt0 = ++idp;
-            for (i = 0; i < numFacePts; i++)
-            {
-              faceIds->InsertNextId(ptIds[idp + i]);
+            vtkCell *face = cell->GetFace(j);
+            if ( !myShowInside ) {
+              theContext.GetCellNeighbors(cellId, face->PointIds, cellIds);
+              nbNeighbors = cellIds->GetNumberOfIds() - cellIdsTmp->GetNumberOfIds();
             }
-            idp += numFacePts;
-            switch (numFacePts)
-            {
-            case 3: aCellType = VTK_TRIANGLE; break;
-            case 4: aCellType = VTK_QUAD;     break;
-            default:aCellType = VTK_POLYGON;
-            }
-            input->GetCellNeighbors(cellId, faceIds, cellIds);
-            vtkIdType nbNeighbors = cellIds->GetNumberOfIds() - cellIdsTmp->GetNumberOfIds();
-            if ( myShowInside && nbNeighbors > 0 && cellId < cellIds->GetId(0) )
-              continue; // don't add twice same internal face in wireframe mode
 #ifdef SHOW_COINCIDING_3D_PAL21924
             bool process = nbNeighbors <= 0;
 #else
-            bool process = cellIds->GetNumberOfIds() <= 0 || GetAppendCoincident3D();
+            bool process = nbNeighbors <= 0 || GetAppendCoincident3D();
 #endif
-            if (process || myShowInside
-                || (!allVisible && !cellVis[cellIds->GetId(0)]))
-            {
-              for (i = 0; i < numFacePts; i++)
-                aNewPts[i] = ptIds[pt0 + i];
-              newCellId = output->InsertNextCell(aCellType, numFacePts, aNewPts);
-              if (myStoreMapping)
-                InsertId( cellId, aCellType, myVTK2ObjIds, aDimension2VTK2ObjIds );
-              outputCD->CopyData(cd, cellId, newCellId);
+            if ( process || myShowInside ) {
+              face->Triangulate(0,lpts,coords);
+              for (i=0; i < lpts->GetNumberOfIds(); i+=3) {
+                aNewPts[0] = lpts->GetId(i);
+                aNewPts[1] = lpts->GetId(i+1);
+                aNewPts[2] = lpts->GetId(i+2);
+                sink->InsertNextCell(cellId,aCellType,numFacePts,aNewPts);
+              }
             }
           }
+        } //3d nonlinear cell
+        break;
+      }
+      else { // wireframe
+        switch(aCellType) {
+        case VTK_QUADRATIC_EDGE:
+        {
+          if(!myIsBuildArc || !BuildArcedEdge(cellId, pts, theContext)) {
+            aCellType = VTK_POLY_LINE;
+            numFacePts = 3;
+
+            aNewPts[0] = pts[0];
+            aNewPts[2] = pts[1];
+            aNewPts[1] = pts[2];
+
+            sink->InsertNextCell(cellId,aCellType,numFacePts,aNewPts);
+          }
           break;
         }
-#endif
-        //Quadratic cells
-        case VTK_QUADRATIC_EDGE:
         case VTK_QUADRATIC_TRIANGLE:
         case VTK_BIQUADRATIC_TRIANGLE:
+        {
+          if(!myIsBuildArc) {
+            aCellType = VTK_POLYGON;
+            numFacePts = 6;
+
+            aNewPts[0] = pts[0];
+            aNewPts[1] = pts[3];
+            aNewPts[2] = pts[1];
+            aNewPts[3] = pts[4];
+            aNewPts[4] = pts[2];
+            aNewPts[5] = pts[5];
+
+            sink->InsertNextCell(cellId,aCellType,numFacePts,aNewPts);
+          }
+          else
+            BuildArcedPolygon(cellId,theContext);
+          break;
+        }
         case VTK_QUADRATIC_QUAD:
         case VTK_BIQUADRATIC_QUAD:
+        {
+          if(!myIsBuildArc) {
+            aCellType = VTK_POLYGON;
+            numFacePts = 8;
+
+            aNewPts[0] = pts[0];
+            aNewPts[1] = pts[4];
+            aNewPts[2] = pts[1];
+            aNewPts[3] = pts[5];
+            aNewPts[4] = pts[2];
+            aNewPts[5] = pts[6];
+            aNewPts[6] = pts[3];
+            aNewPts[7] = pts[7];
+
+            sink->InsertNextCell(cellId,aCellType,numFacePts,aNewPts);
+          }
+          else
+            BuildArcedPolygon(cellId,theContext);
+          break;
+        }
         case VTK_QUADRATIC_POLYGON:
+        {
+          if(!myIsBuildArc)
+          {
+            aCellType = VTK_POLYGON;
+
+            for ( i = 0; i < npts/2; ++i )
+            {
+              aNewPts[i*2  ] = pts[i];
+              aNewPts[i*2+1] = pts[i+npts/2];
+            }
+            sink->InsertNextCell(cellId,aCellType,npts,aNewPts);
+          }
+          else
+            BuildArcedPolygon(cellId,theContext);
+          break;
+        }
         case VTK_QUADRATIC_TETRA:
-        case VTK_QUADRATIC_HEXAHEDRON:
-        case VTK_TRIQUADRATIC_HEXAHEDRON:
         case VTK_QUADRATIC_WEDGE:
         case VTK_BIQUADRATIC_QUADRATIC_WEDGE:
+        case VTK_TRIQUADRATIC_HEXAHEDRON:
+        case VTK_QUADRATIC_HEXAHEDRON:
         case VTK_QUADRATIC_PYRAMID:
-
-          if(!myIsWireframeMode)
+        {
+          aCellType = VTK_POLY_LINE;
+          input->GetCell(cellId,cell);
+          if ( myShowInside )
           {
-            input->GetCell(cellId,cell);
-            vtkIdList *lpts = vtkIdList::New();
-            vtkPoints *coords = vtkPoints::New();
-            vtkIdList *cellIds = vtkIdList::New();
-            vtkIdType newCellId;
-
-            if ( cell->GetCellDimension() == 1 ) {
-              vtkIdType arcResult = -1;
-              if(myIsBuildArc) {
-                arcResult = Build1DArc(cellId, input, output, const_cast<vtkIdType *>(pts), myMaxArcAngle);
-                newCellId = arcResult;
-              }
-
-              if(!myIsBuildArc || arcResult == -1 ) {
-                aCellType = VTK_LINE;
-                numFacePts = 2;
-                cell->Triangulate(0,lpts,coords);
-                for (i=0; i < lpts->GetNumberOfIds(); i+=2) {
-                  aNewPts[0] = lpts->GetId(i);
-                  aNewPts[1] = lpts->GetId(i+1);
-                  newCellId = output->InsertNextCell(aCellType,numFacePts,aNewPts);
-                  if(myStoreMapping)
-                    InsertId( cellId, aCellType, myVTK2ObjIds, aDimension2VTK2ObjIds );
-                  outputCD->CopyData(cd,cellId,newCellId);
-                }
-              }
-              else {
-                if(myStoreMapping)
-                  InsertId( cellId, aCellType, myVTK2ObjIds, aDimension2VTK2ObjIds );
-                outputCD->CopyData(cd,cellId,newCellId);
-              }
-            }
-            else if ( cell->GetCellDimension() == 2 ) {
-              if(!myIsBuildArc) {
-                aCellType = VTK_TRIANGLE;
-                numFacePts = 3;
-                cell->Triangulate(0,lpts,coords);
-                for (i=0; i < lpts->GetNumberOfIds(); i+=3) {
-                  aNewPts[0] = lpts->GetId(i);
-                  aNewPts[1] = lpts->GetId(i+1);
-                  aNewPts[2] = lpts->GetId(i+2);
-                  newCellId = output->InsertNextCell(aCellType,numFacePts,aNewPts);
-                  if(myStoreMapping)
-                    InsertId( cellId, aCellType, myVTK2ObjIds, aDimension2VTK2ObjIds );
-                  outputCD->CopyData(cd,cellId,newCellId);
-                }
-              }
-              else{
-                BuildArcedPolygon(cellId,input,output,aDimension2VTK2ObjIds,true);
-              }
-            }
-            else //3D nonlinear cell
+            int nbEdges = cell->GetNumberOfEdges();
+            for ( int edgeId = 0; edgeId < nbEdges; ++edgeId )
             {
-#ifdef SHOW_COINCIDING_3D_PAL21924
-              if ( !myShowInside )
+              vtkCell * edge = cell->GetEdge( edgeId );
+              if ( theContext.ToShowEdge( edge->GetPointId(0), edge->GetPointId(2), cellId ))
               {
-                vtkIdType npts1 = 0;
-                switch (aCellType ){
-                case VTK_QUADRATIC_TETRA:             npts1 = 4; break;
-                case VTK_QUADRATIC_HEXAHEDRON:        npts1 = 8; break;
-                case VTK_TRIQUADRATIC_HEXAHEDRON:     npts1 = 8; break;
-                case VTK_QUADRATIC_WEDGE:             npts1 = 6; break;
-                case VTK_BIQUADRATIC_QUADRATIC_WEDGE: npts1 = 6; break;
-                case VTK_QUADRATIC_PYRAMID:           npts1 = 5; break;
-                }
-                faceIdsTmp->SetNumberOfIds( npts1 );
-                if ( npts1 > 0 ) {
-                  for (auto ai=0; ai<npts1; ai++)
-                    faceIdsTmp->SetId( ai, pts[ai] );
-                  input->GetCellNeighbors(cellId, faceIdsTmp, cellIdsTmp);
-                }
+                aNewPts[0] = edge->GetPointId(0);
+                aNewPts[1] = edge->GetPointId(2);
+                aNewPts[2] = edge->GetPointId(1);
+                sink->InsertNextCell( cellId, aCellType, 3, aNewPts );
               }
-#endif
-              aCellType = VTK_TRIANGLE;
-              numFacePts = 3;
-              vtkIdType nbNeighbors = 0;
-              for (auto j=0; j < cell->GetNumberOfFaces(); j++)
-              {
-                vtkCell *face = cell->GetFace(j);
-                if ( !myShowInside ) {
-                  input->GetCellNeighbors(cellId, face->PointIds, cellIds);
-                  nbNeighbors = cellIds->GetNumberOfIds() - cellIdsTmp->GetNumberOfIds();
-                }
+            }
+          }
+          else
+          {
+            vtkIdType nbCoincident = 0;
 #ifdef SHOW_COINCIDING_3D_PAL21924
-                bool process = nbNeighbors <= 0;
-#else
-                bool process = nbNeighbors <= 0 || GetAppendCoincident3D();
+            vtkIdType nbPnt = npts - cell->GetNumberOfEdges();
+            faceIdsTmp->SetNumberOfIds( nbPnt );
+            for ( auto ai = 0; ai < nbPnt; ai++ )
+              faceIdsTmp->SetId( ai, pts[ai] );
+            theContext.GetCellNeighbors(cellId, faceIdsTmp, cellIdsTmp);
+            nbCoincident = cellIdsTmp->GetNumberOfIds();
 #endif
-                if ( process || myShowInside ) {
-                  face->Triangulate(0,lpts,coords);
-                  for (i=0; i < lpts->GetNumberOfIds(); i+=3) {
-                    aNewPts[0] = lpts->GetId(i);
-                    aNewPts[1] = lpts->GetId(i+1);
-                    aNewPts[2] = lpts->GetId(i+2);
-                    newCellId = output->InsertNextCell(aCellType,numFacePts,aNewPts);
-                    if(myStoreMapping)
-                      InsertId( cellId, aCellType, myVTK2ObjIds, aDimension2VTK2ObjIds );
-                    outputCD->CopyData(cd,cellId,newCellId);
-                  }
-                }
-              }
-            } //3d nonlinear cell
-            cellIds->Delete();
-            coords->Delete();
-            lpts->Delete();
-            break;
-          }
-          else { // wireframe
-            switch(aCellType) {
-            case VTK_QUADRATIC_EDGE:
-            {
-              vtkIdType arcResult = -1;
-              if(myIsBuildArc) {
-                arcResult = Build1DArc(cellId, input, output, const_cast<vtkIdType *>(pts), myMaxArcAngle);
-                newCellId = arcResult;
-              }
-              if(!myIsBuildArc || arcResult == -1) {
-                aCellType = VTK_POLY_LINE;
-                numFacePts = 3;
-
-                aNewPts[0] = pts[0];
-                aNewPts[2] = pts[1];
-                aNewPts[1] = pts[2];
-
-                newCellId = output->InsertNextCell(aCellType,numFacePts,aNewPts);
-              }
-
-              if(myStoreMapping)
-                InsertId( cellId, aCellType, myVTK2ObjIds, aDimension2VTK2ObjIds );
-
-              outputCD->CopyData(cd,cellId,newCellId);
-              break;
-            }
-            case VTK_QUADRATIC_TRIANGLE:
-            case VTK_BIQUADRATIC_TRIANGLE:
-            {
-              if(!myIsBuildArc) {
-                aCellType = VTK_POLYGON;
-                numFacePts = 6;
-
-                aNewPts[0] = pts[0];
-                aNewPts[1] = pts[3];
-                aNewPts[2] = pts[1];
-                aNewPts[3] = pts[4];
-                aNewPts[4] = pts[2];
-                aNewPts[5] = pts[5];
-
-                newCellId = output->InsertNextCell(aCellType,numFacePts,aNewPts);
-                if(myStoreMapping)
-                  InsertId( cellId, aCellType, myVTK2ObjIds, aDimension2VTK2ObjIds );
-
-                outputCD->CopyData(cd,cellId,newCellId);
-              }
-              else
-                BuildArcedPolygon(cellId,input,output,aDimension2VTK2ObjIds);
-              break;
-            }
-            case VTK_QUADRATIC_QUAD:
-            case VTK_BIQUADRATIC_QUAD:
-            {
-              if(!myIsBuildArc) {
-                aCellType = VTK_POLYGON;
-                numFacePts = 8;
-
-                aNewPts[0] = pts[0];
-                aNewPts[1] = pts[4];
-                aNewPts[2] = pts[1];
-                aNewPts[3] = pts[5];
-                aNewPts[4] = pts[2];
-                aNewPts[5] = pts[6];
-                aNewPts[6] = pts[3];
-                aNewPts[7] = pts[7];
-
-                newCellId = output->InsertNextCell(aCellType,numFacePts,aNewPts);
-                if(myStoreMapping)
-                  InsertId( cellId, aCellType, myVTK2ObjIds, aDimension2VTK2ObjIds );
-
-                outputCD->CopyData(cd,cellId,newCellId);
-              }
-              else
-                BuildArcedPolygon(cellId,input,output,aDimension2VTK2ObjIds);
-              break;
-            }
-            case VTK_QUADRATIC_POLYGON:
-            {
-              if(!myIsBuildArc)
-              {
-                aCellType = VTK_POLYGON;
-
-                for ( i = 0; i < npts/2; ++i )
-                {
-                  aNewPts[i*2  ] = pts[i];
-                  aNewPts[i*2+1] = pts[i+npts/2];
-                }
-                newCellId = output->InsertNextCell(aCellType,npts,aNewPts);
-                if(myStoreMapping)
-                  InsertId( cellId, aCellType, myVTK2ObjIds, aDimension2VTK2ObjIds );
-
-                outputCD->CopyData(cd,cellId,newCellId);
-              }
-              else
-                BuildArcedPolygon(cellId,input,output,aDimension2VTK2ObjIds);
-              break;
-            }
-            case VTK_QUADRATIC_TETRA:
-            case VTK_QUADRATIC_WEDGE:
-            case VTK_BIQUADRATIC_QUADRATIC_WEDGE:
-            case VTK_TRIQUADRATIC_HEXAHEDRON:
-            case VTK_QUADRATIC_HEXAHEDRON:
-            case VTK_QUADRATIC_PYRAMID:
+            midPoints.clear();
+            int nbFaces = cell->GetNumberOfFaces();
+            for ( faceId = 0; faceId < nbFaces; faceId++ )
             {
-              aCellType = VTK_POLY_LINE;
-              input->GetCell(cellId,cell);
-              if ( myShowInside )
+              vtkCell * face = cell->GetFace( faceId );
+              theContext.GetCellNeighbors( cellId, face->GetPointIds(), cellIds );
+              vtkIdType nbNeighbors = cellIds->GetNumberOfIds() - nbCoincident;
+              if ( nbNeighbors <= 0 )
               {
-                int nbEdges = cell->GetNumberOfEdges();
-                for ( int edgeId = 0; edgeId < nbEdges; ++edgeId )
+                vtkIdType nbEdges = face->GetNumberOfPoints() / 2;
+                for ( auto edgeId = 0; edgeId < nbEdges; ++edgeId )
                 {
-                  vtkCell * edge = cell->GetEdge( edgeId );
-                  if ( toShowEdge( edge->GetPointId(0), edge->GetPointId(2), cellId, input ))
-                  {
-                    aNewPts[0] = edge->GetPointId(0);
-                    aNewPts[1] = edge->GetPointId(2);
-                    aNewPts[2] = edge->GetPointId(1);
-                    newCellId = output->InsertNextCell( aCellType, 3, aNewPts );
-                    if(myStoreMapping)
-                      InsertId( cellId, aCellType, myVTK2ObjIds, aDimension2VTK2ObjIds );
-                    outputCD->CopyData(cd,cellId,newCellId);
+                  vtkIdType p1 = ( edgeId );               // corner
+                  vtkIdType p2 = ( edgeId + nbEdges );     // medium
+                  vtkIdType p3 = ( edgeId + 1 ) % nbEdges; // next corner
+                  faceIdsTmp->SetNumberOfIds( 2 );
+                  faceIdsTmp->SetId( 0, face->GetPointId(p2) );
+                  faceIdsTmp->SetId( 1, face->GetPointId(p1) );
+                  theContext.GetCellNeighbors(cellId, faceIdsTmp, cellIdsTmp);
+                  bool process;
+                  switch ( cellIdsTmp->GetNumberOfIds() ) {
+                  case 0: // the edge belong to this cell only
+                    // avoid adding it when treating another face
+                    process = midPoints.insert( face->GetPointId(p2) ).second; break;
+                  case 1: // the edge is shared by two cells
+                    process = ( cellIdsTmp->GetId(0) < cellId ); break;
+                  default: // the edge is shared by >2 cells
+                    process = ( cellIdsTmp->GetId(0) < cellId ); break;
                   }
-                }
-              }
-              else
-              {
-                vtkIdType nbCoincident = 0;
-#ifdef SHOW_COINCIDING_3D_PAL21924
-                vtkIdType nbPnt = npts - cell->GetNumberOfEdges();
-                faceIdsTmp->SetNumberOfIds( nbPnt );
-                for ( auto ai = 0; ai < nbPnt; ai++ )
-                  faceIdsTmp->SetId( ai, pts[ai] );
-                input->GetCellNeighbors(cellId, faceIdsTmp, cellIdsTmp);
-                nbCoincident = cellIdsTmp->GetNumberOfIds();
-#endif
-                midPoints.clear();
-                int nbFaces = cell->GetNumberOfFaces();
-                for ( faceId = 0; faceId < nbFaces; faceId++ )
-                {
-                  vtkCell * face = cell->GetFace( faceId );
-                  input->GetCellNeighbors( cellId, face->GetPointIds(), cellIds );
-                  vtkIdType nbNeighbors = cellIds->GetNumberOfIds() - nbCoincident;
-                  if ( nbNeighbors <= 0 )
+                  if ( process )
                   {
-                    vtkIdType nbEdges = face->GetNumberOfPoints() / 2;
-                    for ( auto edgeId = 0; edgeId < nbEdges; ++edgeId )
-                    {
-                      vtkIdType p1 = ( edgeId );               // corner
-                      vtkIdType p2 = ( edgeId + nbEdges );     // medium
-                      vtkIdType p3 = ( edgeId + 1 ) % nbEdges; // next corner
-                      faceIdsTmp->SetNumberOfIds( 2 );
-                      faceIdsTmp->SetId( 0, face->GetPointId(p2) );
-                      faceIdsTmp->SetId( 1, face->GetPointId(p1) );
-                      input->GetCellNeighbors(cellId, faceIdsTmp, cellIdsTmp);
-                      bool process;
-                      switch ( cellIdsTmp->GetNumberOfIds() ) {
-                      case 0: // the edge belong to this cell only
-                        // avoid adding it when treating another face
-                        process = midPoints.insert( face->GetPointId(p2) ).second; break;
-                      case 1: // the edge is shared by two cells
-                        process = ( cellIdsTmp->GetId(0) < cellId ); break;
-                      default: // the edge is shared by >2 cells
-                        process = ( cellIdsTmp->GetId(0) < cellId ); break;
-                      }
-                      if ( process )
-                      {
-                        aNewPts[0] = face->GetPointId( p1 );
-                        aNewPts[1] = face->GetPointId( p2 );
-                        aNewPts[2] = face->GetPointId( p3 );
-                        newCellId = output->InsertNextCell( aCellType, 3, aNewPts );
-                        if(myStoreMapping)
-                          InsertId( cellId, aCellType, myVTK2ObjIds, aDimension2VTK2ObjIds );
-                        outputCD->CopyData(cd,cellId,newCellId);
-                      }
-                    }
+                    aNewPts[0] = face->GetPointId( p1 );
+                    aNewPts[1] = face->GetPointId( p2 );
+                    aNewPts[2] = face->GetPointId( p3 );
+                    sink->InsertNextCell( cellId, aCellType, 3, aNewPts );
                   }
                 }
               }
-              break;
-            } // case of volumes in wireframe
-            } // switch by quadratic type
-          } // end WIREFRAME
+            }
+          }
           break;
-        } //switch by type
-
-    } //if visible
-  } //for all cells
-
-  output->Squeeze();
-
-  vtkDebugMacro(<<"Extracted " << input->GetNumberOfPoints() << " points,"
-                << output->GetNumberOfCells() << " cells.");
-
-  cell->Delete();
-
-  cellIds->Delete();
-  faceIds->Delete();
-  cellIdsTmp->Delete();
-  faceIdsTmp->Delete();
-
-  if ( cellVis )
-  {
-    delete [] cellVis;
-  }
-
-  if ( input->GetLinks() )
-  {
-    input->GetLinks()->Initialize(); // free memory
-  }
-
-  // fill myVTK2ObjIds vector in ascending cell dimension order
-  myVTK2ObjIds.clear();
-  if( myStoreMapping && !aDimension2VTK2ObjIds.empty() )
-  {
-    size_t nbCells = ( aDimension2VTK2ObjIds[0].size() +
-                       aDimension2VTK2ObjIds[1].size() +
-                       aDimension2VTK2ObjIds[2].size() );
-    if ( myVTK2ObjIds.capacity() > nbCells )
-      TVectorId().swap( myVTK2ObjIds );
-    myVTK2ObjIds.reserve( nbCells );
-
-    for( int aDimension = 0; aDimension <= 2; aDimension++ )
-      if ( !aDimension2VTK2ObjIds[ aDimension ].empty() )
-      {
-        myVTK2ObjIds.insert( myVTK2ObjIds.end(),
-                             aDimension2VTK2ObjIds[ aDimension ].begin(),
-                             aDimension2VTK2ObjIds[ aDimension ].end() );
-        TVectorId().swap( aDimension2VTK2ObjIds[ aDimension ]);
-      }
-  }
-
-  return 1;
+        } // case of volumes in wireframe
+        } // switch by quadratic type
+      } // end WIREFRAME
+      break;
+    } //switch by type
 }
 
 void
@@ -1453,29 +1852,58 @@ vtkIdType VTKViewer_GeometryFilter::GetElemObjId( vtkIdType theVtkID )
 }
 
 
+/*!
+ * \brief Build an arc for a quadratic edge and pass it to the sink of the context
+ *  \retval bool - false if the arc can't be built
+ */
+bool VTKViewer_GeometryFilter::BuildArcedEdge(vtkIdType cellId,
+                                              const vtkIdType* pts,
+                                              TExtractionContext& theContext)
+{
+  vtkGenericCell* aCell = theContext.myCell.Get();
+  theContext.myInput->GetCell(cellId, aCell);
+
+  //Get All points from input cell
+  Pnt P0 = CreatePnt( aCell, theContext.myInputScalars, 0 );
+  Pnt P1 = CreatePnt( aCell, theContext.myInputScalars, 1 );
+  Pnt P2 = CreatePnt( aCell, theContext.myInputScalars, 2 );
+
+  VTKViewer_ArcBuilder aBuilder(P0,P2,P1,myMaxArcAngle);
+  if (aBuilder.GetStatus() != VTKViewer_ArcBuilder::Arc_Done)
+    return false;
+
+  vtkPoints* aPoints = aBuilder.GetPoints();
+  const std::vector<double>& aScalarValues = aBuilder.GetScalarValues();
+  vtkIdType aNbPts = aPoints->GetNumberOfPoints();
+  std::vector< vtkIdType > aNewPoints( aNbPts );
+
+  aNewPoints[0] = pts[0];
+  for(vtkIdType idx = 1; idx < aNbPts-1;idx++)
+    aNewPoints[idx] = theContext.mySink->InsertNextPoint(aPoints->GetPoint(idx), aScalarValues[idx]);
+  aNewPoints[aNbPts-1] = pts[1];
+
+  // the arc is registered in the mapping as the quadratic edge it comes from
+  theContext.mySink->InsertNextCell(cellId, VTK_POLY_LINE, aNbPts, &aNewPoints[0], VTK_QUADRATIC_EDGE);
+  return true;
+}
+
 void VTKViewer_GeometryFilter::BuildArcedPolygon(vtkIdType cellId,
-                                                 vtkUnstructuredGrid* input,
-                                                 vtkPolyData *output,
-                                                 TMapOfVectorId& theDimension2VTK2ObjIds,
+                                                 TExtractionContext& theContext,
                                                  bool triangulate)
 {
   vtkIdType aCellType = VTK_POLYGON;
   vtkIdType *aNewPoints = NULL;
   vtkIdType aNbPoints = 0;
-  vtkIdType newCellId;
 
-  //Input and output cell data
-  vtkCellData *cd = input->GetCellData();
-  vtkCellData *outputCD = output->GetCellData();
-
-  //Input and output scalars on point data
-  vtkDataArray* inputScalars = input->GetPointData()->GetScalars();
-  vtkDataArray* outputScalars = output->GetPointData()->GetScalars();
+  //Input scalars on point data
+  vtkDataArray* inputScalars = theContext.myInputScalars;
+  TCellSink* aSink = theContext.mySink;
 
   std::vector< vtkSmartPointer<vtkPoints> > aCollection;
   std::vector< std::vector<double> > aScalarCollection;
 
-  vtkCell* aCell = input->GetCell(cellId);
+  vtkGenericCell* aCell = theContext.myCell.Get();
+  theContext.myInput->GetCell(cellId, aCell);
   switch(aCell->GetCellType()) {
     case VTK_QUADRATIC_TRIANGLE:
     case VTK_BIQUADRATIC_TRIANGLE:
@@ -1583,11 +2011,10 @@ void VTKViewer_GeometryFilter::BuildArcedPolygon(vtkIdType cellId,
 
   if(triangulate){
     const vtkIdType numFacePts = 3;
-    vtkIdList *pts = vtkIdList::New();
-    vtkPoints *coords = vtkPoints::New();
+    vtkIdList *pts = theContext.myTriaIds.Get();
+    vtkPoints *coords = theContext.myTriaCoords.Get();
     aCellType = VTK_TRIANGLE;
     vtkIdType aNewPts[numFacePts];
-    vtkIdType aTriangleId;
 
     vtkPolygon *aPlg = vtkPolygon::New();
     std::map<vtkIdType, double> aPntId2ScalarValue;
@@ -1601,37 +2028,22 @@ void VTKViewer_GeometryFilter::BuildArcedPolygon(vtkIdType cellId,
     aPlg->Triangulate(0,pts,coords);
 
     for (vtkIdType i=0; i < pts->GetNumberOfIds(); i+=3) {
-      aNewPts[0] = output->GetPoints()->InsertNextPoint(coords->GetPoint(i));
-      aNewPts[1] = output->GetPoints()->InsertNextPoint(coords->GetPoint(i+1));
-      aNewPts[2] = output->GetPoints()->InsertNextPoint(coords->GetPoint(i+2));
-
-      if(outputScalars) {
-        outputScalars->InsertNextTuple1(aPntId2ScalarValue[pts->GetId(i)]);
-        outputScalars->InsertNextTuple1(aPntId2ScalarValue[pts->GetId(i+1)]);
-        outputScalars->InsertNextTuple1(aPntId2ScalarValue[pts->GetId(i+2)]);
-      }
-
-      aTriangleId = output->InsertNextCell(aCellType,numFacePts,aNewPts);
+      aNewPts[0] = aSink->InsertNextPoint(coords->GetPoint(i),   aPntId2ScalarValue[pts->GetId(i)]);
+      aNewPts[1] = aSink->InsertNextPoint(coords->GetPoint(i+1), aPntId2ScalarValue[pts->GetId(i+1)]);
+      aNewPts[2] = aSink->InsertNextPoint(coords->GetPoint(i+2), aPntId2ScalarValue[pts->GetId(i+2)]);
 
-      if(myStoreMapping)
-        InsertId( cellId, aCellType, myVTK2ObjIds, theDimension2VTK2ObjIds );
-      outputCD->CopyData(cd,cellId,aTriangleId);
+      aSink->InsertNextCell(cellId,aCellType,numFacePts,aNewPts);
     }
-    pts->Delete();
-    coords->Delete();
     aPlg->Delete();
   }
   else {
+    // merge arcs in a local set of points, then add them to the output
+    vtkNew<vtkPoints> aPoints;
     std::map<vtkIdType, double> aPntId2ScalarValue;
-    aNbPoints = MergevtkPoints(aCollection, aScalarCollection, output->GetPoints(), aPntId2ScalarValue, aNewPoints);
-    if(outputScalars)
-      for(vtkIdType i = 0; i < aNbPoints; i++)
-        outputScalars->InsertNextTuple1(aPntId2ScalarValue[aNewPoints[i]]);
-    newCellId = output->InsertNextCell(aCellType,aNbPoints,aNewPoints);
-    outputCD->CopyData(cd,cellId,newCellId);
-
-    if(myStoreMapping)
-      InsertId( cellId, aCellType, myVTK2ObjIds, theDimension2VTK2ObjIds );
+    aNbPoints = MergevtkPoints(aCollection, aScalarCollection, aPoints.Get(), aPntId2ScalarValue, aNewPoints);
+    for(vtkIdType i = 0; i < aNbPoints; i++)
+      aNewPoints[i] = aSink->InsertNextPoint(aPoints->GetPoint(aNewPoints[i]), aPntId2ScalarValue[aNewPoints[i]]);
+    aSink->InsertNextCell(cellId,aCellType,aNbPoints,aNewPoints);
   }
 
   if (aNewPoints)
@@ -1680,3 +2092,39 @@ void VTKViewer_GeometryFilter::SetAppendCoincident3D(int theFlag) {
     this->Modified();
   }
 }
+
+void VTKViewer_GeometryFilter::SetParallelMode(bool theFlag)
+{
+  // the result does not depend on the mode, so there is no need to call Modified()
+  myIsParallel = theFlag;
+}
+
+bool VTKViewer_GeometryFilter::GetParallelMode() const
+{
+  return myIsParallel;
+}
+
+void VTKViewer_GeometryFilter::SetTopologyCaching(bool theFlag)
+{
+  // the result does not depend on the caching, so there is no need to call Modified()
+  myUseTopologyCache = theFlag;
+  if ( !myUseTopologyCache )
+    ReleaseTopologyCache();
+}
+
+bool VTKViewer_GeometryFilter::GetTopologyCaching() const
+{
+  return myUseTopologyCache;
+}
+
+void VTKViewer_GeometryFilter::ReleaseTopologyCache()
+{
+  delete myTopologyCache;
+  myTopologyCache = 0;
+}
+
+void VTKViewer_GeometryFilter::ReleaseScratch()
+{
+  delete myScratchPool;
+  myScratchPool = 0;
+}
@@ -106,6 +106,37 @@ public:
   virtual void   SetQuadraticArcAngle(double theMaxAngle);
   virtual double GetQuadraticArcAngle() const;
 
+  /*! \fn void SetParallelMode(bool theFlag)
+   * \brief Sets \a myIsParallel flag. If this flag is true, the cells of an unstructured grid
+   *  are extracted by chunks in several threads (see vtkSMPTools), the chunks being merged
+   *  in order, so the output and the ids mapping are the same as in the serial mode.
+   */
+  void SetParallelMode(bool theFlag);
+  /*! \fn bool GetParallelMode()
+   * \brief Return value of \a myIsParallel
+   */
+  bool GetParallelMode() const;
+
+  /*! \fn void SetTopologyCaching(bool theFlag)
+   * \brief Sets \a myUseTopologyCache flag. If this flag is true, the results of the neighbour
+   *  queries done to find boundary faces and edges are kept until the input is modified,
+   *  so that changing the representation (wireframe, inside, arcs) only re-emits the output
+   *  cells. The cache is filled only if there is no clipping and no ghost cells.
+   */
+  void SetTopologyCaching(bool theFlag);
+  /*! \fn bool GetTopologyCaching()
+   * \brief Return value of \a myUseTopologyCache
+   */
+  bool GetTopologyCaching() const;
+  /*! \fn void ReleaseTopologyCache()
+   * \brief Free memory used by the topology cache; it is filled again on next execution.
+   */
+  void ReleaseTopologyCache();
+  /*! \fn void ReleaseScratch()
+   * \brief Free the scratch objects and the triangulations of convex cells kept between executions.
+   */
+  void ReleaseScratch();
+
   typedef std::vector<vtkIdType> TVectorId;
   //typedef std::map<vtkIdType, TVectorId> TMapOfVectorId;
   typedef std::vector<TVectorId> TMapOfVectorId;
@@ -115,7 +146,13 @@ public:
                         TVectorId& /*theVTK2ObjIds*/,
                         TMapOfVectorId& theDimension2VTK2ObjIds );
 
+  struct TCellSink; //!< receiver of the cells built from the input cells
+
 protected:
+  struct TExtractionContext; //!< data and scratch objects used to extract cells
+  struct TTopologyCache;     //!< results of neighbour queries kept between executions
+  struct TScratchPool;       //!< extraction contexts and triangulations reused between executions
+
   /*! \fn VTKViewer_GeometryFilter();
    * \brief Constructor which sets \a myShowInside = 0 and \a myStoreMapping = 0
    */
@@ -134,11 +171,20 @@ protected:
    */
   int UnstructuredGridExecute (vtkDataSet *, vtkPolyData *, vtkInformation *);
 
+  /*! \fn void ExtractCell(vtkIdType, vtkIdType, const vtkIdType*, TExtractionContext&);
+   * \brief Build faces / edges of a visible input cell. Thread-safe if the links of the input are built.
+   */
+  void ExtractCell(vtkIdType cellId,
+                   vtkIdType npts,
+                   const vtkIdType* pts,
+                   TExtractionContext& theContext);
+
+  bool BuildArcedEdge(vtkIdType cellId,
+                      const vtkIdType* pts,
+                      TExtractionContext& theContext);
 
   void BuildArcedPolygon(vtkIdType cellId,
-                         vtkUnstructuredGrid* input,
-                         vtkPolyData *output,
-                         TMapOfVectorId& theDimension2VTK2ObjIds,
+                         TExtractionContext& theContext,
                          bool triangulate = false);
 
   /*! \fn void FillVTK2ObjIds(vtkPolyData *output);
@@ -159,6 +205,11 @@ private:
 
   double    myMaxArcAngle;    // define max angle for mesh 2D quadratic element in the degrees
   bool      myIsBuildArc;     // flag for representation 2D quadratic element as arked polygon
+  bool      myIsParallel;     // flag for multi-threaded extraction of unstructured grid cells
+  bool      myUseTopologyCache; // flag for keeping results of neighbour queries between executions
+
+  TTopologyCache* myTopologyCache;
+  TScratchPool*   myScratchPool;
 };
 
 #ifdef WIN32